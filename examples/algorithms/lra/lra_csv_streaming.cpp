@@ -0,0 +1,158 @@
+//   Copyright (c) 2021 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <hpx/hpx_init.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <blaze/Math.h>
+#include <hpx/program_options.hpp>
+
+//////////////////////////////////////////////////////////////////////////////////
+// This example compares the full batch logistic regression (lra) operating on
+// data read into memory with the mini-batch trainer (lra_sgd) which streams
+// the data from the CSV file. The data file holds one sample per line with the
+// classification in the last column (see breast_cancer.csv in
+// examples/algorithms/datasets).
+//
+// With --distributed every locality streams its own part of the data, the
+// string '{locality}' in the file name is replaced by the locality id.
+/////////////////////////////////////////////////////////////////////////////////
+
+char const* const read_code = R"(block(
+    //
+    // Read X and Y-data from given CSV file
+    //
+    define(read, filepath, block(
+        define(data, file_read_csv(filepath)),
+        define(cols, shape(data, 1)),
+        list(slice(data, nil, list(0, cols - 1)), slice(data, nil, cols - 1))
+    )),
+    read
+))";
+
+char const* const lra_code = R"(block(
+    define(run_lra, x, y, alpha, iterations, lra(x, y, alpha, iterations)),
+    run_lra
+))";
+
+char const* const lra_sgd_code = R"(block(
+    define(run_lra_sgd, filepath, alpha, epochs, batch_size, optimizer,
+        lra_sgd(filepath, nil, alpha, epochs, batch_size, optimizer)
+    ),
+    run_lra_sgd
+))";
+
+char const* const lra_sgd_d_code = R"(block(
+    define(run_lra_sgd_d, filepath, alpha, epochs, batch_size, optimizer,
+        lra_sgd_d(filepath, nil, alpha, epochs, batch_size, optimizer)
+    ),
+    run_lra_sgd_d
+))";
+
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    if (vm.count("data_csv") == 0)
+    {
+        std::cerr << "Please specify '--data_csv=data-file'";
+        return hpx::finalize();
+    }
+
+    std::string filepath = vm["data_csv"].as<std::string>();
+    bool const distributed = vm.count("distributed") != 0;
+    if (distributed)
+    {
+        std::string const placeholder = "{locality}";
+        auto pos = filepath.find(placeholder);
+        if (pos != std::string::npos)
+        {
+            filepath.replace(pos, placeholder.size(),
+                std::to_string(hpx::get_locality_id()));
+        }
+    }
+
+    auto alpha = vm["alpha"].as<double>();
+    auto epochs = vm["epochs"].as<std::int64_t>();
+    auto batch_size = vm["batch_size"].as<std::int64_t>();
+    auto optimizer = vm["optimizer"].as<std::string>();
+
+    phylanx::execution_tree::compiler::function_list snippets;
+
+    // full batch gradient descent on the data in memory, using the same
+    // number of passes over the data
+    if (!distributed)
+    {
+        auto const& code_read =
+            phylanx::execution_tree::compile("read", read_code, snippets);
+        auto read = code_read.run();
+
+        auto const& code_lra =
+            phylanx::execution_tree::compile("lra", lra_code, snippets);
+        auto lra = code_lra.run();
+
+        hpx::chrono::high_resolution_timer t;
+
+        auto data = phylanx::execution_tree::extract_list_value(read(filepath));
+        auto it = data.begin();
+        auto x = *it++;
+        auto y = *it;
+        auto result = lra(std::move(x), std::move(y), alpha, epochs);
+
+        std::cout << "lra (in memory): " << t.elapsed() << " s\n"
+                  << phylanx::execution_tree::extract_numeric_value(result)
+                  << std::endl;
+    }
+
+    // mini-batches streamed from the file
+    auto const& code_sgd = phylanx::execution_tree::compile("lra_sgd",
+        distributed ? lra_sgd_d_code : lra_sgd_code, snippets);
+    auto lra_sgd = code_sgd.run();
+
+    hpx::chrono::high_resolution_timer t;
+
+    auto result = lra_sgd(filepath, alpha, epochs, batch_size, optimizer);
+
+    if (hpx::get_locality_id() == 0)
+    {
+        std::cout << (distributed ? "lra_sgd_d" : "lra_sgd")
+                  << " (streaming, batch size " << batch_size
+                  << ", " << optimizer << "): " << t.elapsed() << " s\n"
+                  << phylanx::execution_tree::extract_numeric_value(result)
+                  << std::endl;
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // command line handling
+    hpx::program_options::options_description desc(
+        "usage: lra_csv_streaming [options]");
+    desc.add_options()
+        ("data_csv", hpx::program_options::value<std::string>(),
+            "file name for reading data")
+        ("distributed", "train on data distributed over all localities")
+        ("alpha,a",
+            hpx::program_options::value<double>()->default_value(1e-5),
+            "alpha (default: 1e-5)")
+        ("epochs,n",
+            hpx::program_options::value<std::int64_t>()->default_value(10),
+            "number of passes over the data (default: 10)")
+        ("batch_size",
+            hpx::program_options::value<std::int64_t>()->default_value(32),
+            "number of samples per batch (default: 32)")
+        ("optimizer",
+            hpx::program_options::value<std::string>()->default_value("sgd"),
+            "sgd, momentum, or adam (default: sgd)");
+
+    hpx::init_params params;
+    params.desc_cmdline = desc;
+    return hpx::init(argc, argv, params);
+}
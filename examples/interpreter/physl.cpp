@@ -239,7 +239,8 @@ int handle_command_line(int argc, char* argv[], po::variables_map& vm)
                 "Print the result of evaluation using the given format, valid "
                 "values are 'plain', 'physl', or 'json' (default: 'plain')")
             ("performance", "Print the topology of the created execution "
-                "tree and the corresponding performance counter results")
+                "tree, the corresponding performance counter results, and "
+                "the memory held by the results of the primitives")
             ("dump-dot", po::value<std::string>(), "Write the topology of the "
                 "created execution tree as a dot file to a file")
             ("dump-newick-tree", po::value<std::string>(), "Write the topology "
@@ -261,9 +262,23 @@ int handle_command_line(int argc, char* argv[], po::variables_map& vm)
                 "is to be executed to a file")
             ("dump-counters", po::value<std::string>(), "Write the performance "
                 "counter CSV data code to a file")
+            ("performance-report",
+                po::value<std::string>()->implicit_value("<none>"),
+                "Print the self time of all primitives and source lines, the "
+                "critical path, and the achieved parallelism. If a filename "
+                "is specified, print to the file.")
+            ("dump-folded-stacks", po::value<std::string>(), "Write the self "
+                "time of all primitives as folded stacks (as understood by "
+                "flamegraph.pl) to a file")
+            ("hardware-counters", "Sample the hardware counters (cycles, "
+                "instructions, cache and branch misses) of all primitive "
+                "evaluations and print them with the performance data")
             ("dry-run", "Perform all other options requested but do not "
                 "actually run the code")
             ("time", "Print overall execution time before exiting")
+            ("trace", po::value<std::string>(), "Write the timeline of all "
+                "primitive evaluations to a file (in the Chrome Trace Event "
+                "format, as understood by chrome://tracing or Perfetto)")
         ;
         // clang-format on
 
@@ -421,7 +436,8 @@ phylanx::execution_tree::compiler::result_type compile_and_run(
     std::vector<phylanx::ast::expression> const& ast,
     std::vector<std::string> const& positional_args,
     phylanx::execution_tree::compiler::function_list& snippets,
-    std::string const& code_source_name, bool dry_run, bool print_time)
+    std::string const& code_source_name, bool dry_run, bool print_time,
+    bool trace)
 {
     phylanx::execution_tree::compiler::environment env =
         phylanx::execution_tree::compiler::default_environment();
@@ -449,6 +465,11 @@ phylanx::execution_tree::compiler::result_type compile_and_run(
     // Evaluate user code using the read data
     if (!dry_run)
     {
+        if (trace)
+        {
+            phylanx::util::enable_tracing();
+        }
+
         hpx::chrono::high_resolution_timer t;
         auto retval = code.run(ctx).arg_;
 
@@ -502,10 +523,71 @@ void print_newick_tree(std::string const& code_source_name,
        << "\n";
 }
 
+void print_memory_summary(std::ostream& os)
+{
+    phylanx::util::print_memory_report(
+        os, phylanx::util::retrieve_memory_data());
+    os << "\n";
+}
+
+void print_hardware_counters(std::ostream& os)
+{
+    if (!phylanx::util::hardware_counters_available())
+    {
+        os << "Hardware counters are not available on this system (see "
+              "/proc/sys/kernel/perf_event_paranoid)\n\n";
+        return;
+    }
+
+    phylanx::util::print_hardware_counter_report(
+        os, phylanx::util::retrieve_hardware_counter_data());
+    os << "\n";
+}
+
+void print_performance_analysis(std::string const& code_source_name,
+    phylanx::execution_tree::topology const& topology,
+    std::string const& report_file, std::string const& folded_stacks_file)
+{
+    auto const analysis = phylanx::util::analyze_performance(
+        code_source_name, topology, phylanx::util::retrieve_counter_data());
+
+    if (report_file == "<none>")
+    {
+        hpx::cout << "\n";
+        phylanx::util::print_performance_report(hpx::cout, analysis);
+    }
+    else if (!report_file.empty())
+    {
+        std::ofstream os(report_file);
+        if (!os.good())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "print_performance_analysis",
+                "Failed to open the specified file: " + report_file);
+        }
+
+        phylanx::util::print_performance_report(os, analysis);
+    }
+
+    if (!folded_stacks_file.empty())
+    {
+        std::ofstream os(folded_stacks_file);
+        if (!os.good())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "print_performance_analysis",
+                "Failed to open the specified file: " + folded_stacks_file);
+        }
+
+        phylanx::util::print_folded_stacks(os, analysis);
+    }
+}
+
 void print_performance_profile(
     phylanx::execution_tree::compiler::function_list& snippets,
     std::string const& code_source_name, std::string dot_file,
-    std::string newick_tree_file, std::string counter_file)
+    std::string newick_tree_file, std::string counter_file,
+    std::string report_file, std::string folded_stacks_file)
 {
     std::string locality =
         std::to_string(hpx::naming::get_locality_id_from_id(hpx::find_here()));
@@ -515,6 +597,14 @@ void print_performance_profile(
         counter_file += "." + locality;
         dot_file += "." + locality;
         newick_tree_file += "." + locality;
+        if (!report_file.empty() && report_file != "<none>")
+        {
+            report_file += "." + locality;
+        }
+        if (!folded_stacks_file.empty())
+        {
+            folded_stacks_file += "." + locality;
+        }
     }
 
     std::set<std::string> resolve_children;
@@ -589,6 +679,16 @@ void print_performance_profile(
 
         print_performance_counter_data_csv(os);
     }
+
+    print_memory_summary(hpx::cout);
+
+    if (phylanx::util::hardware_counters_enabled())
+    {
+        print_hardware_counters(hpx::cout);
+    }
+
+    print_performance_analysis(
+        code_source_name, topology, report_file, folded_stacks_file);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -674,9 +774,30 @@ void interpreter(po::variables_map const& vm)
         dump_physl_code(ast, physl_file);
     }
 
+    // Attribute the memory held by the results of the evaluations (and the
+    // hardware counters, if requested) to the primitives, if the performance
+    // data is requested
+    if (vm.count("performance") != 0)
+    {
+        phylanx::util::enable_memory_accounting();
+
+        if (vm.count("hardware-counters") != 0)
+        {
+            phylanx::util::enable_hardware_counters();
+        }
+    }
+
     phylanx::execution_tree::compiler::function_list snippets;
     auto const result = compile_and_run(ast, positional_args, snippets,
-        code_source_name, vm.count("dry-run") != 0, vm.count("time") != 0);
+        code_source_name, vm.count("dry-run") != 0, vm.count("time") != 0,
+        vm.count("trace") != 0);
+
+    // Write the timeline of the primitive evaluations, if requested
+    if (vm.count("trace") != 0)
+    {
+        phylanx::util::enable_tracing(false);
+        phylanx::util::write_trace(vm["trace"].as<std::string>());
+    }
 
     // Print the result of the last PhySL expression, and to the specified file,
     // if requested
@@ -721,17 +842,29 @@ void interpreter(po::variables_map const& vm)
         std::string counter_file = vm.count("dump-counters") == 0 ?
             "" :
             vm["dump-counters"].as<std::string>();
+        std::string report_file = vm.count("performance-report") == 0 ?
+            "" :
+            vm["performance-report"].as<std::string>();
+        std::string folded_stacks_file =
+            vm.count("dump-folded-stacks") == 0 ?
+            "" :
+            vm["dump-folded-stacks"].as<std::string>();
 
         print_performance_profile(snippets, code_source_name, dot_file,
-            newick_tree_file, counter_file);
+            newick_tree_file, counter_file, report_file, folded_stacks_file);
     }
     else if (vm.count("dump-dot") != 0 || vm.count("dump-newick-tree") != 0 ||
-        vm.count("dump-counters") != 0)
+        vm.count("dump-counters") != 0 ||
+        vm.count("performance-report") != 0 ||
+        vm.count("dump-folded-stacks") != 0 ||
+        vm.count("hardware-counters") != 0)
     {
         hpx::cerr
             << "physl: in order to generate any of the performance "
-               "output (--dump-dot, --dump-newick-tree, or --dump-counters), "
-               "please also specify the command line option --performance.";
+               "output (--dump-dot, --dump-newick-tree, --dump-counters, "
+               "--performance-report, --dump-folded-stacks, or "
+               "--hardware-counters), please also specify the command line "
+               "option --performance.";
     }
 }
 
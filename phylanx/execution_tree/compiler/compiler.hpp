@@ -21,9 +21,11 @@
 #include <hpx/errors/throw_exception.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -586,10 +588,41 @@ namespace phylanx { namespace execution_tree { namespace compiler
             return base_arg_num_;
         }
 
+        // The self-recursive calls in tail position of the function whose
+        // body is compiled in this environment, identified by the (line,
+        // column) tags of the calls.
+        using tail_calls_type = std::set<std::pair<std::int64_t, std::int64_t>>;
+
+        void set_tail_calls(tail_calls_type calls, std::size_t num_bound_args)
+        {
+            tail_calls_ = std::move(calls);
+            num_bound_args_ = num_bound_args;
+        }
+
+        bool is_tail_call(std::int64_t id, std::int64_t col,
+            std::size_t& num_bound_args) const
+        {
+            if (tail_calls_.find(std::make_pair(id, col)) != tail_calls_.end())
+            {
+                num_bound_args = num_bound_args_;
+                return true;
+            }
+
+            if (outer_ != nullptr)
+            {
+                return outer_->is_tail_call(id, col, num_bound_args);
+            }
+
+            return false;
+        }
+
     private:
         environment* outer_;
         map_type definitions_;
         std::size_t base_arg_num_;
+
+        tail_calls_type tail_calls_;
+        std::size_t num_bound_args_ = 0;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -26,6 +26,7 @@
 #include <phylanx/execution_tree/primitives/lambda.hpp>
 #include <phylanx/execution_tree/primitives/store_operation.hpp>
 #include <phylanx/execution_tree/primitives/string_output.hpp>
+#include <phylanx/execution_tree/primitives/tail_call.hpp>
 #include <phylanx/execution_tree/primitives/target_reference.hpp>
 #include <phylanx/execution_tree/primitives/timer.hpp>
 #include <phylanx/execution_tree/primitives/variable.hpp>
@@ -14,6 +14,7 @@
 #include <phylanx/execution_tree/primitives/primitive_argument_type.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/ir/ranges.hpp>
+#include <phylanx/util/future_or_value.hpp>
 #include <phylanx/util/generate_error_message.hpp>
 
 #include <hpx/include/runtime.hpp>
@@ -849,6 +850,33 @@ namespace phylanx { namespace execution_tree
         };
     }    // namespace functional
 
+    // Same as value_operand, except that ready results are returned as
+    // plain values, which avoids allocating a shared state for those.
+    PHYLANX_EXPORT util::future_or_value<primitive_argument_type>
+    value_operand_future_or_value(primitive_argument_type const& val,
+        primitive_arguments_type const& args, std::string const& name = "",
+        std::string const& codename = "<unknown>",
+        eval_context ctx = eval_context{});
+    PHYLANX_EXPORT util::future_or_value<primitive_argument_type>
+    value_operand_future_or_value(primitive_argument_type&& val,
+        primitive_arguments_type const& args, std::string const& name = "",
+        std::string const& codename = "<unknown>",
+        eval_context ctx = eval_context{});
+
+    namespace functional {
+
+        struct value_operand_future_or_value
+        {
+            template <typename... Ts>
+            util::future_or_value<primitive_argument_type> operator()(
+                Ts&&... ts) const
+            {
+                return execution_tree::value_operand_future_or_value(
+                    std::forward<Ts>(ts)...);
+            }
+        };
+    }    // namespace functional
+
     // was declared above
     //     PHYLANX_EXPORT primitive_argument_type value_operand_sync(
     //         primitive_argument_type const& val,
@@ -893,6 +921,33 @@ namespace phylanx { namespace execution_tree
         };
     }    // namespace functional
 
+    // Same as literal_operand, except that ready results are returned as
+    // plain values.
+    PHYLANX_EXPORT util::future_or_value<primitive_argument_type>
+    literal_operand_future_or_value(primitive_argument_type const& val,
+        primitive_arguments_type const& args, std::string const& name = "",
+        std::string const& codename = "<unknown>",
+        eval_context ctx = eval_context{});
+    PHYLANX_EXPORT util::future_or_value<primitive_argument_type>
+    literal_operand_future_or_value(primitive_argument_type&& val,
+        primitive_arguments_type const& args, std::string const& name = "",
+        std::string const& codename = "<unknown>",
+        eval_context ctx = eval_context{});
+
+    namespace functional {
+
+        struct literal_operand_future_or_value
+        {
+            template <typename... Ts>
+            util::future_or_value<primitive_argument_type> operator()(
+                Ts&&... ts) const
+            {
+                return execution_tree::literal_operand_future_or_value(
+                    std::forward<Ts>(ts)...);
+            }
+        };
+    }    // namespace functional
+
     PHYLANX_EXPORT primitive_argument_type literal_operand_sync(
         primitive_argument_type const& val,
         primitive_arguments_type const& args,
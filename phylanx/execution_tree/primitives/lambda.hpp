@@ -12,7 +12,13 @@
 
 #include <hpx/futures/future.hpp>
 
+#include <hpx/synchronization/spinlock.hpp>
+
 #include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -21,6 +27,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
 {
     class lambda
       : public primitive_component_base
+      , public std::enable_shared_from_this<lambda>
     {
     public:
         static match_pattern_type const match_data;
@@ -40,6 +47,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         void store(primitive_arguments_type&& data,
             primitive_arguments_type&& params, eval_context ctx) override;
+
+    private:
+        // evaluate the body, self-recursive calls in tail position re-run
+        // the body with the new arguments instead of nesting invocations
+        hpx::future<primitive_argument_type> eval_body(
+            primitive_arguments_type&& args, eval_context ctx) const;
+
+        hpx::future<primitive_argument_type> eval_memoized(
+            primitive_arguments_type&& args, eval_context ctx) const;
+
+        // maximal number of results memoized per function
+        static std::size_t get_memo_cache_size();
+
+        using mutex_type = hpx::lcos::local::spinlock;
+        using memo_key_type = std::vector<std::int64_t>;
+        using memo_list_type =
+            std::list<std::pair<memo_key_type, primitive_argument_type>>;
+
+        bool has_tail_calls_ = false;
+        bool memoize_ = false;
+
+        // the memoized results, most recently used first
+        mutable mutex_type mtx_;
+        mutable memo_list_type memo_;
+        mutable std::map<memo_key_type, memo_list_type::iterator> memo_index_;
     };
 }}}
 
@@ -12,6 +12,7 @@
 #include <phylanx/ir/dictionary.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/ir/ranges.hpp>
+#include <phylanx/util/future_or_value.hpp>
 #include <phylanx/util/hashed_string.hpp>
 #include <phylanx/util/variant.hpp>
 
@@ -122,6 +123,14 @@ namespace phylanx { namespace execution_tree
             util::hashed_string const& name, primitive_argument_type&& var,
             bool define_globally = false);
 
+        // a self-recursive call in tail position leaves its arguments in the
+        // frame of the function invocation instead of recursing, the
+        // function will re-run its body with those arguments
+        inline void set_tail_call(
+            std::vector<primitive_argument_type>&& args) noexcept;
+        inline bool extract_tail_call(
+            std::vector<primitive_argument_type>& args) noexcept;
+
         PHYLANX_EXPORT std::vector<std::string> back_trace() const;
 
     private:
@@ -137,6 +146,10 @@ namespace phylanx { namespace execution_tree
         language lang_;
         std::string name_;
         std::string codename_;
+
+        // pending tail call, not serialized
+        std::vector<primitive_argument_type> tail_call_args_;
+        bool has_tail_call_ = false;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -205,6 +218,12 @@ namespace phylanx { namespace execution_tree
         inline primitive_argument_type& set_var(util::hashed_string const& name,
             primitive_argument_type&& var, bool define_globally = false);
 
+        void set_tail_call(std::vector<primitive_argument_type>&& args)
+        {
+            HPX_ASSERT(bool(variables_));
+            variables_->set_tail_call(std::move(args));
+        }
+
         eval_context& add_frame(
             std::string const& name, std::string const& codename)
         {
@@ -333,6 +352,14 @@ namespace phylanx { namespace execution_tree
             primitive_arguments_type const& args,
             eval_context ctx = eval_context{}) const;
 
+        // Evaluates local primitives in place if their execution policy
+        // selects synchronous execution, in which case ready results are
+        // returned without allocating a shared state. Falls back to eval
+        // otherwise.
+        PHYLANX_EXPORT util::future_or_value<primitive_argument_type>
+        eval_future_or_value(primitive_arguments_type const& args,
+            eval_context ctx = eval_context{}) const;
+
         PHYLANX_EXPORT hpx::future<void> store(primitive_argument_type&&,
             primitive_arguments_type&&, eval_context ctx = eval_context{});
         PHYLANX_EXPORT hpx::future<void> store(primitive_arguments_type&&,
@@ -1067,6 +1094,27 @@ namespace phylanx { namespace execution_tree
         return it->second;
     }
 
+    void variable_frame::set_tail_call(
+        std::vector<primitive_argument_type>&& args) noexcept
+    {
+        tail_call_args_ = std::move(args);
+        has_tail_call_ = true;
+    }
+
+    bool variable_frame::extract_tail_call(
+        std::vector<primitive_argument_type>& args) noexcept
+    {
+        if (!has_tail_call_)
+        {
+            return false;
+        }
+
+        args = std::move(tail_call_args_);
+        tail_call_args_.clear();
+        has_tail_call_ = false;
+        return true;
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     template <typename T>
     primitive_argument_type as_primitive_argument_type(T&& t)
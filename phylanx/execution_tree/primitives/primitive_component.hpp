@@ -67,6 +67,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         PHYLANX_EXPORT hpx::future<primitive_argument_type> eval_single(
             primitive_argument_type && param, eval_context ctx) const;
 
+        // local evaluation, ready results are returned as plain values
+        PHYLANX_EXPORT util::future_or_value<primitive_argument_type>
+        eval_future_or_value(primitive_arguments_type const& params,
+            eval_context ctx) const;
+
         // store_action
         PHYLANX_EXPORT void store(primitive_arguments_type&&,
             primitive_arguments_type&&, eval_context ctx);
@@ -101,12 +106,25 @@ namespace phylanx { namespace execution_tree { namespace primitives
         PHYLANX_EXPORT std::int64_t get_eval_count(bool reset) const;
         PHYLANX_EXPORT std::int64_t get_eval_duration(bool reset) const;
         PHYLANX_EXPORT std::int64_t get_direct_execution(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_sync_eval_count(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_async_eval_count(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_eval_estimate(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_allocated_bytes(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_live_bytes(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_peak_bytes(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_cycles(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_instructions(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_llc_misses(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_branch_misses(bool reset) const;
 
         PHYLANX_EXPORT std::int64_t get_transferred_bytes(bool reset) const;
 
         PHYLANX_EXPORT void enable_measurements();
 
         // decide whether to execute eval directly
+        PHYLANX_EXPORT hpx::launch select_eval_execution(
+            hpx::launch policy) const;
+
         PHYLANX_EXPORT static hpx::launch select_direct_execution(
             eval_action, hpx::launch policy, hpx::naming::address_type lva);
         PHYLANX_EXPORT static hpx::launch select_direct_execution(
@@ -9,6 +9,11 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/util/adaptive_execution_policy.hpp>
+#include <phylanx/util/future_or_value.hpp>
+#include <phylanx/util/hardware_counters.hpp>
+#include <phylanx/util/memory_accounting.hpp>
+#include <phylanx/util/primitive_trace.hpp>
 
 #include <hpx/allocator_support/internal_allocator.hpp>
 #include <hpx/include/lcos.hpp>
@@ -16,6 +21,7 @@
 #include <hpx/async_base/launch_policy.hpp>
 #include <hpx/modules/naming.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
@@ -64,6 +70,18 @@ namespace phylanx { namespace execution_tree
                 primitive_arguments_type const& operands,
                 primitive_arguments_type const& args, eval_context ctx) const;
 
+            // Same as eval, except that ready results may be returned as
+            // plain values. The default implementations forward to eval,
+            // primitives that are able to produce their results in place
+            // should override the variant taking the operands.
+            virtual util::future_or_value<primitive_argument_type>
+            eval_future_or_value(
+                primitive_arguments_type const& params, eval_context ctx) const;
+
+            virtual util::future_or_value<primitive_argument_type>
+            eval_future_or_value(primitive_arguments_type const& operands,
+                primitive_arguments_type const& args, eval_context ctx) const;
+
             // store_action
             virtual void store(primitive_arguments_type&&,
                 primitive_arguments_type&&, eval_context ctx);
@@ -94,10 +112,24 @@ namespace phylanx { namespace execution_tree
             hpx::future<primitive_argument_type> do_eval(
                 primitive_argument_type && param, eval_context ctx) const;
 
+            util::future_or_value<primitive_argument_type>
+            do_eval_future_or_value(primitive_arguments_type const& params,
+                eval_context ctx) const;
+
             // access data for performance counter
             std::int64_t get_eval_count(bool reset) const;
             std::int64_t get_eval_duration(bool reset) const;
             std::int64_t get_direct_execution(bool reset) const;
+            std::int64_t get_sync_eval_count(bool reset) const;
+            std::int64_t get_async_eval_count(bool reset) const;
+            std::int64_t get_eval_estimate(bool reset) const;
+            std::int64_t get_allocated_bytes(bool reset) const;
+            std::int64_t get_live_bytes(bool reset) const;
+            std::int64_t get_peak_bytes(bool reset) const;
+            std::int64_t get_cycles(bool reset) const;
+            std::int64_t get_instructions(bool reset) const;
+            std::int64_t get_llc_misses(bool reset) const;
+            std::int64_t get_branch_misses(bool reset) const;
 
             virtual std::int64_t get_transferred_bytes(bool reset) const;
 
@@ -106,6 +138,9 @@ namespace phylanx { namespace execution_tree
             // decide whether to execute eval directly
             hpx::launch select_direct_eval_execution(hpx::launch policy) const;
 
+            // decide whether the next evaluation should be timed
+            bool measure_eval() const;
+
             // A primitive was constructed with no operands if the list of
             // operands is empty or the only provided operand is 'nil' (used
             // for function invocations like 'func()').
@@ -133,6 +168,18 @@ namespace phylanx { namespace execution_tree
             static std::int64_t get_exec_upper_threshold();
             static std::int64_t get_exec_lower_threshold();
 
+        private:
+            hpx::launch select_eval_execution(hpx::launch policy) const;
+
+            // invoke the given evaluation while measuring, tracing, and
+            // accounting for it as requested
+            template <typename F>
+            util::future_or_value<primitive_argument_type> instrumented_eval(
+                F&& eval) const;
+
+            // start recording an evaluation, if tracing is enabled
+            util::trace_scope trace_eval() const;
+
         protected:
             static primitive_arguments_type noargs;
             mutable primitive_arguments_type operands_;
@@ -145,6 +192,21 @@ namespace phylanx { namespace execution_tree
             mutable std::int64_t eval_duration_;
             mutable std::int64_t execute_directly_;
             bool measurements_enabled_;
+            bool eval_direct_;
+
+            // decisions of the execution policy
+            mutable std::atomic<std::int64_t> sync_eval_count_;
+            mutable std::atomic<std::int64_t> async_eval_count_;
+            mutable util::adaptive_execution_policy adaptive_policy_;
+
+            // identifier of this primitive in the trace events
+            mutable std::atomic<std::int64_t> trace_name_;
+
+            // memory held by the results of this primitive
+            mutable util::memory_accounting memory_;
+
+            // hardware counters accumulated during the evaluations
+            mutable util::hardware_counter_data hardware_counters_;
 
 #if defined(HPX_HAVE_APEX)
             std::string eval_name_;
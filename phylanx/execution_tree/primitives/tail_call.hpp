@@ -0,0 +1,46 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_TAIL_CALL_JUN_14_2021_0215PM)
+#define PHYLANX_PRIMITIVES_TAIL_CALL_JUN_14_2021_0215PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    // A call of a function to itself in tail position. Instead of invoking
+    // the function recursively, the evaluated arguments are stored in the
+    // variable frame of the current invocation. The enclosing lambda picks
+    // them up and re-runs the function body in a loop.
+    class tail_call
+      : public primitive_component_base
+    {
+    public:
+        static match_pattern_type const match_data;
+
+        tail_call() = default;
+
+        tail_call(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& params,
+            eval_context ctx) const override;
+
+    private:
+        // number of leading arguments bound by the enclosing functions
+        std::size_t num_bound_args_ = 0;
+    };
+}}}
+
+#endif
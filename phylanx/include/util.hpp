@@ -8,9 +8,13 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/util/distributed_object.hpp>
+#include <phylanx/util/hardware_counters.hpp>
 #include <phylanx/util/hashed_string.hpp>
+#include <phylanx/util/memory_accounting.hpp>
 #include <phylanx/util/none_manip.hpp>
+#include <phylanx/util/performance_analysis.hpp>
 #include <phylanx/util/performance_data.hpp>
+#include <phylanx/util/primitive_trace.hpp>
 #include <phylanx/util/random.hpp>
 #include <phylanx/util/repr_manip.hpp>
 #include <phylanx/util/serialization/ast.hpp>
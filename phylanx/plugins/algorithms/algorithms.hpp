@@ -7,8 +7,13 @@
 #define PHYLANX_PLUGINS_ALGORITHMS_MAY_02_2108_1251PM
 
 #include <phylanx/plugins/algorithms/als.hpp>
+#include <phylanx/plugins/algorithms/dist_als.hpp>
+#include <phylanx/plugins/algorithms/dist_kmeans.hpp>
+#include <phylanx/plugins/algorithms/dist_lda_trainer.hpp>
+#include <phylanx/plugins/algorithms/dist_lra_sgd.hpp>
 #include <phylanx/plugins/algorithms/kmeans.hpp>
 #include <phylanx/plugins/algorithms/lra.hpp>
+#include <phylanx/plugins/algorithms/lra_sgd.hpp>
 #include <phylanx/plugins/algorithms/lda.hpp>
 
 #endif
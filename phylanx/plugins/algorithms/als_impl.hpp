@@ -0,0 +1,130 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_ALS_IMPL_JUL_14_2021_0315PM)
+#define PHYLANX_ALS_IMPL_JUL_14_2021_0315PM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include <blaze/Math.h>
+
+// Building blocks for implicit-feedback ALS (http://yifanhu.net/PUB/cf.pdf)
+// shared by the local and the distributed ALS primitives. The confidence
+// values are held in a sparse matrix, and the normal equations of each row
+// are formed using the identity
+//
+//      Y^T C_u Y = Y^T Y + Y^T (C_u - I) Y
+//
+// where (C_u - I) is non-zero only for the items rated by user u.
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    using als_matrix_type = blaze::DynamicMatrix<double>;
+    using als_vector_type = blaze::DynamicVector<double>;
+    using als_sparse_matrix_type = blaze::CompressedMatrix<double>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Store only the non-zero entries of 'alpha * ratings'
+    template <typename Matrix>
+    als_sparse_matrix_type als_confidence(Matrix const& ratings, double alpha)
+    {
+        als_sparse_matrix_type conf(ratings.rows(), ratings.columns());
+        conf.reserve(blaze::nonZeros(ratings));
+
+        for (std::size_t u = 0; u != ratings.rows(); ++u)
+        {
+            for (std::size_t i = 0; i != ratings.columns(); ++i)
+            {
+                if (ratings(u, i) != 0.0)
+                {
+                    conf.append(u, i, alpha * ratings(u, i));
+                }
+            }
+            conf.finalize(u);
+        }
+        return conf;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Initialize the user and the item factors from normally distributed
+    // random numbers, the users are initialized first
+    inline void als_initialize_factors(als_matrix_type& X, als_matrix_type& Y)
+    {
+        std::mt19937 rng{0};
+        std::normal_distribution<double> dist;
+
+        for (std::size_t row = 0; row != blaze::rows(X); ++row)
+        {
+            for (auto& val : blaze::row(X, row))
+            {
+                val = dist(rng);
+            }
+        }
+
+        for (std::size_t row = 0; row != blaze::rows(Y); ++row)
+        {
+            for (auto& val : blaze::row(Y, row))
+            {
+                val = dist(rng);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Y^T Y + reg * I
+    inline als_matrix_type als_gramian(als_matrix_type const& Y, double reg)
+    {
+        als_matrix_type YtY = blaze::trans(Y) * Y;
+        blaze::band(YtY, 0) += reg;
+        return YtY;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Solve the normal equations for all rows of 'conf' in parallel:
+    //
+    //      X(u) = (YtY + Y^T (C_u - I) Y)^-1 * Y^T C_u p(u)
+    //
+    // where 'conf' holds C - I and 'YtY' has the regularization applied
+    // already. Only the rows of Y referenced by row u of 'conf' are touched.
+    // Rows of 'conf' without any entries yield a zero row in X.
+    inline void als_update_factors(als_sparse_matrix_type const& conf,
+        als_matrix_type const& Y, als_matrix_type const& YtY,
+        als_matrix_type& X)
+    {
+        std::size_t const num_factors = Y.columns();
+
+        hpx::for_loop(hpx::execution::par, std::size_t(0), conf.rows(),
+            [&](std::size_t u) {
+                auto row_x = blaze::row(X, u);
+                if (conf.begin(u) == conf.end(u))
+                {
+                    row_x = 0.0;
+                    return;
+                }
+
+                als_matrix_type A(YtY);
+                als_vector_type b(num_factors, 0.0);
+
+                for (auto it = conf.begin(u); it != conf.end(u); ++it)
+                {
+                    auto y = blaze::row(Y, it->index());
+                    A += it->value() * (blaze::trans(y) * y);
+                    b += (it->value() + 1.0) * blaze::trans(y);
+                }
+
+                // A is symmetric positive definite
+                blaze::posv(A, b, 'U');
+                row_x = blaze::trans(b);
+            });
+    }
+}}}}
+
+#endif
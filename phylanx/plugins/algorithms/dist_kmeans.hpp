@@ -0,0 +1,60 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_KMEANS_JUL_15_2021_1130AM)
+#define PHYLANX_DIST_KMEANS_JUL_15_2021_1130AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    class dist_kmeans
+      : public primitive_component_base
+      , public std::enable_shared_from_this<dist_kmeans>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static match_pattern_type const match_data;
+
+        dist_kmeans() = default;
+
+        ///
+        /// Creates a primitive executing the kmeans algorithm on points
+        /// distributed over all localities, each locality holding a
+        /// contiguous block of points (rows)
+        ///
+        dist_kmeans(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    protected:
+        primitive_argument_type calculate_kmeans(
+            primitive_arguments_type&& args) const;
+    };
+
+    inline primitive create_dist_kmeans(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "kmeans_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
@@ -0,0 +1,60 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_LDA_TRAINER_AUG_02_2021_0215PM)
+#define PHYLANX_DIST_LDA_TRAINER_AUG_02_2021_0215PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    class dist_lda_trainer
+      : public primitive_component_base
+      , public std::enable_shared_from_this<dist_lda_trainer>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static match_pattern_type const match_data;
+
+        dist_lda_trainer() = default;
+
+        ///
+        /// Creates a primitive executing the LDA trainer on documents
+        /// distributed over all localities, each locality holding a
+        /// contiguous block of documents (rows)
+        ///
+        dist_lda_trainer(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    protected:
+        primitive_argument_type calculate_lda_trainer(
+            primitive_arguments_type&& args) const;
+    };
+
+    inline primitive create_dist_lda_trainer(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "lda_trainer_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
@@ -0,0 +1,422 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_KMEANS_IMPL_JUL_15_2021_1045AM)
+#define PHYLANX_KMEANS_IMPL_JUL_15_2021_1045AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/random.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <blaze/Math.h>
+
+// Building blocks for the k-means primitives operating on points of any
+// dimensionality. The points are processed in fixed size blocks in parallel.
+// The distances between a block of points and the centroids are calculated
+// using a matrix product:
+//
+//      |x - c|^2 = |x|^2 - 2 x^T c + |c|^2
+//
+// Hamerly's triangle inequality bounds are maintained for every point such
+// that only points which may have changed their cluster are reconsidered.
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    using kmeans_matrix_type = blaze::DynamicMatrix<double>;
+    using kmeans_vector_type = blaze::DynamicVector<double>;
+
+    // number of points handled as one block, this is independent of the
+    // number of cores to make the results reproducible
+    constexpr std::size_t kmeans_block_size = 1024;
+
+    inline std::size_t kmeans_num_blocks(std::size_t num_points)
+    {
+        return (num_points + kmeans_block_size - 1) / kmeans_block_size;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // squared distances of the given points (rows) to all centroids
+    template <typename Points>
+    kmeans_matrix_type kmeans_squared_distances(Points const& points,
+        kmeans_matrix_type const& centroids,
+        kmeans_vector_type const& centroid_norms)
+    {
+        kmeans_matrix_type dist =
+            -2.0 * (points * blaze::trans(centroids));
+        for (std::size_t i = 0; i != dist.rows(); ++i)
+        {
+            double const norm = blaze::sqrNorm(blaze::row(points, i));
+            auto row = blaze::row(dist, i);
+            row += blaze::trans(centroid_norms);
+            row += norm;
+        }
+        return dist;
+    }
+
+    inline kmeans_vector_type kmeans_centroid_norms(
+        kmeans_matrix_type const& centroids)
+    {
+        kmeans_vector_type norms(centroids.rows());
+        for (std::size_t j = 0; j != centroids.rows(); ++j)
+        {
+            norms[j] = blaze::sqrNorm(blaze::row(centroids, j));
+        }
+        return norms;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Choose num_centroids distinct random points as the initial centroids,
+    // 'pick' is invoked with the index of every chosen point
+    template <typename F>
+    void kmeans_random_indices(
+        std::size_t num_points, std::size_t num_centroids, F&& pick)
+    {
+        std::uniform_int_distribution<std::int64_t> distribution(
+            0, num_points - 1);
+        std::vector<std::int64_t> indices;
+
+        for (std::size_t i = 0; i != num_centroids; ++i)
+        {
+            std::int64_t rand_index = distribution(util::rng_);
+
+            // rand indices should be unique
+            while (std::find(indices.begin(), indices.end(), rand_index) !=
+                indices.end())
+            {
+                rand_index = distribution(util::rng_);
+            }
+            indices.push_back(rand_index);
+
+            pick(i, rand_index);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Update the squared distance of each point to its closest centroid
+    // after 'centroid' was added to the set of chosen centroids, returns
+    // the sum of all squared distances
+    template <typename Centroid>
+    double kmeans_plusplus_update(kmeans_matrix_type const& points,
+        Centroid const& centroid, kmeans_vector_type& min_dist)
+    {
+        std::size_t const num_blocks = kmeans_num_blocks(points.rows());
+        std::vector<double> partial(num_blocks, 0.0);
+
+        hpx::for_loop(hpx::execution::par, std::size_t(0), num_blocks,
+            [&](std::size_t b) {
+                std::size_t const first = b * kmeans_block_size;
+                std::size_t const last =
+                    (std::min)(first + kmeans_block_size, points.rows());
+                double sum = 0.0;
+                for (std::size_t i = first; i != last; ++i)
+                {
+                    min_dist[i] = (std::min)(min_dist[i],
+                        blaze::sqrNorm(blaze::row(points, i) - centroid));
+                    sum += min_dist[i];
+                }
+                partial[b] = sum;
+            });
+
+        double total = 0.0;
+        for (double p : partial)
+        {
+            total += p;
+        }
+        return total;
+    }
+
+    // Select the point for which the running sum of squared distances
+    // exceeds 'target'
+    inline std::size_t kmeans_plusplus_select(
+        kmeans_vector_type const& min_dist, double target)
+    {
+        double sum = 0.0;
+        for (std::size_t i = 0; i != min_dist.size(); ++i)
+        {
+            sum += min_dist[i];
+            if (sum > target)
+            {
+                return i;
+            }
+        }
+        return min_dist.size() - 1;
+    }
+
+    // k-means++ seeding (Arthur and Vassilvitskii, 2007)
+    inline kmeans_matrix_type kmeans_plusplus_centroids(
+        kmeans_matrix_type const& points, std::size_t num_centroids)
+    {
+        kmeans_matrix_type centroids(num_centroids, points.columns());
+
+        std::uniform_int_distribution<std::size_t> first_dist(
+            0, points.rows() - 1);
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+        kmeans_vector_type min_dist(
+            points.rows(), (std::numeric_limits<double>::max)());
+
+        blaze::row(centroids, 0) =
+            blaze::row(points, first_dist(util::rng_));
+        for (std::size_t j = 1; j != num_centroids; ++j)
+        {
+            double const total = kmeans_plusplus_update(
+                points, blaze::row(centroids, j - 1), min_dist);
+            blaze::row(centroids, j) = blaze::row(points,
+                kmeans_plusplus_select(min_dist, dist(util::rng_) * total));
+        }
+        return centroids;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Assignment of points to centroids, maintains the distance bounds
+    // between iterations
+    class kmeans_assignment
+    {
+    public:
+        explicit kmeans_assignment(std::size_t num_points)
+          : closest_(num_points, 0)
+          , upper_(num_points, 0.0)
+          , lower_(num_points, 0.0)
+        {
+        }
+
+        std::vector<std::size_t> const& closest() const
+        {
+            return closest_;
+        }
+
+        // assign all points to their closest centroid
+        void assign(kmeans_matrix_type const& points,
+            kmeans_matrix_type const& centroids)
+        {
+            kmeans_vector_type const norms = kmeans_centroid_norms(centroids);
+
+            if (previous_.rows() != centroids.rows())
+            {
+                // no bounds are known yet
+                std::size_t const num_blocks =
+                    kmeans_num_blocks(points.rows());
+                hpx::for_loop(hpx::execution::par, std::size_t(0), num_blocks,
+                    [&](std::size_t b) {
+                        std::size_t const first = b * kmeans_block_size;
+                        std::size_t const last = (std::min)(
+                            first + kmeans_block_size, points.rows());
+                        assign_block(blaze::submatrix(points, first, 0,
+                                         last - first, points.columns()),
+                            centroids, norms, first);
+                    });
+            }
+            else
+            {
+                update(points, centroids, norms);
+            }
+
+            previous_ = centroids;
+        }
+
+        // calculate the sum of the points assigned to each of the centroids
+        // (first columns) and their number (last column)
+        kmeans_matrix_type sums(kmeans_matrix_type const& points,
+            std::size_t num_centroids) const
+        {
+            std::size_t const num_blocks = kmeans_num_blocks(points.rows());
+            std::vector<kmeans_matrix_type> partial(num_blocks);
+
+            hpx::for_loop(hpx::execution::par, std::size_t(0), num_blocks,
+                [&](std::size_t b) {
+                    std::size_t const first = b * kmeans_block_size;
+                    std::size_t const last = (std::min)(
+                        first + kmeans_block_size, points.rows());
+
+                    kmeans_matrix_type& s = partial[b];
+                    s.resize(num_centroids, points.columns() + 1, false);
+                    s = 0.0;
+                    for (std::size_t i = first; i != last; ++i)
+                    {
+                        auto row = blaze::row(s, closest_[i]);
+                        blaze::subvector(row, 0, points.columns()) +=
+                            blaze::row(points, i);
+                        row[points.columns()] += 1.0;
+                    }
+                });
+
+            kmeans_matrix_type result(
+                num_centroids, points.columns() + 1, 0.0);
+            for (auto const& s : partial)
+            {
+                result += s;
+            }
+            return result;
+        }
+
+    private:
+        template <typename Points>
+        void assign_block(Points const& points,
+            kmeans_matrix_type const& centroids,
+            kmeans_vector_type const& norms, std::size_t offset)
+        {
+            kmeans_matrix_type const dist =
+                kmeans_squared_distances(points, centroids, norms);
+
+            for (std::size_t i = 0; i != dist.rows(); ++i)
+            {
+                assign_point(blaze::row(dist, i), offset + i);
+            }
+        }
+
+        template <typename Row>
+        void assign_point(Row const& dist, std::size_t i)
+        {
+            double best = (std::numeric_limits<double>::max)();
+            double second = (std::numeric_limits<double>::max)();
+            std::size_t best_idx = 0;
+            for (std::size_t j = 0; j != dist.size(); ++j)
+            {
+                if (dist[j] < best)
+                {
+                    second = best;
+                    best = dist[j];
+                    best_idx = j;
+                }
+                else if (dist[j] < second)
+                {
+                    second = dist[j];
+                }
+            }
+
+            closest_[i] = best_idx;
+            upper_[i] = std::sqrt((std::max)(best, 0.0));
+            lower_[i] = std::sqrt((std::max)(second, 0.0));
+        }
+
+        void update(kmeans_matrix_type const& points,
+            kmeans_matrix_type const& centroids,
+            kmeans_vector_type const& norms)
+        {
+            std::size_t const num_centroids = centroids.rows();
+
+            // half the distance of each centroid to its closest neighbor
+            kmeans_vector_type half_dist(
+                num_centroids, (std::numeric_limits<double>::max)());
+            if (num_centroids > 1)
+            {
+                kmeans_matrix_type const cdist =
+                    kmeans_squared_distances(centroids, centroids, norms);
+                for (std::size_t j = 0; j != num_centroids; ++j)
+                {
+                    for (std::size_t l = 0; l != num_centroids; ++l)
+                    {
+                        if (l != j)
+                        {
+                            half_dist[j] = (std::min)(half_dist[j],
+                                0.5 * std::sqrt((std::max)(cdist(j, l), 0.0)));
+                        }
+                    }
+                }
+            }
+
+            // the distance each of the centroids has moved since the bounds
+            // were calculated
+            kmeans_vector_type moved(num_centroids);
+            for (std::size_t j = 0; j != num_centroids; ++j)
+            {
+                moved[j] = blaze::norm(
+                    blaze::row(centroids, j) - blaze::row(previous_, j));
+            }
+            double const max_moved = blaze::max(moved);
+
+            std::size_t const num_blocks = kmeans_num_blocks(points.rows());
+            hpx::for_loop(hpx::execution::par, std::size_t(0), num_blocks,
+                [&](std::size_t b) {
+                    std::size_t const first = b * kmeans_block_size;
+                    std::size_t const last = (std::min)(
+                        first + kmeans_block_size, points.rows());
+
+                    // collect the points which may have changed their cluster
+                    std::vector<std::size_t> candidates;
+                    for (std::size_t i = first; i != last; ++i)
+                    {
+                        std::size_t const a = closest_[i];
+                        upper_[i] += moved[a];
+                        lower_[i] -= max_moved;
+
+                        double const bound =
+                            (std::max)(half_dist[a], lower_[i]);
+                        if (upper_[i] <= bound)
+                        {
+                            continue;
+                        }
+
+                        // tighten the upper bound
+                        upper_[i] = blaze::norm(
+                            blaze::row(points, i) - blaze::row(centroids, a));
+                        if (upper_[i] > bound)
+                        {
+                            candidates.push_back(i);
+                        }
+                    }
+
+                    if (candidates.empty())
+                    {
+                        return;
+                    }
+
+                    kmeans_matrix_type block(
+                        candidates.size(), points.columns());
+                    for (std::size_t c = 0; c != candidates.size(); ++c)
+                    {
+                        blaze::row(block, c) =
+                            blaze::row(points, candidates[c]);
+                    }
+
+                    kmeans_matrix_type const dist =
+                        kmeans_squared_distances(block, centroids, norms);
+                    for (std::size_t c = 0; c != candidates.size(); ++c)
+                    {
+                        assign_point(blaze::row(dist, c), candidates[c]);
+                    }
+                });
+        }
+
+        std::vector<std::size_t> closest_;
+        std::vector<double> upper_;
+        std::vector<double> lower_;
+        kmeans_matrix_type previous_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Calculate the new centroids from the sums generated by
+    // kmeans_assignment::sums, centroids without any points are kept at the
+    // origin
+    inline kmeans_matrix_type kmeans_new_centroids(
+        kmeans_matrix_type const& sums)
+    {
+        std::size_t const num_features = sums.columns() - 1;
+
+        kmeans_matrix_type centroids(sums.rows(), num_features, 0.0);
+        for (std::size_t k = 0; k != sums.rows(); ++k)
+        {
+            double const count = sums(k, num_features);
+            if (count != 0)
+            {
+                blaze::row(centroids, k) =
+                    blaze::subvector(blaze::row(sums, k), 0, num_features) /
+                    count;
+            }
+        }
+        return centroids;
+    }
+}}}}
+
+#endif
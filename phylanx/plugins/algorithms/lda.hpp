@@ -17,7 +17,7 @@
 #include <utility>
 #include <vector>
 
-#include "lda_trainer.hpp"
+#include <phylanx/plugins/algorithms/lda_trainer.hpp>
 
 namespace phylanx { namespace execution_tree { namespace primitives
 {
@@ -28,7 +28,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     protected:
         hpx::future<primitive_argument_type> eval(
             primitive_arguments_type const& operands,
-            primitive_arguments_type const& args) const;
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
 
     public:
         static match_pattern_type const match_data;
@@ -36,7 +37,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         lda_trainer() = default;
 
         ///
-        /// Creates a primitive executing the ALS algorithm on the given
+        /// Creates a primitive executing the LDA trainer on the given
         /// input data
         ///
         /// \param args Is a (possibly empty) list of any values to be
@@ -45,9 +46,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         lda_trainer(primitive_arguments_type&& operands,
             std::string const& name, std::string const& codename);
 
-//        hpx::future<primitive_argument_type> eval(
-//            primitive_arguments_type const& params) const override;
-
     protected:
         primitive_argument_type calculate_lda_trainer(
             primitive_arguments_type&& args) const;
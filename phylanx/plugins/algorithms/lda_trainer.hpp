@@ -8,59 +8,119 @@
 #define __PHYLANX_LDA_TRAINER_IMPL_HPP__
 
 #include <phylanx/config.hpp>
-#include <phylanx/execution_tree/annotation.hpp>
-#include <phylanx/execution_tree/localities_annotation.hpp>
-#include <phylanx/execution_tree/locality_annotation.hpp>
-#include <phylanx/execution_tree/meta_annotation.hpp>
-#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
-#include <phylanx/ir/node_data.hpp>
-#include <phylanx/plugins/common/dot_operation_nd.hpp>
-#include <phylanx/plugins/dist_matrixops/dist_cannon_product.hpp>
-#include <phylanx/util/distributed_matrix.hpp>
-
-#include <hpx/assert.hpp>
-#include <hpx/errors/throw_exception.hpp>
-#include <hpx/include/lcos.hpp>
-#include <hpx/include/naming.hpp>
-#include <hpx/include/util.hpp>
 
+#include <cstddef>
 #include <cstdint>
-#include <cmath>
-#include <cstdlib>
+#include <random>
 #include <tuple>
-#include <numeric>
-#include <algorithm>
-#include <iostream>
+#include <unordered_map>
+#include <vector>
 
-#include <blaze/Blaze.h>
+#include <blaze/Math.h>
 
 /////////////////////////////////////////////////////////////////////
+// Collapsed Gibbs sampler for LDA.
+//
+// The documents are partitioned into chunks which are sampled
+// concurrently (AD-LDA, Newman et al., "Distributed Algorithms for
+// Topic Models", JMLR 2009). Every chunk sees the word-topic counts
+// of the beginning of the sweep plus its own changes, which are kept
+// as sparse thread-local deltas and merged at the end of the sweep.
+//
+// Each token is resampled using Metropolis-Hastings steps alternating
+// between a document proposal and a word proposal drawn from alias
+// tables (Yuan et al., "LightLDA: Big Topic Models on Modest Compute
+// Clusters", WWW 2015), which makes the per token cost independent of
+// the number of topics.
 namespace phylanx { namespace execution_tree { namespace primitives {
 
+/////////////////////////////////////////////////////////////////////
+// The tokens of a set of documents, ordered by document
+struct lda_corpus {
+
+    // build the corpus from a (dense) document-word count matrix,
+    // documents are rows, words are columns
+    static lda_corpus from_counts(
+        const blaze::DynamicMatrix<double> & word_doc_mat);
+
+    std::int64_t num_documents() const {
+        return static_cast<std::int64_t>(doc_offsets.size()) - 1;
+    }
+
+    std::int64_t num_words;
+    std::vector<std::int64_t> doc_offsets;  // first token of each doc
+    std::vector<std::int64_t> words;        // word of each token
+};
+
+/////////////////////////////////////////////////////////////////////
+class lda_gibbs_sampler {
+
+    public:
+
+    using dmatrix_t = blaze::DynamicMatrix<double>;
+    using dvector_t = blaze::DynamicVector<double, blaze::rowVector>;
+
+    lda_gibbs_sampler(lda_corpus && corpus,
+        const std::int64_t T,
+        const double alpha,
+        const double beta,
+        const std::uint32_t seed);
+
+    // assign random topics to all tokens, returns the word-topic counts
+    // of the local documents
+    dmatrix_t initialize();
+
+    // sample new topics for all tokens given the word-topic counts of
+    // all documents, returns the change of the word-topic counts
+    dmatrix_t sweep(const dmatrix_t & wp);
+
+    // document-topic counts of the local documents
+    const dmatrix_t & doc_topics() const { return dp; }
+
+    private:
+
+    // Walker's alias tables for the word proposal
+    struct alias_table {
+        std::vector<double> prob;
+        std::vector<std::int64_t> alias;
+    };
+
+    struct chunk_state;
+
+    void build_alias_tables(const dmatrix_t & wp, const dvector_t & ztot);
+
+    void sample_chunk(chunk_state & state, const dmatrix_t & wp,
+        const dvector_t & ztot, std::int64_t first_doc,
+        std::int64_t last_doc);
+
+    lda_corpus corpus;
+    std::int64_t T;
+    double alpha, beta;
+
+    std::mt19937 rng;
+    std::vector<std::int64_t> z;
+    dmatrix_t dp;
+
+    std::vector<alias_table> tables;
+    std::vector<bool> has_tokens;
+};
+
+/////////////////////////////////////////////////////////////////////
 class lda_trainer_impl {
 
     private:
 
     double alpha, beta;
+    std::uint32_t seed;
 
     public:
 
-    lda_trainer_impl(const double alpha_=0.1, const double beta_=0.01) :
-        alpha(alpha_), beta(beta_) {
+    lda_trainer_impl(const double alpha_=0.1, const double beta_=0.01,
+        const std::uint32_t seed_=std::random_device{}()) :
+        alpha(alpha_), beta(beta_), seed(seed_) {
     }
 
-    static void gibbs(
-        const blaze::DynamicMatrix<double> & word_doc_mat,
-        const double alpha,
-        const double beta,
-        blaze::DynamicVector<std::int64_t> & z,
-        blaze::DynamicMatrix<double> & wp0,
-        blaze::DynamicMatrix<double> & dp,
-        blaze::DynamicVector<double, blaze::rowVector> & ztot);
-
     using dmatrix_t = blaze::DynamicMatrix<double>;
-    using dvector_t = blaze::DynamicVector<double>;
-    using i64vector_t = blaze::DynamicVector<std::int64_t>;
 
     std::tuple<dmatrix_t, dmatrix_t> operator()(
         const dmatrix_t & word_doc_mat,
@@ -0,0 +1,313 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_LRA_SGD_IMPL_AUG_09_2021_1100AM)
+#define PHYLANX_LRA_SGD_IMPL_AUG_09_2021_1100AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/fileio/file_read_csv_impl.hpp>
+
+#include <hpx/include/async.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/futures/future.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+// Building blocks for the mini-batch logistic regression primitives. The
+// training data is consumed in batches of rows which either are taken from
+// a matrix in memory or are read from a CSV file while the previous batch is
+// being processed. The gradient of every batch is accumulated in parallel
+// over fixed size blocks of rows.
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    using lra_matrix_type = blaze::DynamicMatrix<double>;
+    using lra_vector_type = blaze::DynamicVector<double>;
+
+    // number of rows handled as one block, this is independent of the
+    // number of cores to make the results reproducible
+    constexpr std::size_t lra_block_size = 1024;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Returns the sum of the gradients of the logistic loss of the given rows
+    // with one additional element holding the number of rows. Summing these
+    // over several batches (or localities) and dividing by the last element
+    // gives the mean gradient.
+    inline lra_vector_type lra_gradient(lra_matrix_type const& x,
+        lra_vector_type const& y, lra_vector_type const& weights)
+    {
+        std::size_t const num_features = weights.size();
+        std::size_t const num_blocks =
+            (x.rows() + lra_block_size - 1) / lra_block_size;
+
+        std::vector<lra_vector_type> partial(num_blocks);
+        hpx::for_loop(hpx::execution::par, std::size_t(0), num_blocks,
+            [&](std::size_t b) {
+                std::size_t const first = b * lra_block_size;
+                std::size_t const size =
+                    (std::min)(lra_block_size, x.rows() - first);
+
+                auto xb = blaze::submatrix(x, first, 0, size, num_features);
+
+                // error = sigmoid(x * weights) - y
+                lra_vector_type error = xb * weights;
+                for (std::size_t i = 0; i != size; ++i)
+                {
+                    error[i] = 1.0 / (1.0 + std::exp(-error[i])) -
+                        y[first + i];
+                }
+                partial[b] = blaze::trans(xb) * error;
+            });
+
+        lra_vector_type result(num_features + 1, 0.0);
+        auto gradient = blaze::subvector(result, 0, num_features);
+        for (auto const& p : partial)
+        {
+            gradient += p;
+        }
+        result[num_features] = double(x.rows());
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Update rules for the weights given the mean gradient of a batch
+    class lra_optimizer
+    {
+    public:
+        lra_optimizer(std::string const& method, std::size_t num_features,
+            double alpha, double momentum)
+          : alpha_(alpha)
+          , momentum_(momentum)
+          , first_(num_features, 0.0)
+          , second_(num_features, 0.0)
+        {
+            if (method == "sgd")
+            {
+                method_ = sgd;
+            }
+            else if (method == "momentum")
+            {
+                method_ = momentum_sgd;
+            }
+            else if (method == "adam")
+            {
+                method_ = adam;
+            }
+            else
+            {
+                throw std::invalid_argument(
+                    "the optimizer has to be one of 'sgd', 'momentum', or "
+                    "'adam'");
+            }
+        }
+
+        template <typename Gradient>
+        void update(lra_vector_type& weights, Gradient const& gradient)
+        {
+            switch (method_)
+            {
+            case sgd:
+                weights -= alpha_ * gradient;
+                break;
+
+            case momentum_sgd:
+                first_ = momentum_ * first_ + gradient;
+                weights -= alpha_ * first_;
+                break;
+
+            case adam:
+                {
+                    constexpr double beta1 = 0.9;
+                    constexpr double beta2 = 0.999;
+                    constexpr double epsilon = 1e-8;
+
+                    ++step_;
+                    first_ = beta1 * first_ + (1.0 - beta1) * gradient;
+                    second_ = beta2 * second_ +
+                        (1.0 - beta2) * (gradient * gradient);
+
+                    double const correction1 =
+                        1.0 - std::pow(beta1, double(step_));
+                    double const correction2 =
+                        1.0 - std::pow(beta2, double(step_));
+
+                    weights -= alpha_ * (first_ / correction1) /
+                        (blaze::sqrt(second_ / correction2) + epsilon);
+                }
+                break;
+            }
+        }
+
+    private:
+        enum method_type
+        {
+            sgd,
+            momentum_sgd,
+            adam
+        };
+
+        method_type method_ = sgd;
+        double alpha_;
+        double momentum_;
+        std::size_t step_ = 0;
+        lra_vector_type first_;
+        lra_vector_type second_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Source of the batches of an epoch, the data is taken either from
+    // memory or from a CSV file holding one row per sample with the label in
+    // the last column
+    class lra_batches
+    {
+    public:
+        lra_batches(lra_matrix_type const& x, lra_vector_type const& y,
+            std::size_t batch_size)
+          : x_(&x)
+          , y_(&y)
+          , batch_size_(batch_size)
+        {
+        }
+
+        lra_batches(std::string const& filename, std::size_t batch_size)
+          : reader_(std::make_shared<csv_chunk_reader>(filename))
+          , batch_size_(batch_size)
+        {
+            // the first chunk is read right away to know the number of
+            // features
+            std::vector<double> data;
+            reader_->read(batch_size_, data);
+            next_chunk_ = hpx::make_ready_future(std::move(data));
+
+            if (reader_->columns() < 2)
+            {
+                throw std::runtime_error(
+                    "the data file has to have at least two columns");
+            }
+        }
+
+        std::size_t num_features() const
+        {
+            return reader_ ? reader_->columns() - 1 : x_->columns();
+        }
+
+        // fetch the next batch, returns false at the end of the epoch
+        bool next(lra_matrix_type& x, lra_vector_type& y)
+        {
+            if (!reader_)
+            {
+                if (next_row_ >= x_->rows())
+                {
+                    return false;
+                }
+
+                std::size_t const size =
+                    (std::min)(batch_size_, x_->rows() - next_row_);
+                x = blaze::submatrix(
+                    *x_, next_row_, 0, size, x_->columns());
+                y = blaze::subvector(*y_, next_row_, size);
+                next_row_ += size;
+                return true;
+            }
+
+            // the next chunk of the file is read while this one is used
+            std::vector<double> data = next_chunk_.get();
+            if (data.empty())
+            {
+                return false;
+            }
+            prefetch();
+
+            std::size_t const columns = reader_->columns();
+            lra_matrix_type chunk(
+                data.size() / columns, columns, data.data());
+            x = blaze::submatrix(chunk, 0, 0, chunk.rows(), columns - 1);
+            y = blaze::column(chunk, columns - 1);
+            return true;
+        }
+
+    private:
+        void prefetch()
+        {
+            next_chunk_ = hpx::async(
+                [reader = reader_, batch_size = batch_size_]() {
+                    std::vector<double> data;
+                    reader->read(batch_size, data);
+                    return data;
+                });
+        }
+
+        lra_matrix_type const* x_ = nullptr;
+        lra_vector_type const* y_ = nullptr;
+        std::shared_ptr<csv_chunk_reader> reader_;
+        hpx::future<std::vector<double>> next_chunk_;
+        std::size_t batch_size_;
+        std::size_t next_row_ = 0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Runs the given number of epochs over the batches created by
+    // make_batches. The combined gradient of every step is given by reduce,
+    // the training stops as soon as the combined gradient does not cover any
+    // rows.
+    template <typename MakeBatches, typename Reduce, typename Output>
+    lra_vector_type lra_train(MakeBatches&& make_batches,
+        std::size_t num_features, lra_optimizer& optimizer,
+        std::int64_t epochs, Reduce&& reduce, Output&& output)
+    {
+        lra_vector_type weights(num_features, 0.0);
+
+        lra_matrix_type x;
+        lra_vector_type y;
+        for (std::int64_t epoch = 0; epoch < epochs; ++epoch)
+        {
+            lra_batches batches = make_batches();
+            for (std::size_t step = 0; /**/; ++step)
+            {
+                lra_vector_type gradient;
+                if (batches.next(x, y))
+                {
+                    if (x.columns() != num_features)
+                    {
+                        throw std::runtime_error(
+                            "all batches have to have the same number of "
+                            "features");
+                    }
+                    gradient = lra_gradient(x, y, weights);
+                }
+                else
+                {
+                    gradient = lra_vector_type(num_features + 1, 0.0);
+                }
+
+                gradient = reduce(std::move(gradient), epoch, step);
+
+                double const rows = gradient[num_features];
+                if (rows == 0)
+                {
+                    break;
+                }
+
+                optimizer.update(weights,
+                    blaze::subvector(gradient, 0, num_features) / rows);
+            }
+
+            output(epoch, weights);
+        }
+        return weights;
+    }
+}}}}
+
+#endif
@@ -31,9 +31,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
         using base_type = numeric<detail::add_op, add_operation>;
 
     protected:
-        hpx::future<primitive_argument_type> eval(
+        util::future_or_value<primitive_argument_type> eval_future_or_value(
             primitive_arguments_type const& operands,
-            primitive_arguments_type const& args, eval_context ctx) const;
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
 
     public:
         static match_pattern_type const match_data;
@@ -9,12 +9,12 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/plugins/arithmetics/cumulative.hpp>
+#include <phylanx/util/parallel_scan.hpp>
 
 #include <hpx/datastructures/optional.hpp>
 #include <hpx/modules/format.hpp>
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
-#include <hpx/include/parallel_scan.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
 
@@ -91,7 +91,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto v = value.vector();
         blaze::DynamicVector<T> result(v.size());
 
-        Op{}(v.begin(), v.end(), result.begin(), Op::template initial<T>());
+        util::inclusive_scan(v.data(), v.size(), result.data(), Op{},
+            Op::template initial<T>());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -108,14 +109,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = value.matrix();
         blaze::DynamicVector<T> result(m.rows() * m.columns());
 
-        T init = Op::template initial<T>();
-        auto last = result.begin();
-
-        for (std::size_t row = 0; row != m.rows(); ++row)
-        {
-            last = Op{}(m.begin(row), m.end(row), last, init);
-            init = *(last - 1);
-        }
+        util::inclusive_scan(m.data(), m.rows(), m.columns(), m.spacing(),
+            result.data(), m.columns(), Op{}, Op::template initial<T>());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -131,14 +126,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = value.matrix();
         blaze::DynamicMatrix<T> result(m.rows(), m.columns());
 
-        T init = Op::template initial<T>();
-        for (std::size_t col = 0; col != m.columns(); ++col)
-        {
-            auto column = blaze::column(m, col);
-            auto result_column = blaze::column(result, col);
-
-            Op{}(column.begin(), column.end(), result_column.begin(), init);
-        }
+        // all columns are scanned together, row by row
+        util::inclusive_scan_axis(m.data(), {0, m.spacing(), 1},
+            result.data(), {0, result.spacing(), 1},
+            {1, m.rows(), m.columns()}, Op{}, Op::template initial<T>());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -154,11 +145,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = value.matrix();
         blaze::DynamicMatrix<T> result(m.rows(), m.columns());
 
-        T init = Op::template initial<T>();
-        for (std::size_t row = 0; row != m.rows(); ++row)
-        {
-            Op{}(m.begin(row), m.end(row), result.begin(row), init);
-        }
+        util::inclusive_scan_axis(m.data(), {m.spacing(), 1, 0},
+            result.data(), {result.spacing(), 1, 0},
+            {m.rows(), m.columns(), 1}, Op{}, Op::template initial<T>());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -208,18 +197,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t = value.tensor();
         blaze::DynamicVector<T> result(t.pages() * t.rows() * t.columns());
 
-        T init = Op::template initial<T>();
-        auto last = result.begin();
-
-        for (std::size_t page = 0; page != t.pages(); ++page)
-        {
-            auto ps = blaze::pageslice(t, page);
-            for (std::size_t row = 0; row != t.rows(); ++row)
-            {
-                last = Op{}(ps.begin(row), ps.end(row), last, init);
-                init = *(last - 1);
-            }
-        }
+        // the rows of all pages are equally spaced
+        util::inclusive_scan(t.data(), t.pages() * t.rows(), t.columns(),
+            t.spacing(), result.data(), t.columns(), Op{},
+            Op::template initial<T>());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -235,19 +216,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t = value.tensor();
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t i = 0; i != t.rows(); ++i)
-        {
-            auto slice = blaze::rowslice(t, i);
-            auto result_slice = blaze::rowslice(result, i);
-            for (std::size_t j = 0; j != blaze::rows(slice); ++j)
-            {
-                auto row = blaze::row(slice, j);
-                auto result_row = blaze::row(result_slice, j);
 
-                Op{}(row.begin(), row.end(), result_row.begin(), init);
-            }
-        }
+        // the rows of all pages are scanned together, page by page
+        util::inclusive_scan_axis(t.data(),
+            {t.spacing(), t.rows() * t.spacing(), 1}, result.data(),
+            {result.spacing(), result.rows() * result.spacing(), 1},
+            {t.rows(), t.pages(), t.columns()}, Op{},
+            Op::template initial<T>());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -263,19 +238,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t = value.tensor();
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t k = 0; k != t.pages(); ++k)
-        {
-            auto slice = blaze::pageslice(t, k);
-            auto result_slice = blaze::pageslice(result, k);
-            for (std::size_t j = 0; j != blaze::columns(slice); ++j)
-            {
-                auto col = blaze::column(slice, j);
-                auto result_col = blaze::column(result_slice, j);
 
-                Op{}(col.begin(), col.end(), result_col.begin(), init);
-            }
-        }
+        // the columns of every page are scanned together, row by row
+        util::inclusive_scan_axis(t.data(),
+            {t.rows() * t.spacing(), t.spacing(), 1}, result.data(),
+            {result.rows() * result.spacing(), result.spacing(), 1},
+            {t.pages(), t.rows(), t.columns()}, Op{},
+            Op::template initial<T>());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -291,19 +260,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t = value.tensor();
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t k = 0; k != t.pages(); ++k)
-        {
-            auto slice = blaze::pageslice(t, k);
-            auto result_slice = blaze::pageslice(result, k);
-            for (std::size_t j = 0; j != blaze::rows(slice); ++j)
-            {
-                auto row = blaze::row(slice, j);
-                auto result_row = blaze::row(result_slice, j);
 
-                Op{}(row.begin(), row.end(), result_row.begin(), init);
-            }
-        }
+        // the rows of all pages are equally spaced
+        util::inclusive_scan_axis(t.data(), {t.spacing(), 1, 0},
+            result.data(), {result.spacing(), 1, 0},
+            {t.pages() * t.rows(), t.columns(), 1}, Op{},
+            Op::template initial<T>());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -13,6 +13,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/future_or_value.hpp>
 
 #include <hpx/futures/future.hpp>
 
@@ -44,6 +45,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
             primitive_arguments_type const& args,
             eval_context ctx) const override;
 
+        // binary operations on ready operands are evaluated in place
+        util::future_or_value<primitive_argument_type> eval_future_or_value(
+            primitive_arguments_type const& params,
+            eval_context ctx) const override;
+
+        util::future_or_value<primitive_argument_type> eval_future_or_value(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
         template <typename T>
         using arg_type = ir::node_data<T>;
 
@@ -95,6 +106,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type handle_numeric_operands(
             primitive_arguments_type&& ops) const;
 
+        void verify_operands(primitive_arguments_type const& operands) const;
+
     protected:
         node_data_type dtype_;
     };
@@ -485,9 +485,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     ///////////////////////////////////////////////////////////////////////////
     template <typename Op, typename Derived>
-    hpx::future<primitive_argument_type> numeric<Op, Derived>::eval(
-        primitive_arguments_type const& operands,
-        primitive_arguments_type const& args, eval_context ctx) const
+    void numeric<Op, Derived>::verify_operands(
+        primitive_arguments_type const& operands) const
     {
         if (operands.size() < 2)
         {
@@ -512,13 +511,63 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "the numeric primitive requires that the arguments "
                     "given by the operands array are valid"));
         }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Op, typename Derived>
+    hpx::future<primitive_argument_type> numeric<Op, Derived>::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        return this->eval_future_or_value(operands, args, std::move(ctx))
+            .get_future();
+    }
+
+    template <typename Op, typename Derived>
+    util::future_or_value<primitive_argument_type>
+    numeric<Op, Derived>::eval_future_or_value(
+        primitive_arguments_type const& params, eval_context ctx) const
+    {
+        if (this->no_operands())
+        {
+            return this->eval_future_or_value(
+                params, noargs, std::move(ctx));
+        }
+        return this->eval_future_or_value(
+            this->operands(), params, std::move(ctx));
+    }
+
+    template <typename Op, typename Derived>
+    util::future_or_value<primitive_argument_type>
+    numeric<Op, Derived>::eval_future_or_value(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        verify_operands(operands);
 
-        auto this_ = this->shared_from_this();
         if (operands.size() == 2)
         {
-            // special case for 2 operands
+            // special case for 2 operands, the result is computed right
+            // away if both operands are available
+            auto lhs = value_operand_future_or_value(
+                operands[0], args, name_, codename_, ctx);
+            auto rhs = value_operand_future_or_value(
+                operands[1], args, name_, codename_, ctx);
+
+            if (lhs.is_ready() && rhs.is_ready())
+            {
+                auto&& op1 = lhs.get();
+                auto&& op2 = rhs.get();
+
+                annotation_wrapper wrap(op1, op2);
+
+                return wrap.propagate(handle_numeric_operands(
+                                          std::move(op1), std::move(op2)),
+                    name_, codename_);
+            }
+
             return hpx::dataflow(hpx::launch::sync,
-                [this_ = std::move(this_)](
+                [this_ = this->shared_from_this()](
                     hpx::future<primitive_argument_type>&& lhs,
                     hpx::future<primitive_argument_type>&& rhs)
                 -> primitive_argument_type
@@ -532,12 +581,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                               std::move(op1), std::move(op2)),
                         this_->name_, this_->codename_);
                 },
-                value_operand(operands[0], args, name_, codename_, ctx),
-                value_operand(operands[1], args, name_, codename_, ctx));
+                lhs.get_future(), rhs.get_future());
         }
 
         return hpx::dataflow(hpx::launch::sync, hpx::unwrapping(
-            [this_ = std::move(this_)](primitive_arguments_type&& ops)
+            [this_ = this->shared_from_this()](primitive_arguments_type&& ops)
             ->  primitive_argument_type
             {
                 annotation_wrapper wrap(ops);
@@ -7,6 +7,7 @@
 #define PHYLANX_PLUGINS_BOOLEANS_APR_07_2108_1127PM
 
 #include <phylanx/plugins/booleans/and_operation.hpp>
+#include <phylanx/plugins/booleans/compress_operation.hpp>
 #include <phylanx/plugins/booleans/equal.hpp>
 #include <phylanx/plugins/booleans/greater.hpp>
 #include <phylanx/plugins/booleans/greater_equal.hpp>
@@ -0,0 +1,77 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_COMPRESS_OPERATION_SEP_02_2021_0215PM)
+#define PHYLANX_PRIMITIVES_COMPRESS_OPERATION_SEP_02_2021_0215PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/bit_mask.hpp>
+
+#include <hpx/datastructures/optional.hpp>
+#include <hpx/futures/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    class compress_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<compress_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static match_pattern_type const match_data;
+
+        compress_operation() = default;
+
+        compress_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        primitive_argument_type calculate_compress(
+            primitive_arguments_type&& args) const;
+
+        util::bit_mask compress_mask(ir::node_data<std::uint8_t> const& cond,
+            std::size_t extent) const;
+
+        template <typename T>
+        primitive_argument_type compress_flat(
+            ir::node_data<std::uint8_t>&& cond, ir::node_data<T>&& arg) const;
+
+        template <typename T>
+        primitive_argument_type compress_axis(
+            ir::node_data<std::uint8_t>&& cond, ir::node_data<T>&& arg,
+            std::size_t axis) const;
+
+        template <typename T>
+        primitive_argument_type compress(ir::node_data<std::uint8_t>&& cond,
+            ir::node_data<T>&& arg,
+            hpx::util::optional<std::int64_t> const& axis) const;
+    };
+
+    inline primitive create_compress_operation(
+        hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "compress", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
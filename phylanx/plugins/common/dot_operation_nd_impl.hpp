@@ -12,6 +12,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/common/export_definitions.hpp>
 #include <phylanx/plugins/common/dot_operation_nd.hpp>
+#include <phylanx/util/batched_gemm.hpp>
 #include <phylanx/util/generate_error_message.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
@@ -185,12 +186,15 @@ namespace phylanx { namespace common
                     name, codename));
         }
 
+        auto v = lhs.vector();
         auto t = rhs.tensor();
         blaze::DynamicMatrix<T> result(t.pages(), t.columns());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::row(blaze::submatrix(result, i, 0, 1, t.columns()), 0) =
-                blaze::trans(lhs.vector()) * blaze::pageslice(t, i);
+        // row i of the result is the vector times page i
+        util::batched_gemm<T>(t.pages(), 1, t.columns(), t.rows(),
+            {v.data(), 0, 0, 1},
+            {t.data(), t.rows() * t.spacing(), t.spacing(), 1},
+            {result.data(), result.spacing(), 0, 1});
 
         return execution_tree::primitive_argument_type{std::move(result)};
     }
@@ -323,10 +327,12 @@ namespace phylanx { namespace common
 
         blaze::DynamicTensor<T> result(m.rows(), t.pages(), t.columns());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::rowslice(
-                blaze::subtensor(result, 0, i, 0, m.rows(), 1, t.columns()),
-                0) = blaze::trans(m * blaze::pageslice(t, i));
+        // result(:, i, :) is the matrix times page i
+        util::batched_gemm<T>(t.pages(), m.rows(), t.columns(), m.columns(),
+            {m.data(), 0, m.spacing(), 1},
+            {t.data(), t.rows() * t.spacing(), t.spacing(), 1},
+            {result.data(), result.spacing(),
+                result.rows() * result.spacing(), 1});
 
         return execution_tree::primitive_argument_type{std::move(result)};
     }
@@ -432,11 +438,13 @@ namespace phylanx { namespace common
                     name, codename));
         }
         auto t = lhs.tensor();
+        auto v = rhs.vector();
         blaze::DynamicMatrix<T> result(t.pages(), t.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::row(blaze::submatrix(result, i, 0, 1, t.rows()), 0) =
-                blaze::trans(blaze::pageslice(t, i) * rhs.vector());
+        // row i of the result is page i times the vector
+        util::batched_gemm<T>(t.pages(), t.rows(), 1, t.columns(),
+            {t.data(), t.rows() * t.spacing(), t.spacing(), 1},
+            {v.data(), 0, 1, 0}, {result.data(), result.spacing(), 1, 0});
 
         return execution_tree::primitive_argument_type{std::move(result)};
     }
@@ -460,10 +468,11 @@ namespace phylanx { namespace common
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), m.columns());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::pageslice(
-                blaze::subtensor(result, i, 0, 0, 1, t.rows(), m.columns()),
-                0) = blaze::pageslice(t, i) * m;
+        util::batched_gemm<T>(t.pages(), t.rows(), m.columns(), t.columns(),
+            {t.data(), t.rows() * t.spacing(), t.spacing(), 1},
+            {m.data(), 0, m.spacing(), 1},
+            {result.data(), result.rows() * result.spacing(),
+                result.spacing(), 1});
 
         return execution_tree::primitive_argument_type{std::move(result)};
     }
@@ -481,10 +490,23 @@ namespace phylanx { namespace common
                     "the operands have incompatible number of dimensions",
                     name, codename));
         }
-        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "dot3d3d",
-            util::generate_error_message(
-                "it is not supported by Phylanx yet", name, codename));
+
+        // result(i, j, k, m) = sum(lhs(i, j, :) * rhs(k, :, m)), the pages
+        // of lhs are stacked into one matrix which is multiplied with every
+        // page of rhs
+        auto t1 = lhs.tensor();
+        auto t2 = rhs.tensor();
+
+        blaze::DynamicArray<4UL, T> result(
+            t1.pages(), t1.rows(), t2.pages(), t2.columns());
+
+        util::batched_gemm<T>(t2.pages(), t1.pages() * t1.rows(),
+            t2.columns(), t1.columns(), {t1.data(), 0, t1.spacing(), 1},
+            {t2.data(), t2.rows() * t2.spacing(), t2.spacing(), 1},
+            {result.data(), result.spacing(),
+                t2.pages() * result.spacing(), 1});
+
+        return execution_tree::primitive_argument_type{std::move(result)};
     }
 }}
 
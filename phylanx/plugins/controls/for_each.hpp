@@ -37,6 +37,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
             primitive_arguments_type const& args,
             eval_context ctx) const override;
 
+        primitive_argument_type iterate(primitive_argument_type&& bound_func,
+            primitive_argument_type&& value, eval_context ctx) const;
+
         void iterate_over_array(primitive const* p,
             primitive_argument_type&& value, eval_context ctx) const;
 
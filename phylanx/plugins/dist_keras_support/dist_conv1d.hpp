@@ -47,6 +47,10 @@ namespace phylanx { namespace dist_keras_support { namespace primitives {
             execution_tree::localities_information&& arg_locs,
             execution_tree::localities_information&& kernel_locs,
             std::string&& padding, std::string&& given_name) const;
+        execution_tree::primitive_argument_type conv1d_halo(
+            ir::node_data<double>&& arg, ir::node_data<double>&& kernel,
+            execution_tree::localities_information&& arg_locs,
+            std::string const& padding, std::string&& given_name) const;
         execution_tree::primitive_argument_type conv1d_all_paddings(
             execution_tree::primitive_argument_type&& arg,
             execution_tree::primitive_argument_type&& kernel,
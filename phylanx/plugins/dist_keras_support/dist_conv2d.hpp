@@ -0,0 +1,66 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_KERAS_SUPPORT_CONV2D_OPERATION)
+#define PHYLANX_DIST_KERAS_SUPPORT_CONV2D_OPERATION
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace dist_keras_support { namespace primitives {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // 2d convolution of an image tiled along its height. The rows of the image
+    // needed from the neighboring tiles are exchanged while the interior of
+    // the local tile is computed.
+    class dist_conv2d
+      : public execution_tree::primitives::primitive_component_base
+      , public std::enable_shared_from_this<dist_conv2d>
+    {
+    protected:
+        hpx::future<execution_tree::primitive_argument_type> eval(
+            execution_tree::primitive_arguments_type const& operands,
+            execution_tree::primitive_arguments_type const& args,
+            execution_tree::eval_context ctx) const override;
+
+    public:
+        static execution_tree::match_pattern_type const match_data;
+
+        dist_conv2d() = default;
+
+        dist_conv2d(execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        execution_tree::primitive_argument_type conv2d(
+            ir::node_data<double>&& arg, ir::node_data<double>&& kernel,
+            std::string const& padding) const;
+        execution_tree::primitive_argument_type conv2d(
+            ir::node_data<double>&& arg, ir::node_data<double>&& kernel,
+            execution_tree::localities_information&& arg_locs,
+            std::string const& padding, std::string&& given_name) const;
+    };
+
+    inline execution_tree::primitive create_dist_conv2d(
+        hpx::id_type const& locality,
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return execution_tree::create_primitive_component(
+            locality, "conv2d_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
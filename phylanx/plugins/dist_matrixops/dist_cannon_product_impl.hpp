@@ -157,12 +157,12 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         std::uint32_t rhs_locality_id = rhs_localities.locality_.locality_id_;
 
         // construct a distributed matrix object for both tiles
-        util::distributed_matrix<T> lhs_data(lhs_localities.annotation_.name_,
-            lhs.matrix(), lhs_num_localities, lhs_locality_id,
-            &transferred_bytes_);
-        util::distributed_matrix<T> rhs_data(rhs_localities.annotation_.name_,
-            rhs.matrix(), rhs_num_localities, rhs_locality_id,
-            &transferred_bytes_);
+        util::distributed_matrix<T> const lhs_data(
+            lhs_localities.annotation_.name_, lhs.matrix(), lhs_num_localities,
+            lhs_locality_id, &transferred_bytes_, true);
+        util::distributed_matrix<T> const rhs_data(
+            rhs_localities.annotation_.name_, rhs.matrix(), rhs_num_localities,
+            rhs_locality_id, &transferred_bytes_, true);
 
         std::size_t lhs_local_tile_index = std::distance(lhs_tile_row.begin(),
             std::find(
@@ -117,9 +117,10 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         }
 
         // construct a distributed vector object for the rhs
-        util::distributed_vector<T> rhs_data(rhs_localities.annotation_.name_,
-            rhs.vector(), rhs_localities.locality_.num_localities_,
-            rhs_localities.locality_.locality_id_, &transferred_bytes_);
+        util::distributed_vector<T> const rhs_data(
+            rhs_localities.annotation_.name_, rhs.vector(),
+            rhs_localities.locality_.num_localities_,
+            rhs_localities.locality_.locality_id_, &transferred_bytes_, true);
 
         // use the local tile of lhs and calculate the dot product with all
         // corresponding tiles of rhs
@@ -233,9 +234,10 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         }
 
         // construct a distributed matrix object for the rhs
-        util::distributed_matrix<T> rhs_data(rhs_localities.annotation_.name_,
-            rhs.matrix(), rhs_localities.locality_.num_localities_,
-            rhs_localities.locality_.locality_id_, &transferred_bytes_);
+        util::distributed_matrix<T> const rhs_data(
+            rhs_localities.annotation_.name_, rhs.matrix(),
+            rhs_localities.locality_.num_localities_,
+            rhs_localities.locality_.locality_id_, &transferred_bytes_, true);
 
         // use the local tile of lhs and calculate the dot product with all
         // corresponding tiles of rhs
@@ -430,9 +432,10 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         }
 
         // construct a distributed vector object for the rhs
-        util::distributed_vector<T> rhs_data(rhs_localities.annotation_.name_,
-            rhs.vector(), rhs_localities.locality_.num_localities_,
-            rhs_localities.locality_.locality_id_, &transferred_bytes_);
+        util::distributed_vector<T> const rhs_data(
+            rhs_localities.annotation_.name_, rhs.vector(),
+            rhs_localities.locality_.num_localities_,
+            rhs_localities.locality_.locality_id_, &transferred_bytes_, true);
 
         // we need to get the lhs column span
         std::size_t lhs_span_index = 1;
@@ -600,9 +603,10 @@ namespace phylanx { namespace dist_matrixops { namespace primitives {
         }
 
         // construct a distributed matrix object for the rhs
-        util::distributed_matrix<T> rhs_data(rhs_localities.annotation_.name_,
-            rhs.matrix(), rhs_localities.locality_.num_localities_,
-            rhs_localities.locality_.locality_id_, &transferred_bytes_);
+        util::distributed_matrix<T> const rhs_data(
+            rhs_localities.annotation_.name_, rhs.matrix(),
+            rhs_localities.locality_.num_localities_,
+            rhs_localities.locality_.locality_id_, &transferred_bytes_, true);
 
         // use the local tile of lhs and calculate the dot product with all
         // corresponding tiles of rhs, lhs column span
@@ -0,0 +1,111 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_MATRIXOPS_DIST_ELEMENTWISE_OPERATION)
+#define PHYLANX_DIST_MATRIXOPS_DIST_ELEMENTWISE_OPERATION
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Element-wise binary operations (arithmetics, comparisons, maximum,
+    // minimum, and power) on tiled arrays. If the tilings of both operands
+    // match, the operation is performed on the local tiles only. Otherwise
+    // the operand that requires less data to be moved is aligned with the
+    // tiling of the other one by fetching the overlapping parts of its remote
+    // tiles. The result is annotated with the tiling it was computed for.
+    class dist_elementwise_operation
+      : public execution_tree::primitives::primitive_component_base
+      , public std::enable_shared_from_this<dist_elementwise_operation>
+    {
+    public:
+        enum operation
+        {
+            add, sub, mul, div,
+            less, less_equal, greater, greater_equal, equal, not_equal,
+            maximum, minimum, power
+        };
+
+        static std::vector<execution_tree::match_pattern_type> const
+            match_data;
+
+        dist_elementwise_operation() = default;
+
+        dist_elementwise_operation(
+            execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    protected:
+        hpx::future<execution_tree::primitive_argument_type> eval(
+            execution_tree::primitive_arguments_type const& operands,
+            execution_tree::primitive_arguments_type const& args,
+            execution_tree::eval_context ctx) const override;
+
+    private:
+        execution_tree::primitive_argument_type elementwise(
+            execution_tree::primitive_argument_type&& lhs,
+            execution_tree::primitive_argument_type&& rhs) const;
+
+        template <typename Op>
+        execution_tree::primitive_argument_type elementwise(
+            execution_tree::primitive_argument_type&& lhs,
+            execution_tree::primitive_argument_type&& rhs, Op op) const;
+
+        template <typename T, typename Op>
+        execution_tree::primitive_argument_type elementwise(
+            ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
+            execution_tree::localities_information&& lhs_localities,
+            execution_tree::localities_information&& rhs_localities,
+            bool lhs_annotated, bool rhs_annotated, Op op) const;
+
+        template <typename T, std::size_t N, typename Op>
+        execution_tree::primitive_argument_type elementwise_nd(
+            ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
+            execution_tree::localities_information&& lhs_localities,
+            execution_tree::localities_information&& rhs_localities,
+            bool lhs_annotated, bool rhs_annotated, Op op) const;
+
+        template <typename T, typename Op>
+        execution_tree::primitive_argument_type elementwise_scalar(
+            ir::node_data<T>&& lhs, ir::node_data<T>&& rhs,
+            execution_tree::localities_information&& localities,
+            bool annotated, bool scalar_lhs, Op op) const;
+
+        std::shared_ptr<execution_tree::annotation> result_annotation(
+            execution_tree::localities_information&& localities) const;
+
+        std::int64_t get_transferred_bytes(bool reset) const;
+
+    private:
+        operation op_;
+        std::string op_name_;
+        mutable std::int64_t transferred_bytes_;
+    };
+
+    inline execution_tree::primitive create_dist_elementwise_operation(
+        hpx::id_type const& locality,
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return execution_tree::create_primitive_component(locality,
+            "__elementwise_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
@@ -13,9 +13,12 @@
 #include <phylanx/plugins/dist_matrixops/dist_constant.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_diag.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_dot_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_elementwise_operation.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_identity.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_inverse_operation.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_random.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_sort.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_stencil.hpp>
 #include <phylanx/plugins/dist_matrixops/dist_transpose_operation.hpp>
 #include <phylanx/plugins/dist_matrixops/retile_annotations.hpp>
 
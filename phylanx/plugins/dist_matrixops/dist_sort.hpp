@@ -0,0 +1,95 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_MATRIXOPS_DIST_SORT)
+#define PHYLANX_DIST_MATRIXOPS_DIST_SORT
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // sort_d, argsort_d and unique_d for tiled vectors, based on a
+    // distributed sample sort. The result is a tiled vector with balanced
+    // tile sizes.
+    class dist_sort
+      : public execution_tree::primitives::primitive_component_base
+      , public std::enable_shared_from_this<dist_sort>
+    {
+    public:
+        enum sort_mode
+        {
+            sort_values,
+            argsort_values,
+            unique_values
+        };
+
+        static std::vector<execution_tree::match_pattern_type> const
+            match_data;
+
+        dist_sort() = default;
+
+        dist_sort(execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    protected:
+        hpx::future<execution_tree::primitive_argument_type> eval(
+            execution_tree::primitive_arguments_type const& operands,
+            execution_tree::primitive_arguments_type const& args,
+            execution_tree::eval_context ctx) const override;
+
+    private:
+        execution_tree::primitive_argument_type sort1d(
+            execution_tree::primitive_argument_type&& arg) const;
+
+        template <typename T>
+        execution_tree::primitive_argument_type sort1d(ir::node_data<T>&& arg,
+            execution_tree::localities_information&& localities) const;
+        template <typename T>
+        execution_tree::primitive_argument_type argsort1d(
+            ir::node_data<T>&& arg,
+            execution_tree::localities_information&& localities) const;
+
+        template <typename T>
+        execution_tree::primitive_argument_type sort1d_local(
+            ir::node_data<T>&& arg) const;
+
+        template <typename T>
+        execution_tree::primitive_argument_type finalize(
+            blaze::DynamicVector<T>&& local,
+            execution_tree::localities_information&& localities) const;
+
+        std::int64_t get_transferred_bytes(bool reset) const;
+
+    private:
+        sort_mode mode_;
+        mutable std::int64_t transferred_bytes_;
+    };
+
+    inline execution_tree::primitive create_dist_sort(
+        hpx::id_type const& locality,
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return execution_tree::create_primitive_component(
+            locality, "__sort_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
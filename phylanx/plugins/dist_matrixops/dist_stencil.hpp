@@ -0,0 +1,73 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_MATRIXOPS_DIST_STENCIL)
+#define PHYLANX_DIST_MATRIXOPS_DIST_STENCIL
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply a centered stencil (given by its weights) to a vector or a matrix
+    // tiled along one of its dimensions. The elements needed from the
+    // neighboring tiles are exchanged while the interior of the local tile is
+    // computed.
+    class dist_stencil
+      : public execution_tree::primitives::primitive_component_base
+      , public std::enable_shared_from_this<dist_stencil>
+    {
+    public:
+        static execution_tree::match_pattern_type const match_data;
+
+        dist_stencil() = default;
+
+        dist_stencil(execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    protected:
+        hpx::future<execution_tree::primitive_argument_type> eval(
+            execution_tree::primitive_arguments_type const& operands,
+            execution_tree::primitive_arguments_type const& args,
+            execution_tree::eval_context ctx) const override;
+
+    private:
+        execution_tree::primitive_argument_type stencil1d(
+            ir::node_data<double>&& arg, ir::node_data<double>&& weights,
+            execution_tree::localities_information&& arg_locs,
+            std::string&& given_name) const;
+        execution_tree::primitive_argument_type stencil2d(
+            ir::node_data<double>&& arg, ir::node_data<double>&& weights,
+            execution_tree::localities_information&& arg_locs,
+            std::string&& given_name) const;
+
+        std::shared_ptr<execution_tree::annotation> result_annotation(
+            execution_tree::localities_information&& arg_locs,
+            std::string&& given_name) const;
+    };
+
+    inline execution_tree::primitive create_dist_stencil(
+        hpx::id_type const& locality,
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return execution_tree::create_primitive_component(
+            locality, "stencil_d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
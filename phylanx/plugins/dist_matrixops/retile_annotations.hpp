@@ -46,35 +46,41 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_argument_type retile1d(
             execution_tree::primitive_argument_type&& arr,
             std::string const& tiling_type, std::size_t intersection,
-            std::uint32_t numtiles, ir::range&& new_tiling) const;
+            std::uint32_t numtiles, ir::range&& new_tiling,
+            bool optimize_placement) const;
         template <typename T>
         execution_tree::primitive_argument_type retile1d(ir::node_data<T>&& arr,
             std::string const& tiling_type, std::size_t intersection,
             std::uint32_t numtiles, ir::range&& new_tiling,
+            bool optimize_placement,
             execution_tree::localities_information&& arr_localities) const;
 
         execution_tree::primitive_argument_type retile2d(
             execution_tree::primitive_argument_type&& arr,
             std::string const& tiling_type,
             std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersection,
-            std::uint32_t numtiles, ir::range&& new_tiling) const;
+            std::uint32_t numtiles, ir::range&& new_tiling,
+            bool optimize_placement) const;
         template <typename T>
         execution_tree::primitive_argument_type retile2d(ir::node_data<T>&& arr,
             std::string const& tiling_type,
             std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersection,
             std::uint32_t numtiles, ir::range&& new_tiling,
+            bool optimize_placement,
             execution_tree::localities_information&& arr_localities) const;
 
         execution_tree::primitive_argument_type retile3d(
             execution_tree::primitive_argument_type&& arr,
             std::string const& tiling_type,
             std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersection,
-            std::uint32_t numtiles, ir::range&& new_tiling) const;
+            std::uint32_t numtiles, ir::range&& new_tiling,
+            bool optimize_placement) const;
         template <typename T>
         execution_tree::primitive_argument_type retile3d(ir::node_data<T>&& arr,
             std::string const& tiling_type,
             std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersection,
             std::uint32_t numtiles, ir::range&& new_tiling,
+            bool optimize_placement,
             execution_tree::localities_information&& arr_localities) const;
 
     private:
@@ -0,0 +1,570 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_MATRIXOPS_RETILE_PLANNER)
+#define PHYLANX_DIST_MATRIXOPS_RETILE_PLANNER
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+#include <phylanx/util/serialization/blaze.hpp>
+
+#include <hpx/assert.hpp>
+#include <hpx/collectives/all_to_all.hpp>
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+// The retile planner computes how much data has to be moved between
+// localities when changing the tiling of a distributed array. All tiles are
+// described by their (global) spans ordered from the outermost to the
+// innermost dimension, i.e. {span} for vectors, {rows, columns} for matrices
+// and {pages, rows, columns} for tensors.
+namespace phylanx { namespace dist_matrixops { namespace retile_planner
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <std::size_t N>
+    using tile_spans = std::array<execution_tree::tiling_span, N>;
+
+    template <std::size_t N>
+    using tiling = std::vector<tile_spans<N>>;
+
+    // number of elements in the given tile
+    template <std::size_t N>
+    std::int64_t volume(tile_spans<N> const& tile)
+    {
+        std::int64_t result = 1;
+        for (auto const& span : tile)
+        {
+            if (!span.is_valid())
+            {
+                return 0;
+            }
+            result *= span.size();
+        }
+        return result;
+    }
+
+    // calculate the intersection of two tiles, returns false if the tiles do
+    // not overlap
+    template <std::size_t N>
+    bool intersect(tile_spans<N> const& lhs, tile_spans<N> const& rhs,
+        tile_spans<N>& result)
+    {
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            if (!execution_tree::intersect(lhs[i], rhs[i], result[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <std::size_t N>
+    std::int64_t intersection_volume(
+        tile_spans<N> const& lhs, tile_spans<N> const& rhs)
+    {
+        tile_spans<N> result;
+        if (!intersect(lhs, rhs, result))
+        {
+            return 0;
+        }
+        return volume(result);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // extract the tiles of all localities from the given localities
+    // information
+    namespace detail
+    {
+        template <std::size_t N>
+        struct tile_extractor;
+
+        template <>
+        struct tile_extractor<1>
+        {
+            static tile_spans<1> call(
+                execution_tree::tiling_information const& tile,
+                std::string const& name, std::string const& codename)
+            {
+                execution_tree::tiling_information_1d info(
+                    tile, name, codename);
+                return tile_spans<1>{info.span_};
+            }
+        };
+
+        template <>
+        struct tile_extractor<2>
+        {
+            static tile_spans<2> call(
+                execution_tree::tiling_information const& tile,
+                std::string const& name, std::string const& codename)
+            {
+                execution_tree::tiling_information_2d info(
+                    tile, name, codename);
+                return tile_spans<2>{info.spans_[0], info.spans_[1]};
+            }
+        };
+
+        template <>
+        struct tile_extractor<3>
+        {
+            static tile_spans<3> call(
+                execution_tree::tiling_information const& tile,
+                std::string const& name, std::string const& codename)
+            {
+                execution_tree::tiling_information_3d info(
+                    tile, name, codename);
+                return tile_spans<3>{
+                    info.spans_[0], info.spans_[1], info.spans_[2]};
+            }
+        };
+    }
+
+    template <std::size_t N>
+    tiling<N> extract_tiling(
+        execution_tree::localities_information const& locs,
+        std::string const& name, std::string const& codename)
+    {
+        tiling<N> result;
+        result.reserve(locs.tiles_.size());
+        for (auto const& tile : locs.tiles_)
+        {
+            result.push_back(
+                detail::tile_extractor<N>::call(tile, name, codename));
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The transfer matrix holds in element (i, j) the number of elements the
+    // current tile on locality i contributes to the new tile j.
+    template <std::size_t N>
+    blaze::DynamicMatrix<std::int64_t> transfer_matrix(
+        tiling<N> const& current, tiling<N> const& desired)
+    {
+        blaze::DynamicMatrix<std::int64_t> result(
+            current.size(), desired.size(), 0);
+
+        for (std::size_t i = 0; i != current.size(); ++i)
+        {
+            for (std::size_t j = 0; j != desired.size(); ++j)
+            {
+                result(i, j) = intersection_volume(current[i], desired[j]);
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Find the assignment of new tiles to localities that maximizes the
+    // amount of data staying local (Hungarian method, O(n^3)). Returns the
+    // index of the new tile for each locality.
+    inline std::vector<std::uint32_t> assign_tiles(
+        blaze::DynamicMatrix<std::int64_t> const& transfer)
+    {
+        std::size_t const n = transfer.rows();
+        if (n != transfer.columns())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "retile_planner::assign_tiles",
+                util::generate_error_message(
+                    "the number of new tiles must be equal to the number of "
+                    "localities"));
+        }
+
+        std::vector<std::uint32_t> tile_of(n);
+        if (n == 0)
+        {
+            return tile_of;
+        }
+
+        // turn maximization into minimization
+        std::int64_t const max_value = blaze::max(transfer);
+        auto cost = [&](std::size_t i, std::size_t j) {
+            return max_value - transfer(i - 1, j - 1);
+        };
+
+        std::int64_t const inf = (std::numeric_limits<std::int64_t>::max)();
+
+        // potentials and matching (1-based, index 0 is a sentinel)
+        std::vector<std::int64_t> u(n + 1, 0), v(n + 1, 0);
+        std::vector<std::size_t> p(n + 1, 0), way(n + 1, 0);
+
+        for (std::size_t i = 1; i <= n; ++i)
+        {
+            p[0] = i;
+            std::size_t j0 = 0;
+            std::vector<std::int64_t> minv(n + 1, inf);
+            std::vector<bool> used(n + 1, false);
+            do
+            {
+                used[j0] = true;
+                std::size_t i0 = p[j0], j1 = 0;
+                std::int64_t delta = inf;
+                for (std::size_t j = 1; j <= n; ++j)
+                {
+                    if (!used[j])
+                    {
+                        std::int64_t cur = cost(i0, j) - u[i0] - v[j];
+                        if (cur < minv[j])
+                        {
+                            minv[j] = cur;
+                            way[j] = j0;
+                        }
+                        if (minv[j] < delta)
+                        {
+                            delta = minv[j];
+                            j1 = j;
+                        }
+                    }
+                }
+                for (std::size_t j = 0; j <= n; ++j)
+                {
+                    if (used[j])
+                    {
+                        u[p[j]] += delta;
+                        v[j] -= delta;
+                    }
+                    else
+                    {
+                        minv[j] -= delta;
+                    }
+                }
+                j0 = j1;
+            } while (p[j0] != 0);
+
+            do
+            {
+                std::size_t j1 = way[j0];
+                p[j0] = p[j1];
+                j0 = j1;
+            } while (j0 != 0);
+        }
+
+        for (std::size_t j = 1; j <= n; ++j)
+        {
+            tile_of[p[j] - 1] = static_cast<std::uint32_t>(j - 1);
+        }
+        return tile_of;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct retile_plan
+    {
+        // element (i, j): number of elements locality i sends to new tile j
+        blaze::DynamicMatrix<std::int64_t> transfer_;
+
+        // the index of the new tile each of the localities will hold
+        std::vector<std::uint32_t> tile_of_;
+
+        // number of elements that stay local/have to be communicated
+        std::int64_t local_volume_ = 0;
+        std::int64_t remote_volume_ = 0;
+    };
+
+    // plan the retiling for the given assignment of new tiles to localities
+    inline retile_plan make_retile_plan(
+        blaze::DynamicMatrix<std::int64_t>&& transfer,
+        std::vector<std::uint32_t>&& tile_of)
+    {
+        HPX_ASSERT(tile_of.size() == transfer.rows());
+
+        retile_plan plan;
+        plan.transfer_ = std::move(transfer);
+        plan.tile_of_ = std::move(tile_of);
+
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i != plan.transfer_.rows(); ++i)
+        {
+            for (std::size_t j = 0; j != plan.transfer_.columns(); ++j)
+            {
+                total += plan.transfer_(i, j);
+            }
+            if (plan.tile_of_[i] < plan.transfer_.columns())
+            {
+                plan.local_volume_ += plan.transfer_(i, plan.tile_of_[i]);
+            }
+        }
+        plan.remote_volume_ = total - plan.local_volume_;
+
+        return plan;
+    }
+
+    inline retile_plan make_retile_plan(
+        blaze::DynamicMatrix<std::int64_t>&& transfer, bool optimize_placement)
+    {
+        std::vector<std::uint32_t> tile_of;
+        if (optimize_placement)
+        {
+            tile_of = assign_tiles(transfer);
+        }
+        else
+        {
+            // locality i keeps new tile i
+            tile_of.resize(transfer.rows());
+            for (std::size_t i = 0; i != tile_of.size(); ++i)
+            {
+                tile_of[i] = static_cast<std::uint32_t>(i);
+            }
+        }
+        return make_retile_plan(std::move(transfer), std::move(tile_of));
+    }
+
+    template <std::size_t N>
+    retile_plan make_retile_plan(tiling<N> const& current,
+        tiling<N> const& desired, bool optimize_placement)
+    {
+        return make_retile_plan(
+            transfer_matrix(current, desired), optimize_placement);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Suggest the cheapest common tiling for the two operands of a binary
+    // operation. The candidate tilings are the tilings of both operands
+    // (index 0: lhs, index 1: rhs) and any additionally given ones. The new
+    // tiles are assigned to the localities such that the combined volume of
+    // data to move for both operands is minimal. Ties are resolved in favor
+    // of the earlier candidate and of keeping tile i on locality i, thus all
+    // localities arrive at the same, stable decision.
+    struct common_tiling
+    {
+        std::size_t candidate_ = 0;
+        std::vector<std::uint32_t> tile_of_;
+        std::int64_t remote_volume_ = 0;
+    };
+
+    template <std::size_t N>
+    common_tiling suggest_common_tiling(tiling<N> const& lhs,
+        tiling<N> const& rhs, std::vector<tiling<N>> const& candidates = {})
+    {
+        common_tiling result;
+        result.remote_volume_ = (std::numeric_limits<std::int64_t>::max)();
+
+        auto evaluate = [&](tiling<N> const& candidate, std::size_t index) {
+            if (candidate.size() != lhs.size() || lhs.size() != rhs.size())
+            {
+                return;
+            }
+
+            blaze::DynamicMatrix<std::int64_t> transfer(
+                transfer_matrix(lhs, candidate) +
+                transfer_matrix(rhs, candidate));
+
+            retile_plan in_place = make_retile_plan(
+                blaze::DynamicMatrix<std::int64_t>(transfer), false);
+            retile_plan plan = make_retile_plan(std::move(transfer), true);
+            if (in_place.remote_volume_ <= plan.remote_volume_)
+            {
+                plan = std::move(in_place);
+            }
+
+            if (plan.remote_volume_ < result.remote_volume_)
+            {
+                result.candidate_ = index;
+                result.tile_of_ = std::move(plan.tile_of_);
+                result.remote_volume_ = plan.remote_volume_;
+            }
+        };
+
+        evaluate(lhs, 0);
+        evaluate(rhs, 1);
+        for (std::size_t i = 0; i != candidates.size(); ++i)
+        {
+            evaluate(candidates[i], i + 2);
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename T, std::size_t N>
+        struct block_type;
+
+        template <typename T>
+        struct block_type<T, 1>
+        {
+            using type = blaze::DynamicVector<T>;
+
+            template <typename Data>
+            static type extract(Data const& data, tile_spans<1> const& s)
+            {
+                return blaze::subvector(data, s[0].start_, s[0].size());
+            }
+
+            static void assign(
+                type& result, tile_spans<1> const& s, type const& block)
+            {
+                blaze::subvector(result, s[0].start_, s[0].size()) = block;
+            }
+
+            static type create(tile_spans<1> const& s)
+            {
+                return type(s[0].size());
+            }
+        };
+
+        template <typename T>
+        struct block_type<T, 2>
+        {
+            using type = blaze::DynamicMatrix<T>;
+
+            template <typename Data>
+            static type extract(Data const& data, tile_spans<2> const& s)
+            {
+                return blaze::submatrix(data, s[0].start_, s[1].start_,
+                    s[0].size(), s[1].size());
+            }
+
+            static void assign(
+                type& result, tile_spans<2> const& s, type const& block)
+            {
+                blaze::submatrix(result, s[0].start_, s[1].start_,
+                    s[0].size(), s[1].size()) = block;
+            }
+
+            static type create(tile_spans<2> const& s)
+            {
+                return type(s[0].size(), s[1].size());
+            }
+        };
+
+        template <typename T>
+        struct block_type<T, 3>
+        {
+            using type = blaze::DynamicTensor<T>;
+
+            template <typename Data>
+            static type extract(Data const& data, tile_spans<3> const& s)
+            {
+                return blaze::subtensor(data, s[0].start_, s[1].start_,
+                    s[2].start_, s[0].size(), s[1].size(), s[2].size());
+            }
+
+            static void assign(
+                type& result, tile_spans<3> const& s, type const& block)
+            {
+                blaze::subtensor(result, s[0].start_, s[1].start_,
+                    s[2].start_, s[0].size(), s[1].size(), s[2].size()) =
+                    block;
+            }
+
+            static type create(tile_spans<3> const& s)
+            {
+                return type(s[0].size(), s[1].size(), s[2].size());
+            }
+        };
+
+        // project global coordinates onto the given tile
+        template <std::size_t N>
+        tile_spans<N> project(
+            tile_spans<N> const& global, tile_spans<N> const& tile)
+        {
+            tile_spans<N> result;
+            for (std::size_t i = 0; i != N; ++i)
+            {
+                result[i] = execution_tree::tiling_span(
+                    global[i].start_ - tile[i].start_,
+                    global[i].stop_ - tile[i].start_);
+            }
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Execute the given plan by exchanging all required blocks between the
+    // participating localities in one all-to-all operation. Returns the new
+    // local tile.
+    template <typename T, std::size_t N, typename Data>
+    typename detail::block_type<T, N>::type execute_retile_plan(
+        std::string const& basename, Data const& local,
+        retile_plan const& plan, tiling<N> const& current,
+        tiling<N> const& desired, std::uint32_t loc_id,
+        std::int64_t* transferred_bytes = nullptr)
+    {
+        using block = detail::block_type<T, N>;
+        using block_data = typename block::type;
+
+        std::size_t const num_localities = current.size();
+        HPX_ASSERT(plan.tile_of_.size() == num_localities);
+
+        tile_spans<N> const& cur_tile = current[loc_id];
+        tile_spans<N> const& des_tile = desired[plan.tile_of_[loc_id]];
+
+        block_data result = block::create(des_tile);
+
+        // collect the blocks all other localities need from us
+        std::vector<block_data> to_send(num_localities);
+        for (std::size_t dest = 0; dest != num_localities; ++dest)
+        {
+            tile_spans<N> overlap;
+            if (!intersect(cur_tile, desired[plan.tile_of_[dest]], overlap))
+            {
+                continue;
+            }
+
+            if (dest == loc_id)
+            {
+                // copy the part staying local directly
+                block::assign(result, detail::project(overlap, des_tile),
+                    block::extract(local, detail::project(overlap, cur_tile)));
+            }
+            else
+            {
+                to_send[dest] =
+                    block::extract(local, detail::project(overlap, cur_tile));
+            }
+        }
+
+        if (plan.remote_volume_ == 0)
+        {
+            return result;
+        }
+
+        std::vector<block_data> received =
+            hpx::collectives::all_to_all(("retile_" + basename).c_str(),
+                std::move(to_send),
+                hpx::collectives::num_sites_arg{num_localities},
+                hpx::collectives::this_site_arg{loc_id})
+                .get();
+
+        // place all received blocks into the new tile
+        std::int64_t bytes = 0;
+        for (std::size_t src = 0; src != num_localities; ++src)
+        {
+            tile_spans<N> overlap;
+            if (src == loc_id || !intersect(current[src], des_tile, overlap))
+            {
+                continue;
+            }
+
+            block::assign(
+                result, detail::project(overlap, des_tile), received[src]);
+            bytes += volume(overlap) * sizeof(T);
+        }
+
+        if (transferred_bytes != nullptr)
+        {
+            *transferred_bytes += bytes;
+        }
+
+        return result;
+    }
+}}}
+
+#endif
@@ -0,0 +1,242 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DIST_MATRIXOPS_SAMPLE_SORT)
+#define PHYLANX_DIST_MATRIXOPS_SAMPLE_SORT
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/plugins/dist_matrixops/retile_planner.hpp>
+
+#include <hpx/collectives/all_gather.hpp>
+#include <hpx/collectives/all_to_all.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/serialization/pair.hpp>
+#include <hpx/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+// Sample sort for data distributed over all localities. Every locality sorts
+// its part of the data, all localities agree on a set of splitters derived
+// from regular samples of the locally sorted data, and the data is exchanged
+// in one all-to-all operation such that locality i ends up with all elements
+// falling between splitter i-1 and splitter i.
+namespace phylanx { namespace dist_matrixops { namespace sample_sort
+{
+    namespace detail
+    {
+        // Merge the given sorted runs in O(n log P), keeping the current
+        // head of every run in a binary heap. Elements comparing equal are
+        // taken from the runs in order.
+        template <typename E, typename Compare>
+        std::vector<E> merge_runs(
+            std::vector<std::vector<E>>& runs, Compare comp)
+        {
+            std::size_t size = 0;
+            for (auto const& run : runs)
+            {
+                size += run.size();
+            }
+
+            std::vector<E> result;
+            result.reserve(size);
+
+            // (run, position) of the heads, the smallest one on top
+            using head = std::pair<std::size_t, std::size_t>;
+            auto later = [&](head const& lhs, head const& rhs) {
+                E const& l = runs[lhs.first][lhs.second];
+                E const& r = runs[rhs.first][rhs.second];
+                if (comp(r, l))
+                {
+                    return true;
+                }
+                return !comp(l, r) && lhs.first > rhs.first;
+            };
+
+            std::vector<head> heads;
+            heads.reserve(runs.size());
+            for (std::size_t i = 0; i != runs.size(); ++i)
+            {
+                if (!runs[i].empty())
+                {
+                    heads.emplace_back(i, 0);
+                }
+            }
+            std::make_heap(heads.begin(), heads.end(), later);
+
+            while (heads.size() > 1)
+            {
+                std::pop_heap(heads.begin(), heads.end(), later);
+
+                head& top = heads.back();
+                result.push_back(std::move(runs[top.first][top.second]));
+
+                if (++top.second != runs[top.first].size())
+                {
+                    std::push_heap(heads.begin(), heads.end(), later);
+                }
+                else
+                {
+                    heads.pop_back();
+                }
+            }
+
+            // the remainder of the last run is copied as a whole
+            if (!heads.empty())
+            {
+                auto& run = runs[heads.front().first];
+                std::move(run.begin() + heads.front().second, run.end(),
+                    std::back_inserter(result));
+            }
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The returned vector is sorted, and all elements held by locality i are
+    // not larger than any of the elements held by locality i+1. Elements
+    // comparing equal always end up on the same locality.
+    template <typename E, typename Compare>
+    std::vector<E> sort(std::string const& basename, std::vector<E>&& local,
+        Compare comp, std::uint32_t num_localities, std::uint32_t loc_id)
+    {
+        hpx::parallel::sort(
+            hpx::execution::par, local.begin(), local.end(), comp);
+
+        if (num_localities == 1)
+        {
+            return std::move(local);
+        }
+
+        // select num_localities regular samples from the local data
+        std::vector<E> samples;
+        if (!local.empty())
+        {
+            samples.reserve(num_localities);
+            for (std::size_t i = 0; i != num_localities; ++i)
+            {
+                samples.push_back(
+                    local[(2 * i + 1) * local.size() / (2 * num_localities)]);
+            }
+        }
+
+        std::vector<std::vector<E>> all_samples =
+            hpx::collectives::all_gather(
+                ("sample_sort_samples_" + basename).c_str(),
+                std::move(samples),
+                hpx::collectives::num_sites_arg{num_localities},
+                hpx::collectives::this_site_arg{loc_id})
+                .get();
+
+        // all localities derive the same splitters from the gathered samples
+        std::vector<E> candidates;
+        for (auto& s : all_samples)
+        {
+            std::move(s.begin(), s.end(), std::back_inserter(candidates));
+        }
+        std::sort(candidates.begin(), candidates.end(), comp);
+
+        std::vector<E> splitters;
+        if (!candidates.empty())
+        {
+            splitters.reserve(num_localities - 1);
+            for (std::size_t i = 1; i != num_localities; ++i)
+            {
+                splitters.push_back(
+                    candidates[i * candidates.size() / num_localities]);
+            }
+        }
+
+        // partition the local data using the splitters
+        std::vector<std::vector<E>> buckets(num_localities);
+
+        auto it = local.begin();
+        for (std::size_t i = 0; i != splitters.size(); ++i)
+        {
+            auto next = std::upper_bound(it, local.end(), splitters[i], comp);
+            buckets[i].assign(
+                std::make_move_iterator(it), std::make_move_iterator(next));
+            it = next;
+        }
+        buckets[splitters.size()].assign(
+            std::make_move_iterator(it), std::make_move_iterator(local.end()));
+
+        std::vector<std::vector<E>> received =
+            hpx::collectives::all_to_all(
+                ("sample_sort_exchange_" + basename).c_str(),
+                std::move(buckets),
+                hpx::collectives::num_sites_arg{num_localities},
+                hpx::collectives::this_site_arg{loc_id})
+                .get();
+
+        // merge the sorted runs received from all localities
+        return detail::merge_runs(received, comp);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Calculate the span of the given tile if 'size' elements are distributed
+    // evenly over 'numtiles' tiles
+    inline execution_tree::tiling_span balanced_span(
+        std::uint32_t tile_idx, std::int64_t size, std::uint32_t numtiles)
+    {
+        std::int64_t const tile_size = size / numtiles;
+        std::int64_t const remainder = size % numtiles;
+
+        std::int64_t const start =
+            tile_idx * tile_size + (std::min)(std::int64_t(tile_idx), remainder);
+        return execution_tree::tiling_span(
+            start, start + tile_size + (tile_idx < remainder ? 1 : 0));
+    }
+
+    // Redistribute the (globally ordered) local parts of a vector such that
+    // all localities hold the same number of elements (+/- 1). Returns the
+    // new local part, 'span' is set to the global span it covers.
+    template <typename T>
+    blaze::DynamicVector<T> rebalance(std::string const& basename,
+        blaze::DynamicVector<T> const& local, std::uint32_t num_localities,
+        std::uint32_t loc_id, execution_tree::tiling_span& span,
+        std::int64_t* transferred_bytes = nullptr)
+    {
+        std::vector<std::int64_t> sizes = hpx::collectives::all_gather(
+            ("sample_sort_sizes_" + basename).c_str(),
+            std::int64_t(local.size()),
+            hpx::collectives::num_sites_arg{num_localities},
+            hpx::collectives::this_site_arg{loc_id})
+            .get();
+
+        std::int64_t total = 0;
+        retile_planner::tiling<1> current(num_localities);
+        for (std::uint32_t i = 0; i != num_localities; ++i)
+        {
+            current[i][0] = execution_tree::tiling_span(total, total + sizes[i]);
+            total += sizes[i];
+        }
+
+        retile_planner::tiling<1> desired(num_localities);
+        for (std::uint32_t i = 0; i != num_localities; ++i)
+        {
+            desired[i][0] = balanced_span(i, total, num_localities);
+        }
+
+        span = desired[loc_id][0];
+
+        retile_planner::retile_plan plan =
+            retile_planner::make_retile_plan(current, desired, false);
+
+        return retile_planner::execute_retile_plan<T, 1>(
+            "sample_sort_" + basename, local, plan, current, desired, loc_id,
+            transferred_bytes);
+    }
+}}}
+
+#endif
@@ -88,6 +88,84 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         return std::move(std::make_tuple(matrix_array, n_rows, n_cols));
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // read the data from the given file in chunks of rows, this allows to
+    // process files which do not fit into memory
+    class csv_chunk_reader
+    {
+    public:
+        explicit csv_chunk_reader(std::string filename)
+          : filename_(std::move(filename))
+          , infile_(filename_)
+        {
+            if (!infile_.is_open())
+            {
+                throw std::runtime_error(util::generate_error_message(
+                    "couldn't open file: " + filename_));
+            }
+        }
+
+        // read at most max_rows rows, returns the number of rows read (zero
+        // if the end of the file was reached)
+        std::size_t read(std::size_t max_rows, std::vector<double>& data)
+        {
+            data.clear();
+
+            std::string line;
+            std::vector<double> current_line;
+            std::size_t rows = 0;
+            while (rows != max_rows && std::getline(infile_, line))
+            {
+                auto begin_local = line.begin();
+                if (!boost::spirit::qi::parse(begin_local, line.end(),
+                        boost::spirit::qi::double_ % ',', current_line))
+                {
+                    throw std::runtime_error(
+                        util::generate_error_message("wrong data format " +
+                            filename_ + ':' + std::to_string(n_rows_)));
+                }
+
+                // skip the header
+                if (begin_local == line.end() || header_parsed_)
+                {
+                    header_parsed_ = true;
+
+                    if (n_rows_ == 0)
+                    {
+                        n_cols_ = current_line.size();
+                    }
+                    else if (n_cols_ != current_line.size())
+                    {
+                        throw std::runtime_error(util::generate_error_message(
+                            "wrong data format, different number of element "
+                            "in this row " +
+                            filename_ + ':' + std::to_string(n_rows_)));
+                    }
+
+                    data.insert(
+                        data.end(), current_line.begin(), current_line.end());
+                    ++n_rows_;
+                    ++rows;
+                }
+                current_line.clear();
+            }
+            return rows;
+        }
+
+        // number of columns, known after the first row was read
+        std::size_t columns() const
+        {
+            return n_cols_;
+        }
+
+    private:
+        std::string filename_;
+        std::ifstream infile_;
+        bool header_parsed_ = false;
+        std::size_t n_rows_ = 0;
+        std::size_t n_cols_ = 0;
+    };
 }}}
 
 #endif
@@ -49,18 +49,9 @@ namespace phylanx { namespace execution_tree { namespace primitives {
 
     private:
         primitive_argument_type avg_pool2d(ir::node_data<double>&& arg,
-            std::size_t filter_height, std::size_t filter_width) const;
-
-        primitive_argument_type avg_pool2d(ir::node_data<double>&& arg,
-            std::size_t filter_height, std::size_t filter_width,
-            std::size_t stride_height, std::size_t stride_width) const;
-
-        primitive_argument_type avg_pool2d_same(ir::node_data<double>&& arg,
-            std::size_t filter_height, std::size_t filter_width) const;
-
-        primitive_argument_type avg_pool2d_same(ir::node_data<double>&& arg,
             std::size_t filter_height, std::size_t filter_width,
-            std::size_t stride_height, std::size_t stride_width) const;
+            std::size_t stride_height, std::size_t stride_width,
+            bool same) const;
 
         primitive_argument_type avg_pool_any_pad(ir::node_data<double>&& arg,
             std::size_t filter_height, std::size_t filter_width,
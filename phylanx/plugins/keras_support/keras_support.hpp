@@ -26,6 +26,7 @@
 #include <phylanx/plugins/keras_support/resize_operation.hpp>
 #include <phylanx/plugins/keras_support/separable_conv1d_operation.hpp>
 #include <phylanx/plugins/keras_support/sigmoid_operation.hpp>
+#include <phylanx/plugins/keras_support/softmax_cross_entropy_operation.hpp>
 #include <phylanx/plugins/keras_support/softmax_operation.hpp>
 #include <phylanx/plugins/keras_support/softplus_operation.hpp>
 #include <phylanx/plugins/keras_support/softsign_operation.hpp>
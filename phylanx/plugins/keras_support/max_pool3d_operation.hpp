@@ -50,22 +50,10 @@ namespace phylanx { namespace execution_tree { namespace primitives {
 
     private:
         primitive_argument_type max_pool3d(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width) const;
-
-        primitive_argument_type max_pool3d(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width, std::size_t stride_depth,
-            std::size_t stride_height, std::size_t stride_width) const;
-
-        primitive_argument_type max_pool3d_same(ir::node_data<double>&& arg,
-            std::size_t filter_depth, std::size_t filter_height,
-            std::size_t filter_width) const;
-
-        primitive_argument_type max_pool3d_same(ir::node_data<double>&& arg,
             std::size_t filter_depth, std::size_t filter_height,
             std::size_t filter_width, std::size_t stride_depth,
-            std::size_t stride_height, std::size_t stride_width) const;
+            std::size_t stride_height, std::size_t stride_width,
+            bool same) const;
 
         primitive_argument_type max_pool_any_pad(ir::node_data<double>&& arg,
             std::size_t filter_depth, std::size_t filter_height,
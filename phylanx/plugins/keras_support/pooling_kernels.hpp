@@ -0,0 +1,353 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_KERAS_SUPPORT_POOLING_KERNELS)
+#define PHYLANX_KERAS_SUPPORT_POOLING_KERNELS
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Max and average pooling over the spatial axes of an array whose elements
+// are addressed as (outer, x_0, ..., x_{N-1}, channel). Windows are boxes, so
+// the pooling is done one axis at a time, starting with the innermost one:
+// the partial results of a window along one axis are shared by all windows
+// of the other axes that overlap it, which avoids recomputing the
+// overlapping parts of neighboring windows whenever the strides are smaller
+// than the pool size. A block of neighboring channels is processed together,
+// which keeps the innermost loops contiguous and allows the compiler to
+// vectorize them. The blocks of all batches are processed in parallel, if
+// there are not enough of those the outputs are additionally split into
+// bands along the outermost spatial axis.
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    // number of neighboring channels processed together
+    constexpr std::size_t pool_channel_block_size = 64;
+
+    // minimal number of input elements for which the work is done in
+    // parallel
+    constexpr std::size_t pool_parallel_threshold = 65536;
+
+    // number of tasks to aim for when splitting the outputs into bands
+    constexpr std::size_t pool_min_tasks = 64;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The window of one output position along one axis, clipped to the
+    // elements of the input.
+    struct pool_window
+    {
+        std::size_t begin;
+        std::size_t size;
+    };
+
+    // Computes the windows along an axis with the given number of elements,
+    // for `same` padding the input is padded such that every element is
+    // covered if the stride is smaller than the pool size (as done by
+    // Keras), the padded elements are ignored.
+    inline std::vector<pool_window> make_pool_windows(std::size_t size,
+        std::size_t pool_size, std::size_t stride, bool same)
+    {
+        std::size_t pad = 0;
+        if (same)
+        {
+            std::size_t const covered =
+                size % stride == 0 ? stride : size % stride;
+            pad = pool_size > covered ? pool_size - covered : 0;
+        }
+
+        std::size_t const count = (size + pad - pool_size) / stride + 1;
+        std::int64_t const pad_before = std::int64_t(pad / 2);
+
+        std::vector<pool_window> windows(count);
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            std::int64_t const first = std::int64_t(i * stride) - pad_before;
+            std::int64_t const last = (std::min)(
+                first + std::int64_t(pool_size), std::int64_t(size));
+            std::int64_t const begin = (std::max)(first, std::int64_t(0));
+
+            windows[i].begin = std::size_t(begin);
+            windows[i].size = std::size_t((std::max)(last - begin,
+                std::int64_t(0)));
+        }
+        return windows;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An array with N spatial axes, the element (o, x_0, ..., x_{N-1}, c)
+    // is located at o * outer_stride + sum(x_i * strides[i]) +
+    // c * channel_stride.
+    template <std::size_t N>
+    struct pool_layout
+    {
+        std::size_t outer;
+        std::size_t channels;
+        std::array<std::size_t, N> extents;
+        std::size_t outer_stride;
+        std::array<std::size_t, N> strides;
+        std::size_t channel_stride;
+    };
+
+    struct pool_max
+    {
+        template <typename T>
+        static T init()
+        {
+            return std::numeric_limits<T>::lowest();
+        }
+
+        template <typename T>
+        static T combine(T lhs, T rhs)
+        {
+            return lhs < rhs ? rhs : lhs;
+        }
+
+        template <typename T>
+        static T finalize(T value, std::size_t)
+        {
+            return value;
+        }
+    };
+
+    // the average over the elements of the input covered by a window
+    struct pool_avg
+    {
+        template <typename T>
+        static T init()
+        {
+            return T(0);
+        }
+
+        template <typename T>
+        static T combine(T lhs, T rhs)
+        {
+            return lhs + rhs;
+        }
+
+        template <typename T>
+        static T finalize(T value, std::size_t count)
+        {
+            return value / T(count);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Pools the middle axis of a dense buffer viewed as prefix x size x
+    // suffix elements into the given outputs [first, last) of that axis,
+    // the windows are shifted by offset.
+    template <typename Op, typename T>
+    void pool_dense_axis(T const* src, std::size_t prefix, std::size_t size,
+        std::size_t suffix, std::vector<pool_window> const& windows,
+        std::size_t first, std::size_t last, std::size_t offset, T* dst)
+    {
+        std::size_t const count = last - first;
+        for (std::size_t p = 0; p != prefix; ++p)
+        {
+            T const* s = src + p * size * suffix;
+            for (std::size_t y = 0; y != count; ++y)
+            {
+                T* d = dst + (p * count + y) * suffix;
+                std::fill_n(d, suffix, Op::template init<T>());
+
+                pool_window const& w = windows[first + y];
+                for (std::size_t x = 0; x != w.size; ++x)
+                {
+                    T const* s_x = s + (w.begin + x - offset) * suffix;
+                    for (std::size_t j = 0; j != suffix; ++j)
+                    {
+                        d[j] = Op::combine(d[j], s_x[j]);
+                    }
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // dst = pool(src), where the number of outputs along every spatial axis
+    // is given by the number of windows for that axis, the extents of the
+    // output layout are ignored
+    template <typename Op, typename T, std::size_t N>
+    void pool(T const* src, pool_layout<N> const& in, T* dst,
+        pool_layout<N> const& out,
+        std::array<std::vector<pool_window>, N> const& windows)
+    {
+        static_assert(N != 0, "pooling requires at least one spatial axis");
+
+        std::size_t input_size = in.outer * in.channels;
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            if (windows[i].empty())
+            {
+                return;
+            }
+            input_size *= in.extents[i];
+        }
+        if (input_size == 0)
+        {
+            return;
+        }
+
+        constexpr std::size_t block_size = pool_channel_block_size;
+        std::size_t const blocks =
+            (in.channels + block_size - 1) / block_size;
+        std::size_t const tiles = in.outer * blocks;
+
+        // split the outputs along the outermost axis if there are not
+        // enough tiles to keep the cores busy
+        bool const parallel = input_size >= pool_parallel_threshold;
+        std::size_t const outputs = windows[0].size();
+        std::size_t bands = 1;
+        if (parallel && tiles < pool_min_tasks)
+        {
+            bands = (std::min)(
+                outputs, (pool_min_tasks + tiles - 1) / tiles);
+        }
+        std::size_t const band_size = (outputs + bands - 1) / bands;
+        bands = (outputs + band_size - 1) / band_size;
+
+        auto task = [&](std::size_t t) {
+            std::size_t const band = t % bands;
+            std::size_t const tile = t / bands;
+            std::size_t const outer = tile / blocks;
+            std::size_t const c0 = (tile % blocks) * block_size;
+            std::size_t const cb = (std::min)(block_size, in.channels - c0);
+
+            // the outputs of this band and the input elements they cover
+            // along the outermost axis
+            std::size_t const first = band * band_size;
+            std::size_t const last = (std::min)(outputs, first + band_size);
+            std::size_t const x_first = windows[0][first].begin;
+            std::size_t const x_last =
+                windows[0][last - 1].begin + windows[0][last - 1].size;
+
+            std::array<std::size_t, N> shape = in.extents;
+            shape[0] = x_last - x_first;
+
+            // pool the innermost axis straight from the input
+            std::size_t prefix = 1;
+            for (std::size_t i = 0; i + 1 < N; ++i)
+            {
+                prefix *= shape[i];
+            }
+
+            std::vector<pool_window> const& inner = windows[N - 1];
+            std::size_t const inner_count = inner.size();
+
+            std::vector<T> current(prefix * inner_count * cb);
+            for (std::size_t p = 0; p != prefix; ++p)
+            {
+                std::size_t offset = outer * in.outer_stride +
+                    c0 * in.channel_stride;
+                for (std::size_t i = N - 1, rest = p; i-- != 0; /**/)
+                {
+                    std::size_t const x = rest % shape[i];
+                    rest /= shape[i];
+                    offset += (i == 0 ? x + x_first : x) * in.strides[i];
+                }
+
+                T const* s = src + offset;
+                for (std::size_t y = 0; y != inner_count; ++y)
+                {
+                    T* d = current.data() + (p * inner_count + y) * cb;
+                    std::fill_n(d, cb, Op::template init<T>());
+
+                    pool_window const& w = inner[y];
+                    for (std::size_t x = 0; x != w.size; ++x)
+                    {
+                        T const* s_x =
+                            s + (w.begin + x) * in.strides[N - 1];
+                        for (std::size_t j = 0; j != cb; ++j)
+                        {
+                            d[j] = Op::combine(
+                                d[j], s_x[j * in.channel_stride]);
+                        }
+                    }
+                }
+            }
+            shape[N - 1] = inner_count;
+
+            // pool the remaining axes, the innermost loops run over all
+            // elements of the inner axes of the buffer
+            std::vector<T> next;
+            for (std::size_t i = N - 1; i-- != 0; /**/)
+            {
+                std::size_t pre = 1;
+                for (std::size_t k = 0; k != i; ++k)
+                {
+                    pre *= shape[k];
+                }
+                std::size_t suffix = cb;
+                for (std::size_t k = i + 1; k != N; ++k)
+                {
+                    suffix *= shape[k];
+                }
+
+                std::size_t const y_first = i == 0 ? first : 0;
+                std::size_t const y_last = i == 0 ? last : windows[i].size();
+
+                next.resize(pre * (y_last - y_first) * suffix);
+                pool_dense_axis<Op>(current.data(), pre, shape[i], suffix,
+                    windows[i], y_first, y_last, i == 0 ? x_first : 0,
+                    next.data());
+
+                shape[i] = y_last - y_first;
+                current.swap(next);
+            }
+
+            // write the results of this band, an output position covers
+            // the product of the sizes of its windows
+            std::size_t positions = 1;
+            for (std::size_t i = 0; i != N; ++i)
+            {
+                positions *= shape[i];
+            }
+
+            for (std::size_t p = 0; p != positions; ++p)
+            {
+                std::size_t offset = outer * out.outer_stride +
+                    c0 * out.channel_stride;
+                std::size_t count = 1;
+                for (std::size_t i = N, rest = p; i-- != 0; /**/)
+                {
+                    std::size_t const y =
+                        (rest % shape[i]) + (i == 0 ? first : 0);
+                    rest /= shape[i];
+                    offset += y * out.strides[i];
+                    count *= windows[i][y].size;
+                }
+
+                T const* s = current.data() + p * cb;
+                T* d = dst + offset;
+                for (std::size_t j = 0; j != cb; ++j)
+                {
+                    d[j * out.channel_stride] = Op::finalize(s[j], count);
+                }
+            }
+        };
+
+        std::size_t const count = tiles * bands;
+        if (parallel && count > 1)
+        {
+            hpx::for_loop(hpx::execution::par, std::size_t(0), count, task);
+        }
+        else
+        {
+            for (std::size_t t = 0; t != count; ++t)
+            {
+                task(t);
+            }
+        }
+    }
+}}}}
+
+#endif
@@ -0,0 +1,66 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_KERAS_SUPPORT_SOFTMAX_CROSS_ENTROPY_OPERATION)
+#define PHYLANX_PLUGINS_KERAS_SUPPORT_SOFTMAX_CROSS_ENTROPY_OPERATION
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/futures/future.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx {  namespace execution_tree {  namespace primitives  {
+/// \brief Returns the cross entropy between the labels and the softmax of the
+///        logits along the given axis, together with the gradient of the
+///        loss with respect to the logits. The softmax is never formed.
+///
+/// \param labels The labels, an array of the same shape as the logits
+/// \param logits The unscaled log probabilities
+/// \param axis   Optional. The default is the last axis (axis == -1)
+
+    class softmax_cross_entropy_operation
+        : public primitive_component_base
+        , public std::enable_shared_from_this<softmax_cross_entropy_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+        using val_type = double;
+        using arg_type = ir::node_data<val_type>;
+
+    public:
+        static match_pattern_type const match_data;
+
+        softmax_cross_entropy_operation() = default;
+
+        softmax_cross_entropy_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        primitive_argument_type softmax_cross_entropy(arg_type&& labels,
+            arg_type&& logits, std::int64_t axis) const;
+    };
+
+    inline primitive create_softmax_cross_entropy_operation(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(locality,
+            "softmax_cross_entropy_with_logits", std::move(operands), name,
+            codename);
+    }
+}}}
+
+#endif
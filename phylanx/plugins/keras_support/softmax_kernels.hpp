@@ -0,0 +1,311 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_KERAS_SUPPORT_SOFTMAX_KERNELS)
+#define PHYLANX_KERAS_SUPPORT_SOFTMAX_KERNELS
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// Numerically stable softmax, log-softmax, and softmax cross entropy along
+// an arbitrary axis of an array with up to four dimensions. The maximum and
+// the sum of the exponentials of every lane are computed in a single pass
+// (online softmax: the sum is rescaled whenever a new maximum is found), a
+// second pass writes the results. Neighboring lanes whose elements are
+// contiguous are processed together, which allows the compiler to vectorize
+// the inner loops, and independent lanes are processed in parallel.
+namespace phylanx { namespace execution_tree { namespace primitives {
+namespace detail
+{
+    // number of neighboring lanes processed together
+    constexpr std::size_t softmax_lane_block_size = 256;
+
+    // minimal number of elements for which the work is done in parallel
+    constexpr std::size_t softmax_parallel_threshold = 65536;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // An array viewed as outer0 x outer1 x length x inner elements, where
+    // the softmax is computed along length. The element (o0, o1, k, i) is
+    // located at o0 * strides[0] + o1 * strides[1] + k * strides[2] +
+    // i * strides[3]. The lanes are numbered such that the results of a
+    // reduction along the axis are stored in row major order.
+    struct softmax_layout
+    {
+        std::size_t lanes() const
+        {
+            return dims[0] * dims[1] * dims[3];
+        }
+
+        std::size_t size() const
+        {
+            return lanes() * dims[2];
+        }
+
+        std::array<std::size_t, 4> dims;
+        std::array<std::size_t, 4> strides;
+    };
+
+    // layout of a row major array with the given extents (of which the
+    // first num_dims are used) and rows padded to the given spacing, the
+    // axis has to be in [0, num_dims)
+    inline softmax_layout make_softmax_layout(std::size_t num_dims,
+        std::array<std::size_t, 4> const& extents, std::size_t spacing,
+        std::size_t axis)
+    {
+        std::array<std::size_t, 4> strides = {0, 0, 0, 0};
+        if (num_dims != 0)
+        {
+            strides[num_dims - 1] = 1;
+        }
+        if (num_dims > 1)
+        {
+            strides[num_dims - 2] = spacing;
+            for (std::size_t j = num_dims - 2; j-- != 0; /**/)
+            {
+                strides[j] = strides[j + 1] * extents[j + 1];
+            }
+        }
+
+        auto product = [&](std::size_t first, std::size_t last) {
+            std::size_t result = 1;
+            for (std::size_t j = first; j < last; ++j)
+            {
+                result *= extents[j];
+            }
+            return result;
+        };
+
+        softmax_layout layout;
+        if (axis == num_dims - 1)
+        {
+            // the leading axes are equally spaced
+            layout.dims = {product(0, axis), 1, extents[axis], 1};
+            layout.strides = {spacing, 0, 1, 0};
+            return layout;
+        }
+
+        // the axes before the reduction axis, and the axes between the
+        // reduction axis and the innermost one are equally spaced
+        layout.dims = {product(0, axis), product(axis + 1, num_dims - 1),
+            extents[axis], extents[num_dims - 1]};
+        layout.strides = {axis != 0 ? strides[axis - 1] : 0, spacing,
+            strides[axis], 1};
+        return layout;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Calls f(lane, first, last) for blocks of neighboring lanes, where lane
+    // identifies the lanes (o0, o1, i) with i in [first, last) as
+    // lane + i.
+    template <typename F>
+    void softmax_for_each_block(softmax_layout const& layout, F&& f)
+    {
+        constexpr std::size_t block_size = softmax_lane_block_size;
+
+        std::size_t const inner = layout.dims[3];
+        std::size_t const blocks = (inner + block_size - 1) / block_size;
+        std::size_t const count = layout.dims[0] * layout.dims[1] * blocks;
+
+        auto block = [&](std::size_t task) {
+            std::size_t const outer = task / blocks;
+            std::size_t const first = (task % blocks) * block_size;
+            f(outer * inner, first, (std::min)(inner, first + block_size));
+        };
+
+        if (layout.size() >= softmax_parallel_threshold && count > 1)
+        {
+            hpx::for_loop(
+                hpx::execution::par, std::size_t(0), count, block);
+        }
+        else
+        {
+            for (std::size_t task = 0; task != count; ++task)
+            {
+                block(task);
+            }
+        }
+    }
+
+    // offset of the first element of the lanes identified by lane
+    inline std::size_t softmax_offset(
+        softmax_layout const& layout, std::size_t lane)
+    {
+        std::size_t const outer = lane / layout.dims[3];
+        return (outer / layout.dims[1]) * layout.strides[0] +
+            (outer % layout.dims[1]) * layout.strides[1];
+    }
+
+    // running maximum and sum of exponentials of a block of lanes
+    template <typename T>
+    struct softmax_state
+    {
+        void init(std::size_t size)
+        {
+            std::fill_n(max.begin(), size, std::numeric_limits<T>::lowest());
+            std::fill_n(sum.begin(), size, T(0));
+        }
+
+        void update(std::size_t j, T value)
+        {
+            if (value > max[j])
+            {
+                sum[j] = sum[j] * std::exp(max[j] - value) + T(1);
+                max[j] = value;
+            }
+            else
+            {
+                sum[j] += std::exp(value - max[j]);
+            }
+        }
+
+        std::array<T, softmax_lane_block_size> max;
+        std::array<T, softmax_lane_block_size> sum;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // dst = softmax(src) or dst = log(softmax(src)) along the axis described
+    // by the layouts, src and dst may be the same
+    template <typename T>
+    void softmax(T const* src, softmax_layout const& in, T* dst,
+        softmax_layout const& out, bool log_softmax)
+    {
+        std::size_t const length = in.dims[2];
+
+        softmax_for_each_block(in, [&](std::size_t lane, std::size_t first,
+                                       std::size_t last) {
+            std::size_t const size = last - first;
+            T const* x = src + softmax_offset(in, lane) + first * in.strides[3];
+            T* y = dst + softmax_offset(out, lane) + first * out.strides[3];
+
+            softmax_state<T> state;
+            state.init(size);
+            for (std::size_t k = 0; k != length; ++k)
+            {
+                T const* x_k = x + k * in.strides[2];
+                for (std::size_t j = 0; j != size; ++j)
+                {
+                    state.update(j, x_k[j * in.strides[3]]);
+                }
+            }
+
+            if (log_softmax)
+            {
+                for (std::size_t j = 0; j != size; ++j)
+                {
+                    state.max[j] += std::log(state.sum[j]);
+                }
+                for (std::size_t k = 0; k != length; ++k)
+                {
+                    T const* x_k = x + k * in.strides[2];
+                    T* y_k = y + k * out.strides[2];
+                    for (std::size_t j = 0; j != size; ++j)
+                    {
+                        y_k[j * out.strides[3]] =
+                            x_k[j * in.strides[3]] - state.max[j];
+                    }
+                }
+                return;
+            }
+
+            for (std::size_t j = 0; j != size; ++j)
+            {
+                state.sum[j] = T(1) / state.sum[j];
+            }
+            for (std::size_t k = 0; k != length; ++k)
+            {
+                T const* x_k = x + k * in.strides[2];
+                T* y_k = y + k * out.strides[2];
+                for (std::size_t j = 0; j != size; ++j)
+                {
+                    y_k[j * out.strides[3]] =
+                        std::exp(x_k[j * in.strides[3]] - state.max[j]) *
+                        state.sum[j];
+                }
+            }
+        });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Cross entropy between the given labels and the softmax of the logits
+    // along the axis described by the layouts. For every lane
+    //
+    //      loss = -sum(labels * log(softmax(logits)))
+    //           = logsumexp(logits) * sum(labels) - sum(labels * logits)
+    //
+    // is stored in loss (in row major order), the gradient of the loss with
+    // respect to the logits, softmax(logits) * sum(labels) - labels, is
+    // stored in gradient. The probabilities are never stored.
+    template <typename T>
+    void softmax_cross_entropy(T const* labels, softmax_layout const& l,
+        T const* logits, softmax_layout const& in, T* loss, T* gradient,
+        softmax_layout const& out)
+    {
+        std::size_t const length = in.dims[2];
+
+        softmax_for_each_block(in, [&](std::size_t lane, std::size_t first,
+                                       std::size_t last) {
+            std::size_t const size = last - first;
+            T const* t =
+                labels + softmax_offset(l, lane) + first * l.strides[3];
+            T const* x =
+                logits + softmax_offset(in, lane) + first * in.strides[3];
+            T* g =
+                gradient + softmax_offset(out, lane) + first * out.strides[3];
+
+            softmax_state<T> state;
+            state.init(size);
+
+            std::array<T, softmax_lane_block_size> label_sum;
+            std::array<T, softmax_lane_block_size> weighted_sum;
+            std::fill_n(label_sum.begin(), size, T(0));
+            std::fill_n(weighted_sum.begin(), size, T(0));
+
+            for (std::size_t k = 0; k != length; ++k)
+            {
+                T const* t_k = t + k * l.strides[2];
+                T const* x_k = x + k * in.strides[2];
+                for (std::size_t j = 0; j != size; ++j)
+                {
+                    T const label = t_k[j * l.strides[3]];
+                    T const value = x_k[j * in.strides[3]];
+                    state.update(j, value);
+                    label_sum[j] += label;
+                    weighted_sum[j] += label * value;
+                }
+            }
+
+            for (std::size_t j = 0; j != size; ++j)
+            {
+                loss[lane + first + j] =
+                    (state.max[j] + std::log(state.sum[j])) * label_sum[j] -
+                    weighted_sum[j];
+                state.sum[j] = label_sum[j] / state.sum[j];
+            }
+
+            for (std::size_t k = 0; k != length; ++k)
+            {
+                T const* t_k = t + k * l.strides[2];
+                T const* x_k = x + k * in.strides[2];
+                T* g_k = g + k * out.strides[2];
+                for (std::size_t j = 0; j != size; ++j)
+                {
+                    g_k[j * out.strides[3]] =
+                        std::exp(x_k[j * in.strides[3]] - state.max[j]) *
+                            state.sum[j] -
+                        t_k[j * l.strides[3]];
+                }
+            }
+        });
+    }
+}}}}
+
+#endif
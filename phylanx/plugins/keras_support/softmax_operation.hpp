@@ -24,7 +24,7 @@ namespace phylanx {  namespace execution_tree {  namespace primitives  {
 /// \brief Returns an array of the same shape which is the normalized exponential
 ///        function of the given array.  The resulting array consists of real
 ///        values in the range (0..1], which add up to 1 in direction of the
-///        given axis
+///        given axis (softmax), or the logarithm thereof (log_softmax)
 ///
 /// \param a      The scalar, vector, or matrix to perform softmax over
 /// \param axis   Optional. The default is the last axis (axis == -1). Effective
@@ -43,7 +43,7 @@ namespace phylanx {  namespace execution_tree {  namespace primitives  {
         using arg_type = ir::node_data<val_type>;
 
     public:
-        static match_pattern_type const match_data;
+        static match_pattern_type const match_data[2];
 
         softmax_operation() = default;
 
@@ -52,25 +52,10 @@ namespace phylanx {  namespace execution_tree {  namespace primitives  {
 
     private:
         primitive_argument_type softmax0d() const;
-        primitive_argument_type softmax1d(arg_type&& arg) const;
-
-        primitive_argument_type softmax2d(
-            arg_type&& arg, std::int64_t axis) const;
-        primitive_argument_type softmax2d_axis0(arg_type&& arg) const;
-        primitive_argument_type softmax2d_axis1(arg_type&& arg) const;
-
-        primitive_argument_type softmax3d_axis0(arg_type&& arg) const;
-        primitive_argument_type softmax3d_axis1(arg_type&& arg) const;
-        primitive_argument_type softmax3d_axis2(arg_type&& arg) const;
-        primitive_argument_type softmax3d(
+        primitive_argument_type softmaxnd(
             arg_type&& arg, std::int64_t axis) const;
 
-        primitive_argument_type softmax4d_axis0(arg_type&& arg) const;
-        primitive_argument_type softmax4d_axis1(arg_type&& arg) const;
-        primitive_argument_type softmax4d_axis2(arg_type&& arg) const;
-        primitive_argument_type softmax4d_axis3(arg_type&& arg) const;
-        primitive_argument_type softmax4d(
-            arg_type&& arg, std::int64_t axis) const;
+        bool log_softmax_ = false;
     };
 
     inline primitive create_softmax_operation(hpx::id_type const& locality,
@@ -80,6 +65,14 @@ namespace phylanx {  namespace execution_tree {  namespace primitives  {
         return create_primitive_component(
             locality, "softmax", std::move(operands), name, codename);
     }
+
+    inline primitive create_log_softmax_operation(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "log_softmax", std::move(operands), name, codename);
+    }
 }}}
 
 #endif
@@ -13,6 +13,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/dot_operation.hpp>
 #include <phylanx/plugins/common/dot_operation_nd.hpp>
+#include <phylanx/util/batched_gemm.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -334,12 +335,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "the operands have incompatible number of dimensions"));
         }
 
+        auto v = lhs.vector();
         auto t = rhs.tensor();
         blaze::DynamicMatrix<T> result(t.rows(), t.columns());
 
-        for (std::size_t i = 0; i != t.rows(); ++i)
-            blaze::row(blaze::submatrix(result, i, 0, 1, t.columns()), 0) =
-                blaze::trans(blaze::rowslice(t, i) * (lhs.vector()));
+        // row i of the result is the vector times t(:, i, :)
+        util::batched_gemm<T>(t.rows(), 1, t.columns(), t.pages(),
+            {v.data(), 0, 0, 1},
+            {t.data(), t.spacing(), t.rows() * t.spacing(), 1},
+            {result.data(), result.spacing(), 0, 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -361,10 +365,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(m.columns(), t.rows(), t.columns());
 
-        for (std::size_t i = 0; i != t.rows(); ++i)
-            blaze::rowslice(
-                blaze::subtensor(result, 0, i, 0, m.columns(), 1, t.columns()),
-                0) = blaze::rowslice(t, i) * m;
+        // result(:, i, :) is trans(m) times t(:, i, :)
+        util::batched_gemm<T>(t.rows(), m.columns(), t.columns(), m.rows(),
+            {m.data(), 0, 1, m.spacing()},
+            {t.data(), t.spacing(), t.rows() * t.spacing(), 1},
+            {result.data(), result.spacing(),
+                result.rows() * result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -386,10 +392,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(m.columns(), t.pages(), t.columns());
 
-        for (std::size_t i = 0; i != t.columns(); ++i)
-            blaze::columnslice(
-                blaze::subtensor(result, 0, 0, i, m.columns(), t.pages(), 1),
-                0) = blaze::trans(blaze::columnslice(t, i) * m);
+        // result(:, i, :) is trans(m) times page i of t
+        util::batched_gemm<T>(t.pages(), m.columns(), t.columns(), m.rows(),
+            {m.data(), 0, 1, m.spacing()},
+            {t.data(), t.rows() * t.spacing(), t.spacing(), 1},
+            {result.data(), result.spacing(),
+                result.rows() * result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -411,10 +419,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(m.columns(), t.pages(), t.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::rowslice(
-                blaze::subtensor(result, 0, i, 0, m.columns(), 1, t.rows()),
-                0) = blaze::pageslice(t, i) * m;
+        // result(:, i, :) is trans(m) times the transposed page i of t
+        util::batched_gemm<T>(t.pages(), m.columns(), t.rows(), m.rows(),
+            {m.data(), 0, 1, m.spacing()},
+            {t.data(), t.rows() * t.spacing(), 1, t.spacing()},
+            {result.data(), result.spacing(),
+                result.rows() * result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -436,10 +446,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(m.rows(), t.rows(), t.columns());
 
-        for (std::size_t i = 0; i != t.columns(); ++i)
-            blaze::columnslice(
-                blaze::subtensor(result, 0, 0, i, m.rows(), t.rows(), 1), 0) =
-                m * blaze::columnslice(t, i);
+        // result(:, i, :) is m times t(:, i, :)
+        util::batched_gemm<T>(t.rows(), m.rows(), t.columns(), m.columns(),
+            {m.data(), 0, m.spacing(), 1},
+            {t.data(), t.spacing(), t.rows() * t.spacing(), 1},
+            {result.data(), result.spacing(),
+                result.rows() * result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -461,10 +473,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(m.rows(), t.pages(), t.rows());
 
-        for (std::size_t i = 0; i != t.rows(); ++i)
-            blaze::columnslice(
-                blaze::subtensor(result, 0, 0, i, m.rows(), t.pages(), 1), 0) =
-                m * blaze::rowslice(t, i);
+        // result(:, i, :) is m times the transposed page i of t
+        util::batched_gemm<T>(t.pages(), m.rows(), t.rows(), m.columns(),
+            {m.data(), 0, m.spacing(), 1},
+            {t.data(), t.rows() * t.spacing(), 1, t.spacing()},
+            {result.data(), result.spacing(),
+                result.rows() * result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -486,10 +500,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t.rows(), t.columns(), m.columns());
 
-        for (std::size_t i = 0; i != t.rows(); ++i)
-            blaze::pageslice(
-                blaze::subtensor(result, i, 0, 0, 1, t.columns(), m.columns()),
-                0) = blaze::rowslice(t, i) * m;
+        // page i of the result is trans(t(:, i, :)) times m
+        util::batched_gemm<T>(t.rows(), t.columns(), m.columns(), t.pages(),
+            {t.data(), t.spacing(), 1, t.rows() * t.spacing()},
+            {m.data(), 0, m.spacing(), 1},
+            {result.data(), result.rows() * result.spacing(),
+                result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -511,10 +527,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t.rows(), t.columns(), m.rows());
 
-        for (std::size_t i = 0; i != t.columns(); ++i)
-            blaze::rowslice(
-                blaze::subtensor(result, 0, i, 0, t.rows(), 1, m.rows()), 0) =
-                m * blaze::columnslice(t, i);
+        // page i of the result is trans(t(:, i, :)) times trans(m)
+        util::batched_gemm<T>(t.rows(), t.columns(), m.rows(), t.pages(),
+            {t.data(), t.spacing(), 1, t.rows() * t.spacing()},
+            {m.data(), 0, 1, m.spacing()},
+            {result.data(), result.rows() * result.spacing(),
+                result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -536,10 +554,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t.pages(), t.columns(), m.columns());
 
-        for (std::size_t i = 0; i != t.columns(); ++i)
-            blaze::rowslice(
-                blaze::subtensor(result, 0, i, 0, t.pages(), 1, m.columns()),
-                0) = blaze::trans(blaze::columnslice(t, i) * m);
+        // page i of the result is the transposed page i of t times m
+        util::batched_gemm<T>(t.pages(), t.columns(), m.columns(), t.rows(),
+            {t.data(), t.rows() * t.spacing(), 1, t.spacing()},
+            {m.data(), 0, m.spacing(), 1},
+            {result.data(), result.rows() * result.spacing(),
+                result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -561,10 +581,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t.pages(), t.columns(), m.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::pageslice(
-                blaze::subtensor(result, i, 0, 0, 1, t.columns(), m.rows()),
-                0) = blaze::trans(m * blaze::pageslice(t, i));
+        // page i of the result is the transposed page i of t times trans(m)
+        util::batched_gemm<T>(t.pages(), t.columns(), m.rows(), t.rows(),
+            {t.data(), t.rows() * t.spacing(), 1, t.spacing()},
+            {m.data(), 0, 1, m.spacing()},
+            {result.data(), result.rows() * result.spacing(),
+                result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -586,10 +608,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), m.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::pageslice(
-                blaze::subtensor(result, i, 0, 0, 1, t.rows(), m.rows()), 0) =
-                blaze::pageslice(t, i) * blaze::trans(m);
+        // page i of the result is page i of t times trans(m)
+        util::batched_gemm<T>(t.pages(), t.rows(), m.rows(), t.columns(),
+            {t.data(), t.rows() * t.spacing(), t.spacing(), 1},
+            {m.data(), 0, 1, m.spacing()},
+            {result.data(), result.rows() * result.spacing(),
+                result.spacing(), 1});
 
         return primitive_argument_type{std::move(result)};
     }
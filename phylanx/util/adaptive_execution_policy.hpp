@@ -0,0 +1,114 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_ADAPTIVE_EXECUTION_POLICY_HPP)
+#define PHYLANX_UTIL_ADAPTIVE_EXECUTION_POLICY_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Return the time (in nanoseconds) needed to schedule an HPX task and
+    /// to wait for its completion on this locality. The overhead is measured
+    /// the first time it is needed, unless it is given by the configuration
+    /// setting 'phylanx.task_spawn_overhead'. This has to be called on an
+    /// HPX thread.
+    PHYLANX_EXPORT std::int64_t task_spawn_overhead();
+
+    /// Performance counter data, the task spawn overhead (in nanoseconds) if
+    /// it was needed before, zero otherwise
+    PHYLANX_EXPORT std::int64_t task_spawn_overhead_counter(bool reset);
+
+    /// Return whether the adaptive execution policy is enabled (configuration
+    /// setting 'phylanx.adaptive_execution', disabled by default)
+    PHYLANX_EXPORT bool adaptive_execution_enabled();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Decides whether a primitive should be evaluated directly (in the
+    /// context of its caller) or asynchronously (on a new HPX thread), based
+    /// on a moving estimate of the time its evaluation takes. Evaluating
+    /// asynchronously pays off only if the estimate exceeds the overhead of
+    /// spawning a task by some factor. Primitives whose estimate is below
+    /// 'phylanx.adaptive_execution.lower_factor' (default: 10) times the
+    /// overhead are evaluated directly, primitives whose estimate is above
+    /// 'phylanx.adaptive_execution.upper_factor' (default: 20) times the
+    /// overhead are evaluated asynchronously, in between the previous
+    /// decision is kept.
+    ///
+    /// Once decided, only every sampling_period'th evaluation is timed. Two
+    /// consecutive samples that deviate from the estimate by more than
+    /// shift_factor (for instance, because the primitive is evaluated for
+    /// inputs of a different size) replace the estimate, which allows to
+    /// quickly adapt to the new cost.
+    ///
+    /// A primitive may be evaluated concurrently, all member functions are
+    /// safe to be called from several threads at the same time.
+    class adaptive_execution_policy
+    {
+    public:
+        // number of samples before the first decision is made
+        static constexpr std::int64_t warmup_samples = 4;
+
+        // once decided, every sampling_period'th evaluation is timed
+        static constexpr std::int64_t sampling_period = 16;
+
+        // samples deviating from the estimate by this factor indicate a
+        // change of the cost of the evaluation
+        static constexpr std::int64_t shift_factor = 4;
+
+        adaptive_execution_policy() = default;
+
+        // return whether the next evaluation should be timed
+        bool sample() noexcept
+        {
+            return decision_.load(std::memory_order_relaxed) == -1 ||
+                (evaluations_.fetch_add(1, std::memory_order_relaxed) + 1) %
+                        sampling_period ==
+                    0;
+        }
+
+        // update the estimate from the accumulated number and duration of
+        // the timed evaluations (these might have been reset in between)
+        PHYLANX_EXPORT void update(
+            std::int64_t count, std::int64_t duration) noexcept;
+
+        // return 1 for direct evaluation, 0 for asynchronous evaluation, and
+        // -1 if no decision could be made yet
+        PHYLANX_EXPORT std::int64_t decide();
+
+        // the current estimate of the duration of an evaluation (in
+        // nanoseconds), -1 if there is none yet
+        std::int64_t estimate() const noexcept
+        {
+            return estimate_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        using mutex_type = hpx::lcos::local::spinlock;
+
+        void add_sample(std::int64_t duration) noexcept;
+
+        // protects the samples and the estimate, the latter is atomic only
+        // to be read without holding the lock
+        mutable mutex_type mtx_;
+
+        std::atomic<std::int64_t> estimate_{-1};
+        std::int64_t samples_ = 0;
+        std::int64_t outliers_ = 0;
+        std::atomic<std::int64_t> evaluations_{0};
+        std::atomic<std::int64_t> decision_{-1};
+
+        std::int64_t last_count_ = 0;
+        std::int64_t last_duration_ = 0;
+    };
+}}
+
+#endif
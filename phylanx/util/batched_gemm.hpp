@@ -0,0 +1,257 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_BATCHED_GEMM_HPP)
+#define PHYLANX_UTIL_BATCHED_GEMM_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+// Products of batches of equally sized matrices, C[b] = A[b] * B[b]. Each
+// operand is described by a base pointer and the distances between
+// consecutive matrices, rows, and columns of the batch, which allows to
+// express transposed operands, slices of tensors along any axis, and
+// operands broadcast over the batch (a batch distance of zero) without
+// copying. Small products are computed by a micro kernel which accumulates
+// four rows of the result at a time from a packed copy of the right operand,
+// larger ones are handed to Blaze. The matrices of a batch are distributed
+// over the cores in groups, so that the scratch space is reused within a
+// group.
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // element (i, j) of matrix b is located at
+    // data[b * batch_stride + i * row_stride + j * column_stride]
+    template <typename T>
+    struct strided_matrices
+    {
+        strided_matrices(T* data_, std::size_t batch_stride_,
+                std::size_t row_stride_, std::size_t column_stride_)
+          : data(data_)
+          , batch_stride(batch_stride_)
+          , row_stride(row_stride_)
+          , column_stride(column_stride_)
+        {
+        }
+
+        // allows to pass a batch of mutable matrices as a constant one
+        template <typename U,
+            typename Enable = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+        strided_matrices(strided_matrices<U> const& rhs)
+          : data(rhs.data)
+          , batch_stride(rhs.batch_stride)
+          , row_stride(rhs.row_stride)
+          , column_stride(rhs.column_stride)
+        {
+        }
+
+        T* data;
+        std::size_t batch_stride;
+        std::size_t row_stride;
+        std::size_t column_stride;
+    };
+
+    namespace detail
+    {
+        // products with all extents up to this size use the micro kernel
+        constexpr std::size_t gemm_small_size = 64;
+
+        // number of rows of the result accumulated together
+        constexpr std::size_t gemm_micro_rows = 4;
+
+        // minimal number of multiply-adds per task
+        constexpr std::size_t gemm_task_size = 262144;
+
+        ///////////////////////////////////////////////////////////////////////
+        // C = A * B for a single small matrix, B is stored contiguously
+        // with the given distance between its rows, acc provides space for
+        // gemm_micro_rows rows of the result
+        template <typename T>
+        void gemm_micro_kernel(std::size_t rows, std::size_t columns,
+            std::size_t inner, T const* a, std::size_t a_rs, std::size_t a_cs,
+            T const* b, std::size_t b_rs, T* c, std::size_t c_rs,
+            std::size_t c_cs, T* acc)
+        {
+            constexpr std::size_t micro_rows = gemm_micro_rows;
+
+            for (std::size_t i = 0; i < rows; i += micro_rows)
+            {
+                std::size_t const block = (std::min)(micro_rows, rows - i);
+                std::fill_n(acc, micro_rows * columns, T(0));
+
+                for (std::size_t p = 0; p != inner; ++p)
+                {
+                    T const* b_p = b + p * b_rs;
+                    for (std::size_t r = 0; r != block; ++r)
+                    {
+                        T const a_rp = a[(i + r) * a_rs + p * a_cs];
+                        T* acc_r = acc + r * columns;
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            acc_r[j] += a_rp * b_p[j];
+                        }
+                    }
+                }
+
+                for (std::size_t r = 0; r != block; ++r)
+                {
+                    T const* acc_r = acc + r * columns;
+                    T* c_r = c + (i + r) * c_rs;
+                    for (std::size_t j = 0; j != columns; ++j)
+                    {
+                        c_r[j * c_cs] = acc_r[j];
+                    }
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, bool SO>
+        using gemm_custom_matrix =
+            blaze::CustomMatrix<T, blaze::unaligned, blaze::unpadded, SO>;
+
+        // calls f with a Blaze view of matrix b, returns false if the
+        // layout can't be represented by a dense Blaze matrix
+        template <typename T, typename F>
+        bool with_blaze_matrix(strided_matrices<T> const& m, std::size_t b,
+            std::size_t rows, std::size_t columns, F&& f)
+        {
+            T* data = m.data + b * m.batch_stride;
+            if (m.column_stride == 1 &&
+                (rows == 1 || m.row_stride >= columns))
+            {
+                f(gemm_custom_matrix<T, blaze::rowMajor>(data, rows, columns,
+                    (std::max)(m.row_stride, columns)));
+                return true;
+            }
+            if (m.row_stride == 1 &&
+                (columns == 1 || m.column_stride >= rows))
+            {
+                f(gemm_custom_matrix<T, blaze::columnMajor>(data, rows,
+                    columns, (std::max)(m.column_stride, rows)));
+                return true;
+            }
+            return false;
+        }
+
+        template <typename T>
+        void gemm_blaze(std::size_t batch, std::size_t rows,
+            std::size_t columns, std::size_t inner,
+            strided_matrices<T const> const& a,
+            strided_matrices<T const> const& b, strided_matrices<T> const& c)
+        {
+            with_blaze_matrix(a, batch, rows, inner, [&](auto&& lhs) {
+                with_blaze_matrix(b, batch, inner, columns, [&](auto&& rhs) {
+                    with_blaze_matrix(c, batch, rows, columns,
+                        [&](auto&& result) { result = lhs * rhs; });
+                });
+            });
+        }
+
+        template <typename T>
+        bool gemm_blaze_compatible(strided_matrices<T> const& m,
+            std::size_t rows, std::size_t columns)
+        {
+            return (m.column_stride == 1 &&
+                       (rows == 1 || m.row_stride >= columns)) ||
+                (m.row_stride == 1 &&
+                    (columns == 1 || m.column_stride >= rows));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // C[b] = A[b] * B[b] for b in [0, batch), where A[b] is a rows x inner,
+    // B[b] is an inner x columns, and C[b] is a rows x columns matrix, the
+    // matrices of C must not overlap
+    template <typename T>
+    void batched_gemm(std::size_t batch, std::size_t rows,
+        std::size_t columns, std::size_t inner, strided_matrices<T const> a,
+        strided_matrices<T const> b, strided_matrices<T> c)
+    {
+        if (batch == 0 || rows == 0 || columns == 0)
+        {
+            return;
+        }
+
+        bool const small = rows <= detail::gemm_small_size &&
+            columns <= detail::gemm_small_size &&
+            inner <= detail::gemm_small_size;
+
+        bool const use_blaze = !small &&
+            detail::gemm_blaze_compatible(a, rows, inner) &&
+            detail::gemm_blaze_compatible(b, inner, columns) &&
+            detail::gemm_blaze_compatible(c, rows, columns);
+
+        // the right operand is packed unless its rows are contiguous
+        bool const pack = b.column_stride != 1;
+
+        std::size_t const work = (std::max)(rows * columns * inner,
+            std::size_t(1));
+        std::size_t const group_size =
+            (std::max)(detail::gemm_task_size / work, std::size_t(1));
+        std::size_t const groups = (batch + group_size - 1) / group_size;
+
+        auto group = [&](std::size_t g) {
+            std::size_t const first = g * group_size;
+            std::size_t const last = (std::min)(batch, first + group_size);
+
+            if (use_blaze)
+            {
+                for (std::size_t k = first; k != last; ++k)
+                {
+                    detail::gemm_blaze(k, rows, columns, inner, a, b, c);
+                }
+                return;
+            }
+
+            std::vector<T> acc(detail::gemm_micro_rows * columns);
+            std::vector<T> packed(pack ? inner * columns : 0);
+
+            for (std::size_t k = first; k != last; ++k)
+            {
+                T const* b_k = b.data + k * b.batch_stride;
+                std::size_t b_rs = b.row_stride;
+                if (pack)
+                {
+                    for (std::size_t p = 0; p != inner; ++p)
+                    {
+                        for (std::size_t j = 0; j != columns; ++j)
+                        {
+                            packed[p * columns + j] =
+                                b_k[p * b.row_stride + j * b.column_stride];
+                        }
+                    }
+                    b_k = packed.data();
+                    b_rs = columns;
+                }
+
+                detail::gemm_micro_kernel(rows, columns, inner,
+                    a.data + k * a.batch_stride, a.row_stride,
+                    a.column_stride, b_k, b_rs, c.data + k * c.batch_stride,
+                    c.row_stride, c.column_stride, acc.data());
+            }
+        };
+
+        if (groups > 1)
+        {
+            hpx::for_loop(hpx::execution::par, std::size_t(0), groups, group);
+        }
+        else
+        {
+            group(0);
+        }
+    }
+}}
+
+#endif
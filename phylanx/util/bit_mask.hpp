@@ -0,0 +1,254 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_BIT_MASK_HPP)
+#define PHYLANX_UTIL_BIT_MASK_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Boolean masks packed into 64 bit words, used to record a selection of
+// indices (see util::compact). The predicate selecting the indices is
+// evaluated once, counting the selected indices and visiting them afterwards
+// operates on whole words. The bits beyond the size of the mask are always
+// kept cleared. Large masks are processed in parallel, distributing fixed
+// size blocks of words over the cores.
+//
+// The masks are internal to the compacting kernels (compress, nonzero, and
+// unique). Booleans are exchanged between primitives as
+// node_data<std::uint8_t>, which is why the comparisons, the logical
+// operations, and any/all do not use packed masks: packing their results
+// would add a pass over the data without saving any bandwidth.
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        // number of words handled as one block
+        constexpr std::size_t bit_mask_block_size = 1024;
+
+        inline std::size_t popcount(std::uint64_t word)
+        {
+#if defined(__GNUC__)
+            return std::size_t(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+            return std::size_t(__popcnt64(word));
+#else
+            word = word - ((word >> 1) & 0x5555555555555555ull);
+            word = (word & 0x3333333333333333ull) +
+                ((word >> 2) & 0x3333333333333333ull);
+            word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+            return std::size_t((word * 0x0101010101010101ull) >> 56);
+#endif
+        }
+
+        // index of the lowest set bit of a non-zero word
+        inline std::size_t count_trailing_zeros(std::uint64_t word)
+        {
+#if defined(__GNUC__)
+            return std::size_t(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanForward64(&index, word);
+            return std::size_t(index);
+#else
+            return popcount((word & (~word + 1)) - 1);
+#endif
+        }
+
+        template <typename F>
+        void bit_mask_for_loop(std::size_t words, F&& f)
+        {
+            std::size_t const blocks =
+                (words + bit_mask_block_size - 1) / bit_mask_block_size;
+
+            auto block = [&](std::size_t b) {
+                std::size_t const first = b * bit_mask_block_size;
+                f(first, (std::min)(words, first + bit_mask_block_size));
+            };
+
+            if (blocks > 1)
+            {
+                hpx::for_loop(
+                    hpx::execution::par, std::size_t(0), blocks, block);
+            }
+            else if (blocks == 1)
+            {
+                block(0);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Returns the number of non-zero bytes, examining eight bytes at a time
+    inline std::size_t count_nonzero_bytes(
+        std::uint8_t const* data, std::size_t size)
+    {
+        constexpr std::uint64_t low_bits = 0x7f7f7f7f7f7f7f7full;
+        constexpr std::uint64_t high_bits = 0x8080808080808080ull;
+
+        std::size_t result = 0;
+        std::size_t i = 0;
+        for (/**/; i + 8 <= size; i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+
+            // the high bit of every non-zero byte is set
+            word = (((word & low_bits) + low_bits) | word) & high_bits;
+            result += detail::popcount(word);
+        }
+        for (/**/; i != size; ++i)
+        {
+            result += data[i] != 0 ? 1 : 0;
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    class bit_mask
+    {
+    public:
+        using word_type = std::uint64_t;
+        static constexpr std::size_t word_bits = 64;
+
+        bit_mask() = default;
+
+        explicit bit_mask(std::size_t size)
+          : words_(num_words(size), word_type(0))
+          , size_(size)
+        {
+        }
+
+        // the i-th bit is set if pred(i) holds
+        template <typename Pred>
+        static bit_mask from_predicate(std::size_t size, Pred&& pred)
+        {
+            bit_mask result(size);
+            word_type* words = result.words_.data();
+
+            detail::bit_mask_for_loop(result.words_.size(),
+                [&](std::size_t first, std::size_t last) {
+                    for (std::size_t w = first; w != last; ++w)
+                    {
+                        std::size_t const base = w * word_bits;
+                        std::size_t const bits =
+                            (std::min)(word_bits, size - base);
+
+                        word_type word = 0;
+                        for (std::size_t b = 0; b != bits; ++b)
+                        {
+                            word |= word_type(pred(base + b) ? 1 : 0) << b;
+                        }
+                        words[w] = word;
+                    }
+                });
+
+            return result;
+        }
+
+        // the i-th bit is set if data[i] is non-zero
+        template <typename T>
+        static bit_mask from_values(T const* data, std::size_t size)
+        {
+            return from_predicate(
+                size, [data](std::size_t i) { return data[i] != T(0); });
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        std::vector<word_type> const& words() const
+        {
+            return words_;
+        }
+
+        bool test(std::size_t i) const
+        {
+            return (words_[i / word_bits] >> (i % word_bits)) & 1;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // number of set bits in the words [first, last)
+        std::size_t count(std::size_t first, std::size_t last) const
+        {
+            std::size_t result = 0;
+            for (std::size_t w = first; w != last; ++w)
+            {
+                result += detail::popcount(words_[w]);
+            }
+            return result;
+        }
+
+        // number of set bits
+        std::size_t count() const
+        {
+            std::size_t const blocks =
+                (words_.size() + detail::bit_mask_block_size - 1) /
+                detail::bit_mask_block_size;
+
+            std::vector<std::size_t> counts(blocks, 0);
+            detail::bit_mask_for_loop(
+                words_.size(), [&](std::size_t first, std::size_t last) {
+                    counts[first / detail::bit_mask_block_size] =
+                        count(first, last);
+                });
+
+            std::size_t result = 0;
+            for (std::size_t c : counts)
+            {
+                result += c;
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // calls f(i) for every set bit i in the words [first, last), in
+        // ascending order
+        template <typename F>
+        void for_each_set(std::size_t first, std::size_t last, F&& f) const
+        {
+            for (std::size_t w = first; w != last; ++w)
+            {
+                word_type word = words_[w];
+                while (word != 0)
+                {
+                    f(w * word_bits + detail::count_trailing_zeros(word));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        template <typename F>
+        void for_each_set(F&& f) const
+        {
+            for_each_set(0, words_.size(), std::forward<F>(f));
+        }
+
+    private:
+        static std::size_t num_words(std::size_t size)
+        {
+            return (size + word_bits - 1) / word_bits;
+        }
+
+        std::vector<word_type> words_;
+        std::size_t size_ = 0;
+    };
+}}
+
+#endif
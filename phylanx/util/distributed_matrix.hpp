@@ -8,6 +8,7 @@
 #define PHYLANX_UTIL_DISTRIBUTED_MATRIX_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/remote_tile_cache.hpp>
 #include <phylanx/util/serialization/blaze.hpp>
 
 #include <hpx/actions_base/component_action.hpp>
@@ -16,6 +17,7 @@
 #include <hpx/errors/throw_exception.hpp>
 #include <hpx/modules/components.hpp>
 #include <hpx/modules/components_base.hpp>
+#include <hpx/modules/futures.hpp>
 #include <hpx/modules/runtime_components.hpp>
 #include <hpx/preprocessor/cat.hpp>
 #include <hpx/runtime.hpp>
@@ -23,6 +25,8 @@
 #include <hpx/synchronization/spinlock.hpp>
 #include <hpx/thread_support/unlock_guard.hpp>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <map>
@@ -48,18 +52,56 @@ namespace phylanx { namespace util { namespace server {
 
         distributed_matrix_part() = default;
 
-        explicit distributed_matrix_part(reference_type const& data)
+        // copies keep the version of the source, moving a part transfers its
+        // version (the atomic version would otherwise make the parts
+        // neither copyable nor movable)
+        distributed_matrix_part(distributed_matrix_part const& rhs)
+          : data_(rhs.data_)
+          , version_(rhs.version_.load())
+        {
+        }
+
+        distributed_matrix_part(distributed_matrix_part&& rhs)
+          : data_(std::move(rhs.data_))
+          , version_(rhs.version_.exchange(unversioned_tile))
+        {
+        }
+
+        distributed_matrix_part& operator=(distributed_matrix_part const& rhs)
+        {
+            data_ = rhs.data_;
+            version_.store(rhs.version_.load());
+            return *this;
+        }
+
+        distributed_matrix_part& operator=(distributed_matrix_part&& rhs)
+        {
+            data_ = std::move(rhs.data_);
+            version_.store(rhs.version_.exchange(unversioned_tile));
+            return *this;
+        }
+
+        // the version of a part that may be cached by other localities is
+        // derived from its contents
+        explicit distributed_matrix_part(
+            reference_type const& data, bool versioned = false)
           : data_(data)
+          , version_(versioned ? compute_version() : unversioned_tile)
         {
         }
 
-        explicit distributed_matrix_part(reference_type&& data)
+        explicit distributed_matrix_part(
+            reference_type&& data, bool versioned = false)
           : data_(std::move(data))
+          , version_(versioned ? compute_version() : unversioned_tile)
         {
         }
 
+        // the data may be modified through the returned reference, it can't
+        // be cached by other localities anymore
         reference_type& operator*()
         {
+            version_.store(unversioned_tile);
             return data_;
         }
 
@@ -70,6 +112,7 @@ namespace phylanx { namespace util { namespace server {
 
         reference_type* operator->()
         {
+            version_.store(unversioned_tile);
             return &data_;
         }
 
@@ -94,8 +137,47 @@ namespace phylanx { namespace util { namespace server {
 
         HPX_DEFINE_COMPONENT_ACTION(distributed_matrix_part, fetch_part);
 
+        versioned_tile<data_type> fetch_if_modified(
+            std::uint64_t version) const
+        {
+            std::uint64_t const current = version_.load();
+            if (current != unversioned_tile && current == version)
+            {
+                return versioned_tile<data_type>{current, false, data_type{}};
+            }
+            return versioned_tile<data_type>{current, true, data_};
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(
+            distributed_matrix_part, fetch_if_modified);
+
+        versioned_tile<data_type> fetch_part_if_modified(
+            std::size_t start_row, std::size_t start_column,
+            std::size_t stop_row, std::size_t stop_column,
+            std::uint64_t version) const
+        {
+            std::uint64_t const current = version_.load();
+            if (current != unversioned_tile && current == version)
+            {
+                return versioned_tile<data_type>{current, false, data_type{}};
+            }
+            return versioned_tile<data_type>{current, true,
+                data_type{blaze::submatrix(data_, start_row, start_column,
+                    stop_row - start_row, stop_column - start_column)}};
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(
+            distributed_matrix_part, fetch_part_if_modified);
+
     private:
+        std::uint64_t compute_version() const
+        {
+            return remote_tile_cache_version<T>(data_.rows(), data_.columns(),
+                [this](std::size_t i) { return data_.data(i); });
+        }
+
         reference_type data_;
+        std::atomic<std::uint64_t> version_{unversioned_tile};
     };
 }}}    // namespace phylanx::util::server
 /// \endcond
@@ -107,7 +189,16 @@ namespace phylanx { namespace util { namespace server {
     HPX_REGISTER_ACTION_DECLARATION(                                           \
         phylanx::util::server::distributed_matrix_part<                        \
             type>::fetch_part_action,                                          \
-        HPX_PP_CAT(__distributed_matrix_part_fetch_part_action_, type))        \
+        HPX_PP_CAT(__distributed_matrix_part_fetch_part_action_, type));       \
+    HPX_REGISTER_ACTION_DECLARATION(                                           \
+        phylanx::util::server::distributed_matrix_part<                        \
+            type>::fetch_if_modified_action,                                   \
+        HPX_PP_CAT(__distributed_matrix_part_fetch_if_modified_action_, type));\
+    HPX_REGISTER_ACTION_DECLARATION(                                           \
+        phylanx::util::server::distributed_matrix_part<                        \
+            type>::fetch_part_if_modified_action,                              \
+        HPX_PP_CAT(                                                            \
+            __distributed_matrix_part_fetch_part_if_modified_action_, type))   \
     /**/
 
 #define REGISTER_DISTRIBUTED_MATRIX(type)                                      \
@@ -117,6 +208,13 @@ namespace phylanx { namespace util { namespace server {
     HPX_REGISTER_ACTION(phylanx::util::server::distributed_matrix_part<        \
                             type>::fetch_part_action,                          \
         HPX_PP_CAT(__distributed_matrix_part_fetch_part_action_, type));       \
+    HPX_REGISTER_ACTION(phylanx::util::server::distributed_matrix_part<        \
+                            type>::fetch_if_modified_action,                   \
+        HPX_PP_CAT(__distributed_matrix_part_fetch_if_modified_action_, type));\
+    HPX_REGISTER_ACTION(phylanx::util::server::distributed_matrix_part<        \
+                            type>::fetch_part_if_modified_action,              \
+        HPX_PP_CAT(                                                            \
+            __distributed_matrix_part_fetch_part_if_modified_action_, type));  \
     typedef ::hpx::components::component<                                      \
         phylanx::util::server::distributed_matrix_part<type>>                  \
         HPX_PP_CAT(__distributed_matrix_part_, type);                          \
@@ -159,11 +257,16 @@ namespace phylanx { namespace util {
         /// \param sub_localities The sub_localities accepts a list of locality
         ///             index. By default, it is initialized to a list of all
         ///             provided locality index.
+        /// \param cache_remote_tiles Keep the tiles fetched from remote
+        ///             localities in the remote tile cache. The parts of
+        ///             all sites are versioned by their contents, which
+        ///             makes storing them somewhat more expensive.
         ///
         distributed_matrix(std::string basename, reference_type const& data,
             std::size_t num_sites = std::size_t(-1),
             std::size_t this_site = std::size_t(-1),
-            std::int64_t* transferred_bytes = nullptr)
+            std::int64_t* transferred_bytes = nullptr,
+            bool cache_remote_tiles = false)
           : num_sites_(num_sites == std::size_t(-1) ?
                     hpx::get_num_localities(hpx::launch::sync) :
                     num_sites)
@@ -171,6 +274,7 @@ namespace phylanx { namespace util {
                                                       this_site)
           , basename_("dist_matrix_" + std::move(basename))
           , transferred_bytes_(transferred_bytes)
+          , cache_remote_tiles_(cache_remote_tiles)
         {
             if (this_site_ >= num_sites_)
             {
@@ -200,11 +304,16 @@ namespace phylanx { namespace util {
         /// \param sub_localities The sub_localities accepts a list of locality
         ///             index. By default, it is initialized to a list of all
         ///             provided locality index.
+        /// \param cache_remote_tiles Keep the tiles fetched from remote
+        ///             localities in the remote tile cache. The parts of
+        ///             all sites are versioned by their contents, which
+        ///             makes storing them somewhat more expensive.
         ///
         distributed_matrix(std::string basename, reference_type&& data,
             std::size_t num_sites = std::size_t(-1),
             std::size_t this_site = std::size_t(-1),
-            std::int64_t* transferred_bytes = nullptr)
+            std::int64_t* transferred_bytes = nullptr,
+            bool cache_remote_tiles = false)
           : num_sites_(num_sites == std::size_t(-1) ?
                     hpx::get_num_localities(hpx::launch::sync) :
                     num_sites)
@@ -212,6 +321,7 @@ namespace phylanx { namespace util {
                                                       this_site)
           , basename_("dist_matrix_" + std::move(basename))
           , transferred_bytes_(transferred_bytes)
+          , cache_remote_tiles_(cache_remote_tiles)
         {
             if (this_site_ >= num_sites_)
             {
@@ -241,7 +351,7 @@ namespace phylanx { namespace util {
         reference_type const& operator*() const
         {
             HPX_ASSERT(!!ptr_);
-            return **ptr_;
+            return *part();
         }
 
         /// Access the calling locality's value instance for this distributed_matrix
@@ -255,7 +365,7 @@ namespace phylanx { namespace util {
         reference_type const* operator->() const
         {
             HPX_ASSERT(!!ptr_);
-            return &**ptr_;
+            return &*part();
         }
 
         /// fetch() function is an asynchronous function. This returns a future
@@ -271,6 +381,21 @@ namespace phylanx { namespace util {
             using action_type =
                 typename server::distributed_matrix_part<T>::fetch_action;
 
+            if (is_cacheable(idx))
+            {
+                using cached_action_type = typename server::
+                    distributed_matrix_part<T>::fetch_if_modified_action;
+
+                return fetch_cached(idx,
+                    {remote_tile_cache_key::whole_tile,
+                        remote_tile_cache_key::whole_tile,
+                        remote_tile_cache_key::whole_tile,
+                        remote_tile_cache_key::whole_tile},
+                    [id = get_part_id(idx)](std::uint64_t version) {
+                        return hpx::async<cached_action_type>(id, version);
+                    });
+            }
+
             auto f = hpx::async<action_type>(get_part_id(idx));
 
             // keep track of number of transferred bytes, if needed
@@ -311,6 +436,20 @@ namespace phylanx { namespace util {
             using action_type =
                 typename server::distributed_matrix_part<T>::fetch_part_action;
 
+            if (is_cacheable(idx))
+            {
+                using cached_action_type = typename server::
+                    distributed_matrix_part<T>::fetch_part_if_modified_action;
+
+                return fetch_cached(idx,
+                    {start_row, start_column, stop_row, stop_column},
+                    [id = get_part_id(idx), start_row, start_column, stop_row,
+                        stop_column](std::uint64_t version) {
+                        return hpx::async<cached_action_type>(id, start_row,
+                            start_column, stop_row, stop_column, version);
+                    });
+            }
+
             auto f = hpx::async<action_type>(get_part_id(idx), start_row,
                 start_column, stop_row, stop_column);
 
@@ -338,13 +477,35 @@ namespace phylanx { namespace util {
 
     private:
         /// \cond NOINTERNAL
+        server::distributed_matrix_part<T> const& part() const
+        {
+            return *ptr_;
+        }
+
+        bool is_cacheable(std::size_t idx) const
+        {
+            return cache_remote_tiles_ && idx != this_site_ &&
+                remote_tile_cache_enabled();
+        }
+
+        template <typename F>
+        hpx::future<data_type> fetch_cached(std::size_t idx,
+            std::array<std::size_t, 4> const& range,
+            F&& fetch_if_modified) const
+        {
+            return remote_tile_cache_fetch<data_type>(basename_, idx, range,
+                transferred_bytes_, std::forward<F>(fetch_if_modified),
+                [](data_type const& r) { return r.capacity() * sizeof(T); });
+        }
+
         template <typename Arg>
         hpx::id_type create_and_register_server(Arg&& value)
         {
             // create new distributed_matrix component and register it with AGAS
             hpx::id_type part_id =
                 hpx::local_new<server::distributed_matrix_part<T>>(
-                    hpx::launch::sync, std::forward<Arg>(value));
+                    hpx::launch::sync, std::forward<Arg>(value),
+                    cache_remote_tiles_ && remote_tile_cache_enabled());
 
             hpx::register_with_basename(basename_, part_id, this_site_).get();
 
@@ -405,6 +566,7 @@ namespace phylanx { namespace util {
         mutable std::map<std::size_t, hpx::id_type> part_ids_;
 
         std::int64_t* transferred_bytes_;
+        bool const cache_remote_tiles_;
         /// \endcond
     };
 }}    // namespace phylanx::util
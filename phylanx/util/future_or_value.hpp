@@ -63,6 +63,16 @@ namespace phylanx { namespace util
             return util::get<1>(data_).get();
         }
 
+        // a ready value is wrapped into a ready future
+        hpx::future<T> get_future()
+        {
+            if (data_.index() == 0)
+            {
+                return hpx::make_ready_future(std::move(util::get<0>(data_)));
+            }
+            return std::move(util::get<1>(data_));
+        }
+
         ///////////////////////////////////////////////////////////////////////
         bool is_ready() const
         {
@@ -0,0 +1,434 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_HALO_EXCHANGE_HPP)
+#define PHYLANX_UTIL_HALO_EXCHANGE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/distributed_matrix.hpp>
+#include <phylanx/util/distributed_tensor.hpp>
+#include <phylanx/util/distributed_vector.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/modules/futures.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+// Halo exchange for arrays that are tiled along one of their dimensions
+// without any overlap between the tiles. A stencil applied to the local tile
+// needs a couple of elements (the halo) from the neighboring tiles on either
+// side. A halo_exchange requests those from the owning localities as soon as
+// it is constructed, which allows to compute the interior of the local tile
+// while the halo data is still in flight. The borders of the tile are
+// finished once the halos have arrived.
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Global [start, stop) range of a tile along the decomposed dimension. An
+    // empty span marks a tile that does not take part in the exchange.
+    using halo_span = std::pair<std::int64_t, std::int64_t>;
+
+    // Part of a halo owned by the given site (global coordinates)
+    struct halo_segment
+    {
+        std::size_t site_;
+        std::int64_t start_;
+        std::int64_t stop_;
+    };
+
+    // Find the parts of the tiles of other sites that together cover the
+    // global range [start, stop)
+    inline std::vector<halo_segment> find_halo_segments(
+        std::vector<halo_span> const& spans, std::size_t this_site,
+        std::int64_t start, std::int64_t stop)
+    {
+        std::vector<halo_segment> segments;
+        while (start < stop)
+        {
+            // prefer the tile reaching furthest to minimize the number of
+            // messages
+            std::size_t site = std::size_t(-1);
+            std::int64_t site_stop = start;
+            for (std::size_t i = 0; i != spans.size(); ++i)
+            {
+                if (i != this_site && spans[i].first <= start &&
+                    spans[i].second > site_stop)
+                {
+                    site = i;
+                    site_stop = spans[i].second;
+                }
+            }
+
+            if (site == std::size_t(-1))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::util::find_halo_segments",
+                    "the tiles of the array do not cover the halo region "
+                    "requested by the stencil");
+            }
+
+            site_stop = (std::min)(site_stop, stop);
+            segments.push_back(halo_segment{site, start, site_stop});
+            start = site_stop;
+        }
+        return segments;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Describes the neighborhood of a stencil along the decomposed dimension:
+    // output element i depends on the input elements [i - offset, i - offset
+    // + width), input elements outside of [0, size) are treated as zeros.
+    struct stencil_extent
+    {
+        std::int64_t offset_;
+        std::int64_t width_;
+
+        // number of elements needed from the tiles before the local tile
+        // [start, stop) to compute the output elements starting at out_start
+        std::int64_t lower_halo(
+            std::int64_t start, std::int64_t out_start) const
+        {
+            return (std::max)(std::int64_t(0),
+                start - (std::max)(std::int64_t(0), out_start - offset_));
+        }
+
+        // number of elements needed from the tiles after the local tile
+        // [start, stop) to compute the output elements up to out_stop
+        std::int64_t upper_halo(std::int64_t stop, std::int64_t out_stop,
+            std::int64_t size) const
+        {
+            return (std::max)(std::int64_t(0),
+                (std::min)(size, out_stop - offset_ + width_ - 1) - stop);
+        }
+
+        // range of the output elements in [out_start, out_stop) that depend
+        // on the local tile [start, stop) only
+        std::pair<std::int64_t, std::int64_t> interior(std::int64_t start,
+            std::int64_t stop, std::int64_t size, std::int64_t out_start,
+            std::int64_t out_stop) const
+        {
+            std::int64_t first =
+                start == 0 ? out_start : (std::max)(out_start, start + offset_);
+            std::int64_t last = stop == size ?
+                out_stop :
+                (std::min)(out_stop, stop + offset_ - width_ + 1);
+
+            first = (std::min)(first, out_stop);
+            return std::make_pair(first, (std::max)(first, last));
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Data>
+    class halo_exchange
+    {
+    public:
+        // The function 'fetch' is invoked as fetch(site, start, stop), where
+        // start and stop are relative to the tile owned by 'site'. It has to
+        // return a hpx::future<Data> holding the requested part of that tile.
+        template <typename Fetch>
+        halo_exchange(std::vector<halo_span> const& spans,
+            std::size_t this_site, std::int64_t lower_width,
+            std::int64_t upper_width, Fetch&& fetch)
+          : lower_width_(lower_width)
+          , upper_width_(upper_width)
+        {
+            halo_span const& local = spans[this_site];
+
+            // post all requests right away, the data will be needed only
+            // after the interior of the local tile has been computed
+            lower_ = post(spans, find_halo_segments(spans, this_site,
+                local.first - lower_width, local.first), fetch);
+            upper_ = post(spans, find_halo_segments(spans, this_site,
+                local.second, local.second + upper_width), fetch);
+        }
+
+        std::int64_t lower_width() const
+        {
+            return lower_width_;
+        }
+        std::int64_t upper_width() const
+        {
+            return upper_width_;
+        }
+
+        // wait for the halo data, the parts are ordered by their position
+        std::vector<Data> lower()
+        {
+            return get(lower_);
+        }
+        std::vector<Data> upper()
+        {
+            return get(upper_);
+        }
+
+    private:
+        template <typename Fetch>
+        static std::vector<hpx::future<Data>> post(
+            std::vector<halo_span> const& spans,
+            std::vector<halo_segment> const& segments, Fetch& fetch)
+        {
+            std::vector<hpx::future<Data>> result;
+            result.reserve(segments.size());
+            for (auto const& s : segments)
+            {
+                std::int64_t const offset = spans[s.site_].first;
+                result.push_back(
+                    fetch(s.site_, s.start_ - offset, s.stop_ - offset));
+            }
+            return result;
+        }
+
+        static std::vector<Data> get(std::vector<hpx::future<Data>>& parts)
+        {
+            std::vector<Data> result;
+            result.reserve(parts.size());
+            for (auto& f : parts)
+            {
+                result.push_back(f.get());
+            }
+            return result;
+        }
+
+        std::int64_t lower_width_;
+        std::int64_t upper_width_;
+        std::vector<hpx::future<Data>> lower_;
+        std::vector<hpx::future<Data>> upper_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Halo exchange for tiled vectors
+    template <typename T>
+    halo_exchange<blaze::DynamicVector<T>> make_halo_exchange(
+        distributed_vector<T> const& data, std::vector<halo_span> const& spans,
+        std::size_t this_site, std::int64_t lower_width,
+        std::int64_t upper_width)
+    {
+        return halo_exchange<blaze::DynamicVector<T>>(spans, this_site,
+            lower_width, upper_width,
+            [&](std::size_t site, std::int64_t start, std::int64_t stop) {
+                return data.fetch(site, start, stop);
+            });
+    }
+
+    // Halo exchange for matrices tiled along their rows (axis == 0) or their
+    // columns (axis == 1), the tiles have to span the other dimension fully
+    template <typename T>
+    halo_exchange<blaze::DynamicMatrix<T>> make_halo_exchange(
+        distributed_matrix<T> const& data, std::size_t axis,
+        std::vector<halo_span> const& spans, std::size_t this_site,
+        std::int64_t lower_width, std::int64_t upper_width)
+    {
+        std::size_t const rows = data->rows();
+        std::size_t const columns = data->columns();
+        return halo_exchange<blaze::DynamicMatrix<T>>(spans, this_site,
+            lower_width, upper_width,
+            [&, axis, rows, columns](std::size_t site, std::int64_t start,
+                std::int64_t stop) {
+                return axis == 0 ?
+                    data.fetch(site, start, 0, stop, columns) :
+                    data.fetch(site, 0, start, rows, stop);
+            });
+    }
+
+    // Halo exchange for tensors tiled along their pages (axis == 0), rows
+    // (axis == 1), or columns (axis == 2), the tiles have to span the other
+    // dimensions fully
+    template <typename T>
+    halo_exchange<blaze::DynamicTensor<T>> make_halo_exchange(
+        distributed_tensor<T> const& data, std::size_t axis,
+        std::vector<halo_span> const& spans, std::size_t this_site,
+        std::int64_t lower_width, std::int64_t upper_width)
+    {
+        std::size_t const pages = data->pages();
+        std::size_t const rows = data->rows();
+        std::size_t const columns = data->columns();
+        return halo_exchange<blaze::DynamicTensor<T>>(spans, this_site,
+            lower_width, upper_width,
+            [&, axis, pages, rows, columns](std::size_t site,
+                std::int64_t start, std::int64_t stop) {
+                switch (axis)
+                {
+                case 0:
+                    return data.fetch(
+                        site, start, 0, 0, stop, rows, columns);
+                case 1:
+                    return data.fetch(
+                        site, 0, start, 0, pages, stop, columns);
+                default:
+                    return data.fetch(
+                        site, 0, 0, start, pages, rows, stop);
+                }
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Concatenate the lower halo parts, (a part of) the local tile, and the
+    // upper halo parts along the decomposed dimension
+    template <typename T, typename Local>
+    blaze::DynamicVector<T> assemble_halo_block(
+        std::vector<blaze::DynamicVector<T>> const& lower, Local const& local,
+        std::vector<blaze::DynamicVector<T>> const& upper)
+    {
+        std::size_t size = local.size();
+        for (auto const& part : lower)
+            size += part.size();
+        for (auto const& part : upper)
+            size += part.size();
+
+        blaze::DynamicVector<T> result(size);
+
+        std::size_t pos = 0;
+        auto append = [&](auto const& part) {
+            blaze::subvector(result, pos, part.size()) = part;
+            pos += part.size();
+        };
+
+        for (auto const& part : lower)
+            append(part);
+        append(local);
+        for (auto const& part : upper)
+            append(part);
+
+        return result;
+    }
+
+    template <typename T, typename Local>
+    blaze::DynamicMatrix<T> assemble_halo_block(std::size_t axis,
+        std::vector<blaze::DynamicMatrix<T>> const& lower, Local const& local,
+        std::vector<blaze::DynamicMatrix<T>> const& upper)
+    {
+        auto extent = [axis](auto const& m) {
+            return axis == 0 ? m.rows() : m.columns();
+        };
+
+        std::size_t size = extent(local);
+        for (auto const& part : lower)
+            size += extent(part);
+        for (auto const& part : upper)
+            size += extent(part);
+
+        blaze::DynamicMatrix<T> result = axis == 0 ?
+            blaze::DynamicMatrix<T>(size, local.columns()) :
+            blaze::DynamicMatrix<T>(local.rows(), size);
+
+        std::size_t pos = 0;
+        auto append = [&](auto const& part) {
+            if (axis == 0)
+            {
+                blaze::submatrix(result, pos, 0, part.rows(), part.columns()) =
+                    part;
+            }
+            else
+            {
+                blaze::submatrix(result, 0, pos, part.rows(), part.columns()) =
+                    part;
+            }
+            pos += extent(part);
+        };
+
+        for (auto const& part : lower)
+            append(part);
+        append(local);
+        for (auto const& part : upper)
+            append(part);
+
+        return result;
+    }
+
+    template <typename T, typename Local>
+    blaze::DynamicTensor<T> assemble_halo_block(std::size_t axis,
+        std::vector<blaze::DynamicTensor<T>> const& lower, Local const& local,
+        std::vector<blaze::DynamicTensor<T>> const& upper)
+    {
+        auto extent = [axis](auto const& t) {
+            return axis == 0 ? t.pages() : axis == 1 ? t.rows() : t.columns();
+        };
+
+        std::size_t size = extent(local);
+        for (auto const& part : lower)
+            size += extent(part);
+        for (auto const& part : upper)
+            size += extent(part);
+
+        blaze::DynamicTensor<T> result(axis == 0 ? size : local.pages(),
+            axis == 1 ? size : local.rows(),
+            axis == 2 ? size : local.columns());
+
+        std::size_t pos = 0;
+        auto append = [&](auto const& part) {
+            blaze::subtensor(result, axis == 0 ? pos : 0, axis == 1 ? pos : 0,
+                axis == 2 ? pos : 0, part.pages(), part.rows(),
+                part.columns()) = part;
+            pos += extent(part);
+        };
+
+        for (auto const& part : lower)
+            append(part);
+        append(local);
+        for (auto const& part : upper)
+            append(part);
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply a stencil to the local tile [start, stop) producing the output
+    // elements [out_start, out_stop), overlapping the computation of the
+    // interior with the halo exchange.
+    //
+    // slice(first, last) has to return the local data for the global range
+    // [first, last), assemble(lower, local, upper) has to concatenate the
+    // given parts, and compute(block, block_start, first, last) has to
+    // calculate the output elements [first, last) from the input elements
+    // held by 'block', which starts at the global index 'block_start'.
+    template <typename Data, typename Slice, typename Assemble,
+        typename Compute>
+    void apply_stencil(halo_exchange<Data>& halo, stencil_extent const& extent,
+        std::int64_t start, std::int64_t stop, std::int64_t size,
+        std::int64_t out_start, std::int64_t out_stop, Slice&& slice,
+        Assemble&& assemble, Compute&& compute)
+    {
+        auto const interior =
+            extent.interior(start, stop, size, out_start, out_stop);
+
+        if (interior.first == interior.second)
+        {
+            // the local tile is too small to have an interior
+            compute(assemble(halo.lower(), slice(start, stop), halo.upper()),
+                start - halo.lower_width(), out_start, out_stop);
+            return;
+        }
+
+        // compute the interior while the halos are in flight
+        compute(slice(start, stop), start, interior.first, interior.second);
+
+        // finish the borders once the halos have arrived
+        std::vector<Data> const none;
+        if (out_start != interior.first)
+        {
+            std::int64_t const last = (std::min)(
+                stop, interior.first - extent.offset_ + extent.width_ - 1);
+            compute(assemble(halo.lower(), slice(start, last), none),
+                start - halo.lower_width(), out_start, interior.first);
+        }
+        if (interior.second != out_stop)
+        {
+            std::int64_t const first =
+                (std::max)(start, interior.second - extent.offset_);
+            compute(assemble(none, slice(first, stop), halo.upper()), first,
+                interior.second, out_stop);
+        }
+    }
+}}
+
+#endif
@@ -0,0 +1,156 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_HARDWARE_COUNTERS_HPP)
+#define PHYLANX_UTIL_HARDWARE_COUNTERS_HPP
+
+#include <phylanx/config.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+// The hardware counters of the evaluations of the primitives are read from
+// per-thread Linux perf_event counters (cycles, instructions, last level
+// cache misses, and branch misses) before and after each invocation of
+// eval. Only the work done on the calling thread until eval returns is
+// accounted for, evaluations that were suspended in between (and thus
+// might have continued on another thread or have been interleaved with
+// other work) are not sampled. If the counters can't be opened (on other
+// platforms, if the kernel does not support them, or if access is denied
+// by /proc/sys/kernel/perf_event_paranoid) all values stay zero.
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    enum hardware_event : std::size_t
+    {
+        hardware_cycles = 0,
+        hardware_instructions = 1,
+        hardware_llc_misses = 2,
+        hardware_branch_misses = 3,
+        num_hardware_events = 4
+    };
+
+    using hardware_counter_values =
+        std::array<std::int64_t, num_hardware_events>;
+
+    namespace detail
+    {
+        PHYLANX_EXPORT extern std::atomic<bool> hardware_counters_enabled_;
+    }
+
+    /// Return whether the hardware counters of the primitives are sampled
+    /// on this locality
+    inline bool hardware_counters_enabled() noexcept
+    {
+        return detail::hardware_counters_enabled_.load(
+            std::memory_order_relaxed);
+    }
+
+    /// Enable (or disable) the sampling of the hardware counters on this
+    /// locality. The sampling is enabled as well if the configuration
+    /// setting 'phylanx.hardware_counters' is set to 1, or if any of the
+    /// hardware performance counters of the primitives is queried.
+    PHYLANX_EXPORT void enable_hardware_counters(bool enable = true);
+
+    /// Return whether the hardware counters can be read on the calling
+    /// thread
+    PHYLANX_EXPORT bool hardware_counters_available();
+
+    /// Performance counter data, 1 if the hardware counters can be read on
+    /// this locality, 0 otherwise
+    PHYLANX_EXPORT std::int64_t hardware_counters_available_counter(
+        bool reset);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The accumulated hardware counters of one primitive instance
+    class hardware_counter_data
+    {
+    public:
+        hardware_counter_data() = default;
+
+        hardware_counter_data(hardware_counter_data const&) = delete;
+        hardware_counter_data& operator=(
+            hardware_counter_data const&) = delete;
+
+        void add(hardware_counter_values const& deltas) noexcept
+        {
+            for (std::size_t i = 0; i != num_hardware_events; ++i)
+            {
+                values_[i].fetch_add(deltas[i], std::memory_order_relaxed);
+            }
+        }
+
+        std::int64_t get(hardware_event event, bool reset) noexcept
+        {
+            if (reset)
+            {
+                return values_[event].exchange(0, std::memory_order_relaxed);
+            }
+            return values_[event].load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::array<std::atomic<std::int64_t>, num_hardware_events> values_{};
+    };
+
+    /// Adds the hardware counters of the calling thread accumulated during
+    /// the lifetime of this object to the given data (if enabled)
+    class hardware_counter_scope
+    {
+    public:
+        explicit hardware_counter_scope(hardware_counter_data& data) noexcept
+          : data_(hardware_counters_enabled() ? &data : nullptr)
+          , thread_(nullptr)
+          , phase_(0)
+          , begin_()
+        {
+            if (data_ != nullptr)
+            {
+                start();
+            }
+        }
+
+        hardware_counter_scope(hardware_counter_scope const&) = delete;
+        hardware_counter_scope& operator=(
+            hardware_counter_scope const&) = delete;
+
+        ~hardware_counter_scope()
+        {
+            if (data_ != nullptr)
+            {
+                stop();
+            }
+        }
+
+    private:
+        PHYLANX_EXPORT void start() noexcept;
+        PHYLANX_EXPORT void stop() noexcept;
+
+        hardware_counter_data* data_;
+        void const* thread_;
+        std::size_t phase_;
+        hardware_counter_values begin_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Print a table of the hardware counters of the primitives (including
+    /// the instructions per cycle and the cache misses per thousand
+    /// instructions), sorted by decreasing number of cycles.
+    ///
+    /// \param data The number of evaluations, cycles, instructions, cache
+    ///             misses, and branch misses of the primitive instances (as
+    ///             returned by retrieve_hardware_counter_data)
+    ///
+    PHYLANX_EXPORT void print_hardware_counter_report(std::ostream& os,
+        std::map<std::string, std::vector<std::int64_t>> const& data);
+}}
+
+#endif
@@ -0,0 +1,109 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_MEMORY_ACCOUNTING_HPP)
+#define PHYLANX_UTIL_MEMORY_ACCOUNTING_HPP
+
+#include <phylanx/config.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    struct primitive_argument_type;
+}}
+
+// The memory accounting attributes the buffers held by the results of the
+// evaluations of a primitive to that primitive: every result that owns the
+// data of its arrays (i.e. that does not refer to the data of some other
+// value) adds the size of that data to the allocated bytes of the primitive
+// which has produced it. The buffers of a result are assumed to be live
+// until the primitive produces its next result, which allows to track the
+// live and peak bytes of every primitive and of the whole locality without
+// having to instrument the allocations of the arrays themselves.
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        PHYLANX_EXPORT extern std::atomic<bool> memory_accounting_enabled_;
+    }
+
+    /// Return whether the memory accounting is enabled on this locality
+    inline bool memory_accounting_enabled() noexcept
+    {
+        return detail::memory_accounting_enabled_.load(
+            std::memory_order_relaxed);
+    }
+
+    /// Enable (or disable) the memory accounting on this locality. The
+    /// accounting is enabled as well if the configuration setting
+    /// 'phylanx.memory_accounting' is set to 1, or if any of the memory
+    /// performance counters of the primitives is queried.
+    PHYLANX_EXPORT void enable_memory_accounting(bool enable = true);
+
+    /// Return the number of bytes of the array data owned by the given value
+    PHYLANX_EXPORT std::int64_t memory_footprint(
+        execution_tree::primitive_argument_type const& value);
+
+    /// Performance counter data, the number of bytes held by the last
+    /// results of all primitives on this locality
+    PHYLANX_EXPORT std::int64_t memory_live_bytes(bool reset);
+
+    /// Performance counter data, the largest number of live bytes observed
+    /// on this locality (reset to the current number of live bytes)
+    PHYLANX_EXPORT std::int64_t memory_peak_bytes(bool reset);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The memory accounting data of one primitive instance
+    class memory_accounting
+    {
+    public:
+        memory_accounting() = default;
+
+        memory_accounting(memory_accounting const&) = delete;
+        memory_accounting& operator=(memory_accounting const&) = delete;
+
+        // the bytes held by the last result are not live anymore
+        PHYLANX_EXPORT ~memory_accounting();
+
+        // account for a new result holding the given number of bytes
+        PHYLANX_EXPORT void record(std::int64_t bytes) noexcept;
+
+        // accumulated number of bytes held by all results
+        PHYLANX_EXPORT std::int64_t allocated_bytes(bool reset) noexcept;
+
+        // number of bytes held by the last result
+        std::int64_t live_bytes(bool) const noexcept
+        {
+            return live_.load(std::memory_order_relaxed);
+        }
+
+        // largest number of bytes held by a result (reset to the number of
+        // live bytes)
+        PHYLANX_EXPORT std::int64_t peak_bytes(bool reset) noexcept;
+
+    private:
+        std::atomic<std::int64_t> allocated_{0};
+        std::atomic<std::int64_t> live_{0};
+        std::atomic<std::int64_t> peak_{0};
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Print a table of the memory accounting data of the primitives, sorted
+    /// by decreasing peak bytes.
+    ///
+    /// \param data The allocated, live, and peak bytes of the primitive
+    ///             instances (as returned by retrieve_memory_data)
+    ///
+    PHYLANX_EXPORT void print_memory_report(std::ostream& os,
+        std::map<std::string, std::vector<std::int64_t>> const& data);
+}}
+
+#endif
@@ -0,0 +1,311 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PARALLEL_SCAN_HPP)
+#define PHYLANX_UTIL_PARALLEL_SCAN_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/bit_mask.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Parallel prefix scans over contiguous (possibly padded) arrays. Long
+// sequences are split into fixed size chunks which are processed in three
+// phases: all chunks are reduced concurrently, the chunk totals are scanned
+// to give the carry of every chunk, and finally all chunks are scanned
+// concurrently starting from their carry. The reductions use independent
+// accumulators which the compiler can map onto vector lanes. As the chunk
+// size does not depend on the number of cores, the results are reproducible
+// for floating point data as well. Scans along an axis of a multidimensional
+// array run in parallel over the independent lanes instead.
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        // number of elements handled as one chunk of a long scan
+        constexpr std::size_t scan_chunk_size = 65536;
+
+        // number of neighboring lanes scanned together by an axis scan
+        constexpr std::size_t scan_lane_block_size = 512;
+
+        // minimal number of elements for which the work is done in parallel
+        constexpr std::size_t scan_parallel_threshold = 2 * scan_chunk_size;
+
+        template <typename F>
+        void scan_for_loop(std::size_t size, std::size_t count, F&& f)
+        {
+            if (size >= scan_parallel_threshold && count > 1)
+            {
+                hpx::for_loop(hpx::execution::par, std::size_t(0), count,
+                    std::forward<F>(f));
+            }
+            else
+            {
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    f(i);
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // reduction of a non-empty sequence using four independent
+        // accumulators
+        template <typename T, typename Op>
+        T scan_reduce(T const* src, std::size_t size, Op& op)
+        {
+            if (size < 8)
+            {
+                T result = src[0];
+                for (std::size_t i = 1; i != size; ++i)
+                {
+                    result = op(result, src[i]);
+                }
+                return result;
+            }
+
+            T acc0 = src[0], acc1 = src[1], acc2 = src[2], acc3 = src[3];
+            std::size_t i = 4;
+            for (/**/; i + 4 <= size; i += 4)
+            {
+                acc0 = op(acc0, src[i]);
+                acc1 = op(acc1, src[i + 1]);
+                acc2 = op(acc2, src[i + 2]);
+                acc3 = op(acc3, src[i + 3]);
+            }
+
+            T result = op(op(acc0, acc1), op(acc2, acc3));
+            for (/**/; i != size; ++i)
+            {
+                result = op(result, src[i]);
+            }
+            return result;
+        }
+
+        // sequential inclusive scan starting from the given value, returns
+        // the last value written
+        template <typename T, typename Op>
+        T scan_sequential(
+            T const* src, std::size_t size, T* dst, Op& op, T value)
+        {
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                value = op(value, src[i]);
+                dst[i] = value;
+            }
+            return value;
+        }
+
+        // Calls f(src, dst, size) for the contiguous pieces making up the
+        // elements [first, last) of the flattened rows x columns array.
+        template <typename T, typename F>
+        void scan_for_each_piece(T const* src, std::size_t src_ld, T* dst,
+            std::size_t dst_ld, std::size_t columns, std::size_t first,
+            std::size_t last, F&& f)
+        {
+            std::size_t row = first / columns;
+            std::size_t column = first % columns;
+            while (first != last)
+            {
+                std::size_t const size =
+                    (std::min)(columns - column, last - first);
+                f(src + row * src_ld + column, dst + row * dst_ld + column,
+                    size);
+                first += size;
+                column = 0;
+                ++row;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Inclusive scan of the flattened rows x columns array src (with the
+    // given distance between consecutive rows) into dst, i.e. the i-th
+    // element of the result is init op x_0 op ... op x_i. The operation has
+    // to be associative.
+    template <typename T, typename Op>
+    void inclusive_scan(T const* src, std::size_t rows, std::size_t columns,
+        std::size_t src_ld, T* dst, std::size_t dst_ld, Op op, T init)
+    {
+        std::size_t const size = rows * columns;
+        if (size == 0)
+        {
+            return;
+        }
+
+        if (size < detail::scan_parallel_threshold)
+        {
+            detail::scan_for_each_piece(src, src_ld, dst, dst_ld, columns,
+                0, size, [&](T const* s, T* d, std::size_t n) {
+                    init = detail::scan_sequential(s, n, d, op, init);
+                });
+            return;
+        }
+
+        constexpr std::size_t chunk_size = detail::scan_chunk_size;
+        std::size_t const chunks = (size + chunk_size - 1) / chunk_size;
+
+        auto for_each_piece = [&](std::size_t chunk, auto&& f) {
+            std::size_t const first = chunk * chunk_size;
+            detail::scan_for_each_piece(src, src_ld, dst, dst_ld, columns,
+                first, (std::min)(size, first + chunk_size), f);
+        };
+
+        // reduce all but the last chunk
+        std::vector<T> carries(chunks, init);
+        hpx::for_loop(hpx::execution::par, std::size_t(0), chunks - 1,
+            [&](std::size_t chunk) {
+                Op chunk_op = op;
+                bool first = true;
+                T total{};
+                for_each_piece(chunk, [&](T const* s, T*, std::size_t n) {
+                    T const value = detail::scan_reduce(s, n, chunk_op);
+                    total = first ? value : chunk_op(total, value);
+                    first = false;
+                });
+                carries[chunk + 1] = std::move(total);
+            });
+
+        // carry of every chunk
+        for (std::size_t chunk = 1; chunk != chunks; ++chunk)
+        {
+            carries[chunk] = op(carries[chunk - 1], carries[chunk]);
+        }
+
+        // scan all chunks starting from their carry
+        hpx::for_loop(hpx::execution::par, std::size_t(0), chunks,
+            [&](std::size_t chunk) {
+                Op chunk_op = op;
+                T value = carries[chunk];
+                for_each_piece(chunk, [&](T const* s, T* d, std::size_t n) {
+                    value = detail::scan_sequential(s, n, d, chunk_op, value);
+                });
+            });
+    }
+
+    // inclusive scan of a contiguous sequence
+    template <typename T, typename Op>
+    void inclusive_scan(
+        T const* src, std::size_t size, T* dst, Op op, T init)
+    {
+        inclusive_scan(src, 1, size, size, dst, size, std::move(op),
+            std::move(init));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Inclusive scans along one axis of an array viewed as outer x length x
+    // inner elements, where the element (o, k, i) is located at
+    // o * stride[0] + k * stride[1] + i * stride[2]. Every one of the
+    // outer * inner lanes is scanned independently starting from init. The
+    // innermost lanes are processed in blocks, which allows to vectorize the
+    // scan over neighboring lanes if their elements are contiguous.
+    template <typename T, typename Op>
+    void inclusive_scan_axis(T const* src,
+        std::array<std::size_t, 3> const& src_strides, T* dst,
+        std::array<std::size_t, 3> const& dst_strides,
+        std::array<std::size_t, 3> const& dims, Op op, T init)
+    {
+        std::size_t const outer = dims[0];
+        std::size_t const length = dims[1];
+        std::size_t const inner = dims[2];
+        if (outer * length * inner == 0)
+        {
+            return;
+        }
+
+        constexpr std::size_t block_size = detail::scan_lane_block_size;
+        std::size_t const blocks = (inner + block_size - 1) / block_size;
+
+        detail::scan_for_loop(outer * length * inner, outer * blocks,
+            [&](std::size_t task) {
+                Op lane_op = op;
+                std::size_t const o = task / blocks;
+                std::size_t const first = (task % blocks) * block_size;
+                std::size_t const last = (std::min)(inner, first + block_size);
+
+                T const* s = src + o * src_strides[0];
+                T* d = dst + o * dst_strides[0];
+                for (std::size_t i = first; i != last; ++i)
+                {
+                    d[i * dst_strides[2]] =
+                        lane_op(init, s[i * src_strides[2]]);
+                }
+
+                for (std::size_t k = 1; k != length; ++k)
+                {
+                    T const* s_k = s + k * src_strides[1];
+                    T const* d_prev = d + (k - 1) * dst_strides[1];
+                    T* d_k = d + k * dst_strides[1];
+                    for (std::size_t i = first; i != last; ++i)
+                    {
+                        d_k[i * dst_strides[2]] =
+                            lane_op(d_prev[i * dst_strides[2]],
+                                s_k[i * src_strides[2]]);
+                    }
+                }
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Stream compaction: calls f(i, pos) for every set bit i of the mask,
+    // where pos is the number of set bits before i. The number of set bits
+    // is passed to allocate(count) before f is called for the first time and
+    // is returned. Large masks are processed in parallel, using an exclusive
+    // scan over the number of set bits in every chunk.
+    template <typename Allocate, typename F>
+    std::size_t compact(bit_mask const& mask, Allocate&& allocate, F&& f)
+    {
+        constexpr std::size_t chunk_words =
+            detail::scan_chunk_size / bit_mask::word_bits;
+
+        std::size_t const words = mask.words().size();
+        std::size_t const chunks = (words + chunk_words - 1) / chunk_words;
+
+        // number of set bits in every chunk
+        std::vector<std::size_t> offsets(chunks + 1, 0);
+        detail::scan_for_loop(mask.size(), chunks, [&](std::size_t chunk) {
+            std::size_t const first = chunk * chunk_words;
+            offsets[chunk + 1] =
+                mask.count(first, (std::min)(words, first + chunk_words));
+        });
+
+        // position of the first set bit of every chunk
+        for (std::size_t chunk = 0; chunk != chunks; ++chunk)
+        {
+            offsets[chunk + 1] += offsets[chunk];
+        }
+
+        std::size_t const count = offsets[chunks];
+        allocate(count);
+
+        detail::scan_for_loop(mask.size(), chunks, [&](std::size_t chunk) {
+            std::size_t const first = chunk * chunk_words;
+            std::size_t pos = offsets[chunk];
+            mask.for_each_set(first, (std::min)(words, first + chunk_words),
+                [&](std::size_t i) { f(i, pos++); });
+        });
+
+        return count;
+    }
+
+    // Stream compaction over the indices [0, size) for which pred(i) holds,
+    // the predicate is evaluated exactly once for every index
+    template <typename Pred, typename Allocate, typename F>
+    std::size_t compact(
+        std::size_t size, Pred&& pred, Allocate&& allocate, F&& f)
+    {
+        return compact(
+            bit_mask::from_predicate(size, std::forward<Pred>(pred)),
+            std::forward<Allocate>(allocate), std::forward<F>(f));
+    }
+}}
+
+#endif
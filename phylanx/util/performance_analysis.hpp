@@ -0,0 +1,102 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PERFORMANCE_ANALYSIS)
+#define PHYLANX_UTIL_PERFORMANCE_ANALYSIS
+
+#include <phylanx/config.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    struct topology;
+}}
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The measurements of one primitive instance (all times in nanoseconds)
+    struct primitive_performance
+    {
+        std::string name;               // full name of the instance
+        std::string location;           // <codename>:<line>
+        std::int64_t count = 0;         // number of evaluations
+        std::int64_t inclusive_time = 0;
+        std::int64_t self_time = 0;
+        bool critical = false;          // instance is on the critical path
+    };
+
+    /// The measurements of all primitive instances created for the same
+    /// line of the source code
+    struct location_performance
+    {
+        std::string location;           // <codename>:<line>
+        std::int64_t count = 0;
+        std::int64_t inclusive_time = 0;
+        std::int64_t self_time = 0;
+    };
+
+    struct performance_analysis
+    {
+        std::string codename;
+
+        // sorted by decreasing self time
+        std::vector<primitive_performance> primitives;
+        std::vector<location_performance> locations;
+
+        // names of the instances on the critical path, starting at the root
+        std::vector<std::string> critical_path;
+
+        std::int64_t total_time = 0;            // sum of all self times
+        std::int64_t critical_path_time = 0;    // sum of the self times on
+                                                // the critical path
+        double parallelism = 0.0;               // total/critical path time
+
+        // self time per call stack (with frames separated by ';')
+        std::vector<std::pair<std::string, std::int64_t>> folded_stacks;
+    };
+
+    /// Analyze the performance counter data of the primitives in the given
+    /// expression topology.
+    ///
+    /// \param codename The name of the code source the topology was
+    ///                 compiled from
+    /// \param t        The topology of the execution tree (as returned by
+    ///                 get_expression_topology)
+    /// \param counter_data The performance counter data of the primitives
+    ///                 (as returned by retrieve_counter_data)
+    ///
+    /// The inclusive time of a primitive is the accumulated time of its
+    /// evaluations, which contains the time spent waiting for its operands.
+    /// Its self (exclusive) time is the part of the inclusive time not
+    /// covered by the inclusive times of its operands. The operands of a
+    /// primitive are assumed to be evaluated concurrently, the critical path
+    /// is therefore the path from the root to a leaf of the topology with
+    /// the largest sum of self times, and the achieved parallelism is the
+    /// ratio of the total self time and the self time on the critical path.
+    /// As with the other topology based tools, every primitive instance is
+    /// accounted for only at its first occurrence in the topology.
+    ///
+    PHYLANX_EXPORT performance_analysis analyze_performance(
+        std::string const& codename, execution_tree::topology const& t,
+        std::map<std::string, std::vector<std::int64_t>> const& counter_data);
+
+    /// Print the analysis as a human readable report
+    PHYLANX_EXPORT void print_performance_report(
+        std::ostream& os, performance_analysis const& analysis);
+
+    /// Print the self times per call stack as folded stacks (one line per
+    /// stack, as understood by flamegraph.pl and speedscope)
+    PHYLANX_EXPORT void print_folded_stacks(
+        std::ostream& os, performance_analysis const& analysis);
+}}
+
+#endif
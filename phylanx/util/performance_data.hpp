@@ -127,5 +127,41 @@ namespace phylanx { namespace util
     ///
     PHYLANX_EXPORT std::map<std::string, std::vector<std::int64_t>>
     retrieve_counter_data(hpx::id_type const& locality_id = hpx::find_here());
+
+    /// Retrieve the memory accounting data for all primitives
+    ///
+    /// \param locality_id The locality the performance counter data is going
+    ///                 to be queried from
+    ///
+    /// \return a std::map containing key/value pairs of primitive
+    ///         instances (names)/memory accounting data (allocated, live,
+    ///         and peak bytes)
+    ///
+    /// \note Querying the memory counters enables the memory accounting on
+    ///       the given locality, see enable_memory_accounting.
+    ///
+    /// \exception hpx::exception
+    ///
+    PHYLANX_EXPORT std::map<std::string, std::vector<std::int64_t>>
+    retrieve_memory_data(hpx::id_type const& locality_id = hpx::find_here());
+
+    /// Retrieve the hardware counter data for all primitives
+    ///
+    /// \param locality_id The locality the performance counter data is going
+    ///                 to be queried from
+    ///
+    /// \return a std::map containing key/value pairs of primitive
+    ///         instances (names)/hardware counter data (number of
+    ///         evaluations, cycles, instructions, last level cache misses,
+    ///         and branch misses)
+    ///
+    /// \note Querying the hardware counters enables their sampling on the
+    ///       given locality, see enable_hardware_counters.
+    ///
+    /// \exception hpx::exception
+    ///
+    PHYLANX_EXPORT std::map<std::string, std::vector<std::int64_t>>
+    retrieve_hardware_counter_data(
+        hpx::id_type const& locality_id = hpx::find_here());
 }}
 #endif
@@ -0,0 +1,311 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PERMUTE_AXES_HPP)
+#define PHYLANX_UTIL_PERMUTE_AXES_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+// Cache blocked kernels permuting the axes of 2d, 3d, and 4d arrays. The
+// output is always written contiguously. If the innermost axis stays in
+// place whole rows are copied, otherwise the two axes which are contiguous in
+// the input and in the output form a matrix which is transposed in tiles
+// small enough to stay in the L1 cache. The tiles are transposed using fixed
+// size micro tiles which the compiler keeps in vector registers. Large arrays
+// are processed in parallel, distributing the outer indices and the tiles
+// over the cores.
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        // edge length of the tiles handled by one task
+        constexpr std::size_t permute_tile_size = 64;
+
+        // edge length of the micro tiles transposed in registers
+        constexpr std::size_t permute_micro_size = 8;
+
+        // minimal number of elements for which the work is done in parallel
+        constexpr std::size_t permute_parallel_threshold = 32768;
+
+        template <typename F>
+        void permute_for_loop(std::size_t size, std::size_t count, F&& f)
+        {
+            if (size >= permute_parallel_threshold && count > 1)
+            {
+                hpx::for_loop(hpx::execution::par, std::size_t(0), count,
+                    std::forward<F>(f));
+            }
+            else
+            {
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    f(i);
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // dst(j, i) = src(i, j) for a micro tile
+        template <typename T>
+        void transpose_micro_tile(T const* src, std::size_t src_ld, T* dst,
+            std::size_t dst_ld)
+        {
+            constexpr std::size_t size = permute_micro_size;
+
+            T tile[size][size];
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                for (std::size_t j = 0; j != size; ++j)
+                {
+                    tile[j][i] = src[i * src_ld + j];
+                }
+            }
+            for (std::size_t j = 0; j != size; ++j)
+            {
+                for (std::size_t i = 0; i != size; ++i)
+                {
+                    dst[j * dst_ld + i] = tile[j][i];
+                }
+            }
+        }
+
+        // dst(j, i) = src(i, j) for a rows x columns block
+        template <typename T>
+        void transpose_block(T const* src, std::size_t src_ld, T* dst,
+            std::size_t dst_ld, std::size_t rows, std::size_t columns)
+        {
+            constexpr std::size_t size = permute_micro_size;
+
+            std::size_t i = 0;
+            for (/**/; i + size <= rows; i += size)
+            {
+                std::size_t j = 0;
+                for (/**/; j + size <= columns; j += size)
+                {
+                    transpose_micro_tile(src + i * src_ld + j, src_ld,
+                        dst + j * dst_ld + i, dst_ld);
+                }
+                for (/**/; j != columns; ++j)
+                {
+                    for (std::size_t k = i; k != i + size; ++k)
+                    {
+                        dst[j * dst_ld + k] = src[k * src_ld + j];
+                    }
+                }
+            }
+            for (/**/; i != rows; ++i)
+            {
+                for (std::size_t j = 0; j != columns; ++j)
+                {
+                    dst[j * dst_ld + i] = src[i * src_ld + j];
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // dst(i_axes[0], ..., i_axes[N-1]) = src(i_0, ..., i_N-1), where the
+        // dimensions and strides of the source are given in source order and
+        // the strides of the destination are given in destination order. The
+        // innermost stride of both has to be one.
+        template <typename T, std::size_t N>
+        void permute_axes(T const* src, std::array<std::size_t, N> const& dims,
+            std::array<std::size_t, N> const& src_strides,
+            std::array<std::size_t, N> const& axes, T* dst,
+            std::array<std::size_t, N> const& dst_strides)
+        {
+            static_assert(N >= 2, "permute_axes requires at least 2d arrays");
+
+            // dimensions and source strides in destination order
+            std::array<std::size_t, N> out_dims, in_strides;
+            std::size_t size = 1;
+            for (std::size_t k = 0; k != N; ++k)
+            {
+                out_dims[k] = dims[axes[k]];
+                in_strides[k] = src_strides[axes[k]];
+                size *= out_dims[k];
+            }
+            if (size == 0)
+            {
+                return;
+            }
+
+            // destination axis corresponding to the innermost source axis
+            std::size_t const inner =
+                std::find(axes.begin(), axes.end(), N - 1) - axes.begin();
+
+            // the outer indices enumerate all destination axes but the
+            // innermost one and the one which is contiguous in the source
+            std::array<std::size_t, N> outer_dims;
+            std::size_t outer_count = 1;
+            for (std::size_t k = 0; k != N - 1; ++k)
+            {
+                outer_dims[k] = (k == inner) ? 1 : out_dims[k];
+                outer_count *= outer_dims[k];
+            }
+
+            auto offsets = [&](std::size_t outer) {
+                std::pair<std::size_t, std::size_t> result(0, 0);
+                for (std::size_t k = N - 1; k-- != 0; /**/)
+                {
+                    std::size_t const idx = outer % outer_dims[k];
+                    outer /= outer_dims[k];
+                    result.first += idx * in_strides[k];
+                    result.second += idx * dst_strides[k];
+                }
+                return result;
+            };
+
+            std::size_t const columns = out_dims[N - 1];
+            if (inner == N - 1)
+            {
+                // the innermost axis stays in place, copy whole rows
+                permute_for_loop(size, outer_count, [&](std::size_t outer) {
+                    auto const offset = offsets(outer);
+                    T const* from = src + offset.first;
+                    std::copy(from, from + columns, dst + offset.second);
+                });
+                return;
+            }
+
+            // transpose the matrices formed by the innermost axes of the
+            // source and the destination in tiles
+            constexpr std::size_t tile = permute_tile_size;
+
+            std::size_t const rows = out_dims[inner];
+            std::size_t const row_tiles = (rows + tile - 1) / tile;
+            std::size_t const column_tiles = (columns + tile - 1) / tile;
+            std::size_t const tiles = row_tiles * column_tiles;
+
+            std::size_t const src_ld = in_strides[N - 1];
+            std::size_t const dst_ld = dst_strides[inner];
+
+            permute_for_loop(
+                size, outer_count * tiles, [&](std::size_t task) {
+                    auto const offset = offsets(task / tiles);
+                    std::size_t const r = (task % tiles) / column_tiles;
+                    std::size_t const c = (task % tiles) % column_tiles;
+
+                    // the tile holds the source rows [c * tile, ...) and
+                    // source columns [r * tile, ...)
+                    std::size_t const first_row = c * tile;
+                    std::size_t const first_column = r * tile;
+                    transpose_block(
+                        src + offset.first + first_row * src_ld + first_column,
+                        src_ld,
+                        dst + offset.second + first_column * dst_ld +
+                            first_row,
+                        dst_ld, (std::min)(tile, columns - first_row),
+                        (std::min)(tile, rows - first_column));
+                });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // transpose of a matrix
+    template <typename Matrix>
+    blaze::DynamicMatrix<blaze::ElementType_t<Matrix>> permute_axes(
+        Matrix const& m)
+    {
+        blaze::DynamicMatrix<blaze::ElementType_t<Matrix>> result(
+            m.columns(), m.rows());
+
+        detail::permute_axes<blaze::ElementType_t<Matrix>, 2>(m.data(),
+            {m.rows(), m.columns()}, {m.spacing(), 1}, {1, 0}, result.data(),
+            {result.spacing(), 1});
+
+        return result;
+    }
+
+    // in-place transpose of a square matrix, swaps the tiles above the
+    // diagonal with the corresponding tiles below the diagonal
+    template <typename T>
+    void transpose_inplace(blaze::DynamicMatrix<T>& m)
+    {
+        if (m.rows() != m.columns())
+        {
+            m = permute_axes(m);
+            return;
+        }
+
+        constexpr std::size_t tile = detail::permute_tile_size;
+
+        std::size_t const n = m.rows();
+        std::size_t const ld = m.spacing();
+        std::size_t const tiles = (n + tile - 1) / tile;
+        T* data = m.data();
+
+        detail::permute_for_loop(n * n, tiles, [&](std::size_t r) {
+            std::size_t const first_row = r * tile;
+            std::size_t const last_row = (std::min)(n, first_row + tile);
+            for (std::size_t c = r; c != tiles; ++c)
+            {
+                std::size_t const first_column = c * tile;
+                std::size_t const last_column =
+                    (std::min)(n, first_column + tile);
+                for (std::size_t i = first_row; i != last_row; ++i)
+                {
+                    for (std::size_t j = (std::max)(first_column, i + 1);
+                         j < last_column; ++j)
+                    {
+                        std::swap(data[i * ld + j], data[j * ld + i]);
+                    }
+                }
+            }
+        });
+    }
+
+    // permutation of the axes of a tensor, the axes are given in the order
+    // used by blaze::trans
+    template <typename Tensor>
+    blaze::DynamicTensor<blaze::ElementType_t<Tensor>> permute_axes(
+        Tensor const& t, std::array<std::size_t, 3> const& axes)
+    {
+        std::array<std::size_t, 3> const dims = {
+            t.pages(), t.rows(), t.columns()};
+
+        blaze::DynamicTensor<blaze::ElementType_t<Tensor>> result(
+            dims[axes[0]], dims[axes[1]], dims[axes[2]]);
+
+        detail::permute_axes<blaze::ElementType_t<Tensor>, 3>(t.data(), dims,
+            {t.rows() * t.spacing(), t.spacing(), 1}, axes, result.data(),
+            {result.rows() * result.spacing(), result.spacing(), 1});
+
+        return result;
+    }
+
+    // permutation of the axes of a 4d array, the axes are given in the order
+    // used by blaze::trans
+    template <typename Array>
+    blaze::DynamicArray<4, blaze::ElementType_t<Array>> permute_axes(
+        Array const& q, std::array<std::size_t, 4> const& axes)
+    {
+        std::array<std::size_t, 4> const dims = {
+            q.quats(), q.pages(), q.rows(), q.columns()};
+
+        blaze::DynamicArray<4, blaze::ElementType_t<Array>> result(
+            dims[axes[0]], dims[axes[1]], dims[axes[2]], dims[axes[3]]);
+
+        detail::permute_axes<blaze::ElementType_t<Array>, 4>(q.data(), dims,
+            {q.pages() * q.rows() * q.spacing(), q.rows() * q.spacing(),
+                q.spacing(), 1},
+            axes, result.data(),
+            {result.pages() * result.rows() * result.spacing(),
+                result.rows() * result.spacing(), result.spacing(), 1});
+
+        return result;
+    }
+}}
+
+#endif
@@ -0,0 +1,234 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PRIMITIVE_TRACE_HPP)
+#define PHYLANX_UTIL_PRIMITIVE_TRACE_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/futures/future.hpp>
+#include <hpx/timing/high_resolution_clock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// The primitive tracer records the evaluations of all primitives into
+// per-thread ring buffers: each evaluation produces one event holding the
+// time it was started and the time its result became available, the worker
+// thread it was started on, the primitive, and the number of its operands
+// that are literal values rather than primitives. Every worker thread is the
+// only writer of its buffer, thus recording an event does not need any
+// synchronization. Once a buffer is full the oldest events are overwritten.
+//
+// While eval runs, every operand it requests from another primitive is
+// checked for readiness. The event counts the requested operands and the
+// ones that were still pending. Every pending operand additionally produces
+// a wait record covering the time from the request until the operand became
+// ready. Operands requested only after eval has returned (for instance from
+// a continuation) are not seen.
+//
+// The recorded events of all localities can be written in the Chrome Trace
+// Event format (as understood by chrome://tracing and Perfetto). Evaluations
+// that finished before eval returned are shown as slices of the worker
+// thread they ran on, evaluations that returned a future are shown as
+// asynchronous slices covering the time until the future became ready. The
+// waits for pending operands are shown as asynchronous slices nested into
+// the slice of the evaluation that requested them.
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    struct trace_event
+    {
+        std::uint64_t begin;            // start of eval (ns)
+        std::uint64_t end;              // result became available (ns)
+        std::uint64_t id;               // identifies the evaluation
+        std::uint32_t name;             // see register_trace_name
+        std::uint32_t worker;           // worker thread eval was started on
+        std::uint32_t operands;         // number of operands
+        std::uint32_t literal_operands; // operands that are not primitives
+        std::uint32_t requested;        // operands requested by eval
+        std::uint32_t pending;          // requested operands not ready
+        bool deferred;                  // eval returned a future
+        bool wait;                      // a wait for the pending operand
+                                        // with the index 'requested'
+    };
+
+    namespace detail
+    {
+        PHYLANX_EXPORT extern std::atomic<bool> tracing_enabled_;
+    }
+
+    /// Return whether primitive evaluations are currently traced on this
+    /// locality
+    inline bool tracing_enabled() noexcept
+    {
+        return detail::tracing_enabled_.load(std::memory_order_relaxed);
+    }
+
+    /// Enable (or disable) the tracing of primitive evaluations on all
+    /// localities. The events recorded so far are kept.
+    ///
+    /// \note The size of the per-thread ring buffers is given by the
+    ///       configuration setting 'phylanx.trace.buffer_size' (default:
+    ///       65536 events).
+    PHYLANX_EXPORT void enable_tracing(bool enable = true);
+
+    /// Discard the trace events recorded on all localities.
+    ///
+    /// \note This must not be called while primitives are being evaluated.
+    PHYLANX_EXPORT void clear_trace();
+
+    /// Write the trace events recorded on all localities to the given
+    /// stream (or file) in the Chrome Trace Event (JSON) format.
+    ///
+    /// \note This must not be called while primitives are being evaluated.
+    PHYLANX_EXPORT void write_trace(std::ostream& os);
+    PHYLANX_EXPORT void write_trace(std::string const& filename);
+
+    /// Return the trace events recorded on all localities in the Chrome
+    /// Trace Event (JSON) format.
+    PHYLANX_EXPORT std::string retrieve_trace();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Return the identifier used for the events of the primitive with the
+    /// given (full) name, the name is associated with the source location
+    /// the primitive was created for.
+    PHYLANX_EXPORT std::uint32_t register_trace_name(
+        std::string const& name, std::string const& codename);
+
+    /// Store the given event in the buffer of the current thread
+    PHYLANX_EXPORT void record_trace_event(trace_event const& event) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Records one evaluation, the event is stored once this object goes out
+    /// of scope (use keep_alive to extend its lifetime until the result of
+    /// an evaluation has become ready).
+    class trace_scope
+    {
+    public:
+        trace_scope() noexcept
+          : event_()
+          , enabled_(false)
+        {
+        }
+
+        PHYLANX_EXPORT trace_scope(std::uint32_t name, std::uint32_t operands,
+            std::uint32_t literal_operands) noexcept;
+
+        trace_scope(trace_scope const&) = delete;
+        trace_scope(trace_scope&& rhs) noexcept
+          : event_(rhs.event_)
+          , enabled_(rhs.enabled_)
+        {
+            rhs.enabled_ = false;
+        }
+
+        ~trace_scope()
+        {
+            if (enabled_)
+            {
+                event_.end = hpx::chrono::high_resolution_clock::now();
+                record_trace_event(event_);
+            }
+        }
+
+        trace_scope& operator=(trace_scope const&) = delete;
+        trace_scope& operator=(trace_scope&& rhs) = delete;
+
+        bool enabled() const noexcept
+        {
+            return enabled_;
+        }
+
+        // the result of the evaluation will become available later
+        void set_deferred() noexcept
+        {
+            event_.deferred = true;
+        }
+
+        // an operand was requested by the evaluation, return its index
+        std::uint32_t add_operand(bool ready) noexcept
+        {
+            if (!ready)
+            {
+                ++event_.pending;
+            }
+            return event_.requested++;
+        }
+
+        trace_event const& event() const noexcept
+        {
+            return event_;
+        }
+
+    private:
+        trace_event event_;
+        bool enabled_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Attributes the operands requested on the current HPX thread to the
+    /// given evaluation for as long as this object is alive.
+    class trace_operands
+    {
+    public:
+        PHYLANX_EXPORT explicit trace_operands(trace_scope& scope) noexcept;
+        PHYLANX_EXPORT ~trace_operands();
+
+        trace_operands(trace_operands const&) = delete;
+        trace_operands& operator=(trace_operands const&) = delete;
+
+    private:
+        std::size_t previous_;
+        bool active_;
+    };
+
+    namespace detail
+    {
+        // count an operand requested by the current evaluation, returns true
+        // and initializes the given wait record if the operand is not ready
+        PHYLANX_EXPORT bool trace_operand(
+            bool ready, trace_event& wait) noexcept;
+    }
+
+    /// Record that an operand requested by the current evaluation was
+    /// available right away
+    inline void trace_ready_operand()
+    {
+        if (tracing_enabled())
+        {
+            trace_event wait;
+            detail::trace_operand(true, wait);
+        }
+    }
+
+    /// Record whether the given operand (future) requested by the current
+    /// evaluation is ready, the wait for a pending operand is recorded once
+    /// it has become ready.
+    template <typename Future>
+    void trace_operand(Future const& f)
+    {
+        if (!tracing_enabled() || !f.valid())
+        {
+            return;
+        }
+
+        trace_event wait;
+        if (detail::trace_operand(f.is_ready(), wait))
+        {
+            auto const& state =
+                hpx::traits::future_access<Future>::get_shared_state(f);
+            state->set_on_completed([wait]() mutable {
+                wait.end = hpx::chrono::high_resolution_clock::now();
+                record_trace_event(wait);
+            });
+        }
+    }
+}}
+
+#endif
@@ -0,0 +1,206 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_REMOTE_TILE_CACHE_HPP)
+#define PHYLANX_UTIL_REMOTE_TILE_CACHE_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/modules/futures.hpp>
+#include <hpx/synchronization/spinlock_pool.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The remote tile cache keeps copies of tiles (or parts of tiles) that
+    /// were fetched from other localities by a distributed_vector or a
+    /// distributed_matrix. Entries are keyed by the basename of the
+    /// distributed object, the site the data was fetched from, and the
+    /// fetched range. Each entry records the version of the remote part it
+    /// was copied from.
+    ///
+    /// The version of a part is owned by the part itself: it is derived from
+    /// the contents whenever the part is stored and it is reset whenever the
+    /// part is accessed for modification. Every fetch sends the version of
+    /// the cached copy (if any) to the owning locality, which replies with
+    /// its current data only if the versions differ. A cached tile is never
+    /// used without this check, the cache saves the transfer of the data,
+    /// not the round trip.
+    ///
+    /// The cache is local to each locality and bounded by the configuration
+    /// setting 'phylanx.remote_tile_cache_size' (in bytes, disabled by
+    /// default).
+    struct remote_tile_cache_key
+    {
+        // the range value used for fetching a whole tile
+        static constexpr std::size_t whole_tile = std::size_t(-1);
+
+        std::string basename_;
+        std::size_t site_;
+        std::array<std::size_t, 4> range_;
+        std::type_index type_;
+
+        friend bool operator<(
+            remote_tile_cache_key const& lhs, remote_tile_cache_key const& rhs)
+        {
+            if (lhs.basename_ != rhs.basename_)
+                return lhs.basename_ < rhs.basename_;
+            if (lhs.site_ != rhs.site_)
+                return lhs.site_ < rhs.site_;
+            if (lhs.range_ != rhs.range_)
+                return lhs.range_ < rhs.range_;
+            return lhs.type_ < rhs.type_;
+        }
+    };
+
+    /// The version of a part that must not be cached, e.g. because it may
+    /// have been modified in place
+    constexpr std::uint64_t unversioned_tile = 0;
+
+    /// The reply to a fetch request, carrying the current version of the
+    /// fetched part
+    template <typename Data>
+    struct versioned_tile
+    {
+        std::uint64_t version_ = unversioned_tile;
+
+        // false if the version of the requester's copy is still current, in
+        // which case no data is sent
+        bool modified_ = true;
+        Data data_;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            // clang-format off
+            ar & version_ & modified_ & data_;
+            // clang-format on
+        }
+    };
+
+    namespace detail
+    {
+        struct remote_tile_cache_entry
+        {
+            std::shared_ptr<void const> data_;
+            std::uint64_t version_;
+        };
+
+        PHYLANX_EXPORT remote_tile_cache_entry remote_tile_cache_lookup(
+            remote_tile_cache_key const& key);
+
+        PHYLANX_EXPORT void remote_tile_cache_insert(
+            remote_tile_cache_key&& key, std::shared_ptr<void const> data,
+            std::uint64_t version, std::size_t size_in_bytes);
+
+        PHYLANX_EXPORT void remote_tile_cache_count_access(bool hit);
+
+        PHYLANX_EXPORT std::uint64_t remote_tile_cache_hash(
+            std::uint64_t seed, void const* data, std::size_t size_in_bytes);
+    }
+
+    /// Return whether the remote tile cache is enabled
+    PHYLANX_EXPORT bool remote_tile_cache_enabled();
+
+    /// Compute the version of a part from its contents, given as a sequence
+    /// of \a count contiguous blocks of \a size elements each (the rows of a
+    /// matrix or a vector as a single block). Unchanged data that is stored
+    /// again yields the same version, which keeps the cached copies of other
+    /// localities valid.
+    template <typename T, typename Block>
+    std::uint64_t remote_tile_cache_version(
+        std::size_t count, std::size_t size, Block&& block)
+    {
+        std::uint64_t version = detail::remote_tile_cache_hash(
+            0, &count, sizeof(count));
+        version = detail::remote_tile_cache_hash(version, &size, sizeof(size));
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            T const* data = block(i);
+            version = detail::remote_tile_cache_hash(
+                version, data, size * sizeof(T));
+        }
+        return version == unversioned_tile ? 1 : version;
+    }
+
+    /// Fetch a tile through the remote tile cache. \a fetch_if_modified is
+    /// invoked with the version of the cached copy (or unversioned_tile) and
+    /// returns a future of the corresponding versioned_tile<Data>.
+    template <typename Data, typename F, typename SizeF>
+    hpx::future<Data> remote_tile_cache_fetch(std::string const& basename,
+        std::size_t site, std::array<std::size_t, 4> const& range,
+        std::int64_t* transferred_bytes, F&& fetch_if_modified,
+        SizeF&& size_in_bytes)
+    {
+        remote_tile_cache_key key{
+            basename, site, range, std::type_index(typeid(Data))};
+
+        detail::remote_tile_cache_entry cached =
+            detail::remote_tile_cache_lookup(key);
+        if (!cached.data_)
+        {
+            cached.version_ = unversioned_tile;
+        }
+
+        hpx::future<versioned_tile<Data>> f =
+            fetch_if_modified(cached.version_);
+
+        return f.then(hpx::launch::sync,
+            [key = std::move(key), cached = std::move(cached),
+                transferred_bytes, size_in_bytes](
+                hpx::future<versioned_tile<Data>>&& f) mutable -> Data {
+                versioned_tile<Data> tile = f.get();
+                if (!tile.modified_)
+                {
+                    detail::remote_tile_cache_count_access(true);
+                    return *std::static_pointer_cast<Data const>(
+                        cached.data_);
+                }
+
+                detail::remote_tile_cache_count_access(false);
+
+                std::size_t size = size_in_bytes(tile.data_);
+                if (transferred_bytes != nullptr)
+                {
+                    using spinlock_pool =
+                        hpx::util::spinlock_pool<std::uint64_t>;
+
+                    std::lock_guard<hpx::util::detail::spinlock> l(
+                        spinlock_pool::spinlock_for(transferred_bytes));
+
+                    *transferred_bytes += size;
+                }
+
+                if (tile.version_ != unversioned_tile)
+                {
+                    detail::remote_tile_cache_insert(std::move(key),
+                        std::make_shared<Data const>(tile.data_),
+                        tile.version_, size);
+                }
+                return std::move(tile.data_);
+            });
+    }
+
+    /// Remove all entries from the remote tile cache
+    PHYLANX_EXPORT void remote_tile_cache_clear();
+
+    /// Performance counter data for the remote tile cache
+    PHYLANX_EXPORT std::int64_t remote_tile_cache_hits(bool reset);
+    PHYLANX_EXPORT std::int64_t remote_tile_cache_misses(bool reset);
+    PHYLANX_EXPORT std::int64_t remote_tile_cache_evictions(bool reset);
+    PHYLANX_EXPORT std::int64_t remote_tile_cache_size(bool reset);
+}}
+
+#endif
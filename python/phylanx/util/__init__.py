@@ -32,3 +32,49 @@ Args:
     dummy.__doc__ = ds[n:]
     dummy.__name__ = fname
     help(dummy)
+
+
+class trace(object):
+    """Context manager recording all primitive evaluations performed while
+it is active. The timeline of the evaluations is written to the given file
+(in the Chrome Trace Event format, which can be loaded into chrome://tracing
+or Perfetto) when the context is left.
+
+Args:
+    filename (string) : the name of the file to write the timeline to
+    """
+
+    def __init__(self, filename):
+        self.filename = filename
+
+    def __enter__(self):
+        clear_trace()
+        enable_tracing(True)
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        enable_tracing(False)
+        write_trace(self.filename)
+        return False
+
+
+def performance_analysis(func):
+    """Return the performance analysis of the last invocation of a Phylanx
+function decorated with @Phylanx(performance=True): a report listing the
+self time of all primitives and source lines, the critical path, and the
+achieved parallelism, and the self times as folded stacks (which can be
+turned into a flame graph using flamegraph.pl or speedscope).
+
+Args:
+    func (function) : the decorated function
+
+Returns:
+    a tuple (report, folded_stacks) of strings
+    """
+    from phylanx.ast.physl import PhySL
+
+    backend = func.backend
+    result = retrieve_performance_analysis(
+        PhySL.compiler_state, backend.file_name,
+        backend.wrapped_function.__name__)
+    return tuple(result) if result else (None, None)
@@ -573,6 +573,67 @@ namespace phylanx { namespace bindings
             });
     }
 
+    // retrieve the performance analysis (report and folded stacks) for the
+    // given expression
+    std::list<std::string> retrieve_performance_analysis(
+        compiler_state& state, std::string const& file_name,
+        std::string const& xexpr_str)
+    {
+        if (!state.enable_measurements)
+        {
+            return std::list<std::string>{};
+        }
+
+        pybind11::gil_scoped_release release;       // release GIL
+
+        return hpx::threads::run_as_hpx_thread(
+            [&]() -> std::list<std::string>
+            {
+                phylanx::execution_tree::compile(
+                    file_name, xexpr_str, state.eval_snippets, state.eval_env);
+
+                auto const& program = state.eval_snippets.program_;
+
+                std::set<std::string> resolve_children;
+                for (auto const& ep : program.entry_points())
+                {
+                    for (auto const& f : ep.functions())
+                    {
+                        resolve_children.insert(f.name_);
+                    }
+                }
+                for (auto const& entry : program.scratchpad())
+                {
+                    for (auto const& f : entry.second)
+                    {
+                        resolve_children.insert(f.name_);
+                    }
+                }
+
+                auto topology = program.get_expression_topology(
+                    std::set<std::string>{}, std::move(resolve_children));
+
+                // make sure all counters 'know' about all primitives
+                hpx::reinit_active_counters();
+
+                auto const analysis = phylanx::util::analyze_performance(
+                    file_name, topology,
+                    phylanx::util::retrieve_counter_data(
+                        state.primitive_instances));
+
+                std::ostringstream report;
+                phylanx::util::print_performance_report(report, analysis);
+
+                std::ostringstream folded_stacks;
+                phylanx::util::print_folded_stacks(folded_stacks, analysis);
+
+                std::list<std::string> result;
+                result.push_back(report.str());
+                result.push_back(folded_stacks.str());
+                return result;
+            });
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     template <pybind11::return_value_policy policy =
                   pybind11::return_value_policy::automatic_reference>
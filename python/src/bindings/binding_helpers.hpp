@@ -242,6 +242,12 @@ namespace phylanx { namespace bindings
     std::list<std::string> retrieve_tree_topology(compiler_state& state,
         std::string const& file_name, std::string const& xexpr_str);
 
+    // retrieve the performance analysis (report and folded stacks) for the
+    // given expression
+    std::list<std::string> retrieve_performance_analysis(
+        compiler_state& state, std::string const& file_name,
+        std::string const& xexpr_str);
+
     // retrieve tree topology in DOT format for given expression
     std::string retrieve_dot_tree_topology(compiler_state& state,
         std::string const& file_name, std::string const& xexpr_str);
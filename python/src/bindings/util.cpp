@@ -14,9 +14,11 @@
 
 #include <pybind11/pybind11.h>
 
+#include <hpx/include/run_as.hpp>
 #include <hpx/iostream.hpp>
 
 #include <cstdint>
+#include <list>
 #include <vector>
 #include <map>
 #include <sstream>
@@ -111,4 +113,46 @@ void phylanx::bindings::bind_util(pybind11::module m)
             return strm.str();
         },
         "return all the output generated through the debug() primitive");
+
+    util.def("retrieve_performance_analysis",
+        phylanx::bindings::retrieve_performance_analysis,
+        "retrieve the self time per primitive and per source line, the "
+        "critical path, and the achieved parallelism for the given execution "
+        "tree (as a report and as folded stacks)");
+
+    util.def(
+        "enable_tracing",
+        [](bool enable) {
+            pybind11::gil_scoped_release release;    // release GIL
+            hpx::threads::run_as_hpx_thread(
+                [&]() { phylanx::util::enable_tracing(enable); });
+        },
+        pybind11::arg("enable") = true,
+        "enable (or disable) the tracing of all primitive evaluations");
+    util.def(
+        "clear_trace",
+        []() {
+            pybind11::gil_scoped_release release;    // release GIL
+            hpx::threads::run_as_hpx_thread(
+                []() { phylanx::util::clear_trace(); });
+        },
+        "discard all recorded primitive evaluations");
+    util.def(
+        "write_trace",
+        [](std::string const& filename) {
+            pybind11::gil_scoped_release release;    // release GIL
+            hpx::threads::run_as_hpx_thread(
+                [&]() { phylanx::util::write_trace(filename); });
+        },
+        "write the recorded primitive evaluations to a file (in the Chrome "
+        "Trace Event format)");
+    util.def(
+        "retrieve_trace",
+        []() -> std::string {
+            pybind11::gil_scoped_release release;    // release GIL
+            return hpx::threads::run_as_hpx_thread(
+                []() { return phylanx::util::retrieve_trace(); });
+        },
+        "return the recorded primitive evaluations (in the Chrome Trace "
+        "Event format)");
 }
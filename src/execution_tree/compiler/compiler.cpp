@@ -593,6 +593,62 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             return last->second;
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Collect the calls of the function 'name' to itself that are in tail
+        // position: the body itself, the last statement of a block(), or a
+        // branch of an if(). Function bodies nested inside are not searched.
+        static void find_tail_calls(std::string const& name,
+            ast::expression const& expr,
+            environment::tail_calls_type& calls)
+        {
+            if (!ast::detail::is_function_call(expr))
+            {
+                return;
+            }
+
+            std::string function_name = ast::detail::function_name(expr);
+            std::vector<ast::expression> args =
+                ast::detail::function_arguments(expr);
+
+            if (function_name == name)
+            {
+                // calls directed to a specific locality are left alone
+                if (ast::detail::function_attribute(expr).empty())
+                {
+                    ast::tagged id = ast::detail::tagged_id(expr);
+                    calls.emplace(id.id, id.col);
+                }
+            }
+            else if (function_name == "block" && !args.empty())
+            {
+                // a local definition of the same name hides the function
+                for (auto const& arg : args)
+                {
+                    if (ast::detail::is_function_call(arg) &&
+                        ast::detail::function_name(arg) == "define")
+                    {
+                        auto define_args = ast::detail::function_arguments(arg);
+                        if (!define_args.empty() &&
+                            ast::detail::is_identifier(define_args[0]) &&
+                            ast::detail::identifier_name(define_args[0]) ==
+                                name)
+                        {
+                            return;
+                        }
+                    }
+                }
+                find_tail_calls(name, args.back(), calls);
+            }
+            else if (function_name == "if" &&
+                (args.size() == 2 || args.size() == 3))
+            {
+                for (std::size_t i = 1; i != args.size(); ++i)
+                {
+                    find_tail_calls(name, args[i], calls);
+                }
+            }
+        }
+
         ///////////////////////////////////////////////////////////////////////
         std::pair<std::string, function> extract_default_argument_value(
             ast::expression const& arg, hpx::id_type const& locality,
@@ -658,7 +714,8 @@ namespace phylanx { namespace execution_tree { namespace compiler {
         }
 
         function compile_body(std::vector<ast::expression> const& args,
-            ast::expression const& body, hpx::id_type const& locality) const
+            ast::expression const& body, hpx::id_type const& locality,
+            environment::tail_calls_type tail_calls = {}) const
         {
 #if !defined(PHYLANX_HAVE_CXX17_SHARED_PTR_ARRAY)
             boost::shared_array<std::string> named_args;
@@ -669,6 +726,10 @@ namespace phylanx { namespace execution_tree { namespace compiler {
 
             bool has_default_value = false;
             environment env(&env_, args.size());
+            if (!tail_calls.empty())
+            {
+                env.set_tail_calls(std::move(tail_calls), base_arg_num);
+            }
             for (std::size_t i = 0; i != args.size(); ++i)
             {
                 ast::tagged id = ast::detail::tagged_id(args[i]);
@@ -748,9 +809,12 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             return f;
         }
 
+        // 'self' is the name of a function defined using define(), its calls
+        // to itself in tail position are compiled into loops
         function compile_lambda(std::vector<ast::expression> const& args,
             ast::expression const& body, ast::tagged const& id,
-            hpx::id_type const& locality)
+            hpx::id_type const& locality, std::string const& self = "",
+            bool memoize = false)
         {
             function& f = snippets_.program_.add_empty(name_);
 
@@ -760,13 +824,43 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                 snippets_.sequence_numbers_[define_lambda_]++, id.id, id.col,
                 snippets_.compile_id_ - 1, get_locality_id(locality));
 
+            environment::tail_calls_type tail_calls;
+            if (!self.empty())
+            {
+                // an argument of the same name hides the function
+                bool hidden = false;
+                for (auto const& arg : args)
+                {
+                    if (ast::detail::is_identifier(arg) &&
+                        ast::detail::identifier_name(arg) == self)
+                    {
+                        hidden = true;
+                        break;
+                    }
+                }
+
+                if (!hidden)
+                {
+                    find_tail_calls(self, body, tail_calls);
+                }
+            }
+
+            primitive_arguments_type operands;
+            operands.emplace_back();
+            if (!tail_calls.empty() || memoize)
+            {
+                operands.emplace_back(!tail_calls.empty());
+                operands.emplace_back(memoize);
+            }
+
             std::string lambda_name = compose_primitive_name(name_parts);
             f = function{primitive_argument_type{create_primitive_component(
                              default_locality_, name_parts.primitive,
-                             primitive_argument_type{}, lambda_name, name_)},
+                             std::move(operands), lambda_name, name_)},
                 lambda_name};
 
-            function body_f = compile_body(args, body, locality);
+            function body_f =
+                compile_body(args, body, locality, std::move(tail_calls));
             f.set_named_args(
                 std::move(body_f.named_args_), body_f.num_named_args_);
 
@@ -792,7 +886,7 @@ namespace phylanx { namespace execution_tree { namespace compiler {
 
         function handle_define(placeholder_map_type& placeholders,
             ast::tagged const& define_id, hpx::id_type const& locality,
-            bool define_globally)
+            bool define_globally, bool memoize)
         {
             // we know that 'define()' uses '__1' to match arguments
             using iterator = placeholder_map_type::iterator;
@@ -866,6 +960,18 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             primitive_name_parts name_parts;
             if (args.empty())
             {
+                if (memoize)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::compiler::handle_define",
+                        generate_error_message(
+                            hpx::util::format(
+                                "the memoize attribute can be applied to "
+                                "function definitions only (variable: '{}')",
+                                name),
+                            name_, id));
+                }
+
                 // create variable in the current environment
                 compiled_function* cf = env_.define_variable(name,
                     access_target(f, "access-variable", default_locality_),
@@ -939,7 +1045,8 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                         primitive_argument_type{}, variable_name, name_)},
                     variable_name};
 
-                function body_f = compile_lambda(args, body, id, locality);
+                function body_f = compile_lambda(
+                    args, body, id, locality, name_parts.instance, memoize);
                 f.set_named_args(
                     std::move(body_f.named_args_), body_f.num_named_args_);
 
@@ -1456,6 +1563,38 @@ namespace phylanx { namespace execution_tree { namespace compiler {
             }
         }
 
+        function handle_tail_call(std::string name,
+            std::vector<ast::expression> const& argexprs,
+            std::size_t num_bound_args, hpx::id_type const& locality,
+            ast::tagged id)
+        {
+            static std::string tail_call_("tail-call");
+            primitive_name_parts name_parts(tail_call_,
+                snippets_.sequence_numbers_[tail_call_]++, id.id, id.col,
+                snippets_.compile_id_ - 1, get_locality_id(locality));
+            name_parts.instance = std::move(name);
+
+            primitive_arguments_type fargs;
+            fargs.reserve(argexprs.size() + 1);
+
+            // the number of arguments bound by enclosing functions, those are
+            // passed along unchanged
+            fargs.emplace_back(static_cast<std::int64_t>(num_bound_args));
+
+            if (!argexprs.empty())
+            {
+                handle_function_call_argument(
+                    name_parts.instance, fargs, argexprs, locality, id);
+            }
+
+            std::string full_name = compose_primitive_name(name_parts);
+            return function{
+                primitive_argument_type{create_primitive_component(locality,
+                    name_parts.primitive, std::move(fargs), full_name,
+                    name_)},
+                full_name};
+        }
+
         function handle_function_call(
             std::string name, ast::expression const& expr)
         {
@@ -1477,6 +1616,16 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                 std::vector<ast::expression> argexprs =
                     ast::detail::function_arguments(expr);
 
+                // a self-recursive call in tail position replaces the
+                // arguments of the current invocation instead of nesting
+                std::size_t num_bound_args = 0;
+                if (attr.empty() &&
+                    env_.is_tail_call(id.id, id.col, num_bound_args))
+                {
+                    return handle_tail_call(std::move(name), argexprs,
+                        num_bound_args, locality, id);
+                }
+
                 static std::string call_function_("call-function");
                 primitive_name_parts name_parts(call_function_,
                     snippets_.sequence_numbers_[call_function_]++, id.id,
@@ -1609,10 +1758,17 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                         {
                             // extract and propagate locality
                             hpx::id_type locality = default_locality_;
+                            bool memoize = false;
 
                             std::string attr =
                                 ast::detail::function_attribute(expr);
-                            if (!attr.empty())
+                            if (attr == "memoize")
+                            {
+                                // define{memoize}(f, ...) caches the results
+                                // of the (pure) function f
+                                memoize = true;
+                            }
+                            else if (!attr.empty())
                             {
                                 // a attribute on the define() could reference
                                 // a specific locality
@@ -1620,7 +1776,7 @@ namespace phylanx { namespace execution_tree { namespace compiler {
                             }
 
                             return handle_define(placeholders, id, locality,
-                                function_name != "define");
+                                function_name != "define", memoize);
                         }
                     }
 
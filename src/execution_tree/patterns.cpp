@@ -149,6 +149,7 @@ namespace phylanx { namespace execution_tree
                 // compiler-specific (internal) primitives
                 PHYLANX_MATCH_DATA(access_argument),
                 PHYLANX_MATCH_DATA(call_function),
+                PHYLANX_MATCH_DATA(tail_call),
                 PHYLANX_MATCH_DATA(target_reference),
 
                 PHYLANX_MATCH_DATA(access_function),
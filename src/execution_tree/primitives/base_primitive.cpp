@@ -14,11 +14,14 @@
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/future_or_value.hpp>
 #include <phylanx/util/generate_error_message.hpp>
+#include <phylanx/util/primitive_trace.hpp>
 #include <phylanx/util/repr_manip.hpp>
 #include <phylanx/util/small_vector.hpp>
 
 #include <hpx/include/actions.hpp>
+#include <hpx/include/agas.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/components.hpp>
 #include <hpx/include/serialization.hpp>
@@ -29,7 +32,9 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <iosfwd>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
@@ -145,6 +150,7 @@ namespace phylanx { namespace execution_tree
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::unwrap_result(this->base_type::get_id()), params,
             std::move(ctx));
+        util::trace_operand(f);
         return detail::lazy_trace("eval", *this, std::move(f));
     }
     hpx::future<primitive_argument_type> primitive::eval(
@@ -154,6 +160,7 @@ namespace phylanx { namespace execution_tree
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::unwrap_result(this->base_type::get_id()), std::move(params),
             std::move(ctx));
+        util::trace_operand(f);
         return detail::lazy_trace("eval", *this, std::move(f));
     }
 
@@ -164,6 +171,7 @@ namespace phylanx { namespace execution_tree
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::unwrap_result(this->base_type::get_id()), std::move(param),
             std::move(ctx));
+        util::trace_operand(f);
         return detail::lazy_trace("eval", *this, std::move(f));
     }
 
@@ -180,6 +188,7 @@ namespace phylanx { namespace execution_tree
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::launch::sync, hpx::unwrap_result(this->base_type::get_id()),
             params, std::move(ctx));
+        util::trace_operand(f);
         return detail::trace("eval", *this, f.get());
     }
     primitive_argument_type primitive::eval(hpx::launch::sync_policy,
@@ -189,6 +198,7 @@ namespace phylanx { namespace execution_tree
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::launch::sync, hpx::unwrap_result(this->base_type::get_id()),
             std::move(params), std::move(ctx));
+        util::trace_operand(f);
         return detail::trace("eval", *this, f.get());
     }
 
@@ -199,6 +209,7 @@ namespace phylanx { namespace execution_tree
         hpx::future<primitive_argument_type> f = hpx::async<action_type>(
             hpx::launch::sync, hpx::unwrap_result(this->base_type::get_id()),
             std::move(param), std::move(ctx));
+        util::trace_operand(f);
         return detail::trace("eval", *this, f.get());
     }
 
@@ -209,9 +220,70 @@ namespace phylanx { namespace execution_tree
         static primitive_arguments_type params;
         hpx::future<primitive_argument_type> f = hpx::sync<action_type>(
             this->base_type::get_id(), std::move(params), std::move(ctx));
+        util::trace_operand(f);
         return detail::trace("eval", *this, f.get());
     }
 
+    util::future_or_value<primitive_argument_type>
+    primitive::eval_future_or_value(
+        primitive_arguments_type const& params, eval_context ctx) const
+    {
+        hpx::naming::address addr;
+        if (!hpx::agas::is_local_address_cached(
+                this->base_type::get_id(), addr))
+        {
+            return eval(params, std::move(ctx));
+        }
+
+        // the component stays pinned as long as it is referenced by this
+        // pointer
+        std::shared_ptr<primitives::primitive_component> component =
+            hpx::get_ptr<primitives::primitive_component>(
+                hpx::launch::sync, this->base_type::get_id());
+
+        // the execution policy is selected exactly once for each
+        // evaluation, the eval action would select it again
+        if (component->select_eval_execution(hpx::launch::async) !=
+            hpx::launch::sync)
+        {
+            hpx::future<primitive_argument_type> f = hpx::async(
+                [component = std::move(component), params,
+                    ctx = std::move(ctx)]() mutable {
+                    return component->eval(params, std::move(ctx));
+                });
+            util::trace_operand(f);
+            return detail::lazy_trace("eval", *this, std::move(f));
+        }
+
+        // the action would be executed synchronously anyways, invoke the
+        // component directly to avoid creating a future for its result,
+        // errors are reported through the result, as for eval
+        try
+        {
+            util::future_or_value<primitive_argument_type> result =
+                component->eval_future_or_value(params, std::move(ctx));
+            if (result.is_ready())
+            {
+                util::trace_ready_operand();
+                return detail::trace("eval", *this, result.get());
+            }
+
+            hpx::future<primitive_argument_type> f =
+                result.get_future().then(hpx::launch::sync,
+                    [component = std::move(component)](
+                        hpx::future<primitive_argument_type>&& f) {
+                        return f.get();
+                    });
+            util::trace_operand(f);
+            return detail::lazy_trace("eval", *this, std::move(f));
+        }
+        catch (...)
+        {
+            return hpx::make_exceptional_future<primitive_argument_type>(
+                std::current_exception());
+        }
+    }
+
     hpx::future<void> primitive::store(primitive_arguments_type&& data,
         primitive_arguments_type&& params, eval_context ctx)
     {
@@ -3184,6 +3256,74 @@ namespace phylanx { namespace execution_tree
             std::move(val), std::move(args), name, codename, std::move(ctx));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail {
+
+        template <typename Val>
+        inline util::future_or_value<primitive_argument_type>
+        value_operand_future_or_value_helper(Val&& val,
+            primitive_arguments_type const& args, std::string const& name,
+            std::string const& codename, eval_context ctx)
+        {
+            auto* p = util::get_if<primitive>(&val);
+            if (p != nullptr)
+            {
+                util::future_or_value<primitive_argument_type> result =
+                    p->eval_future_or_value(args, ctx);
+                if (result.is_ready())
+                {
+                    return result.get();
+                }
+
+                return result.get_future().then(hpx::launch::sync,
+                    [&, ctx = std::move(ctx)](
+                        hpx::future<primitive_argument_type>&& f) {
+                        return extract_value(f.get(), name, codename);
+                    });
+            }
+
+            auto* fp = util::get_if<util::recursive_wrapper<
+                hpx::shared_future<primitive_argument_type>>>(&val);
+            if (fp != nullptr)
+            {
+                hpx::shared_future<primitive_argument_type> const& f =
+                    fp->get();
+                if (f.is_ready())
+                {
+                    return value_operand_future_or_value_helper(
+                        f.get(), args, name, codename, std::move(ctx));
+                }
+                return value_operand_helper_args(std::forward<Val>(val),
+                    args, name, codename, std::move(ctx));
+            }
+
+            if (valid(val))
+            {
+                return extract_ref_value(
+                    std::forward<Val>(val), name, codename);
+            }
+            return primitive_argument_type{std::forward<Val>(val)};
+        }
+    }    // namespace detail
+
+    util::future_or_value<primitive_argument_type>
+    value_operand_future_or_value(primitive_argument_type const& val,
+        primitive_arguments_type const& args, std::string const& name,
+        std::string const& codename, eval_context ctx)
+    {
+        return detail::value_operand_future_or_value_helper(
+            val, args, name, codename, std::move(ctx));
+    }
+
+    util::future_or_value<primitive_argument_type>
+    value_operand_future_or_value(primitive_argument_type&& val,
+        primitive_arguments_type const& args, std::string const& name,
+        std::string const& codename, eval_context ctx)
+    {
+        return detail::value_operand_future_or_value_helper(
+            std::move(val), args, name, codename, std::move(ctx));
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     namespace detail {
 
@@ -3513,6 +3653,74 @@ namespace phylanx { namespace execution_tree
             std::move(val), std::move(args), name, codename, std::move(ctx));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail {
+
+        template <typename Val>
+        inline util::future_or_value<primitive_argument_type>
+        literal_operand_future_or_value_helper(Val&& val,
+            primitive_arguments_type const& args, std::string const& name,
+            std::string const& codename, eval_context ctx)
+        {
+            auto* p = util::get_if<primitive>(&val);
+            if (p != nullptr)
+            {
+                util::future_or_value<primitive_argument_type> result =
+                    p->eval_future_or_value(args, std::move(ctx));
+                if (result.is_ready())
+                {
+                    return extract_literal_value(
+                        result.get(), name, codename);
+                }
+
+                return result.get_future().then(hpx::launch::sync,
+                    [&](hpx::future<primitive_argument_type>&& f) {
+                        return extract_literal_value(f.get(), name, codename);
+                    });
+            }
+
+            auto* fp = util::get_if<util::recursive_wrapper<
+                hpx::shared_future<primitive_argument_type>>>(&val);
+            if (fp != nullptr)
+            {
+                hpx::shared_future<primitive_argument_type> const& f =
+                    fp->get();
+                if (f.is_ready())
+                {
+                    return literal_operand_future_or_value_helper(
+                        f.get(), args, name, codename, std::move(ctx));
+                }
+                return literal_operand_helper_args(std::forward<Val>(val),
+                    args, name, codename, std::move(ctx));
+            }
+
+            if (valid(val))
+            {
+                return extract_literal_ref_value(
+                    std::forward<Val>(val), name, codename);
+            }
+            return primitive_argument_type{std::forward<Val>(val)};
+        }
+    }    // namespace detail
+
+    util::future_or_value<primitive_argument_type>
+    literal_operand_future_or_value(primitive_argument_type const& val,
+        primitive_arguments_type const& args, std::string const& name,
+        std::string const& codename, eval_context ctx)
+    {
+        return detail::literal_operand_future_or_value_helper(
+            val, args, name, codename, std::move(ctx));
+    }
+
+    util::future_or_value<primitive_argument_type>
+    literal_operand_future_or_value(primitive_argument_type&& val,
+        primitive_arguments_type const& args, std::string const& name,
+        std::string const& codename, eval_context ctx)
+    {
+        return detail::literal_operand_future_or_value_helper(
+            std::move(val), args, name, codename, std::move(ctx));
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type literal_operand_sync(
         primitive_argument_type const& val, primitive_arguments_type const& args,
@@ -55,7 +55,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             Returns:
 
-                <nothing>)")
+                <nothing>
+
+            A function defined with define{memoize} caches its results for
+            up to 'phylanx.memoize_cache_size' (default: 4096) different
+            arguments, the least recently used results are dropped first.)")
     };
 
     match_pattern_type const define_variable::match_data_define_globally =
@@ -11,9 +11,13 @@
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -36,7 +40,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             Returns:
 
-            A function object with the arguments and body specified.)"
+            A function object with the arguments and body specified.
+
+            Functions defined with define{memoize} keep the results of up to
+            'phylanx.memoize_cache_size' (default: 4096) different invocations,
+            the least recently used results are dropped first.)"
             )
     };
 
@@ -45,13 +53,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::string const& name, std::string const& codename)
       : primitive_component_base(std::move(args), name, codename)
     {
-        // the first entry of operands represents the target
-        if (operands_.size() != 1)
+        // the first entry of operands represents the target, the optional
+        // second and third entries tell whether the body contains
+        // self-recursive calls in tail position and whether the results of
+        // the function should be memoized
+        if (operands_.empty() || operands_.size() > 3)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "lambda::lambda",
                 generate_error_message(
-                    "the lambda primitive needs exactly one argument"));
+                    "the lambda primitive needs between one and three "
+                    "arguments"));
         }
 
         if (valid(operands_[0]))
@@ -59,6 +71,73 @@ namespace phylanx { namespace execution_tree { namespace primitives
             operands_[0] =
                 extract_copy_value(std::move(operands_[0]), name_, codename_);
         }
+
+        if (operands_.size() > 1)
+        {
+            has_tail_calls_ = extract_scalar_boolean_value(
+                operands_[1], name_, codename_) != 0;
+        }
+        if (operands_.size() > 2)
+        {
+            memoize_ = extract_scalar_boolean_value(
+                operands_[2], name_, codename_) != 0;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Only invocations with scalar boolean, integer, or floating point
+        // arguments are memoized. The key combines the type and the bit
+        // pattern of each of the arguments.
+        bool make_memo_key(primitive_arguments_type const& args,
+            std::vector<std::int64_t>& key)
+        {
+            key.reserve(2 * args.size());
+            for (auto const& arg : args)
+            {
+                if (auto const* b =
+                        util::get_if<ir::node_data<std::uint8_t>>(&arg))
+                {
+                    if (b->num_dimensions() != 0)
+                    {
+                        return false;
+                    }
+                    key.push_back(0);
+                    key.push_back(b->scalar() != 0 ? 1 : 0);
+                }
+                else if (auto const* i =
+                             util::get_if<ir::node_data<std::int64_t>>(&arg))
+                {
+                    if (i->num_dimensions() != 0)
+                    {
+                        return false;
+                    }
+                    key.push_back(1);
+                    key.push_back(i->scalar());
+                }
+                else if (auto const* d =
+                             util::get_if<ir::node_data<double>>(&arg))
+                {
+                    if (d->num_dimensions() != 0)
+                    {
+                        return false;
+                    }
+
+                    double value = d->scalar();
+                    std::int64_t bits = 0;
+                    std::memcpy(&bits, &value, sizeof(bits));
+
+                    key.push_back(2);
+                    key.push_back(bits);
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -94,12 +173,144 @@ namespace phylanx { namespace execution_tree { namespace primitives
             return hpx::make_ready_future(primitive_argument_type{});
         }
 
-        // simply invoke the given body with the given arguments
         eval_context next_ctx = set_mode(std::move(ctx),
             eval_mode(eval_dont_evaluate_lambdas | eval_dont_wrap_functions));
 
-        return value_operand(operands_[0], args, name_, codename_,
-            add_frame(std::move(next_ctx), name_, codename_));
+        if (!has_tail_calls_ && !memoize_)
+        {
+            // simply invoke the given body with the given arguments
+            return value_operand(operands_[0], args, name_, codename_,
+                add_frame(std::move(next_ctx), name_, codename_));
+        }
+
+        primitive_arguments_type fargs;
+        fargs.reserve(args.size());
+        for (auto const& arg : args)
+        {
+            fargs.push_back(extract_value(arg, name_, codename_));
+        }
+
+        if (memoize_)
+        {
+            return eval_memoized(std::move(fargs), std::move(next_ctx));
+        }
+        return eval_body(std::move(fargs), std::move(next_ctx));
+    }
+
+    hpx::future<primitive_argument_type> lambda::eval_body(
+        primitive_arguments_type&& args, eval_context ctx) const
+    {
+        while (true)
+        {
+            // Every iteration runs in a new variable frame, which releases
+            // the frame of the previous iteration. Reusing the frame would
+            // leak the variables of one iteration into closures created by
+            // an earlier one.
+            eval_context next_ctx =
+                add_frame(eval_context(ctx), name_, codename_);
+            std::shared_ptr<variable_frame> frame = next_ctx.variables_;
+
+            hpx::future<primitive_argument_type> f = value_operand(
+                operands_[0], args, name_, codename_, std::move(next_ctx));
+
+            if (!f.is_ready())
+            {
+                auto this_ = this->shared_from_this();
+                return f.then(hpx::launch::sync,
+                    [this_ = std::move(this_), frame = std::move(frame),
+                        ctx = std::move(ctx)](
+                        hpx::future<primitive_argument_type>&& result) mutable
+                    ->  hpx::future<primitive_argument_type>
+                    {
+                        primitive_arguments_type args;
+                        if (result.has_exception() ||
+                            !frame->extract_tail_call(args))
+                        {
+                            return std::move(result);
+                        }
+
+                        frame.reset();
+                        return this_->eval_body(
+                            std::move(args), std::move(ctx));
+                    });
+            }
+
+            // the body has completed synchronously, loop with the arguments
+            // of a pending tail call
+            if (f.has_exception() || !frame->extract_tail_call(args))
+            {
+                return f;
+            }
+        }
+    }
+
+    hpx::future<primitive_argument_type> lambda::eval_memoized(
+        primitive_arguments_type&& args, eval_context ctx) const
+    {
+        memo_key_type key;
+        if (!detail::make_memo_key(args, key))
+        {
+            return eval_body(std::move(args), std::move(ctx));
+        }
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            auto it = memo_index_.find(key);
+            if (it != memo_index_.end())
+            {
+                memo_.splice(memo_.begin(), memo_, it->second);
+                return hpx::make_ready_future(it->second->second);
+            }
+        }
+
+        // concurrent invocations with the same arguments may both evaluate
+        // the body, the function is required to be pure anyways
+        auto this_ = this->shared_from_this();
+        return eval_body(std::move(args), std::move(ctx))
+            .then(hpx::launch::sync,
+                [this_ = std::move(this_), key = std::move(key)](
+                    hpx::future<primitive_argument_type>&& f) mutable
+                ->  primitive_argument_type
+                {
+                    primitive_argument_type result = f.get();
+
+                    std::size_t const cache_size = get_memo_cache_size();
+                    if (cache_size == 0)
+                    {
+                        return result;
+                    }
+
+                    primitive_argument_type value =
+                        extract_copy_value(primitive_argument_type(result),
+                            this_->name_, this_->codename_);
+
+                    std::lock_guard<mutex_type> l(this_->mtx_);
+                    if (this_->memo_index_.find(key) !=
+                        this_->memo_index_.end())
+                    {
+                        return result;
+                    }
+
+                    // evict the least recently used results
+                    while (this_->memo_.size() >= cache_size)
+                    {
+                        this_->memo_index_.erase(this_->memo_.back().first);
+                        this_->memo_.pop_back();
+                    }
+
+                    this_->memo_.emplace_front(key, std::move(value));
+                    this_->memo_index_.emplace(
+                        std::move(key), this_->memo_.begin());
+                    return result;
+                });
+    }
+
+    // get the number of memoized results from command line
+    std::size_t lambda::get_memo_cache_size()
+    {
+        static std::size_t memo_cache_size = std::stoull(
+            hpx::get_config_entry("phylanx.memoize_cache_size", "4096"));
+        return memo_cache_size;
     }
 
     void lambda::store(primitive_arguments_type&& data,
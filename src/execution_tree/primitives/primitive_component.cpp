@@ -7,6 +7,7 @@
 #include <phylanx/execution_tree/compile.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/util/future_or_value.hpp>
 
 #include <hpx/include/actions.hpp>
 #include <hpx/include/components.hpp>
@@ -138,6 +139,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return primitive_->do_eval(std::move(param), std::move(ctx));
     }
 
+    util::future_or_value<primitive_argument_type>
+    primitive_component::eval_future_or_value(
+        primitive_arguments_type const& params, eval_context ctx) const
+    {
+        if ((ctx.mode_ & eval_dont_evaluate_partials) &&
+            primitive_->no_operands())
+        {
+            // return a client referring to this component as the evaluation
+            // result
+            primitive this_{this->get_id()};
+            return primitive_argument_type{std::move(this_)};
+        }
+        return primitive_->do_eval_future_or_value(params, std::move(ctx));
+    }
+
     // store_action
     void primitive_component::store(primitive_arguments_type&& args,
         primitive_arguments_type&& params, eval_context ctx)
@@ -183,6 +199,56 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return primitive_->get_direct_execution(reset);
     }
 
+    std::int64_t primitive_component::get_sync_eval_count(bool reset) const
+    {
+        return primitive_->get_sync_eval_count(reset);
+    }
+
+    std::int64_t primitive_component::get_async_eval_count(bool reset) const
+    {
+        return primitive_->get_async_eval_count(reset);
+    }
+
+    std::int64_t primitive_component::get_eval_estimate(bool reset) const
+    {
+        return primitive_->get_eval_estimate(reset);
+    }
+
+    std::int64_t primitive_component::get_allocated_bytes(bool reset) const
+    {
+        return primitive_->get_allocated_bytes(reset);
+    }
+
+    std::int64_t primitive_component::get_live_bytes(bool reset) const
+    {
+        return primitive_->get_live_bytes(reset);
+    }
+
+    std::int64_t primitive_component::get_peak_bytes(bool reset) const
+    {
+        return primitive_->get_peak_bytes(reset);
+    }
+
+    std::int64_t primitive_component::get_cycles(bool reset) const
+    {
+        return primitive_->get_cycles(reset);
+    }
+
+    std::int64_t primitive_component::get_instructions(bool reset) const
+    {
+        return primitive_->get_instructions(reset);
+    }
+
+    std::int64_t primitive_component::get_llc_misses(bool reset) const
+    {
+        return primitive_->get_llc_misses(reset);
+    }
+
+    std::int64_t primitive_component::get_branch_misses(bool reset) const
+    {
+        return primitive_->get_branch_misses(reset);
+    }
+
     std::int64_t primitive_component::get_transferred_bytes(bool reset) const
     {
         return primitive_->get_transferred_bytes(reset);
@@ -193,29 +259,30 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_->enable_measurements();
     }
 
-    hpx::launch primitive_component::select_direct_execution(
-        primitive_component::eval_action, hpx::launch policy,
-        hpx::naming::address_type lva)
+    hpx::launch primitive_component::select_eval_execution(
+        hpx::launch policy) const
     {
-        auto this_ = hpx::get_lva<primitive_component>::call(lva);
 #if defined(PHYLANX_HAVE_TASK_INLINING_POLICY) && defined(HPX_HAVE_APEX)
-        return this_->primitive_->select_direct_eval_policy_thres(policy);
+        return primitive_->select_direct_eval_policy_thres(policy);
 #else
-        return this_->primitive_->select_direct_eval_execution(policy);
+        return primitive_->select_direct_eval_execution(policy);
 #endif
     }
 
+    hpx::launch primitive_component::select_direct_execution(
+        primitive_component::eval_action, hpx::launch policy,
+        hpx::naming::address_type lva)
+    {
+        return hpx::get_lva<primitive_component>::call(lva)
+            ->select_eval_execution(policy);
+    }
+
     hpx::launch primitive_component::select_direct_execution(
         primitive_component::eval_single_action, hpx::launch policy,
         hpx::naming::address_type lva)
     {
-        auto this_ = hpx::get_lva<primitive_component>::call(lva);
-#if defined(PHYLANX_HAVE_TASK_INLINING_POLICY) && defined(HPX_HAVE_APEX)
-        return this_->primitive_
-            ->select_direct_eval_policy_thres(policy);
-#else
-        return this_->primitive_->select_direct_eval_execution(policy);
-#endif
+        return hpx::get_lva<primitive_component>::call(lva)
+            ->select_eval_execution(policy);
     }
 }}}
 
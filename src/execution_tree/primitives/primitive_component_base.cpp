@@ -7,6 +7,10 @@
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/util/adaptive_execution_policy.hpp>
+#include <phylanx/util/hardware_counters.hpp>
+#include <phylanx/util/memory_accounting.hpp>
+#include <phylanx/util/primitive_trace.hpp>
 #include <phylanx/util/scoped_timer.hpp>
 
 #include <hpx/async_base/launch_policy.hpp>
@@ -16,6 +20,7 @@
 #include <hpx/modules/naming.hpp>
 #include <hpx/runtime_local/config_entry.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
@@ -46,6 +51,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
       , eval_duration_(0ll)
       , execute_directly_(eval_direct ? 1 : -1)
       , measurements_enabled_(false)
+      , eval_direct_(eval_direct)
+      , sync_eval_count_(0ll)
+      , async_eval_count_(0ll)
+      , trace_name_(-1)
     {
 #if defined(HPX_HAVE_APEX)
         eval_name_ = name_ + "::eval";
@@ -66,6 +75,25 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             T t_;
         };
+
+        // attributes the memory held by the result of an evaluation to the
+        // primitive once the result has become available
+        template <typename SharedState>
+        struct account_memory
+        {
+            void operator()() const
+            {
+                hpx::error_code ec(hpx::lightweight);
+                auto const* result = state_->get_result(ec);
+                if (!ec && result != nullptr)
+                {
+                    memory_->record(util::memory_footprint(*result));
+                }
+            }
+
+            SharedState* state_;
+            util::memory_accounting* memory_;
+        };
     }
 
     std::string primitive_component_base::extract_function_name(
@@ -98,48 +126,42 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::forward<T>(t));
     }
 
-    hpx::future<primitive_argument_type> primitive_component_base::do_eval(
-        primitive_arguments_type const& params,
-        eval_context ctx) const
+    template <typename Future>
+    void account_memory(util::memory_accounting& memory, Future const& f)
     {
-#if defined(HPX_HAVE_APEX)
-        hpx::scoped_annotation annotate(eval_name_.c_str());
-#endif
-
-        // perform measurements only when needed
-        bool enable_timer = measurements_enabled_ || (execute_directly_ == -1);
-
-        util::scoped_timer<std::int64_t> timer(eval_duration_, enable_timer);
-        if (enable_timer)
+        auto const& state =
+            hpx::traits::future_access<Future>::get_shared_state(f);
+        if (!state)
         {
-            ++eval_count_;
+            return;
         }
 
-        auto f = this->eval(params, std::move(ctx));
+        using shared_state_type =
+            typename std::decay<decltype(*state)>::type;
 
-        if (enable_timer && !f.is_ready())
-        {
-            using shared_state_ptr =
-                typename hpx::traits::detail::shared_state_ptr_for<
-                    decltype(f)>::type;
-            shared_state_ptr const& state =
-                hpx::traits::future_access<decltype(f)>::get_shared_state(f);
+        detail::account_memory<shared_state_type> account{
+            state.get(), &memory};
 
-            state->set_on_completed(keep_alive(std::move(timer)));
+        if (f.is_ready())
+        {
+            account();
+        }
+        else
+        {
+            state->set_on_completed(std::move(account));
         }
-
-        return f;
     }
 
-    hpx::future<primitive_argument_type> primitive_component_base::do_eval(
-        primitive_argument_type&& param, eval_context ctx) const
+    template <typename F>
+    util::future_or_value<primitive_argument_type>
+    primitive_component_base::instrumented_eval(F&& eval) const
     {
 #if defined(HPX_HAVE_APEX)
         hpx::scoped_annotation annotate(eval_name_.c_str());
 #endif
 
         // perform measurements only when needed
-        bool enable_timer = measurements_enabled_ || (execute_directly_ == -1);
+        bool enable_timer = measure_eval();
 
         util::scoped_timer<std::int64_t> timer(eval_duration_, enable_timer);
         if (enable_timer)
@@ -147,20 +169,79 @@ namespace phylanx { namespace execution_tree { namespace primitives
             ++eval_count_;
         }
 
-        auto f = this->eval(std::move(param), std::move(ctx));
+        util::trace_scope trace = trace_eval();
+
+        util::future_or_value<primitive_argument_type> result;
+        {
+            util::hardware_counter_scope counters(hardware_counters_);
+            util::trace_operands operands(trace);
+            result = eval();
+        }
 
-        if (enable_timer && !f.is_ready())
+        bool const memory_accounting = util::memory_accounting_enabled();
+        if (result.is_ready())
+        {
+            if (memory_accounting && !result.has_exception())
+            {
+                primitive_argument_type value = result.get();
+                memory_.record(util::memory_footprint(value));
+                return value;
+            }
+        }
+        else if (enable_timer || trace.enabled() || memory_accounting)
         {
-            using shared_state_ptr =
-                typename hpx::traits::detail::shared_state_ptr_for<
-                    decltype(f)>::type;
-            shared_state_ptr const& state =
-                hpx::traits::future_access<decltype(f)>::get_shared_state(f);
+            // the shared state is needed anyways to attach the timer
+            auto f = result.get_future();
+
+            if (memory_accounting)
+            {
+                account_memory(memory_, f);
+            }
 
-            state->set_on_completed(keep_alive(std::move(timer)));
+            if (enable_timer || trace.enabled())
+            {
+                using shared_state_ptr =
+                    typename hpx::traits::detail::shared_state_ptr_for<
+                        decltype(f)>::type;
+                shared_state_ptr const& state = hpx::traits::future_access<
+                    decltype(f)>::get_shared_state(f);
+
+                trace.set_deferred();
+                state->set_on_completed(keep_alive(
+                    std::make_pair(std::move(timer), std::move(trace))));
+            }
+            return f;
         }
 
-        return f;
+        return result;
+    }
+
+    hpx::future<primitive_argument_type> primitive_component_base::do_eval(
+        primitive_arguments_type const& params,
+        eval_context ctx) const
+    {
+        return instrumented_eval(
+            [&]() -> util::future_or_value<primitive_argument_type> {
+                return this->eval(params, std::move(ctx));
+            }).get_future();
+    }
+
+    hpx::future<primitive_argument_type> primitive_component_base::do_eval(
+        primitive_argument_type&& param, eval_context ctx) const
+    {
+        return instrumented_eval(
+            [&]() -> util::future_or_value<primitive_argument_type> {
+                return this->eval(std::move(param), std::move(ctx));
+            }).get_future();
+    }
+
+    util::future_or_value<primitive_argument_type>
+    primitive_component_base::do_eval_future_or_value(
+        primitive_arguments_type const& params, eval_context ctx) const
+    {
+        return instrumented_eval([&]() {
+            return this->eval_future_or_value(params, std::move(ctx));
+        });
     }
 
     // eval_action
@@ -194,6 +275,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 std::move(ctx)));
     }
 
+    util::future_or_value<primitive_argument_type>
+    primitive_component_base::eval_future_or_value(
+        primitive_arguments_type const& params, eval_context ctx) const
+    {
+        return this->eval(params, std::move(ctx));
+    }
+
+    util::future_or_value<primitive_argument_type>
+    primitive_component_base::eval_future_or_value(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        return this->eval(operands, args, std::move(ctx));
+    }
+
     // store_action
     void primitive_component_base::store(primitive_arguments_type&&,
         primitive_arguments_type&&, eval_context ctx)
@@ -303,6 +399,96 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return hpx::util::get_and_reset_value(execute_directly_, reset);
     }
 
+    std::int64_t primitive_component_base::get_sync_eval_count(
+        bool reset) const
+    {
+        if (reset)
+        {
+            return sync_eval_count_.exchange(0, std::memory_order_relaxed);
+        }
+        return sync_eval_count_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t primitive_component_base::get_async_eval_count(
+        bool reset) const
+    {
+        if (reset)
+        {
+            return async_eval_count_.exchange(0, std::memory_order_relaxed);
+        }
+        return async_eval_count_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t primitive_component_base::get_eval_estimate(bool) const
+    {
+        return adaptive_policy_.estimate();
+    }
+
+    std::int64_t primitive_component_base::get_allocated_bytes(
+        bool reset) const
+    {
+        return memory_.allocated_bytes(reset);
+    }
+
+    std::int64_t primitive_component_base::get_live_bytes(bool reset) const
+    {
+        return memory_.live_bytes(reset);
+    }
+
+    std::int64_t primitive_component_base::get_peak_bytes(bool reset) const
+    {
+        return memory_.peak_bytes(reset);
+    }
+
+    std::int64_t primitive_component_base::get_cycles(bool reset) const
+    {
+        return hardware_counters_.get(util::hardware_cycles, reset);
+    }
+
+    std::int64_t primitive_component_base::get_instructions(bool reset) const
+    {
+        return hardware_counters_.get(util::hardware_instructions, reset);
+    }
+
+    std::int64_t primitive_component_base::get_llc_misses(bool reset) const
+    {
+        return hardware_counters_.get(util::hardware_llc_misses, reset);
+    }
+
+    std::int64_t primitive_component_base::get_branch_misses(
+        bool reset) const
+    {
+        return hardware_counters_.get(util::hardware_branch_misses, reset);
+    }
+
+    util::trace_scope primitive_component_base::trace_eval() const
+    {
+        if (!util::tracing_enabled())
+        {
+            return util::trace_scope{};
+        }
+
+        std::int64_t name = trace_name_.load(std::memory_order_relaxed);
+        if (name == -1)
+        {
+            name = util::register_trace_name(name_, codename_);
+            trace_name_.store(name, std::memory_order_relaxed);
+        }
+
+        // operands that are literal values, not primitives
+        std::uint32_t literal_operands = 0;
+        for (auto const& operand : operands_)
+        {
+            if (util::get_if<primitive>(&operand) == nullptr)
+            {
+                ++literal_operands;
+            }
+        }
+
+        return util::trace_scope(std::uint32_t(name),
+            std::uint32_t(operands_.size()), literal_operands);
+    }
+
     std::int64_t primitive_component_base::get_transferred_bytes(bool reset) const
     {
         return 0;
@@ -539,8 +725,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 #endif
 
+    bool primitive_component_base::measure_eval() const
+    {
+        // the adaptive policy keeps sampling after it made a decision
+        return measurements_enabled_ || execute_directly_ == -1 ||
+            (!eval_direct_ && util::adaptive_execution_enabled() &&
+                adaptive_policy_.sample());
+    }
+
     hpx::launch primitive_component_base::select_direct_eval_execution(
         hpx::launch policy) const
+    {
+        hpx::launch result = select_eval_execution(policy);
+        if (result == hpx::launch::sync)
+        {
+            sync_eval_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            async_eval_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    hpx::launch primitive_component_base::select_eval_execution(
+        hpx::launch policy) const
     {
         // always run this on an HPX thread
         if (hpx::threads::get_self_ptr() == nullptr)
@@ -554,7 +763,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
             return hpx::launch::sync;
         }
 
-        if ((eval_count_ != 0 && measurements_enabled_) ||
+        if (!eval_direct_ && util::adaptive_execution_enabled())
+        {
+            // compare the estimated cost of the evaluation with the
+            // overhead of spawning a task
+            adaptive_policy_.update(eval_count_, eval_duration_);
+            execute_directly_ = adaptive_policy_.decide();
+        }
+        else if ((eval_count_ != 0 && measurements_enabled_) ||
             (eval_count_ > get_ec_threshold()))
         {
             // check whether execution status needs to be changed (with some
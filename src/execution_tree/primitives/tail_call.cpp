@@ -0,0 +1,109 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/tail_call.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const tail_call::match_data =
+    {
+        hpx::make_tuple("tail-call",
+            std::vector<std::string>{},
+            nullptr, &create_primitive<tail_call>,
+            "Internal")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    tail_call::tail_call(primitive_arguments_type&& args,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(args), name, codename)
+    {
+        // the first entry of operands holds the number of arguments bound
+        // by the enclosing functions, the remaining entries represent the
+        // arguments of the call
+        if (this->no_operands())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "tail_call::tail_call",
+                generate_error_message(
+                    "the number of bound arguments was not given"));
+        }
+
+        std::int64_t num_bound_args =
+            extract_scalar_integer_value(operands_[0], name_, codename_);
+        if (num_bound_args < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "tail_call::tail_call",
+                generate_error_message(
+                    "the number of bound arguments must not be negative"));
+        }
+        num_bound_args_ = static_cast<std::size_t>(num_bound_args);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> tail_call::eval(
+        primitive_arguments_type const& params, eval_context ctx) const
+    {
+        if (!ctx)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "tail_call::eval",
+                generate_error_message(
+                    "the execution context used for the tail call is "
+                    "invalid"));
+        }
+
+        primitive_arguments_type fargs;
+        fargs.reserve(operands_.size() - 1);
+        for (auto it = operands_.begin() + 1; it != operands_.end(); ++it)
+        {
+            fargs.push_back(extract_ref_value(*it, name_, codename_));
+        }
+
+        // the arguments bound by the enclosing functions are passed along
+        // unchanged
+        std::size_t num_bound_args = (std::min)(num_bound_args_, params.size());
+
+        primitive_arguments_type args;
+        args.reserve(num_bound_args + fargs.size());
+        for (std::size_t i = 0; i != num_bound_args; ++i)
+        {
+            args.push_back(extract_value(params[i], name_, codename_));
+        }
+
+        // the arguments have to be evaluated in the current variable frame,
+        // only afterwards they may replace the arguments of the invocation
+        return hpx::dataflow(hpx::launch::sync, hpx::unwrapping(
+                [args = std::move(args), ctx](
+                        primitive_arguments_type&& fargs) mutable
+                ->  primitive_argument_type
+                {
+                    for (auto&& farg : fargs)
+                    {
+                        args.push_back(std::move(farg));
+                    }
+                    ctx.set_tail_call(std::move(args));
+                    return primitive_argument_type{};
+                }),
+            detail::map_operands(std::move(fargs), functional::value_operand{},
+                params, name_, codename_,
+                add_mode(ctx, eval_dont_evaluate_partials)));
+    }
+}}}
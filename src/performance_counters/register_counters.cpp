@@ -9,6 +9,10 @@
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/adaptive_execution_policy.hpp>
+#include <phylanx/util/hardware_counters.hpp>
+#include <phylanx/util/memory_accounting.hpp>
+#include <phylanx/util/remote_tile_cache.hpp>
 
 #include <hpx/include/agas.hpp>
 #include <hpx/include/components.hpp>
@@ -395,6 +399,250 @@ namespace phylanx { namespace performance_counters {
         return hpx::naming::invalid_gid;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Exposes a value accumulated by each of the primitives which is read
+    // through one of the accessors of the primitive component: the decisions
+    // of the execution policy, the memory held by the results, and the
+    // hardware counters sampled during the evaluations.
+    namespace detail
+    {
+        using primitive_component =
+            phylanx::execution_tree::primitives::primitive_component;
+
+        struct primitive_value_accessor
+        {
+            // last element of the counter name
+            char const* name;
+            std::int64_t (primitive_component::*value)(bool) const;
+
+            // enables collecting the value, if needed
+            void (*enable)(bool);
+        };
+
+        primitive_value_accessor const primitive_value_accessors[] = {
+            {"eval_sync", &primitive_component::get_sync_eval_count,
+                nullptr},
+            {"eval_async", &primitive_component::get_async_eval_count,
+                nullptr},
+            {"eval_estimate", &primitive_component::get_eval_estimate,
+                nullptr},
+            {"allocated_bytes", &primitive_component::get_allocated_bytes,
+                &util::enable_memory_accounting},
+            {"live_bytes", &primitive_component::get_live_bytes,
+                &util::enable_memory_accounting},
+            {"peak_bytes", &primitive_component::get_peak_bytes,
+                &util::enable_memory_accounting},
+            {"cycles", &primitive_component::get_cycles,
+                &util::enable_hardware_counters},
+            {"instructions", &primitive_component::get_instructions,
+                &util::enable_hardware_counters},
+            {"llc_misses", &primitive_component::get_llc_misses,
+                &util::enable_hardware_counters},
+            {"branch_misses", &primitive_component::get_branch_misses,
+                &util::enable_hardware_counters}};
+
+        primitive_value_accessor const* find_primitive_value_accessor(
+            std::string const& countername)
+        {
+            std::string const name =
+                countername.substr(countername.find_last_of('/') + 1);
+
+            for (auto const& accessor : primitive_value_accessors)
+            {
+                if (name == accessor.name)
+                {
+                    return &accessor;
+                }
+            }
+            return nullptr;
+        }
+    }    // namespace detail
+
+    class primitive_value_counter
+      : public hpx::performance_counters::base_performance_counter<
+            primitive_value_counter>
+    {
+    private:
+        using primitive_component = detail::primitive_component;
+        using value_function =
+            std::int64_t (primitive_component::*)(bool) const;
+
+    public:
+        primitive_value_counter()
+          : first_init_(false)
+          , value_(nullptr)
+          , enable_(nullptr)
+        {
+        }
+
+        primitive_value_counter(
+            hpx::performance_counters::counter_info const& info,
+            detail::primitive_value_accessor const& accessor)
+          : hpx::performance_counters::base_performance_counter<
+                primitive_value_counter>(info)
+          , first_init_(false)
+          , value_(accessor.value)
+          , enable_(accessor.enable)
+        {
+        }
+
+        // Produce the counter value
+        hpx::performance_counters::counter_values_array
+        get_counter_values_array(bool reset) override
+        {
+            // Need to call reinit here if it has never been called before.
+            bool expected = false;
+            if (first_init_.compare_exchange_strong(expected, true))
+            {
+                reinit(false);
+            }
+
+            hpx::performance_counters::counter_values_array value;
+
+            value.time_ = static_cast<std::int64_t>(hpx::get_system_uptime());
+            value.status_ = hpx::performance_counters::status_new_data;
+            value.count_ = ++invocation_count_;
+
+            std::vector<std::int64_t> result;
+            result.reserve(instances_.size());
+
+            // Extract the values from instances_
+            for (auto const& instance : instances_)
+            {
+                result.push_back(((*instance).*value_)(reset));
+            }
+
+            value.values_ = std::move(result);
+
+            return value;
+        }
+
+        // Retrieve the list of existing primitives for the current execution
+        // tree and keep it
+        void reinit(bool reset) override
+        {
+            // some of the values are meaningful only if collecting them was
+            // enabled
+            if (enable_ != nullptr)
+            {
+                enable_(true);
+            }
+
+            // Structure of primitives in symbolic namespace:
+            // /phylanx$<locality_id>/<primitive>$<sequence-nr>[$<instance>]/
+            //      <compile_id>$<tag>
+            auto entries = hpx::agas::find_symbols(hpx::launch::sync,
+                hpx::util::format("/phylanx${}/{}$*", hpx::get_locality_id(),
+                    detail::extract_primitive_type(info_)));
+
+            std::map<std::int64_t, base_primitive_ptr> instances_sorted;
+
+            for (auto const& value : entries)
+            {
+                auto const& instance =
+                    hpx::get_ptr<primitive_component>(
+                        hpx::launch::sync, value.second);
+
+                auto instance_info =
+                    phylanx::execution_tree::compiler::parse_primitive_name(
+                        value.first);
+
+                // Consider the reset flag
+                if (reset)
+                {
+                    ((*instance).*value_)(true);
+                }
+                instances_sorted[instance_info.sequence_number] = instance;
+            }
+
+            instances_.clear();
+            instances_.reserve(entries.size());
+            for (auto const& value : instances_sorted)
+            {
+                instances_.push_back(value.second);
+            }
+
+            first_init_ = true;
+        }
+
+    private:
+        using base_primitive_ptr = std::shared_ptr<primitive_component>;
+
+        std::vector<base_primitive_ptr> instances_;
+        std::atomic<bool> first_init_;
+        value_function value_;
+        void (*enable_)(bool);
+    };
+
+    hpx::naming::gid_type primitive_value_counter_creator(
+        hpx::performance_counters::counter_info const& info,
+        hpx::error_code& ec)
+    {
+        namespace pc = hpx::performance_counters;
+
+        // Break down the counter name
+        pc::counter_path_elements paths;
+        pc::get_counter_path_elements(info.fullname_, paths, ec);
+        if (ec)
+            return hpx::naming::invalid_gid;
+
+        // If another counter's name was give
+        if (paths.parentinstance_is_basename_)
+        {
+            HPX_THROWS_IF(ec, hpx::bad_parameter,
+                "primitive_value_counter_creator",
+                "invalid counter instance parent name: " +
+                    paths.parentinstancename_);
+            return hpx::naming::invalid_gid;
+        }
+
+        auto const* accessor =
+            detail::find_primitive_value_accessor(paths.countername_);
+        if (accessor == nullptr)
+        {
+            HPX_THROWS_IF(ec, hpx::bad_parameter,
+                "primitive_value_counter_creator",
+                "invalid counter name: " + paths.countername_);
+            return hpx::naming::invalid_gid;
+        }
+
+        if (paths.instancename_ == "total" && paths.instanceindex_ == -1)
+        {
+            pc::counter_info complemented_info = info;
+            pc::complement_counter_info(complemented_info, info, ec);
+            if (ec)
+                return hpx::naming::invalid_gid;
+
+            hpx::naming::gid_type id;
+            try
+            {
+                // Try constructing the actual counter
+                using primitive_value_counter_type =
+                    hpx::components::component<primitive_value_counter>;
+
+                id = hpx::components::server::construct<
+                    primitive_value_counter_type>(
+                    complemented_info, *accessor);
+            }
+            catch (hpx::exception const& e)
+            {
+                if (&ec == &hpx::throws)
+                    throw;
+                ec = hpx::make_error_code(e.get_error(), e.what());
+                return hpx::naming::invalid_gid;
+            }
+
+            if (&ec != &hpx::throws)
+                ec = hpx::make_success_code();
+            return id;
+        }
+
+        HPX_THROWS_IF(ec, hpx::bad_parameter,
+            "primitive_value_counter_creator",
+            "invalid counter instance name: " + paths.instancename_);
+        return hpx::naming::invalid_gid;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     class transferred_bytes_counter
       : public hpx::performance_counters::base_performance_counter<
@@ -584,6 +832,60 @@ namespace phylanx { namespace performance_counters {
             "returns the current value of the move-assignment count of "
             "any node_data<double>");
 
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/remote_tile_cache/count/hits",
+            &util::remote_tile_cache_hits,
+            "returns the number of remote tile fetches that were served "
+            "from the remote tile cache");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/remote_tile_cache/count/misses",
+            &util::remote_tile_cache_misses,
+            "returns the number of remote tile fetches that could not be "
+            "served from the remote tile cache");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/remote_tile_cache/count/evictions",
+            &util::remote_tile_cache_evictions,
+            "returns the number of tiles that were evicted or invalidated "
+            "in the remote tile cache");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/remote_tile_cache/size",
+            &util::remote_tile_cache_size,
+            "returns the current number of bytes held by the remote tile "
+            "cache",
+            "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/execution/task_spawn_overhead",
+            &util::task_spawn_overhead_counter,
+            "returns the measured overhead of spawning an HPX task, which "
+            "is used by the adaptive execution policy (zero if it was not "
+            "needed so far)",
+            "ns");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/memory/live_bytes",
+            &util::memory_live_bytes,
+            "returns the number of bytes held by the last results of all "
+            "primitives (if the memory accounting is enabled)",
+            "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/memory/peak_bytes",
+            &util::memory_peak_bytes,
+            "returns the largest number of bytes held by the last results "
+            "of all primitives at any point in time (if the memory "
+            "accounting is enabled)",
+            "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/hardware_counters/available",
+            &util::hardware_counters_available_counter,
+            "returns 1 if the hardware counters (Linux perf_event) can be "
+            "sampled for the primitives, 0 otherwise");
+
         // Iterate and register a time and count performance counter per each
         // primitive
         namespace et = phylanx::execution_tree;
@@ -624,6 +926,98 @@ namespace phylanx { namespace performance_counters {
                 &direct_execution_counter_creator,
                 &hpx::performance_counters::locality_counter_discoverer);
 
+            // Register the performance counters exposing the decisions of
+            // the execution policy
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/count/eval_sync",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of times "
+                "the eval function was executed directly for each " +
+                    name + " primitive",
+                &primitive_value_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/count/eval_async",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of times "
+                "the eval function was executed asynchronously for each " +
+                    name + " primitive",
+                &primitive_value_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/time/eval_estimate",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the estimated "
+                "execution time of the eval function used by the adaptive "
+                "execution policy for each " +
+                    name + " primitive (-1 if there is no estimate)",
+                &primitive_value_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "ns");
+
+            // Register the performance counters exposing the hardware
+            // counters accumulated during the evaluations of the primitive
+            struct hardware_event_info
+            {
+                char const* counter;
+                char const* description;
+            };
+
+            hardware_event_info const hardware_events[] = {
+                {"cycles", "CPU cycles"},
+                {"instructions", "retired instructions"},
+                {"llc_misses", "last level cache misses"},
+                {"branch_misses", "mispredicted branches"}};
+
+            for (auto const& event : hardware_events)
+            {
+                hpx::performance_counters::install_counter_type(
+                    "/phylanx/primitives/" + name + "/count/" + event.counter,
+                    hpx::performance_counters::counter_raw_values,
+                    std::string("returns a list whose elements contain the "
+                                "number of ") +
+                        event.description +
+                        " while executing the eval function (including the "
+                        "operands evaluated directly) for each " +
+                        name + " primitive",
+                    &primitive_value_counter_creator,
+                    &hpx::performance_counters::locality_counter_discoverer);
+            }
+
+            // Register the performance counters exposing the memory held by
+            // the results of the primitive
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/allocated_bytes",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the accumulated "
+                "number of bytes held by the results of each " +
+                    name + " primitive",
+                &primitive_value_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/live_bytes",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of bytes "
+                "held by the last result of each " +
+                    name + " primitive",
+                &primitive_value_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/peak_bytes",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the largest number "
+                "of bytes held by a result of each " +
+                    name + " primitive",
+                &primitive_value_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
             // Register a transferred bytes performance counter
             hpx::performance_counters::install_counter_type(
                 "/phylanx/primitives/" + name + "/transferred_bytes",
@@ -654,6 +1048,14 @@ using direct_execution_counter =
 HPX_REGISTER_DERIVED_COMPONENT_FACTORY(direct_execution_type,
     direct_execution_counter, "base_performance_counter");
 
+using primitive_value_type = hpx::components::component<
+    phylanx::performance_counters::primitive_value_counter>;
+using primitive_value_counter =
+    phylanx::performance_counters::primitive_value_counter;
+
+HPX_REGISTER_DERIVED_COMPONENT_FACTORY(primitive_value_type,
+    primitive_value_counter, "base_performance_counter");
+
 using transferred_bytes_type = hpx::components::component<
     phylanx::performance_counters::transferred_bytes_counter>;
 using transferred_bytes_counter =
@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/algorithms/als.hpp>
+#include <phylanx/plugins/algorithms/als_impl.hpp>
 
 #include <hpx/iostream.hpp>
 #include <hpx/include/lcos.hpp>
@@ -103,51 +104,28 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 extract_scalar_integer_value(args[5], name_, codename_) != 0;
         }
 
-        using vector_type = ir::node_data<double>::storage1d_type;
-        using matrix_type = ir::node_data<double>::storage2d_type;
+        using matrix_type = detail::als_matrix_type;
 
         // perform calculations
         std::int64_t num_users = ratings.rows();
         std::int64_t num_items = ratings.columns();
-        auto conf = alpha * ratings;
+
+        // only the non-zero confidence values are stored, once per user and
+        // once per item
+        detail::als_sparse_matrix_type conf =
+            detail::als_confidence(ratings, alpha);
+        detail::als_sparse_matrix_type conf_t = blaze::trans(conf);
 
         matrix_type X(num_users, num_factors);
         matrix_type Y(num_items, num_factors);
 
-        matrix_type XtX(num_factors, num_factors);
-        matrix_type YtY(num_factors, num_factors);
-
-        std::uint32_t seed_ = 0;
-        std::mt19937 rng_{seed_};
-        std::normal_distribution<double> dist;
-
-        for (std::size_t row = 0; row != blaze::rows(X); ++row)
-        {
-            for (auto& val : blaze::row(X, row))
-            {
-                val = dist(rng_);
-            }
-        }
-
-        for (std::size_t row = 0; row != blaze::rows(Y); ++row)
-        {
-            for (auto& val : blaze::row(Y, row))
-            {
-                val = dist(rng_);
-            }
-        }
-
-        blaze::IdentityMatrix<double> I_f(num_factors);
-        blaze::IdentityMatrix<double> I_i(num_items);
-        blaze::IdentityMatrix<double> I_u(num_users);
-
-        blaze::DynamicMatrix<double> c_u(num_items, num_items, 0);
-        blaze::DynamicMatrix<double> c_i(num_users, num_users, 0);
+        detail::als_initialize_factors(X, Y);
 
         for (std::int64_t step = 0; step < iterations; ++step)
         {
-            YtY = (blaze::trans(Y) * Y) + regularization * I_f;
-            XtX = (blaze::trans(X) * X) + regularization * I_f;
+            // both Gramians are based on the factors of the previous step
+            matrix_type YtY = detail::als_gramian(Y, regularization);
+            matrix_type XtX = detail::als_gramian(X, regularization);
 
             if (enable_output)
             {
@@ -155,31 +133,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                           << "\nY: " << Y << std::endl;
             }
 
-            for (std::int64_t u = 0; u < num_users; u++)
-            {
-                auto conf_u = blaze::trans(blaze::row(conf, u));
-                auto diag = blaze::band(c_u, 0);
-                diag = conf_u;
-                blaze::DynamicVector<double> p_u =
-                    blaze::map(conf_u, [&](double x) { return (x != 0.0); });
-                auto A = (blaze::trans(Y) * c_u) * Y + YtY;
-                auto b = (blaze::trans(Y) * (c_u + I_i)) * (p_u);
-                auto row_x = blaze::row(X, u);
-                row_x = (trans(b) * blaze::inv(A));
-            }
-
-            for (std::int64_t i = 0; i < num_items; i++)
-            {
-                auto conf_i = blaze::column(conf, i);
-                auto diag = blaze::band(c_i, 0);
-                diag = conf_i;
-                blaze::DynamicVector<double> p_i =
-                    blaze::map(conf_i, [&](double x) { return (x != 0.0); });
-                auto A = (blaze::trans(X) * c_i) * X + XtX;
-                auto b = (blaze::trans(X) * (c_i + I_u)) * (p_i);
-                auto row_y = blaze::row(Y, i);
-                row_y = (trans(b) * blaze::inv(A));
-            }
+            detail::als_update_factors(conf, Y, YtY, X);
+            detail::als_update_factors(conf_t, X, XtX, Y);
         }
 
         return primitive_argument_type
@@ -0,0 +1,373 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/plugins/algorithms/als_impl.hpp>
+#include <phylanx/plugins/algorithms/dist_als.hpp>
+
+#include <hpx/collectives/all_gather.hpp>
+#include <hpx/collectives/all_to_all.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/serialization/tuple.hpp>
+#include <hpx/serialization/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const dist_als::match_data = {hpx::make_tuple("als_d",
+        std::vector<std::string>{
+            "als_d(_1, _2, _3, _4, _5, _6)", "als_d(_1, _2, _3, _4, _5)"},
+        &create_dist_als, &create_primitive<dist_als>,
+        R"(ratings, reg, num, iters, alpha, enable_output
+        Args:
+
+            ratings (matrix): the local part of the matrix representing user
+                             feedback over different items, every locality
+                             holds all items of a contiguous block of users
+            reg (float): the regularization parameter
+            num (integer): the number of factors
+            iters (integer): the number of iterations
+            alpha (float): the scaling factor
+            enable_output(boolean): whether output should be enabled.
+
+        Returns:
+
+        The algorithm returns a list of two matrices: [X, Y] :
+        X: the user-factors of the users held by this locality
+        Y: the item-factors of the block of items assigned to this locality,
+           the items are distributed evenly over all localities
+
+        Of possible interest: http://yifanhu.net/PUB/cf.pdf)"
+        )};
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_als::dist_als(primitive_arguments_type && operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // (item, user, confidence)
+        using als_entry_type = std::tuple<std::int64_t, std::int64_t, double>;
+
+        inline tiling_span als_item_span(
+            std::uint32_t loc, std::int64_t num_items, std::uint32_t numtiles)
+        {
+            return tiling_span(loc * num_items / numtiles,
+                (loc + 1) * num_items / numtiles);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Send the confidence values of the local users to the localities
+        // owning the corresponding items, returns the confidence values of
+        // all users for the local items (one row per local item)
+        als_sparse_matrix_type als_exchange_confidence(
+            std::string const& basename, als_sparse_matrix_type const& conf,
+            std::int64_t user_start, std::int64_t num_users,
+            std::vector<tiling_span> const& item_spans, std::uint32_t loc_id)
+        {
+            std::uint32_t const numtiles = std::uint32_t(item_spans.size());
+
+            std::vector<std::vector<als_entry_type>> buckets(numtiles);
+            for (std::size_t u = 0; u != conf.rows(); ++u)
+            {
+                for (auto it = conf.begin(u); it != conf.end(u); ++it)
+                {
+                    std::int64_t const item = it->index();
+
+                    // the last span starting at or before the item owns it
+                    auto owner = std::upper_bound(item_spans.begin(),
+                        item_spans.end(), item,
+                        [](std::int64_t i, tiling_span const& span) {
+                            return i < span.start_;
+                        });
+                    buckets[std::distance(item_spans.begin(), owner) - 1]
+                        .emplace_back(item, user_start + u, it->value());
+                }
+            }
+
+            std::vector<std::vector<als_entry_type>> received =
+                hpx::collectives::all_to_all(
+                    ("als_d_confidence_" + basename).c_str(),
+                    std::move(buckets),
+                    hpx::collectives::num_sites_arg{numtiles},
+                    hpx::collectives::this_site_arg{loc_id})
+                    .get();
+
+            std::vector<als_entry_type> entries;
+            for (auto& r : received)
+            {
+                std::move(r.begin(), r.end(), std::back_inserter(entries));
+            }
+            std::sort(entries.begin(), entries.end());
+
+            tiling_span const& items = item_spans[loc_id];
+
+            als_sparse_matrix_type conf_t(items.size(), num_users);
+            conf_t.reserve(entries.size());
+
+            auto it = entries.begin();
+            for (std::int64_t i = 0; i != items.size(); ++i)
+            {
+                for (/**/; it != entries.end() &&
+                     std::get<0>(*it) == items.start_ + i;
+                     ++it)
+                {
+                    conf_t.append(i, std::get<1>(*it), std::get<2>(*it));
+                }
+                conf_t.finalize(i);
+            }
+            return conf_t;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Make the factors computed by all localities available everywhere
+        void als_gather_factors(std::string const& basename,
+            als_matrix_type const& local, std::vector<tiling_span> const& spans,
+            std::uint32_t loc_id, als_matrix_type& factors)
+        {
+            std::uint32_t const numtiles = std::uint32_t(spans.size());
+
+            std::vector<als_matrix_type> parts =
+                hpx::collectives::all_gather(basename.c_str(), local,
+                    hpx::collectives::num_sites_arg{numtiles},
+                    hpx::collectives::this_site_arg{loc_id})
+                    .get();
+
+            for (std::uint32_t loc = 0; loc != numtiles; ++loc)
+            {
+                if (spans[loc].size() != 0)
+                {
+                    blaze::submatrix(factors, spans[loc].start_, 0,
+                        spans[loc].size(), factors.columns()) = parts[loc];
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type dist_als::calculate_als(
+        primitive_arguments_type&& args) const
+    {
+        // extract arguments
+        if (extract_numeric_value_dimension(args[0], name_, codename_) != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_als::eval",
+                generate_error_message(
+                    "the als_d algorithm primitive requires for the first "
+                    "argument ('ratings') to represent a matrix"));
+        }
+
+        localities_information locs =
+            extract_localities_information(args[0], name_, codename_);
+        if (locs.locality_.num_localities_ > 1 &&
+            !locs.is_row_tiled(name_, codename_))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_als::eval",
+                generate_error_message(
+                    "the als_d algorithm primitive requires for the ratings "
+                    "to be tiled by rows (users)"));
+        }
+
+        auto arg1 = extract_numeric_value(std::move(args[0]), name_, codename_);
+        auto ratings = arg1.matrix();
+
+        auto arg2 = extract_numeric_value(args[1], name_, codename_);
+        if (arg2.num_dimensions() != 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_als::eval",
+                generate_error_message(
+                    "the als_d algorithm primitive requires for the second "
+                    "argument ('regularization') to represent a scalar"));
+        }
+        auto regularization = arg2.scalar();
+
+        auto num_factors =
+            extract_scalar_integer_value(args[2], name_, codename_);
+
+        auto iterations =
+            extract_scalar_integer_value(args[3], name_, codename_);
+
+        auto arg5 = extract_numeric_value(args[4], name_, codename_);
+        if (arg5.num_dimensions() != 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_als::eval",
+                generate_error_message(
+                    "the als_d algorithm primitive requires for the fifth "
+                    "argument ('alpha') to represent a scalar"));
+        }
+        auto alpha = arg5.scalar();
+
+        bool enable_output = false;
+        if (args.size() == 6 && valid(args[5]))
+        {
+            enable_output =
+                extract_scalar_integer_value(args[5], name_, codename_) != 0;
+        }
+
+        using matrix_type = detail::als_matrix_type;
+
+        std::uint32_t const loc_id = locs.locality_.locality_id_;
+        std::uint32_t const numtiles = locs.locality_.num_localities_;
+
+        std::int64_t const num_users = locs.rows(name_, codename_);
+        std::int64_t const num_items = locs.columns(name_, codename_);
+
+        // users are distributed as given by the ratings, items are distributed
+        // evenly
+        std::vector<tiling_span> user_spans, item_spans;
+        user_spans.reserve(numtiles);
+        item_spans.reserve(numtiles);
+        for (std::uint32_t loc = 0; loc != numtiles; ++loc)
+        {
+            user_spans.push_back(tiling_information_2d(
+                locs.tiles_[loc], name_, codename_).spans_[0]);
+            item_spans.push_back(
+                detail::als_item_span(loc, num_items, numtiles));
+        }
+        tiling_span const& users = user_spans[loc_id];
+        tiling_span const& items = item_spans[loc_id];
+
+        std::string const basename = locs.annotation_.generate_name();
+
+        // every locality holds the confidence values of its users and,
+        // after the exchange, of its items
+        detail::als_sparse_matrix_type conf =
+            detail::als_confidence(ratings, alpha);
+        detail::als_sparse_matrix_type conf_t =
+            detail::als_exchange_confidence(
+                basename, conf, users.start_, num_users, item_spans, loc_id);
+
+        // all localities generate the same initial factors, which makes the
+        // result independent of the number of localities
+        matrix_type X(num_users, num_factors);
+        matrix_type Y(num_items, num_factors);
+
+        detail::als_initialize_factors(X, Y);
+
+        matrix_type X_local =
+            blaze::submatrix(X, users.start_, 0, users.size(), num_factors);
+        matrix_type Y_local =
+            blaze::submatrix(Y, items.start_, 0, items.size(), num_factors);
+
+        for (std::int64_t step = 0; step < iterations; ++step)
+        {
+            // both Gramians are based on the factors of the previous step
+            matrix_type YtY = detail::als_gramian(Y, regularization);
+            matrix_type XtX = detail::als_gramian(X, regularization);
+
+            if (enable_output && loc_id == 0)
+            {
+                hpx::cout << "iteration " << step << "\nX: " << X
+                          << "\nY: " << Y << std::endl;
+            }
+
+            std::string const step_name =
+                basename + "_" + std::to_string(step);
+
+            detail::als_update_factors(conf, Y, YtY, X_local);
+            detail::als_gather_factors(
+                "als_d_users_" + step_name, X_local, user_spans, loc_id, X);
+
+            detail::als_update_factors(conf_t, X, XtX, Y_local);
+            detail::als_gather_factors(
+                "als_d_items_" + step_name, Y_local, item_spans, loc_id, Y);
+        }
+
+        // annotate the local parts of the factors
+        ++locs.annotation_.generation_;
+        auto locality_ann = locs.locality_.as_annotation();
+
+        auto factors_annotation = [&](std::string const& suffix,
+                                      tiling_span const& span) {
+            annotation_information ann_info(
+                locs.annotation_.name_ + suffix, locs.annotation_.generation_);
+            return std::make_shared<annotation>(localities_annotation(
+                locality_ann,
+                tiling_information_2d(span, tiling_span(0, num_factors))
+                    .as_annotation(name_, codename_),
+                ann_info, name_, codename_));
+        };
+
+        return primitive_argument_type
+        {
+            primitive_arguments_type{
+                primitive_argument_type{ir::node_data<double>{
+                    std::move(X_local)},
+                    factors_annotation("_user_factors", users)},
+                primitive_argument_type{ir::node_data<double>{
+                    std::move(Y_local)},
+                    factors_annotation("_item_factors", items)}}
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_als::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() != 5 && operands.size() != 6)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_als::eval",
+                generate_error_message("the als_d algorithm primitive "
+                                       "requires exactly either "
+                                       "five or six operands"));
+        }
+
+        bool arguments_valid = true;
+        for (std::size_t i = 0; i != operands.size(); ++i)
+        {
+            if (!valid(operands[i]))
+            {
+                arguments_valid = false;
+            }
+        }
+
+        if (!arguments_valid)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_als::eval",
+                generate_error_message(
+                    "the als_d algorithm primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                    -> primitive_argument_type
+                {
+                    return this_->calculate_als(std::move(args));
+                }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
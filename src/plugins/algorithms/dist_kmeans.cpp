@@ -0,0 +1,392 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/plugins/algorithms/dist_kmeans.hpp>
+#include <phylanx/plugins/algorithms/kmeans_impl.hpp>
+#include <phylanx/util/random.hpp>
+
+#include <hpx/collectives/all_gather.hpp>
+#include <hpx/collectives/all_reduce.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/iostream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const dist_kmeans::match_data =
+    {
+        hpx::make_tuple("kmeans_d",
+        std::vector<std::string>{R"(
+                kmeans_d(
+                    _1_points,
+                    __arg(_2_num_centroid, 3),
+                    __arg(_3_iterations, 10),
+                    __arg(_4_show_result, false),
+                    __arg(_5_seed, nil),
+                    __arg(_6_initial_centroids, nil),
+                    __arg(_7_init, "random")
+                )
+            )"},
+            &create_dist_kmeans, &create_primitive<dist_kmeans>, R"(
+            points, num_centroids, iterations, show_result, seed,
+            initial_centroids, init
+
+            Args:
+
+                points (matrix): the local part of a matrix with one row per
+                    point and one column per feature. The points have to be
+                    tiled by rows.
+                num_centroids (int, optional): the number of clusters in which
+                    we need to break down the data. It sets to 3 by default
+                iterations (int, optional): the number of iterations. It sets
+                    to 10 by default.
+                show_result (bool, optional): defaults to false.
+                seed (int) : the seed of a random number generator, it has to
+                    be the same on all localities.
+                initial_centroids (matrix): if not given, the centroids are
+                    initialized as specified by init. The initial_centroids
+                    matrix should have num_centroids rows and as many columns
+                    as points.
+                init (string, optional): the method used to choose the
+                    initial centroids if those are not given, either 'random'
+                    (default) or 'k-means++'.
+
+            Returns:
+
+            Number of centroids points that shows the center of clusters given
+            the points matrix. All localities return the same centroids. The
+            sums of the points assigned to each cluster are combined using a
+            single collective operation per iteration.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_kmeans::dist_kmeans(primitive_arguments_type && operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The same random points are chosen as by the kmeans primitive for
+        // the overall points matrix, every locality contributes the points
+        // it holds
+        kmeans_matrix_type dist_kmeans_random_centroids(
+            std::string const& basename, kmeans_matrix_type const& points,
+            tiling_span const& span, std::size_t num_points,
+            std::size_t num_centroids, std::uint32_t numtiles,
+            std::uint32_t loc_id)
+        {
+            kmeans_matrix_type centroids(
+                num_centroids, points.columns(), 0.0);
+
+            kmeans_random_indices(num_points, num_centroids,
+                [&](std::size_t i, std::int64_t index) {
+                    if (index >= span.start_ && index < span.stop_)
+                    {
+                        blaze::row(centroids, i) =
+                            blaze::row(points, index - span.start_);
+                    }
+                });
+
+            return hpx::collectives::all_reduce(
+                ("kmeans_d_random_" + basename).c_str(), std::move(centroids),
+                std::plus<kmeans_matrix_type>{},
+                hpx::collectives::num_sites_arg{numtiles},
+                hpx::collectives::this_site_arg{loc_id})
+                .get();
+        }
+
+        // k-means++ seeding, every locality proposes one of its points
+        // (chosen with a probability proportional to its squared distance
+        // to the closest centroid), the proposal of a locality is selected
+        // with a probability proportional to the sum of the squared
+        // distances of its points
+        kmeans_matrix_type dist_kmeans_plusplus_centroids(
+            std::string const& basename, kmeans_matrix_type const& points,
+            std::size_t num_centroids, std::uint32_t numtiles,
+            std::uint32_t loc_id)
+        {
+            std::size_t const num_features = points.columns();
+            kmeans_matrix_type centroids(num_centroids, num_features);
+
+            std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+            kmeans_vector_type min_dist(
+                points.rows(), (std::numeric_limits<double>::max)());
+
+            for (std::size_t j = 0; j != num_centroids; ++j)
+            {
+                // the random numbers are the same on all localities
+                double const local_target = dist(util::rng_);
+                double const global_target = dist(util::rng_);
+
+                // proposal: weight, number of points, point
+                kmeans_vector_type proposal(num_features + 2, 0.0);
+                if (points.rows() != 0)
+                {
+                    double total = double(points.rows());
+                    std::size_t idx =
+                        std::size_t(local_target * points.rows());
+                    if (j != 0)
+                    {
+                        total = kmeans_plusplus_update(
+                            points, blaze::row(centroids, j - 1), min_dist);
+                        idx = kmeans_plusplus_select(
+                            min_dist, local_target * total);
+                    }
+                    proposal[0] = total;
+                    proposal[1] = double(points.rows());
+                    blaze::subvector(proposal, 2, num_features) =
+                        blaze::trans(blaze::row(points, idx));
+                }
+
+                std::vector<kmeans_vector_type> proposals =
+                    hpx::collectives::all_gather(
+                        ("kmeans_d_plusplus_" + basename + "_" +
+                            std::to_string(j))
+                            .c_str(),
+                        std::move(proposal),
+                        hpx::collectives::num_sites_arg{numtiles},
+                        hpx::collectives::this_site_arg{loc_id})
+                        .get();
+
+                double total = 0.0;
+                for (auto const& p : proposals)
+                {
+                    total += p[0];
+                }
+
+                // select the proposal, fall back to the last locality
+                // holding any points if all distances are zero
+                std::size_t selected = 0;
+                double sum = 0.0;
+                for (std::size_t l = 0; l != proposals.size(); ++l)
+                {
+                    if (proposals[l][1] != 0.0)
+                    {
+                        selected = l;
+                        sum += proposals[l][0];
+                        if (sum > global_target * total)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                blaze::row(centroids, j) = blaze::trans(
+                    blaze::subvector(proposals[selected], 2, num_features));
+            }
+            return centroids;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type dist_kmeans::calculate_kmeans(
+        primitive_arguments_type&& args) const
+    {
+        // extract arguments
+        if (extract_numeric_value_dimension(args[0], name_, codename_) != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_kmeans::calculate_kmeans",
+                generate_error_message(
+                    "the kmeans_d algorithm primitive requires for the first "
+                    "argument, points, to represent a matrix"));
+        }
+
+        localities_information locs =
+            extract_localities_information(args[0], name_, codename_);
+        if (locs.locality_.num_localities_ > 1 &&
+            !locs.is_row_tiled(name_, codename_))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_kmeans::calculate_kmeans",
+                generate_error_message(
+                    "the kmeans_d algorithm primitive requires for the points "
+                    "to be tiled by rows"));
+        }
+
+        auto arg0 = extract_numeric_value(std::move(args[0]), name_, codename_);
+        blaze::DynamicMatrix<double> const points = arg0.matrix();
+
+        std::size_t const num_points = locs.rows(name_, codename_);
+        std::size_t const num_features = locs.columns(name_, codename_);
+
+        std::size_t num_centroids = 3;
+        if (valid(args[1]))
+        {
+            num_centroids = extract_scalar_positive_integer_value_strict(
+                std::move(args[1]), name_, codename_);
+        }
+        if (num_centroids > num_points)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_kmeans::calculate_kmeans",
+                generate_error_message(
+                    "the kmeans_d algorithm primitive requires for the number "
+                    "of centroids not to exceed the number of points"));
+        }
+
+        std::size_t iterations = 10;
+        if (valid(args[2]))
+        {
+            iterations = extract_scalar_positive_integer_value_strict(
+                std::move(args[2]), name_, codename_);
+        }
+
+        bool show_result = false;
+        if (valid(args[3]))
+        {
+            show_result = extract_scalar_boolean_value(
+                std::move(args[3]), name_, codename_);
+        }
+
+        std::uint32_t seed = 42;
+        if (valid(args[4]))
+        {
+            seed = extract_scalar_positive_integer_value_strict(
+                std::move(args[4]), name_, codename_);
+        }
+        util::set_seed(seed);
+
+        std::string init = "random";
+        if (args.size() > 6 && valid(args[6]))
+        {
+            init = extract_string_value(std::move(args[6]), name_, codename_);
+            if (init != "random" && init != "k-means++")
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_kmeans::calculate_kmeans",
+                    generate_error_message(
+                        "the kmeans_d algorithm primitive requires for init "
+                        "to be either 'random' or 'k-means++'"));
+            }
+        }
+
+        std::uint32_t const loc_id = locs.locality_.locality_id_;
+        std::uint32_t const numtiles = locs.locality_.num_localities_;
+        std::string const basename = locs.annotation_.generate_name();
+
+        // initializing the centroids
+        blaze::DynamicMatrix<double> centroids;
+        if (valid(args[5]))
+        {
+            auto arg5 =
+                extract_numeric_value(std::move(args[5]), name_, codename_);
+            if (arg5.num_dimensions() != 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_kmeans::calculate_kmeans",
+                    generate_error_message(
+                        "the kmeans_d algorithm primitive requires for the "
+                        "initial_centroids to represent a matrix"));
+            }
+            centroids = arg5.matrix();
+            if (centroids.columns() != num_features ||
+                centroids.rows() != num_centroids)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_kmeans::calculate_kmeans",
+                    generate_error_message(
+                        "the kmeans_d algorithm primitive requires for the "
+                        "initial_centroids to have num_centroids rows and as "
+                        "many columns as points"));
+            }
+        }
+        else if (init == "k-means++")
+        {
+            centroids = detail::dist_kmeans_plusplus_centroids(
+                basename, points, num_centroids, numtiles, loc_id);
+        }
+        else
+        {
+            centroids = detail::dist_kmeans_random_centroids(basename, points,
+                tiling_information_2d(locs.tiles_[loc_id], name_, codename_)
+                    .spans_[0],
+                num_points, num_centroids, numtiles, loc_id);
+        }
+
+        // kmeans calculations, the partial sums of all localities are
+        // combined by a single all_reduce per iteration
+        detail::kmeans_assignment assignment(points.rows());
+        for (std::size_t i = 0; i != iterations; ++i)
+        {
+            assignment.assign(points, centroids);
+
+            blaze::DynamicMatrix<double> sums =
+                hpx::collectives::all_reduce(
+                    ("kmeans_d_" + basename + "_" + std::to_string(i))
+                        .c_str(),
+                    assignment.sums(points, num_centroids),
+                    std::plus<blaze::DynamicMatrix<double>>{},
+                    hpx::collectives::num_sites_arg{numtiles},
+                    hpx::collectives::this_site_arg{loc_id})
+                    .get();
+
+            centroids = detail::kmeans_new_centroids(sums);
+            if (show_result && loc_id == 0)
+            {
+                std::cout << "centroids after iteration " << i << ": "
+                          << centroids << std::endl;
+            }
+        }
+
+        return primitive_argument_type{std::move(centroids)};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_kmeans::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.empty() || operands.size() > 7)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_kmeans::eval",
+                generate_error_message(
+                    "the kmeans_d algorithm primitive requires at least one "
+                    "and at most 7 operands"));
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_kmeans::eval",
+                generate_error_message(
+                    "the kmeans_d algorithm primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                    -> primitive_argument_type
+                {
+                    return this_->calculate_kmeans(std::move(args));
+                }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
@@ -0,0 +1,229 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/plugins/algorithms/dist_lda_trainer.hpp>
+#include <phylanx/plugins/algorithms/lda_trainer.hpp>
+
+#include <hpx/collectives/all_reduce.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const dist_lda_trainer::match_data =
+    {
+        hpx::make_tuple("lda_trainer_d",
+        std::vector<std::string>{R"(
+                lda_trainer_d(
+                    _1_n_topics,
+                    _2_alpha,
+                    _3_beta,
+                    _4_iters,
+                    _5_word_doc_matrix,
+                    __arg(_6_seed, nil)
+                )
+            )"},
+            &create_dist_lda_trainer, &create_primitive<dist_lda_trainer>, R"(
+            n_topics, alpha, beta, iters, word_doc_matrix, seed
+
+            Args:
+
+                n_topics (integer): number of topics to compute
+                alpha (float): alpha parameter
+                beta (float): beta parameter
+                iters (integer): the number of iterations
+                word_doc_matrix (matrix): the local part of the word-document
+                    histogram, words are columns, documents are rows. The
+                    documents have to be tiled by rows.
+                seed (int, optional): the seed of the random number
+                    generator, it has to be the same on all localities.
+
+            Returns:
+
+            A list of two matrices [word_topic, document_topic]. The
+            word_topic matrix is the same on all localities, the
+            document_topic matrix holds the rows of the local documents. The
+            changes of the word-topic counts are combined using a single
+            collective operation per iteration.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_lda_trainer::dist_lda_trainer(primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type dist_lda_trainer::calculate_lda_trainer(
+        primitive_arguments_type&& args) const
+    {
+        // extract arguments
+        std::int64_t const topics =
+            extract_scalar_positive_integer_value_strict(
+                args[0], name_, codename_);
+
+        auto arg2 = extract_numeric_value(args[1], name_, codename_);
+        auto arg3 = extract_numeric_value(args[2], name_, codename_);
+        if (arg2.num_dimensions() != 0 || arg3.num_dimensions() != 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_lda_trainer::calculate_lda_trainer",
+                generate_error_message(
+                    "the lda_trainer_d algorithm primitive requires for alpha "
+                    "and beta to represent scalars"));
+        }
+        double const alpha = arg2.scalar();
+        double const beta = arg3.scalar();
+        if (alpha <= 0 || beta <= 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_lda_trainer::calculate_lda_trainer",
+                generate_error_message(
+                    "the lda_trainer_d algorithm primitive requires for alpha "
+                    "and beta to be positive"));
+        }
+
+        std::int64_t const iterations =
+            extract_scalar_integer_value(args[3], name_, codename_);
+
+        if (extract_numeric_value_dimension(args[4], name_, codename_) != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_lda_trainer::calculate_lda_trainer",
+                generate_error_message(
+                    "the lda_trainer_d algorithm primitive requires for the "
+                    "fifth argument ('word_doc_mat') to represent a matrix"));
+        }
+
+        localities_information locs =
+            extract_localities_information(args[4], name_, codename_);
+        if (locs.locality_.num_localities_ > 1 &&
+            !locs.is_row_tiled(name_, codename_))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_lda_trainer::calculate_lda_trainer",
+                generate_error_message(
+                    "the lda_trainer_d algorithm primitive requires for the "
+                    "documents to be tiled by rows"));
+        }
+
+        auto arg5 = extract_numeric_value(std::move(args[4]), name_, codename_);
+
+        std::uint32_t seed = 42;
+        if (args.size() > 5 && valid(args[5]))
+        {
+            seed = static_cast<std::uint32_t>(
+                extract_scalar_integer_value(args[5], name_, codename_));
+        }
+
+        std::uint32_t const loc_id = locs.locality_.locality_id_;
+        std::uint32_t const numtiles = locs.locality_.num_localities_;
+        std::string const basename = locs.annotation_.generate_name();
+
+        using matrix_type = blaze::DynamicMatrix<double>;
+
+        // every locality samples the topics of its own documents
+        lda_gibbs_sampler sampler(lda_corpus::from_counts(arg5.matrix()),
+            topics, alpha, beta, seed + loc_id);
+
+        matrix_type wp = hpx::collectives::all_reduce(
+            ("lda_trainer_d_" + basename).c_str(), sampler.initialize(),
+            std::plus<matrix_type>{},
+            hpx::collectives::num_sites_arg{numtiles},
+            hpx::collectives::this_site_arg{loc_id})
+            .get();
+
+        for (std::int64_t i = 0; i < iterations; ++i)
+        {
+            wp += hpx::collectives::all_reduce(
+                ("lda_trainer_d_" + basename + "_" + std::to_string(i))
+                    .c_str(),
+                sampler.sweep(wp), std::plus<matrix_type>{},
+                hpx::collectives::num_sites_arg{numtiles},
+                hpx::collectives::this_site_arg{loc_id})
+                .get();
+        }
+
+        // annotate the local part of the document-topic counts
+        tiling_span const& documents =
+            tiling_information_2d(locs.tiles_[loc_id], name_, codename_)
+                .spans_[0];
+
+        annotation_information ann_info(
+            locs.annotation_.name_ + "_document_topic",
+            ++locs.annotation_.generation_);
+        auto dp_annotation = std::make_shared<annotation>(localities_annotation(
+            locs.locality_.as_annotation(),
+            tiling_information_2d(documents, tiling_span(0, topics))
+                .as_annotation(name_, codename_),
+            ann_info, name_, codename_));
+
+        return primitive_argument_type
+        {
+            primitive_arguments_type{
+                primitive_argument_type{ir::node_data<double>{std::move(wp)}},
+                primitive_argument_type{
+                    ir::node_data<double>{sampler.doc_topics()},
+                    std::move(dp_annotation)}}
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> dist_lda_trainer::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() != 5 && operands.size() != 6)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_lda_trainer::eval",
+                generate_error_message(
+                    "the lda_trainer_d algorithm primitive requires exactly "
+                    "either five or six operands"));
+        }
+
+        for (std::size_t i = 0; i != 5; ++i)
+        {
+            if (!valid(operands[i]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_lda_trainer::eval",
+                    generate_error_message(
+                        "the lda_trainer_d algorithm primitive requires that "
+                        "the arguments given by the operands array are "
+                        "valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                    -> primitive_argument_type
+                {
+                    return this_->calculate_lda_trainer(std::move(args));
+                }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
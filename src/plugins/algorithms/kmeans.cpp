@@ -7,6 +7,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/algorithms/kmeans.hpp>
+#include <phylanx/plugins/algorithms/kmeans_impl.hpp>
 #include <phylanx/util/random.hpp>
 
 #include <hpx/iostream.hpp>
@@ -40,18 +41,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     __arg(_3_iterations, 10),
                     __arg(_4_show_result, false),
                     __arg(_5_seed, nil),
-                    __arg(_6_initial_centroids, nil)
+                    __arg(_6_initial_centroids, nil),
+                    __arg(_7_init, "random")
                 )
             )"},
             &create_kmeans, &create_primitive<kmeans>, R"(
             points, num_centroids, iterations, show_result, seed,
-            initial_centroids
+            initial_centroids, init
 
             Args:
 
-                points (matrix): a matrix with any number of rows and two
-                    columns. Any data that can be represented by two features
-                    can create the point matrix.
+                points (matrix): a matrix with one row per point and one
+                    column per feature.
                 num_centroids (int, optional): the number of clusters in which
                     we need to break down the data. It sets to 3 by default
                 iterations (int, optional): the number of iterations. It sets
@@ -61,7 +62,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 initial_centroids (matrix): if not given, the centroids are
                     initialized by num_centroids randomly chosen points. If
                     given there is no use for a seed. The initial_centroids
-                    matrix should have num_centroids rows and 2 columns.
+                    matrix should have num_centroids rows and as many columns
+                    as points.
+                init (string, optional): the method used to choose the
+                    initial centroids if those are not given, either 'random'
+                    (default) or 'k-means++'.
 
             Returns:
 
@@ -75,90 +80,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
       : primitive_component_base(std::move(operands), name, codename)
     {}
 
-    ///////////////////////////////////////////////////////////////////////////
-    // choose num_centroids random points as the initial centroids
-    blaze::DynamicMatrix<double> kmeans::initialize_centroids(
-        blaze::DynamicMatrix<double> const& points, std::size_t num_points,
-        std::size_t num_centroids) const
-    {
-        blaze::DynamicMatrix<double> centroids(num_centroids, 2);
-        std::uniform_int_distribution<std::int64_t> distribution(
-            0, num_points - 1);
-        std::vector<std::size_t> indices;
-        std::int64_t rand_index;
-
-        for (std::size_t i = 0; i != num_centroids; ++i)
-        {
-            rand_index = distribution(util::rng_);
-
-            // rand indices should be unique
-            while (std::find(indices.begin(), indices.end(), rand_index) !=
-                indices.end())
-            {
-                rand_index = distribution(util::rng_);
-            }
-            indices.emplace_back(rand_index);
-
-            blaze::row(centroids, i) = blaze::row(points, rand_index);
-        }
-        return std::move(centroids);
-    }
-
-    // assign each point to its closest centroid
-    blaze::DynamicVector<std::size_t> kmeans::closest_centroids(
-        blaze::DynamicMatrix<double> const& points,
-        blaze::DynamicMatrix<double> const& centroids, std::size_t num_points,
-        std::size_t num_centroids) const
-    {
-        auto points_x = blaze::column(points, 0);
-        auto points_y = blaze::column(points, 1);
-        auto centroids_x = blaze::column(centroids, 0);
-        auto centroids_y = blaze::column(centroids, 1);
-
-        // calculating the index for each row of points
-        blaze::DynamicVector<std::size_t> result(num_points);
-        for (std::size_t i = 0; i != num_points; ++i)
-        {
-            auto temp = blaze::DynamicVector<double>(num_centroids);
-            for (std::size_t j = 0; j != num_centroids; ++j)
-            {
-                temp[j] = blaze::sqrt(
-                    blaze::pow(points_x[i] - centroids_x[j], 2) +
-                    blaze::pow(points_y[i] - centroids_y[j], 2));
-            }
-            result[i] = blaze::argmin(temp);
-        }
-        return std::move(result);
-    }
-
-    // generates new centroids as the centers of clusters
-    blaze::DynamicMatrix<double> kmeans::move_centroids(
-        blaze::DynamicMatrix<double> const& points,
-        blaze::DynamicVector<std::size_t>&& closest,
-        blaze::DynamicMatrix<double>&& centroids,
-        std::size_t num_points, std::size_t num_centroids) const
-    {
-        blaze::DynamicMatrix<double> result(num_centroids, 2, 0.0);
-        std::size_t count;
-        for (size_t k = 0; k != num_centroids; ++k)
-        {
-            count = 0;
-            for (size_t i = 0; i != num_points; ++i)
-            {
-                if (closest[i] == k)
-                {
-                    blaze::row(result, k) += blaze::row(points, i);
-                    count += 1;
-                }
-            }
-            if (count != 0)
-            {
-                blaze::row(result, k) /= count;
-            }
-        }
-        return std::move(result);
-    }
-
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type kmeans::calculate_kmeans(
         primitive_arguments_type&& args) const
@@ -172,13 +93,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "the kmeans algorithm primitive requires for the first "
                     "argument, points, to represent a matrix"));
         }
-        auto const points = arg0.matrix();
-        if (points.columns() != 2)
+        blaze::DynamicMatrix<double> const points = arg0.matrix();
+        if (points.rows() == 0 || points.columns() == 0)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "kmeans::calculate_kmeans",
                 generate_error_message(
                     "the kmeans algorithm primitive requires for the first "
-                    "argument, points, to have exacty 2 columns"));
+                    "argument, points, not to be empty"));
         }
 
         std::size_t num_centroids = 3;
@@ -210,7 +131,28 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
         util::set_seed(seed);
 
+        std::string init = "random";
+        if (args.size() > 6 && valid(args[6]))
+        {
+            init = extract_string_value(std::move(args[6]), name_, codename_);
+            if (init != "random" && init != "k-means++")
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "kmeans::calculate_kmeans",
+                    generate_error_message(
+                        "the kmeans algorithm primitive requires for init to "
+                        "be either 'random' or 'k-means++'"));
+            }
+        }
+
         std::size_t num_points = points.rows();
+        if (num_centroids > num_points)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "kmeans::calculate_kmeans",
+                generate_error_message(
+                    "the kmeans algorithm primitive requires for the number "
+                    "of centroids not to exceed the number of points"));
+        }
 
         // initializing the centroids
         blaze::DynamicMatrix<double> centroids;
@@ -227,29 +169,38 @@ namespace phylanx { namespace execution_tree { namespace primitives
                         "initial_centroids to represent a matrix"));
             }
             centroids = arg5.matrix();
-            if (centroids.columns() != 2 || centroids.rows() != num_centroids)
+            if (centroids.columns() != points.columns() ||
+                centroids.rows() != num_centroids)
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "kmeans::calculate_kmeans",
                     generate_error_message(
                         "the kmeans algorithm primitive requires for the "
-                        "initial_centroids to have num_centroids rows and 2 "
-                        "columns"));
+                        "initial_centroids to have num_centroids rows and as "
+                        "many columns as points"));
             }
         }
+        else if (init == "k-means++")
+        {
+            centroids =
+                detail::kmeans_plusplus_centroids(points, num_centroids);
+        }
         else
         {
-            centroids = initialize_centroids(points, num_points, num_centroids);
+            centroids.resize(num_centroids, points.columns());
+            detail::kmeans_random_indices(num_points, num_centroids,
+                [&](std::size_t i, std::int64_t index) {
+                    blaze::row(centroids, i) = blaze::row(points, index);
+                });
         }
 
         // kmeans calculations
-        blaze::DynamicVector<std::size_t> closest;
+        detail::kmeans_assignment assignment(num_points);
         for (std::size_t i = 0; i != iterations; ++i)
         {
-            closest =
-                closest_centroids(points, centroids, num_points, num_centroids);
-            centroids = move_centroids(points, std::move(closest),
-                std::move(centroids), num_points, num_centroids);
+            assignment.assign(points, centroids);
+            centroids = detail::kmeans_new_centroids(
+                assignment.sums(points, num_centroids));
             if (show_result)
             {
                 std::cout << "centroids after iteration " << i << ": "
@@ -265,12 +216,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.empty() || operands.size() > 6)
+        if (operands.empty() || operands.size() > 7)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "kmeans::eval",
                 generate_error_message(
                     "the kmeans algorithm primitive requires at least one and "
-                    "at most 6 operands"));
+                    "at most 7 operands"));
         }
 
         if (!valid(operands[0]))
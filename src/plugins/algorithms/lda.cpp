@@ -16,6 +16,7 @@
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -28,10 +29,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     match_pattern_type const lda_trainer::match_data =
         {hpx::make_tuple("lda_trainer",
-            std::vector<std::string>{
-                "lda_trainer(_1, _2, _3, _4, _5)"},
+            std::vector<std::string>{R"(
+                lda_trainer(
+                    _1_n_topics,
+                    _2_alpha,
+                    _3_beta,
+                    _4_iters,
+                    _5_word_doc_matrix,
+                    __arg(_6_seed, nil)
+                )
+            )"},
             &create_lda_trainer, &create_primitive<lda_trainer>,
-            "n_topics, alpha, beta, iters, word_doc_matrix\n"
+            "n_topics, alpha, beta, iters, word_doc_matrix, seed\n"
             "Args:\n"
             "\n"
             "    n_topics (integer): number of topics to compute\n"
@@ -40,15 +49,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
             "    iters (integer): the number of iterations\n"
             "    word_doc_matrix (2x2 matrix float): word-document histogram,\n"
             "    words are columns, documents are rows\n"
+            "    seed (int, optional): the seed of the random number\n"
+            "    generator, a random seed is used if not given\n"
             "\n"
             "Returns:\n"
             "\n"
             "The algorithm returns a list of two matrices:\n"
             "    [word_topic, document_topic] :\n"
             "\n"
-            "word_topic: document-topic assignment matrix\n"
+            "word_topic: word-topic assignment matrix\n"
             "document_topic: document-topic assignment matrix\n"
             "\n"
+            "The documents are sampled concurrently by all cores (AD-LDA),\n"
+            "the topic of each token is drawn using Metropolis-Hastings\n"
+            "steps with alias table proposals (LightLDA).\n"
         )};
 
     ///////////////////////////////////////////////////////////////////////////
@@ -63,23 +77,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type && args) const
     {
         // extract arguments
-        auto arg1 = extract_numeric_value(args[0], name_, codename_);
-        if (arg1.num_dimensions() != 2)
-        {
-            HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
-                generate_error_message(
-                    "the lda_trainer algorithm primitive requires for the first "
-                    "argument ('n_topics') to represent a matrix"));
-        }
-        auto topics = arg1.scalar();
+        auto topics = extract_scalar_positive_integer_value_strict(
+            args[0], name_, codename_);
 
         auto arg2 = extract_numeric_value(args[1], name_, codename_);
         if (arg2.num_dimensions() != 0)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
                 generate_error_message(
-                    "the lda_trainer algorithm primitive requires for the second "
-                    "argument ('alpha') to represent a scalar"));
+                    "the lda_trainer algorithm primitive requires for the "
+                    "second argument ('alpha') to represent a scalar"));
         }
         auto alpha = arg2.scalar();
 
@@ -88,73 +95,54 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
                 generate_error_message(
-                    "the lda_trainer algorithm primitive requires for the second "
-                    "argument ('beta') to represent a scalar"));
+                    "the lda_trainer algorithm primitive requires for the "
+                    "third argument ('beta') to represent a scalar"));
         }
         auto beta = arg3.scalar();
 
-        auto iterations = extract_scalar_integer_value(args[3], name_, codename_);
-
-        // this is the word-count matrix
-        //
-
-        using namespace execution_tree;
-
-        auto arg5 = extract_numeric_value(args[4], name_, codename_);
-
-/*
-        // what about a local matrix
-        if (arg5.has_annotation())
+        if (alpha <= 0 || beta <= 0)
         {
-            // is distributed, run distributed algo logic
-            //execution_tree::localities_information wcm_localities =
-            //    extract_localities_information(args[4], name_, codename_);
-            // distributed lda!
-            //
-            if(wcm_localities.locality_.num_localities_ > 1) {
-
-                util::distributed_matrix<double> dist_word_doc_mat(
-                    wcm_localities.annotation_.name_,
-                    word_doc_mat,
-                    wcm_localities,
-                    wcm_localities.locality_.locality_id_
-                );
-
-                auto result =
-                    trainer(dist_word_doc_mat, topics, iterations, wcm_localities);
- 
-                return primitive_argument_type
-                {
-                    primitive_arguments_type{
-                        ir::node_data<double>{std::move(std::get<0>(result))},
-                        ir::node_data<double>{std::move(std::get<1>(result))}
-                    }
-                };
-            }
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
+                generate_error_message(
+                    "the lda_trainer algorithm primitive requires for alpha "
+                    "and beta to be positive"));
         }
-*/
 
-        if (arg5.num_dimensions() > 0)
+        auto iterations =
+            extract_scalar_integer_value(args[3], name_, codename_);
+
+        // this is the word-count matrix
+        auto arg5 = extract_numeric_value(args[4], name_, codename_);
+        if (arg5.num_dimensions() != 2)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "lda_trainer::eval",
                 generate_error_message(
-                    "the lda_trainer algorithm primitive requires for the second "
-                    "argument ('word_doc_mat') to represent a matrix"));
+                    "the lda_trainer algorithm primitive requires for the "
+                    "fifth argument ('word_doc_mat') to represent a matrix"));
         }
         auto word_doc_mat = arg5.matrix();
 
+        std::uint32_t seed = std::random_device{}();
+        if (args.size() > 5 && valid(args[5]))
+        {
+            seed = static_cast<std::uint32_t>(
+                extract_scalar_integer_value(args[5], name_, codename_));
+        }
+
         using lda_trainer_t =
             phylanx::execution_tree::primitives::lda_trainer_impl;
 
-        lda_trainer_t trainer(alpha, beta);
+        lda_trainer_t trainer(alpha, beta, seed);
 
         auto result = trainer(word_doc_mat, topics, iterations);
 
         return primitive_argument_type
         {
             primitive_arguments_type{
-                ir::node_data<double>{std::move(std::get<0>(result))},
-                ir::node_data<double>{std::move(std::get<1>(result))}
+                primitive_argument_type{
+                    ir::node_data<double>{std::move(std::get<0>(result))}},
+                primitive_argument_type{
+                    ir::node_data<double>{std::move(std::get<1>(result))}}
             }
         };
     }
@@ -162,19 +150,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<primitive_argument_type> lda_trainer::eval(
         primitive_arguments_type const& operands,
-        primitive_arguments_type const& args) const
+        primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 5)
+        if (operands.size() != 5 && operands.size() != 6)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "lda_trainer::eval",
                 generate_error_message("the lda_trainer algorithm primitive "
-                                       "requires exactly "
-                                       "five operands"));
+                                       "requires exactly either "
+                                       "five or six operands"));
         }
 
         bool arguments_valid = true;
-        for (std::size_t i = 0; i != operands.size(); ++i)
+        for (std::size_t i = 0; i != 5; ++i)
         {
             if (!valid(operands[i]))
             {
@@ -200,18 +188,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     return this_->calculate_lda_trainer(std::move(args));
                 }),
             detail::map_operands(
-                operands, functional::value_operand{}, args, name_, codename_));
-    }
-
-/*
-    hpx::future<primitive_argument_type> lda_trainer::eval(
-        primitive_arguments_type const& args) const
-    {
-        if (this->no_operands())
-        {
-            return eval(args, noargs);
-        }
-        return eval(this->operands(), args);
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
     }
-*/
 }}}
@@ -4,187 +4,278 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 #include "phylanx/plugins/algorithms/lda_trainer.hpp"
-#include <cstdint>
 
-/////////////////////////////////////////////////////////////////////
-REGISTER_DISTRIBUTED_MATRIX_DECLARATION(double);
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives {
 
-// https://bitbucket.org/blaze-lib/blaze/issues/158/random-number-distributions
-//
-template< typename Rand    // Random number generator
-        , typename Dist >  // Random distribution
-decltype(auto) random( size_t size, Rand& rand, Dist& dist ) {
-  return blaze::generate( size, [&rand,&dist]( size_t ){
-     return dist( rand );
-  } );
-}
-
-void lda_trainer_impl::gibbs(
-    const blaze::DynamicMatrix<double> & word_doc_mat,
-    const double alpha,
-    const double beta,
-    blaze::DynamicVector<std::int64_t> & z,
-    blaze::DynamicMatrix<double> & wp0,
-    blaze::DynamicMatrix<double> & dp,
-    blaze::DynamicVector<double, blaze::rowVector> & ztot) {
+lda_corpus lda_corpus::from_counts(
+    const blaze::DynamicMatrix<double> & word_doc_mat) {
 
     const std::int64_t D = word_doc_mat.rows();
     const std::int64_t W = word_doc_mat.columns();
-    const std::int64_t T = z.size();
-
-    const double wbeta = static_cast<double>(W) * beta;
-    blaze::DynamicMatrix<double> wp(W, T);
-    wp = wp0;
 
-    blaze::DynamicVector<double> lhs(T), rhs(T), zprob(T), probs(T);
-
-    using row_iterator =
-        blaze::DynamicMatrix<double, blaze::rowMajor>::Iterator;
-
-    using vec_iterator =
-        blaze::DynamicVector<double>::Iterator;
-
-    // N (total instance count of words) == sum(word_doc_mat)
-    std::int64_t n = 0;
+    lda_corpus corpus;
+    corpus.num_words = W;
+    corpus.doc_offsets.reserve(D + 1);
+    corpus.words.reserve(
+        static_cast<std::size_t>(blaze::sum(word_doc_mat)));
 
     for(std::int64_t d = 0; d < D; ++d) {
+        corpus.doc_offsets.push_back(corpus.words.size());
         for(std::int64_t w = 0; w < W; ++w) {
-
             const auto wdf =
                 static_cast<std::int64_t>(word_doc_mat(d, w));
+            for(std::int64_t f = 0; f < wdf; ++f) {
+                corpus.words.push_back(w);
+            }
+        }
+    }
+    corpus.doc_offsets.push_back(corpus.words.size());
 
-            if(wdf < 1) { continue; }
+    return corpus;
+}
 
-            for(std::int64_t f = 0; f < wdf; ++f) {
+/////////////////////////////////////////////////////////////////////
+// word-topic counts changed by one chunk of documents during a sweep
+struct lda_gibbs_sampler::chunk_state {
 
-                std::int64_t t = z[n];
-                --ztot[t];
-                --wp(w, t);
-                --dp(d, t);
+    chunk_state(const std::uint32_t seed, const std::int64_t T) :
+        rng(seed), ztot_delta(T, 0.0) {
+    }
 
-                row_iterator wp_beg = wp.begin(w);
-                row_iterator wp_end = wp.end(w);
+    std::mt19937 rng;
+    std::unordered_map<std::int64_t, double> wp_delta;  // w * T + t
+    std::vector<double> ztot_delta;
+};
+
+lda_gibbs_sampler::lda_gibbs_sampler(lda_corpus && corpus_,
+    const std::int64_t T_,
+    const double alpha_,
+    const double beta_,
+    const std::uint32_t seed) :
+    corpus(std::move(corpus_)), T(T_), alpha(alpha_), beta(beta_),
+    rng(seed), z(corpus.words.size()),
+    dp(corpus.num_documents(), T_, 0.0),
+    tables(corpus.num_words), has_tokens(corpus.num_words, false) {
+
+    for(const auto w : corpus.words) {
+        has_tokens[w] = true;
+    }
+}
 
-                std::transform(wp_beg, wp_end, lhs.begin(),
-                    [&beta](const auto& val) {
-                        return val + beta;
-                });
+lda_gibbs_sampler::dmatrix_t lda_gibbs_sampler::initialize() {
 
-                row_iterator dp_beg = dp.begin(d);
-                row_iterator dp_end = dp.end(d);
+    dmatrix_t wp(corpus.num_words, T, 0.0);
+    std::uniform_int_distribution<std::int64_t> dist(0, T-1);
 
-                std::transform(dp_beg, dp_end, rhs.begin(),
-                    [&alpha](const auto& val) {
-                        return val + alpha;
-                });
+    for(std::int64_t d = 0; d < corpus.num_documents(); ++d) {
+        for(std::int64_t n = corpus.doc_offsets[d];
+            n < corpus.doc_offsets[d+1]; ++n) {
+            const std::int64_t t = dist(rng);
+            z[n] = t;
+            wp(corpus.words[n], t) += 1.0;
+            dp(d, t) += 1.0;
+        }
+    }
 
-                vec_iterator ztot_beg = ztot.begin();
-                vec_iterator ztot_end = ztot.end();
+    return wp;
+}
 
-                std::transform(ztot_beg, ztot_end, zprob.begin(),
-                    [&wbeta](const auto& val) {
-                        return val + wbeta;
-                });
+// q_w(t) ~ (n_wt + beta) / (n_t + W * beta), using the counts of the
+// beginning of the sweep
+void lda_gibbs_sampler::build_alias_tables(
+    const dmatrix_t & wp, const dvector_t & ztot) {
 
-                probs = (lhs * ( rhs / zprob ));
+    const double wbeta = static_cast<double>(corpus.num_words) * beta;
 
-                double max_prob = std::abs(rand() / (RAND_MAX + 1.0)) *
-                    (*std::max_element(probs.begin(), probs.end())) * 2.0;
+    hpx::for_loop(hpx::execution::par, std::int64_t(0),
+        corpus.num_words, [&](std::int64_t w) {
 
-                t = static_cast<std::int64_t>(
-                    std::abs(rand() / (RAND_MAX + 1.0)) * T);
+        if(!has_tokens[w]) { return; }
 
-                while(max_prob > 1e-10) {
-                    max_prob -= probs[t];
-                    t = ((t+1) % T);
-                }
+        alias_table & table = tables[w];
+        table.prob.resize(T);
+        table.alias.resize(T);
 
-                z[n] = t;
-                ++ztot[t];
-                ++wp(w, t);
-                ++dp(d, t);
-                ++n;
-            }
+        double sum = 0.0;
+        for(std::int64_t t = 0; t < T; ++t) {
+            table.prob[t] = (wp(w, t) + beta) / (ztot[t] + wbeta);
+            sum += table.prob[t];
         }
-    }
-}
 
-using dmatrix_t = blaze::DynamicMatrix<double>;
-using dvector_t = blaze::DynamicVector<double>;
-using i64vector_t = blaze::DynamicVector<std::int64_t>;
+        // Vose's method
+        std::vector<std::int64_t> small, large;
+        for(std::int64_t t = 0; t < T; ++t) {
+            table.prob[t] *= static_cast<double>(T) / sum;
+            table.alias[t] = t;
+            (table.prob[t] < 1.0 ? small : large).push_back(t);
+        }
 
-std::tuple<dmatrix_t, dmatrix_t> lda_trainer_impl::operator()(
-    const dmatrix_t & word_doc_mat,
-    const std::int64_t T,
-    const std::int64_t iter) {
+        while(!small.empty() && !large.empty()) {
+            const std::int64_t s = small.back();
+            small.pop_back();
+            const std::int64_t l = large.back();
 
-    const std::int64_t D = word_doc_mat.rows();
-    const std::int64_t W = word_doc_mat.columns();
-    const std::int64_t N =
-        static_cast<std::int64_t>(blaze::sum(word_doc_mat));
-
-    dmatrix_t wp(W, T); // this component stores information that
-                            // contains a distributed reduce and scatter
-                            //
-    dmatrix_t dp(D, T); // this component is distributed, but unchanging
-    i64vector_t z(N);
-
-    {
-        // values near the mean are the most likely
-        // standard deviation affects the dispersion of generated values from the mean
-        {
-            std::random_device rd{};
-            std::default_random_engine eng{rd()};
-            std::uniform_int_distribution<> dist(0, T-1);
-            z = random(N, eng, dist);
+            table.alias[s] = l;
+            table.prob[l] -= 1.0 - table.prob[s];
+            if(table.prob[l] < 1.0) {
+                large.pop_back();
+                small.push_back(l);
+            }
         }
 
-        blaze::DynamicVector<double, blaze::columnwise> word_index_pos;
-        blaze::DynamicVector<double, blaze::rowwise> doc_index_pos;
-
-        word_index_pos = blaze::sum<blaze::rowwise>(word_doc_mat);
-        doc_index_pos = blaze::sum<blaze::columnwise>(word_doc_mat);
+        for(const auto t : small) { table.prob[t] = 1.0; }
+        for(const auto t : large) { table.prob[t] = 1.0; }
+    });
+}
 
-        // word and doc topic updates are parallel blocks
-        {
-            std::int64_t k = 0;
-            for(std::int64_t i = 0; i < W; ++i) {
-                for(std::int64_t j = 0; j < word_index_pos[i]; ++j) {
-                    wp(i, z[k]) += 1.0;
-                    ++k;
+void lda_gibbs_sampler::sample_chunk(chunk_state & state,
+    const dmatrix_t & wp, const dvector_t & ztot,
+    std::int64_t first_doc, std::int64_t last_doc) {
+
+    const double wbeta = static_cast<double>(corpus.num_words) * beta;
+    const double talpha = static_cast<double>(T) * alpha;
+
+    std::uniform_real_distribution<double> unif(0.0, 1.0);
+    auto & rng = state.rng;
+
+    for(std::int64_t d = first_doc; d < last_doc; ++d) {
+
+        const std::int64_t first = corpus.doc_offsets[d];
+        const std::int64_t n_d = corpus.doc_offsets[d+1] - first;
+
+        for(std::int64_t n = first; n < first + n_d; ++n) {
+
+            const std::int64_t w = corpus.words[n];
+
+            // counts seen by this chunk
+            auto n_wt = [&](std::int64_t t) {
+                auto it = state.wp_delta.find(w * T + t);
+                return wp(w, t) +
+                    (it == state.wp_delta.end() ? 0.0 : it->second);
+            };
+            auto n_t = [&](std::int64_t t) {
+                return ztot[t] + state.ztot_delta[t];
+            };
+            auto update = [&](std::int64_t t, double val) {
+                state.wp_delta[w * T + t] += val;
+                state.ztot_delta[t] += val;
+                dp(d, t) += val;
+            };
+
+            // remove the token from all counts
+            std::int64_t cur = z[n];
+            update(cur, -1.0);
+
+            // unnormalized full conditional
+            auto p = [&](std::int64_t t) {
+                return (dp(d, t) + alpha) * (n_wt(t) + beta) /
+                    (n_t(t) + wbeta);
+            };
+
+            // document proposal q_d(t) ~ n_dt + alpha, where n_dt
+            // includes the token itself (z[n] == cur)
+            std::int64_t t = (unif(rng) * (n_d + talpha) < n_d) ?
+                z[first + static_cast<std::int64_t>(unif(rng) * n_d)] :
+                static_cast<std::int64_t>(unif(rng) * T);
+
+            if(t != cur) {
+                const double accept = (p(t) * (dp(d, cur) + 1.0 + alpha)) /
+                    (p(cur) * (dp(d, t) + alpha));
+                if(unif(rng) < accept) {
+                    cur = t;
+                    z[n] = cur;
                 }
             }
-        }
 
-        {
-            std::int64_t k = 0;
-            for(std::int64_t i = 0; i < D; ++i) {
-                for(std::int64_t j = 0; j < doc_index_pos[i]; ++j) {
-                    dp(i, z[k]) += 1.0;
-                    ++k;
+            // word proposal from the alias table
+            const alias_table & table = tables[w];
+            t = static_cast<std::int64_t>(unif(rng) * T);
+            if(unif(rng) >= table.prob[t]) {
+                t = table.alias[t];
+            }
+
+            if(t != cur) {
+                auto q_w = [&](std::int64_t x) {
+                    return (wp(w, x) + beta) / (ztot[x] + wbeta);
+                };
+                const double accept =
+                    (p(t) * q_w(cur)) / (p(cur) * q_w(t));
+                if(unif(rng) < accept) {
+                    cur = t;
                 }
             }
+
+            // add the token back with its new topic
+            z[n] = cur;
+            update(cur, 1.0);
         }
     }
+}
+
+lda_gibbs_sampler::dmatrix_t lda_gibbs_sampler::sweep(
+    const dmatrix_t & wp) {
+
+    const dvector_t ztot = blaze::sum<blaze::columnwise>(wp);
+    build_alias_tables(wp, ztot);
+
+    // the documents are partitioned into one chunk per core
+    const std::int64_t D = corpus.num_documents();
+    const std::int64_t num_chunks = (std::max)(std::int64_t(1),
+        (std::min)(D, static_cast<std::int64_t>(
+                          hpx::get_os_thread_count())));
+
+    std::vector<chunk_state> states;
+    states.reserve(num_chunks);
+    for(std::int64_t c = 0; c < num_chunks; ++c) {
+        states.emplace_back(rng(), T);
+    }
+
+    hpx::for_loop(hpx::execution::par, std::int64_t(0), num_chunks,
+        [&](std::int64_t c) {
+            sample_chunk(states[c], wp, ztot,
+                c * D / num_chunks, (c + 1) * D / num_chunks);
+        });
+
+    // merge the thread-local deltas
+    dmatrix_t delta(corpus.num_words, T, 0.0);
+    for(const auto & state : states) {
+        for(const auto & entry : state.wp_delta) {
+            delta(entry.first / T, entry.first % T) += entry.second;
+        }
+    }
+    return delta;
+}
+
+/////////////////////////////////////////////////////////////////////
+using dmatrix_t = blaze::DynamicMatrix<double>;
+
+std::tuple<dmatrix_t, dmatrix_t> lda_trainer_impl::operator()(
+    const dmatrix_t & word_doc_mat,
+    const std::int64_t T,
+    const std::int64_t iter) {
 
-    blaze::DynamicMatrix<double> wp0(W, T);
-    blaze::DynamicVector<double, blaze::rowVector> ztot0; //(T);
+    lda_gibbs_sampler sampler(
+        lda_corpus::from_counts(word_doc_mat), T, alpha, beta, seed);
 
+    dmatrix_t wp = sampler.initialize();
     for(std::int64_t i = 0; i < iter; ++i) {
-        wp0 = wp;
-        ztot0 = blaze::eval( blaze::sum<blaze::columnwise>(wp0) );
-        // parallel portion
-        //
-        // z, wp, dp
-        //
-        gibbs(word_doc_mat, alpha, beta, z, wp, dp, ztot0);
-        wp = wp0 + (wp - wp0);
+        wp += sampler.sweep(wp);
     }
 
-    return std::make_tuple(wp, dp);
+    return std::make_tuple(std::move(wp), sampler.doc_topics());
 }
 
 } } } // end namespaces
@@ -0,0 +1,243 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/plugins/algorithms/lra_sgd.hpp>
+#include <phylanx/plugins/algorithms/lra_sgd_impl.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/iostream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const lra_sgd::match_data =
+    {
+        hpx::make_tuple("lra_sgd",
+        std::vector<std::string>{R"(
+                lra_sgd(
+                    _1_x,
+                    __arg(_2_y, nil),
+                    __arg(_3_alpha, 0.01),
+                    __arg(_4_epochs, 1),
+                    __arg(_5_batch_size, 32),
+                    __arg(_6_optimizer, "sgd"),
+                    __arg(_7_momentum, 0.9),
+                    __arg(_8_enable_output, false)
+                )
+            )"},
+            &create_lra_sgd, &create_primitive<lra_sgd>, R"(
+            x, y, alpha, epochs, batch_size, optimizer, momentum, enable_output
+
+            Args:
+
+                x (matrix or string) : the samples (one per row), or the name
+                    of a CSV file holding one sample per row with the label in
+                    the last column. The file is read in batches while the
+                    previous batch is being processed.
+                y (vector, optional) : the labels of the samples, has to be
+                    nil if x is a file name
+                alpha (float, optional): the learning rate, defaults to 0.01
+                epochs (int, optional): the number of passes over the data,
+                    defaults to 1
+                batch_size (int, optional): the number of samples used for
+                    every update of the weights, defaults to 32
+                optimizer (string, optional): the update rule, either 'sgd'
+                    (default), 'momentum', or 'adam'
+                momentum (float, optional): the momentum used by the
+                    'momentum' optimizer, defaults to 0.9
+                enable_output (bool, optional): if enabled, prints the
+                    weights after every epoch
+
+            Returns:
+
+            The calculated weights. The gradient of every batch is
+            accumulated in parallel.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    lra_sgd::lra_sgd(primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type lra_sgd::calculate_lra_sgd(
+        primitive_arguments_type&& args) const
+    {
+        // extract arguments
+        double alpha = 0.01;
+        if (valid(args[2]))
+        {
+            alpha = extract_scalar_numeric_value(
+                std::move(args[2]), name_, codename_);
+        }
+
+        std::int64_t epochs = 1;
+        if (valid(args[3]))
+        {
+            epochs = extract_scalar_nonneg_integer_value_strict(
+                std::move(args[3]), name_, codename_);
+        }
+
+        std::size_t batch_size = 32;
+        if (valid(args[4]))
+        {
+            batch_size = extract_scalar_positive_integer_value_strict(
+                std::move(args[4]), name_, codename_);
+        }
+
+        std::string optimizer = "sgd";
+        if (valid(args[5]))
+        {
+            optimizer =
+                extract_string_value(std::move(args[5]), name_, codename_);
+            if (optimizer != "sgd" && optimizer != "momentum" &&
+                optimizer != "adam")
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "lra_sgd::calculate_lra_sgd",
+                    generate_error_message(
+                        "the lra_sgd algorithm primitive requires for the "
+                        "optimizer to be one of 'sgd', 'momentum', or "
+                        "'adam'"));
+            }
+        }
+
+        double momentum = 0.9;
+        if (valid(args[6]))
+        {
+            momentum = extract_scalar_numeric_value(
+                std::move(args[6]), name_, codename_);
+        }
+
+        bool enable_output = false;
+        if (valid(args[7]))
+        {
+            enable_output = extract_scalar_boolean_value(
+                std::move(args[7]), name_, codename_);
+        }
+
+        auto output = [&](std::int64_t epoch,
+                          detail::lra_vector_type const& weights) {
+            if (enable_output)
+            {
+                hpx::cout << "epoch: " << epoch << ", " << weights
+                          << std::endl;
+            }
+        };
+
+        auto reduce = [](detail::lra_vector_type&& gradient, std::int64_t,
+                          std::size_t) { return std::move(gradient); };
+
+        // stream the data from the given file
+        if (is_string_operand(args[0]))
+        {
+            if (valid(args[1]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "lra_sgd::calculate_lra_sgd",
+                    generate_error_message(
+                        "the lra_sgd algorithm primitive requires for the "
+                        "labels not to be given if the data is read from a "
+                        "file"));
+            }
+
+            std::string const filename =
+                extract_string_value(std::move(args[0]), name_, codename_);
+
+            std::size_t const num_features =
+                detail::lra_batches(filename, 1).num_features();
+
+            detail::lra_optimizer opt(
+                optimizer, num_features, alpha, momentum);
+
+            return primitive_argument_type{detail::lra_train(
+                [&]() { return detail::lra_batches(filename, batch_size); },
+                num_features, opt, epochs, reduce, output)};
+        }
+
+        // use the data in memory
+        if (extract_numeric_value_dimension(args[0], name_, codename_) != 2 ||
+            extract_numeric_value_dimension(args[1], name_, codename_) != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "lra_sgd::calculate_lra_sgd",
+                generate_error_message(
+                    "the lra_sgd algorithm primitive requires for the first "
+                    "argument ('x') to represent a matrix and for the second "
+                    "argument ('y') to represent a vector"));
+        }
+
+        auto x = extract_numeric_value(std::move(args[0]), name_, codename_);
+        auto y = extract_numeric_value(std::move(args[1]), name_, codename_);
+
+        detail::lra_matrix_type const x_data = x.matrix();
+        detail::lra_vector_type const y_data = y.vector();
+        if (x_data.rows() != y_data.size())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "lra_sgd::calculate_lra_sgd",
+                generate_error_message(
+                    "the lra_sgd algorithm primitive requires for the number "
+                    "of rows in 'x' to be equal to the size of 'y'"));
+        }
+
+        detail::lra_optimizer opt(
+            optimizer, x_data.columns(), alpha, momentum);
+
+        return primitive_argument_type{detail::lra_train(
+            [&]() {
+                return detail::lra_batches(x_data, y_data, batch_size);
+            },
+            x_data.columns(), opt, epochs, reduce, output)};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> lra_sgd::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.empty() || operands.size() > 8)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "lra_sgd::eval",
+                generate_error_message(
+                    "the lra_sgd algorithm primitive requires at least one "
+                    "and at most 8 operands"));
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "lra_sgd::eval",
+                generate_error_message(
+                    "the lra_sgd algorithm primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                    -> primitive_argument_type
+                {
+                    return this_->calculate_lra_sgd(std::move(args));
+                }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
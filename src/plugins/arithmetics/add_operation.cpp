@@ -131,7 +131,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    hpx::future<primitive_argument_type> add_operation::eval(
+    util::future_or_value<primitive_argument_type>
+    add_operation::eval_future_or_value(
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
@@ -159,40 +160,54 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "given by the operands array are valid"));
         }
 
-        auto this_ = this->shared_from_this();
         if (operands.size() == 2)
         {
-            // special case for 2 operands
-            return hpx::dataflow(hpx::launch::sync,
-                [this_ = std::move(this_)](
-                    hpx::future<primitive_argument_type>&& lhs,
-                    hpx::future<primitive_argument_type>&& rhs)
+            // special case for 2 operands, the result is computed right
+            // away if both operands are available
+            auto add = [](add_operation const& this_,
+                           primitive_argument_type&& lhs_val,
+                           primitive_argument_type&& rhs_val)
                 -> primitive_argument_type
+            {
+                annotation_wrapper wrap(lhs_val, rhs_val);
+
+                if (is_list_operand_strict(lhs_val))
                 {
-                    auto && lhs_val = lhs.get();
-                    auto && rhs_val = rhs.get();
+                    return wrap.propagate(
+                        this_.handle_list_operands(
+                            std::move(lhs_val), std::move(rhs_val)),
+                        this_.name_, this_.codename_);
+                }
 
-                    annotation_wrapper wrap(lhs_val, rhs_val);
+                return wrap.propagate(
+                    this_.handle_numeric_operands(
+                        std::move(lhs_val), std::move(rhs_val)),
+                    this_.name_, this_.codename_);
+            };
 
-                    if (is_list_operand_strict(lhs_val))
-                    {
-                        return wrap.propagate(
-                            this_->handle_list_operands(
-                                std::move(lhs_val), std::move(rhs_val)),
-                            this_->name_, this_->codename_);
-                    }
+            auto lhs = value_operand_future_or_value(
+                operands[0], args, name_, codename_, ctx);
+            auto rhs = value_operand_future_or_value(
+                operands[1], args, name_, codename_, ctx);
 
-                    return wrap.propagate(
-                        this_->handle_numeric_operands(
-                            std::move(lhs_val), std::move(rhs_val)),
-                        this_->name_, this_->codename_);
+            if (lhs.is_ready() && rhs.is_ready())
+            {
+                return add(*this, lhs.get(), rhs.get());
+            }
+
+            return hpx::dataflow(hpx::launch::sync,
+                [this_ = this->shared_from_this(), add](
+                    hpx::future<primitive_argument_type>&& lhs,
+                    hpx::future<primitive_argument_type>&& rhs)
+                -> primitive_argument_type
+                {
+                    return add(*this_, lhs.get(), rhs.get());
                 },
-                value_operand(operands[0], args, name_, codename_, ctx),
-                value_operand(operands[1], args, name_, codename_, ctx));
+                lhs.get_future(), rhs.get_future());
         }
 
         return hpx::dataflow(hpx::launch::sync, hpx::unwrapping(
-            [this_ = std::move(this_)](primitive_arguments_type&& ops)
+            [this_ = this->shared_from_this()](primitive_arguments_type&& ops)
             ->  primitive_argument_type
             {
                 if (is_list_operand_strict(ops[0]))
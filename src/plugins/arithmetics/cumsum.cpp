@@ -7,9 +7,6 @@
 #include <phylanx/plugins/arithmetics/cumulative_impl.hpp>
 #include <phylanx/plugins/arithmetics/cumsum.hpp>
 
-#include <hpx/include/parallel_scan.hpp>
-
-#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -53,12 +50,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 return T(0);
             }
 
-            template <typename InIter, typename OutIter, typename T>
-            OutIter operator()(
-                InIter begin, InIter end, OutIter dest, T init) const
+            template <typename T>
+            T operator()(T const& lhs, T const& rhs) const
             {
-                return hpx::inclusive_scan(
-                    hpx::execution::seq, begin, end, dest, std::plus<>{}, init);
+                return T(lhs + rhs);
             }
         };
     }
@@ -13,6 +13,8 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(and_operation_plugin,
     phylanx::execution_tree::primitives::and_operation::match_data[0]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(logical_and_operation_plugin,
     phylanx::execution_tree::primitives::and_operation::match_data[1]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(compress_operation_plugin,
+    phylanx::execution_tree::primitives::compress_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(equal_plugin,
     phylanx::execution_tree::primitives::equal::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(greater_plugin,
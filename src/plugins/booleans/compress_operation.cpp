@@ -0,0 +1,358 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/booleans/compress_operation.hpp>
+#include <phylanx/util/parallel_scan.hpp>
+
+#include <hpx/datastructures/optional.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/modules/format.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const compress_operation::match_data =
+    {
+        match_pattern_type{"compress",
+            std::vector<std::string>{
+                "compress(_1_condition, _2_a, __arg(_3_axis, nil))"
+            },
+            &create_compress_operation,
+            &create_primitive<compress_operation>, R"(
+            condition, a, axis
+            Args:
+
+                condition (vector) : selects the entries of `a` to return,
+                    entries of `a` beyond the length of `condition` are not
+                    selected
+                a (array) : the array to select the entries from
+                axis (int, optional) : the axis along which slices of `a` are
+                    selected, by default (nil) the entries of the flattened
+                    array are selected
+
+            Returns:
+
+            A copy of `a` with only the slices along the given axis (or the
+            entries of the flattened array) for which `condition` is true.
+            )"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    compress_operation::compress_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    // the condition is converted into a packed mask, it may be shorter than
+    // the array along the given axis (numpy semantics)
+    util::bit_mask compress_operation::compress_mask(
+        ir::node_data<std::uint8_t> const& cond, std::size_t extent) const
+    {
+        auto v = cond.vector();
+        if (v.size() > extent)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "compress_operation::compress_mask",
+                generate_error_message(hpx::util::format(
+                    "the condition (size {:d}) is longer than the array "
+                    "along the given axis (size {:d})",
+                    v.size(), extent)));
+        }
+        return util::bit_mask::from_values(v.data(), v.size());
+    }
+
+    template <typename T>
+    primitive_argument_type compress_operation::compress_flat(
+        ir::node_data<std::uint8_t>&& cond, ir::node_data<T>&& arg) const
+    {
+        util::bit_mask const mask = compress_mask(cond, arg.size());
+
+        blaze::DynamicVector<T> result;
+        auto allocate = [&](std::size_t count) { result.resize(count); };
+
+        switch (arg.num_dimensions())
+        {
+        case 0:
+            result = blaze::DynamicVector<T>(mask.count(), arg.scalar());
+            break;
+
+        case 1:
+            {
+                auto v = arg.vector();
+                util::compact(mask, allocate,
+                    [&](std::size_t i, std::size_t pos) {
+                        result[pos] = v[i];
+                    });
+            }
+            break;
+
+        case 2:
+            {
+                auto m = arg.matrix();
+                std::size_t const columns = m.columns();
+                util::compact(mask, allocate,
+                    [&](std::size_t i, std::size_t pos) {
+                        result[pos] = m(i / columns, i % columns);
+                    });
+            }
+            break;
+
+        case 3:
+            {
+                auto t = arg.tensor();
+                std::size_t const columns = t.columns();
+                std::size_t const page_size = t.rows() * columns;
+                util::compact(mask, allocate,
+                    [&](std::size_t i, std::size_t pos) {
+                        result[pos] = t(i / page_size,
+                            (i % page_size) / columns, i % columns);
+                    });
+            }
+            break;
+
+        default:
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "compress_operation::compress_flat",
+                generate_error_message(
+                    "operand a has unsupported number of dimensions"));
+        }
+
+        return primitive_argument_type{std::move(result)};
+    }
+
+    template <typename T>
+    primitive_argument_type compress_operation::compress_axis(
+        ir::node_data<std::uint8_t>&& cond, ir::node_data<T>&& arg,
+        std::size_t axis) const
+    {
+        // indices of the selected slices
+        std::vector<std::size_t> indices;
+        util::compact(compress_mask(cond, arg.dimension(int(axis))),
+            [&](std::size_t count) { indices.resize(count); },
+            [&](std::size_t i, std::size_t pos) { indices[pos] = i; });
+
+        std::size_t const count = indices.size();
+        switch (arg.num_dimensions())
+        {
+        case 1:
+            {
+                auto v = arg.vector();
+                blaze::DynamicVector<T> result(count);
+                for (std::size_t k = 0; k != count; ++k)
+                {
+                    result[k] = v[indices[k]];
+                }
+                return primitive_argument_type{std::move(result)};
+            }
+
+        case 2:
+            {
+                auto m = arg.matrix();
+                if (axis == 0)
+                {
+                    blaze::DynamicMatrix<T> result(count, m.columns());
+                    for (std::size_t k = 0; k != count; ++k)
+                    {
+                        blaze::row(result, k) = blaze::row(m, indices[k]);
+                    }
+                    return primitive_argument_type{std::move(result)};
+                }
+
+                blaze::DynamicMatrix<T> result(m.rows(), count);
+                for (std::size_t k = 0; k != count; ++k)
+                {
+                    blaze::column(result, k) = blaze::column(m, indices[k]);
+                }
+                return primitive_argument_type{std::move(result)};
+            }
+
+        case 3:
+            {
+                auto t = arg.tensor();
+                if (axis == 0)
+                {
+                    blaze::DynamicTensor<T> result(
+                        count, t.rows(), t.columns());
+                    for (std::size_t k = 0; k != count; ++k)
+                    {
+                        blaze::pageslice(result, k) =
+                            blaze::pageslice(t, indices[k]);
+                    }
+                    return primitive_argument_type{std::move(result)};
+                }
+
+                if (axis == 1)
+                {
+                    blaze::DynamicTensor<T> result(
+                        t.pages(), count, t.columns());
+                    for (std::size_t k = 0; k != count; ++k)
+                    {
+                        blaze::rowslice(result, k) =
+                            blaze::rowslice(t, indices[k]);
+                    }
+                    return primitive_argument_type{std::move(result)};
+                }
+
+                blaze::DynamicTensor<T> result(t.pages(), t.rows(), count);
+                for (std::size_t k = 0; k != count; ++k)
+                {
+                    blaze::columnslice(result, k) =
+                        blaze::columnslice(t, indices[k]);
+                }
+                return primitive_argument_type{std::move(result)};
+            }
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "compress_operation::compress_axis",
+            generate_error_message(
+                "operand a has unsupported number of dimensions"));
+    }
+
+    template <typename T>
+    primitive_argument_type compress_operation::compress(
+        ir::node_data<std::uint8_t>&& cond, ir::node_data<T>&& arg,
+        hpx::util::optional<std::int64_t> const& axis) const
+    {
+        std::size_t const dims = arg.num_dimensions();
+
+        std::int64_t real_axis = 0;
+        if (axis)
+        {
+            real_axis = *axis < 0 ? *axis + std::int64_t(dims) : *axis;
+            if (real_axis < 0 || real_axis >= std::int64_t(dims))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "compress_operation::compress",
+                    generate_error_message(hpx::util::format(
+                        "axis {:d} is out of bounds for an array of "
+                        "dimension {:d}",
+                        *axis, dims)));
+            }
+        }
+
+        if (!axis)
+        {
+            return compress_flat(std::move(cond), std::move(arg));
+        }
+        return compress_axis(
+            std::move(cond), std::move(arg), std::size_t(real_axis));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type compress_operation::calculate_compress(
+        primitive_arguments_type&& args) const
+    {
+        if (extract_numeric_value_dimension(args[0], name_, codename_) != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "compress_operation::calculate_compress",
+                generate_error_message(
+                    "the compress primitive requires for the condition to "
+                    "be a vector"));
+        }
+
+        hpx::util::optional<std::int64_t> axis;
+        if (args.size() == 3 && valid(args[2]))
+        {
+            axis = extract_scalar_integer_value(
+                std::move(args[2]), name_, codename_);
+        }
+
+        auto cond = extract_boolean_value(std::move(args[0]), name_, codename_);
+
+        switch (extract_common_type(args[1]))
+        {
+        case node_data_type_bool:
+            return compress(std::move(cond),
+                extract_boolean_value_strict(
+                    std::move(args[1]), name_, codename_),
+                axis);
+
+        case node_data_type_int64:
+            return compress(std::move(cond),
+                extract_integer_value_strict(
+                    std::move(args[1]), name_, codename_),
+                axis);
+
+        case node_data_type_double:
+            return compress(std::move(cond),
+                extract_numeric_value_strict(
+                    std::move(args[1]), name_, codename_),
+                axis);
+
+        case node_data_type_unknown:
+            return compress(std::move(cond),
+                extract_numeric_value(std::move(args[1]), name_, codename_),
+                axis);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "compress_operation::calculate_compress",
+            generate_error_message(
+                "the compress primitive requires for all arguments to "
+                "be numeric data types"));
+    }
+
+    hpx::future<primitive_argument_type> compress_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() != 2 && operands.size() != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "compress_operation::eval",
+                generate_error_message(
+                    "the compress primitive requires two or three "
+                    "operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "compress_operation::eval",
+                generate_error_message(
+                    "the compress primitive requires that the arguments "
+                    "given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                    -> primitive_argument_type
+                {
+                    return this_->calculate_compress(std::move(args));
+                }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
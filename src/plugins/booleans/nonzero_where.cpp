@@ -8,6 +8,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/booleans/nonzero_where.hpp>
+#include <phylanx/util/parallel_scan.hpp>
 
 #include <hpx/assert.hpp>
 #include <hpx/include/lcos.hpp>
@@ -113,17 +114,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         case 1:
             {
                 auto v = op.vector();
-                storage1d_type indices(v.size());
-                std::size_t count = 0;
-                for (std::size_t i = 0; i != v.size(); ++i)
-                {
-                    if (v[i] != T(0))
-                    {
-                        indices[count++] = std::int64_t(i);
-                    }
-                }
-                indices.resize(count);
-                indices.shrinkToFit();
+                storage1d_type indices;
+                util::compact(
+                    v.size(), [&](std::size_t i) { return v[i] != T(0); },
+                    [&](std::size_t count) { indices.resize(count); },
+                    [&](std::size_t i, std::size_t pos) {
+                        indices[pos] = std::int64_t(i);
+                    });
 
                 primitive_arguments_type result;
                 result.reserve(1);
@@ -134,27 +131,23 @@ namespace phylanx { namespace execution_tree { namespace primitives
         case 2:
             {
                 auto m = op.matrix();
-                storage1d_type indices_row(op.size());
-                storage1d_type indices_column(op.size());
-                std::size_t count = 0;
-
-                for (std::size_t i = 0; i != m.rows(); ++i)
-                {
-                    for (std::size_t j = 0; j != m.columns(); ++j)
-                    {
-                        if (m(i, j) != T(0))
-                        {
-                            indices_row[count] = std::int64_t(i);
-                            indices_column[count++] = std::int64_t(j);
-                        }
-                    }
-                }
-
-                indices_row.resize(count);
-                indices_row.shrinkToFit();
-
-                indices_column.resize(count);
-                indices_column.shrinkToFit();
+                std::size_t const columns = m.columns();
+                storage1d_type indices_row;
+                storage1d_type indices_column;
+
+                util::compact(
+                    m.rows() * columns,
+                    [&](std::size_t i) {
+                        return m(i / columns, i % columns) != T(0);
+                    },
+                    [&](std::size_t count) {
+                        indices_row.resize(count);
+                        indices_column.resize(count);
+                    },
+                    [&](std::size_t i, std::size_t pos) {
+                        indices_row[pos] = std::int64_t(i / columns);
+                        indices_column[pos] = std::int64_t(i % columns);
+                    });
 
                 primitive_arguments_type result;
                 result.reserve(2);
@@ -11,9 +11,12 @@
 #include <phylanx/plugins/common/transpose_operation_nd.hpp>
 #include <phylanx/plugins/matrixops/transpose_operation.hpp>
 #include <phylanx/util/generate_error_message.hpp>
+#include <phylanx/util/permute_axes.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -37,11 +40,11 @@ namespace phylanx { namespace common
     {
         if (arg.is_ref())
         {
-            arg = blaze::trans(arg.matrix());
+            arg = util::permute_axes(arg.matrix());
         }
         else
         {
-            blaze::transpose(arg.matrix_non_ref());
+            util::transpose_inplace(arg.matrix_non_ref());
         }
 
         return execution_tree::primitive_argument_type{std::move(arg)};
@@ -134,68 +137,57 @@ namespace phylanx { namespace common
     }
 
     ////////////////////////////////////////////////////////////////////////////
-    template <typename T>
-    execution_tree::primitive_argument_type transpose3d(ir::node_data<T>&& arg)
+    namespace detail
     {
-        if (arg.is_ref())
-            arg = blaze::trans(arg.tensor(), {2, 1, 0});
+        template <typename T>
+        execution_tree::primitive_argument_type permute3d(
+            ir::node_data<T>&& arg, std::array<std::size_t, 3> const& axes)
+        {
+            arg = util::permute_axes(arg.tensor(), axes);
+            return execution_tree::primitive_argument_type{std::move(arg)};
+        }
 
-        else
-            blaze::transpose(arg.tensor_non_ref(), {2, 1, 0});
+        template <typename T>
+        execution_tree::primitive_argument_type permute4d(
+            ir::node_data<T>&& arg, std::array<std::size_t, 4> const& axes)
+        {
+            arg = util::permute_axes(arg.quatern(), axes);
+            return execution_tree::primitive_argument_type{std::move(arg)};
+        }
+    }
 
-        return execution_tree::primitive_argument_type{std::move(arg)};
+    template <typename T>
+    execution_tree::primitive_argument_type transpose3d(ir::node_data<T>&& arg)
+    {
+        return detail::permute3d(std::move(arg), {2, 1, 0});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose3d_axes102(
         ir::node_data<T>&& arg)
     {
-        if (arg.is_ref())
-            arg = blaze::trans(arg.tensor(), {1, 0, 2});
-
-        else
-            blaze::transpose(arg.tensor_non_ref(), {1, 0, 2});
-
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute3d(std::move(arg), {1, 0, 2});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose3d_axes021(
         ir::node_data<T>&& arg)
     {
-        if (arg.is_ref())
-            arg = blaze::trans(arg.tensor(), {0, 2, 1});
-
-        else
-            blaze::transpose(arg.tensor_non_ref(), {0, 2, 1});
-
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute3d(std::move(arg), {0, 2, 1});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose3d_axes120(
         ir::node_data<T>&& arg)
     {
-        if (arg.is_ref())
-            arg = blaze::trans(arg.tensor(), {1, 2, 0});
-
-        else
-            blaze::transpose(arg.tensor_non_ref(), {1, 2, 0});
-
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute3d(std::move(arg), {1, 2, 0});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose3d_axes201(
         ir::node_data<T>&& arg)
     {
-        if (arg.is_ref())
-            arg = blaze::trans(arg.tensor(), {2, 0, 1});
-
-        else
-            blaze::transpose(arg.tensor_non_ref(), {2, 0, 1});
-
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute3d(std::move(arg), {2, 0, 1});
     }
 
     execution_tree::primitive_argument_type transpose3d(
@@ -296,184 +288,161 @@ namespace phylanx { namespace common
     template <typename T>
     execution_tree::primitive_argument_type transpose4d(ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern());
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {3, 2, 1, 0});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes0132(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {0, 1, 3, 2});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {0, 1, 3, 2});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes0213(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {0, 2, 1, 3});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {0, 2, 1, 3});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes0231(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {0, 2, 3, 1});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {0, 2, 3, 1});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes0312(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {0, 3, 1, 2});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {0, 3, 1, 2});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes0321(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {0, 3, 2, 1});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {0, 3, 2, 1});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes1023(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {1, 0, 2, 3});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {1, 0, 2, 3});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes1032(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {1, 0, 3, 2});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {1, 0, 3, 2});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes1203(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {1, 2, 0, 3});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {1, 2, 0, 3});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes1230(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {1, 2, 3, 0});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {1, 2, 3, 0});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes1302(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {1, 3, 0, 2});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {1, 3, 0, 2});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes1320(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {1, 3, 2, 0});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {1, 3, 2, 0});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes2013(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {2, 0, 1, 3});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {2, 0, 1, 3});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes2031(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {2, 0, 3, 1});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {2, 0, 3, 1});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes2103(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {2, 1, 0, 3});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {2, 1, 0, 3});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes2130(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {2, 1, 3, 0});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {2, 1, 3, 0});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes2301(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {2, 3, 0, 1});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {2, 3, 0, 1});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes2310(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {2, 3, 1, 0});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {2, 3, 1, 0});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes3012(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {3, 0, 1, 2});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {3, 0, 1, 2});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes3021(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {3, 0, 2, 1});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {3, 0, 2, 1});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes3102(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {3, 1, 0, 2});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {3, 1, 0, 2});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes3120(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {3, 1, 2, 0});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {3, 1, 2, 0});
     }
 
     template <typename T>
     execution_tree::primitive_argument_type transpose4d_axes3201(
         ir::node_data<T>&& arg)
     {
-        arg = blaze::trans(arg.quatern(), {3, 2, 0, 1});
-        return execution_tree::primitive_argument_type{std::move(arg)};
+        return detail::permute4d(std::move(arg), {3, 2, 0, 1});
     }
 
     execution_tree::primitive_argument_type transpose4d(
@@ -612,8 +581,6 @@ namespace phylanx { namespace common
             return transpose4d_axes3201(std::move(arg));
         }
         return transpose4d(std::move(arg));
-
-
     }
 
     execution_tree::primitive_argument_type transpose4d(
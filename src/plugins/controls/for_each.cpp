@@ -7,6 +7,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/controls/for_each.hpp>
+#include <phylanx/util/future_or_value.hpp>
 #include <phylanx/util/matrix_iterators.hpp>
 
 #include <hpx/errors/throw_exception.hpp>
@@ -254,9 +255,17 @@ namespace phylanx { namespace execution_tree { namespace primitives {
 
         ctx.remove_mode(eval_dont_wrap_functions);
 
-        auto op0 = value_operand(operands_[0], args, name_, codename_,
-            add_mode(ctx, eval_dont_evaluate_lambdas));
-        auto op1 = value_operand(operands_[1], args, name_, codename_, ctx);
+        auto op0 = value_operand_future_or_value(operands_[0], args, name_,
+            codename_, add_mode(ctx, eval_dont_evaluate_lambdas));
+        auto op1 = value_operand_future_or_value(
+            operands_[1], args, name_, codename_, ctx);
+
+        // iterate right away if both operands are available
+        if (op0.is_ready() && op1.is_ready())
+        {
+            return hpx::make_ready_future(
+                iterate(op0.get(), op1.get(), std::move(ctx)));
+        }
 
         auto this_ = this->shared_from_this();
         return hpx::dataflow(
@@ -265,75 +274,74 @@ namespace phylanx { namespace execution_tree { namespace primitives {
                 hpx::future<primitive_argument_type>&& f,
                 hpx::future<primitive_argument_type>&& fval) mutable
             -> primitive_argument_type {
-                auto&& bound_func = f.get();
-
-                primitive const* p = util::get_if<primitive>(&bound_func);
-                if (p == nullptr)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter, "for_each::eval",
-                        this_->generate_error_message(
-                            "the first argument to for_each must "
-                            "resolve to an invocable object",
-                            ctx));
-                }
+                return this_->iterate(f.get(), fval.get(), std::move(ctx));
+            },
+            op0.get_future(), op1.get_future());
+    }
 
-                // evaluate function for each of the elements from the given
-                // range
-                auto&& value = fval.get();
+    primitive_argument_type for_each::iterate(
+        primitive_argument_type&& bound_func, primitive_argument_type&& value,
+        eval_context ctx) const
+    {
+        primitive const* p = util::get_if<primitive>(&bound_func);
+        if (p == nullptr)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "for_each::iterate",
+                generate_error_message(
+                    "the first argument to for_each must "
+                    "resolve to an invocable object",
+                    ctx));
+        }
 
-                if (is_list_operand_strict(value))
+        // evaluate function for each of the elements from the given range
+        if (is_list_operand_strict(value))
+        {
+            auto&& list =
+                extract_list_value_strict(std::move(value), name_, codename_);
+            for (auto&& e : std::move(list))
+            {
+                auto r = p->eval(hpx::launch::sync, std::move(e), ctx);
+                if (is_boolean_operand_strict(r))
                 {
-                    auto&& list = extract_list_value_strict(
-                        std::move(value), this_->name_, this_->codename_);
-                    for (auto&& e : std::move(list))
+                    if (extract_boolean_value(std::move(r), name_, codename_))
                     {
-                        auto r = p->eval(hpx::launch::sync, std::move(e), ctx);
-                        if (is_boolean_operand_strict(r))
-                        {
-                            if (extract_boolean_value(std::move(r),
-                                    this_->name_, this_->codename_))
-                            {
-                                break;    // stop, if requested
-                            }
-                        }
+                        break;    // stop, if requested
                     }
                 }
-                else if (is_dictionary_operand_strict(value))
+            }
+        }
+        else if (is_dictionary_operand_strict(value))
+        {
+            auto&& dict = extract_dictionary_value_strict(
+                std::move(value), name_, codename_);
+            for (auto&& e : std::move(dict).dict())
+            {
+                auto result = p->eval(hpx::launch::sync,
+                    primitive_argument_type{std::move(e.first.get())}, ctx);
+
+                if (is_boolean_operand_strict(result))
                 {
-                    auto&& dict = extract_dictionary_value_strict(
-                        std::move(value), this_->name_, this_->codename_);
-                    for (auto&& e : std::move(dict).dict())
+                    if (extract_boolean_value(
+                            std::move(result), name_, codename_))
                     {
-                        auto result = p->eval(hpx::launch::sync,
-                            primitive_argument_type{std::move(e.first.get())},
-                            ctx);
-
-                        if (is_boolean_operand_strict(result))
-                        {
-                            if (extract_boolean_value(std::move(result),
-                                    this_->name_, this_->codename_))
-                            {
-                                break;    // stop, if requested
-                            }
-                        }
+                        break;    // stop, if requested
                     }
                 }
-                else if (is_numeric_operand_strict(value) ||
-                    is_boolean_operand_strict(value) ||
-                    is_integer_operand_strict(value))
-                {
-                    this_->iterate_over_array(
-                        p, std::move(value), std::move(ctx));
-                }
-                else
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter, "for_each::eval",
-                        this_->generate_error_message(
-                            "unsupported iteration space for for_each", ctx));
-                }
+            }
+        }
+        else if (is_numeric_operand_strict(value) ||
+            is_boolean_operand_strict(value) ||
+            is_integer_operand_strict(value))
+        {
+            iterate_over_array(p, std::move(value), std::move(ctx));
+        }
+        else
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "for_each::iterate",
+                generate_error_message(
+                    "unsupported iteration space for for_each", ctx));
+        }
 
-                return primitive_argument_type{};
-            },
-            std::move(op0), std::move(op1));
+        return primitive_argument_type{};
     }
 }}}    // namespace phylanx::execution_tree::primitives
@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/controls/for_operation.hpp>
+#include <phylanx/util/future_or_value.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -83,48 +84,99 @@ namespace phylanx { namespace execution_tree { namespace primitives
             primitive_arguments_type const& args)
         {
             this->args_ = args;
-            auto this_ = this->shared_from_this();
-            return value_operand(that_->operands_[0], args_,
-                    that_->name_, that_->codename_, ctx_)
-                .then(hpx::launch::sync,
-                    [this_ = std::move(this_)](
-                        hpx::future<primitive_argument_type>&& val)
-                    -> hpx::future<primitive_argument_type>
-                    {
-                        val.get();
-                        return this_->loop();
-                    });
+
+            util::future_or_value<primitive_argument_type> val =
+                value_operand_future_or_value(that_->operands_[0], args_,
+                    that_->name_, that_->codename_, ctx_);
+
+            if (val.is_ready())
+            {
+                val.get();
+                return loop();
+            }
+            return resume(std::move(val));
         }
 
+        // Evaluate the condition, the body, and the reinit statement in a
+        // plain loop for as long as all of them produce ready values,
+        // continue asynchronously as soon as one of them returns a pending
+        // future.
         hpx::future<primitive_argument_type> loop()
         {
-            // Evaluate condition of for statement
-            auto this_ = this->shared_from_this();
-            return value_operand(that_->operands_[1], args_,
-                    that_->name_, that_->codename_, ctx_)
-                .then(hpx::launch::sync,
-                    [this_ = std::move(this_)](
-                        hpx::future<primitive_argument_type>&& cond)
-                    -> hpx::future<primitive_argument_type>
-                    {
-                        return this_->body(std::move(cond));
-                    });
+            while (true)
+            {
+                util::future_or_value<primitive_argument_type> cond =
+                    value_operand_future_or_value(that_->operands_[1], args_,
+                        that_->name_, that_->codename_, ctx_);
+
+                if (!cond.is_ready())
+                {
+                    auto this_ = this->shared_from_this();
+                    return cond.get_future().then(hpx::launch::sync,
+                        [this_ = std::move(this_)](
+                            hpx::future<primitive_argument_type>&& cond)
+                        -> hpx::future<primitive_argument_type>
+                        {
+                            return this_->body(std::move(cond));
+                        });
+                }
+
+                if (!condition(cond.get()))
+                {
+                    return hpx::make_ready_future(result_);
+                }
+
+                util::future_or_value<primitive_argument_type> result =
+                    value_operand_future_or_value(that_->operands_[3], args_,
+                        that_->name_, that_->codename_, ctx_);
+
+                if (!result.is_ready())
+                {
+                    auto this_ = this->shared_from_this();
+                    return result.get_future().then(hpx::launch::sync,
+                        [this_ = std::move(this_)](
+                            hpx::future<primitive_argument_type>&& result)
+                        -> hpx::future<primitive_argument_type>
+                        {
+                            this_->result_ = result.get();
+                            return this_->reinit();
+                        });
+                }
+                result_ = result.get();
+
+                util::future_or_value<primitive_argument_type> val =
+                    value_operand_future_or_value(that_->operands_[2], args_,
+                        that_->name_, that_->codename_, ctx_);
+
+                if (!val.is_ready())
+                {
+                    return resume(std::move(val));
+                }
+                val.get();
+            }
         }
 
         hpx::future<primitive_argument_type> body(
             hpx::future<primitive_argument_type>&& cond)
         {
-            if (extract_scalar_boolean_value(
-                    cond.get(), that_->name_, that_->codename_))
+            if (condition(cond.get()))
             {
                 // Evaluate body of for statement
+                util::future_or_value<primitive_argument_type> result =
+                    value_operand_future_or_value(that_->operands_[3], args_,
+                        that_->name_, that_->codename_, ctx_);
+
+                if (result.is_ready())
+                {
+                    result_ = result.get();
+                    return reinit();    // Do the reinit statement
+                }
+
                 auto this_ = this->shared_from_this();
-                return value_operand(that_->operands_[3], args_,
-                        that_->name_, that_->codename_, ctx_)
-                    .then(hpx::launch::sync,
-                        [this_ = std::move(this_)](
-                            hpx::future<primitive_argument_type>&& result) mutable
-                        -> hpx::future<primitive_argument_type>
+                return result.get_future().then(hpx::launch::sync,
+                    [this_ = std::move(this_)](
+                        hpx::future<primitive_argument_type>&& result) mutable
+                    -> hpx::future<primitive_argument_type>
                     {
                         this_->result_ = result.get();
                         return this_->reinit();    // Do the reinit statement
@@ -135,18 +187,38 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
 
         hpx::future<primitive_argument_type> reinit()
+        {
+            util::future_or_value<primitive_argument_type> val =
+                value_operand_future_or_value(that_->operands_[2], args_,
+                    that_->name_, that_->codename_, ctx_);
+
+            if (val.is_ready())
+            {
+                val.get();
+                return loop();    // Call the loop again
+            }
+            return resume(std::move(val));
+        }
+
+        // Call the loop again once the pending value is available
+        hpx::future<primitive_argument_type> resume(
+            util::future_or_value<primitive_argument_type>&& val)
         {
             auto this_ = this->shared_from_this();
-            return value_operand(that_->operands_[2], args_,
-                    that_->name_, that_->codename_, ctx_)
-                .then(hpx::launch::sync,
-                    [this_ = std::move(this_)](
-                        hpx::future<primitive_argument_type>&& val)
-                    -> hpx::future<primitive_argument_type>
-                    {
-                        val.get();
-                        return this_->loop();   // Call the loop again
-                    });
+            return val.get_future().then(hpx::launch::sync,
+                [this_ = std::move(this_)](
+                    hpx::future<primitive_argument_type>&& val)
+                -> hpx::future<primitive_argument_type>
+                {
+                    val.get();
+                    return this_->loop();
+                });
+        }
+
+        bool condition(primitive_argument_type&& cond) const
+        {
+            return extract_scalar_boolean_value(
+                std::move(cond), that_->name_, that_->codename_);
         }
 
     private:
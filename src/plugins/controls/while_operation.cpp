@@ -6,6 +6,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/controls/while_operation.hpp>
+#include <phylanx/util/future_or_value.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -74,44 +75,89 @@ namespace phylanx { namespace execution_tree { namespace primitives
             }
         }
 
+        // Evaluate the condition and the body of the while statement in a
+        // plain loop for as long as both produce ready values, continue
+        // asynchronously as soon as one of them returns a pending future.
         hpx::future<primitive_argument_type> loop()
         {
-            // Evaluate condition of while statement
-            auto this_ = this->shared_from_this();
-            return value_operand(that_->operands_[0], args_,
-                    that_->name_, that_->codename_, ctx_)
-                .then(hpx::launch::sync,
-                    [this_ = std::move(this_)](
-                        hpx::future<primitive_argument_type>&& cond)
-                    -> hpx::future<primitive_argument_type>
-                    {
-                        return this_->body(std::move(cond));
-                    });
+            while (true)
+            {
+                util::future_or_value<primitive_argument_type> cond =
+                    value_operand_future_or_value(that_->operands_[0], args_,
+                        that_->name_, that_->codename_, ctx_);
+
+                if (!cond.is_ready())
+                {
+                    auto this_ = this->shared_from_this();
+                    return cond.get_future().then(hpx::launch::sync,
+                        [this_ = std::move(this_)](
+                            hpx::future<primitive_argument_type>&& cond)
+                        -> hpx::future<primitive_argument_type>
+                        {
+                            return this_->body(std::move(cond));
+                        });
+                }
+
+                if (!condition(cond.get()))
+                {
+                    return hpx::make_ready_future(std::move(result_));
+                }
+
+                util::future_or_value<primitive_argument_type> result =
+                    value_operand_future_or_value(that_->operands_[1], args_,
+                        that_->name_, that_->codename_, ctx_);
+
+                if (!result.is_ready())
+                {
+                    return resume(std::move(result));
+                }
+
+                result_ = result.get();
+            }
         }
 
         hpx::future<primitive_argument_type> body(
             hpx::future<primitive_argument_type>&& cond)
         {
-            if (extract_scalar_boolean_value(
-                    cond.get(), that_->name_, that_->codename_))
+            if (condition(cond.get()))
             {
                 // Evaluate body of while statement
-                auto this_ = this->shared_from_this();
-                return value_operand(that_->operands_[1], args_,
-                        that_->name_, that_->codename_, ctx_)
-                    .then(hpx::launch::sync,
-                        [this_ = std::move(this_)](
-                            hpx::future<primitive_argument_type>&& result) mutable
-                        -> hpx::future<primitive_argument_type>
-                        {
-                            this_->result_ = result.get();
-                            return this_->loop();
-                        });
+                util::future_or_value<primitive_argument_type> result =
+                    value_operand_future_or_value(that_->operands_[1], args_,
+                        that_->name_, that_->codename_, ctx_);
+
+                if (result.is_ready())
+                {
+                    result_ = result.get();
+                    return loop();
+                }
+                return resume(std::move(result));
             }
 
             return hpx::make_ready_future(std::move(result_));
         }
 
+        // Continue iterating once the pending result of the body is available
+        hpx::future<primitive_argument_type> resume(
+            util::future_or_value<primitive_argument_type>&& result)
+        {
+            auto this_ = this->shared_from_this();
+            return result.get_future().then(hpx::launch::sync,
+                [this_ = std::move(this_)](
+                    hpx::future<primitive_argument_type>&& result) mutable
+                -> hpx::future<primitive_argument_type>
+                {
+                    this_->result_ = result.get();
+                    return this_->loop();
+                });
+        }
+
+        bool condition(primitive_argument_type&& cond) const
+        {
+            return extract_scalar_boolean_value(
+                std::move(cond), that_->name_, that_->codename_);
+        }
+
     private:
         std::shared_ptr<while_operation const> that_;
         primitive_arguments_type args_;
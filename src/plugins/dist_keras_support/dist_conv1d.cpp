@@ -15,12 +15,15 @@
 #include <phylanx/plugins/common/conv1d_all_paddings.hpp>
 #include <phylanx/plugins/dist_keras_support/dist_conv1d.hpp>
 #include <phylanx/plugins/keras_support/conv_indices_helper.hpp>
+#include <phylanx/util/distributed_tensor.hpp>
+#include <phylanx/util/halo_exchange.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -49,7 +52,10 @@ namespace phylanx { namespace dist_keras_support { namespace primitives
         R"(x, kernel, padding, strides, dilation_rate, name
         Args:
             x (array) : a 3d array consiting of batch, in_length and
-                in_channels dimensions.
+                in_channels dimensions. If x is tiled along its rows without
+                any overlap between the tiles, the rows required from the
+                neighboring tiles are exchanged while the local part of the
+                convolution is computed.
             kernel (array) : a 3d array consisting of filter_length,
                 in_channels and out_channels dimension. Note that the
                 in_channels should be the same in kernel and original array.
@@ -158,8 +164,186 @@ namespace phylanx { namespace dist_keras_support { namespace primitives
 
             return execution_tree::primitive_argument_type{std::move(result)};
         }
+        ///////////////////////////////////////////////////////////////////////
+        // number of zero rows virtually added on top of the array
+        std::int64_t conv1d_pad_top(
+            std::string const& padding, std::int64_t filter_length)
+        {
+            if (padding == "same")
+            {
+                return (filter_length - 1) / 2;
+            }
+            if (padding == "causal")
+            {
+                return filter_length - 1;
+            }
+            return 0;
+        }
+
+        // Spatially tiled arrays either have overlapping tiles prepared by
+        // the caller or plain tiles relying on a halo exchange
+        bool has_overlapping_rows(
+            execution_tree::localities_information const& locs,
+            std::string const& name, std::string const& codename)
+        {
+            std::size_t const numtiles = locs.tiles_.size();
+            for (std::size_t i = 0; i != numtiles; ++i)
+            {
+                execution_tree::tiling_information_3d lhs(
+                    locs.tiles_[i], name, codename);
+                for (std::size_t j = i + 1; j != numtiles; ++j)
+                {
+                    execution_tree::tiling_information_3d rhs(
+                        locs.tiles_[j], name, codename);
+
+                    execution_tree::tiling_span overlap;
+                    if (execution_tree::intersect(
+                            lhs.spans_[1], rhs.spans_[1], overlap))
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // Compute the rows [out_start, out_stop) of the result of a 1d
+        // convolution. The input rows held by 'block' start at the global row
+        // 'block_start', input rows outside of [0, length) are zeros.
+        template <typename Block, typename Kernel>
+        void conv1d_rows(Block const& block, std::int64_t block_start,
+            Kernel const& k, util::stencil_extent const& extent,
+            std::int64_t length, blaze::DynamicTensor<double>& result,
+            std::int64_t result_start, std::int64_t out_start,
+            std::int64_t out_stop)
+        {
+            std::size_t const batch = block.pages();
+            std::size_t const in_channels = block.columns();
+            std::size_t const out_channels = k.columns();
+
+            for (std::int64_t i = out_start; i != out_stop; ++i)
+            {
+                std::int64_t const first =
+                    (std::max)(std::int64_t(0), i - extent.offset_);
+                std::int64_t const last =
+                    (std::min)(length, i - extent.offset_ + extent.width_);
+                std::size_t const kernel_beg = first - (i - extent.offset_);
+
+                for (std::size_t p = 0; p != batch; ++p)
+                {
+                    auto image = blaze::submatrix(blaze::pageslice(block, p),
+                        first - block_start, 0, last - first, in_channels);
+                    for (std::size_t c = 0; c != out_channels; ++c)
+                    {
+                        result(p, i - result_start, c) = blaze::sum(image %
+                            blaze::submatrix(blaze::columnslice(k, c),
+                                kernel_beg, 0, last - first, in_channels));
+                    }
+                }
+            }
+        }
     }    // namespace detail
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Spatial parallelization on plain (non-overlapping) row tiles. The rows
+    // needed from the neighboring tiles are exchanged while the interior of
+    // the local tile is computed.
+    execution_tree::primitive_argument_type dist_conv1d::conv1d_halo(
+        ir::node_data<double>&& arg, ir::node_data<double>&& kernel,
+        execution_tree::localities_information&& arg_locs,
+        std::string const& padding, std::string&& given_name) const
+    {
+        using namespace execution_tree;
+        std::uint32_t const loc_id = arg_locs.locality_.locality_id_;
+        std::uint32_t const numtiles = arg_locs.locality_.num_localities_;
+
+        auto a = arg.tensor();
+        auto k = kernel.tensor();
+
+        if (a.columns() != k.rows())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_conv1d::conv1d_halo",
+                generate_error_message(
+                    "input depth must be evenly divisible by filter depth. "
+                    "Number of input channels is not the same"));
+        }
+
+        std::int64_t const filter_length = k.pages();
+        std::int64_t const length = arg_locs.rows(name_, codename_);
+        std::int64_t const result_length =
+            padding == "valid" ? length - filter_length + 1 : length;
+
+        // result row i depends on the rows [i - pad, i - pad + filter_length)
+        util::stencil_extent const extent{
+            detail::conv1d_pad_top(padding, filter_length), filter_length};
+
+        std::vector<util::halo_span> spans(numtiles);
+        for (std::uint32_t i = 0; i != numtiles; ++i)
+        {
+            tiling_information_3d tile(arg_locs.tiles_[i], name_, codename_);
+            spans[i] = util::halo_span(
+                tile.spans_[1].start_, tile.spans_[1].stop_);
+
+            // every tile produces the result rows matching its own rows
+            if (spans[i].first >= result_length)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_conv1d::conv1d_halo",
+                    generate_error_message(
+                        "in the valid padding mode the last tile has to hold "
+                        "at least filter_length rows"));
+            }
+        }
+
+        std::int64_t const row_start = spans[loc_id].first;
+        std::int64_t const row_stop = spans[loc_id].second;
+        std::int64_t const res_row_stop = (std::min)(row_stop, result_length);
+
+        // make the local tile accessible to the neighbors
+        util::distributed_tensor<double> data(
+            arg_locs.annotation_.generate_name(), a, numtiles, loc_id);
+
+        auto halo = util::make_halo_exchange(data, 1, spans, loc_id,
+            extent.lower_halo(row_start, row_start),
+            extent.upper_halo(row_stop, res_row_stop, length));
+
+        blaze::DynamicTensor<double> result(
+            a.pages(), res_row_stop - row_start, k.columns());
+
+        util::apply_stencil(halo, extent, row_start, row_stop, length,
+            row_start, res_row_stop,
+            [&](std::int64_t first, std::int64_t last) {
+                return blaze::subtensor(a, 0, first - row_start, 0, a.pages(),
+                    last - first, a.columns());
+            },
+            [](auto const& lower, auto const& local, auto const& upper) {
+                return util::assemble_halo_block(1, lower, local, upper);
+            },
+            [&](auto const& block, std::int64_t block_start,
+                std::int64_t first, std::int64_t last) {
+                detail::conv1d_rows(block, block_start, k, extent, length,
+                    result, row_start, first, last);
+            });
+
+        std::string base_name =
+            given_name.empty() ? arg_locs.annotation_.name_ : given_name;
+        annotation_information ann_info(
+            std::move(base_name), ++arg_locs.annotation_.generation_);
+
+        tiling_information_3d tile_info(
+            arg_locs.tiles_[loc_id], name_, codename_);
+        tiling_information_3d res_tile_info(tile_info.spans_[0],
+            tiling_span(row_start, res_row_stop),
+            tiling_span(0, k.columns()));
+
+        auto locality_ann = arg_locs.locality_.as_annotation();
+        return primitive_argument_type(std::move(result),
+            std::make_shared<annotation>(localities_annotation(locality_ann,
+                res_tile_info.as_annotation(name_, codename_), ann_info,
+                name_, codename_)));
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     execution_tree::primitive_argument_type dist_conv1d::conv1d_all_paddings(
     ir::node_data<double>&& arg, ir::node_data<double>&& kernel,
@@ -179,6 +363,14 @@ namespace phylanx { namespace dist_keras_support { namespace primitives
 
         if (numtiles > 1 && numtiles_k == 1)
         {
+            // plain row tiles rely on exchanging the halos between neighbors
+            if (arg_locs.is_row_tiled(name_, codename_) &&
+                !detail::has_overlapping_rows(arg_locs, name_, codename_))
+            {
+                return conv1d_halo(std::move(arg), std::move(kernel),
+                    std::move(arg_locs), padding, std::move(given_name));
+            }
+
             std::size_t filter_length = kernel.tensor().pages();
 
             // parallelization mode is data, spatial or a combination of both
@@ -0,0 +1,400 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/locality_annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/meta_annotation.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_keras_support/dist_conv2d.hpp>
+#include <phylanx/util/distributed_tensor.hpp>
+#include <phylanx/util/halo_exchange.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_keras_support { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::match_pattern_type const dist_conv2d::match_data =
+    {
+        hpx::make_tuple("conv2d_d",
+        std::vector<std::string>{R"(
+            conv2d_d(_1, _2_kernel,
+            __arg(_3_padding, "valid"),
+            __arg(_4_name, ""))
+        )"},
+        &create_dist_conv2d, &execution_tree::create_primitive<dist_conv2d>,
+        R"(x, kernel, padding, name
+        Args:
+            x (array) : a 3d array consisting of in_height, in_width and
+                in_channels dimensions. The array may be tiled along its
+                height, the rows required from the neighboring tiles are
+                exchanged while the local part of the convolution is
+                computed.
+            kernel (array) : a 4d array consisting of filter_height,
+                filter_width, in_channels and out_channels dimensions. Note
+                that the in_channels should be the same in kernel and
+                original array.
+            padding (optional, string) : padding mode, `valid` by default. It
+                can be either `valid` or `same`. `vaild` means no padding.
+                `same` results the output with the same shape as original
+                array.
+            name (optional, string): the result name. If not given it will be
+                the same as the next generation of the original distributed
+                array.
+        Returns:
+        2D convolution (or 2D mathematical cross-correlation) tiled along its
+        height the same way as x)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_conv2d::dist_conv2d(
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Compute the rows [out_start, out_stop) of the result of a 2d
+        // convolution. The input rows held by 'block' start at the global row
+        // 'block_start', input elements outside of the image are zeros.
+        template <typename Block, typename Kernel>
+        void conv2d_rows(Block const& block, std::int64_t block_start,
+            Kernel const& k, util::stencil_extent const& height_extent,
+            util::stencil_extent const& width_extent, std::int64_t height,
+            std::int64_t width, blaze::DynamicTensor<double>& result,
+            std::int64_t result_start, std::int64_t out_start,
+            std::int64_t out_stop)
+        {
+            std::int64_t const result_width = result.rows();
+
+            for (std::int64_t i = out_start; i != out_stop; ++i)
+            {
+                std::int64_t const top = i - height_extent.offset_;
+                std::int64_t const first_row = (std::max)(std::int64_t(0), top);
+                std::int64_t const last_row =
+                    (std::min)(height, top + height_extent.width_);
+
+                auto res_page = blaze::pageslice(result, i - result_start);
+                for (std::int64_t j = 0; j != result_width; ++j)
+                {
+                    std::int64_t const left = j - width_extent.offset_;
+                    std::int64_t const first_column =
+                        (std::max)(std::int64_t(0), left);
+                    std::int64_t const last_column =
+                        (std::min)(width, left + width_extent.width_);
+
+                    auto res_row = blaze::row(res_page, j);
+                    for (std::int64_t r = first_row; r != last_row; ++r)
+                    {
+                        auto image = blaze::pageslice(block, r - block_start);
+                        auto filter = blaze::quatslice(k, r - top);
+                        for (std::int64_t c = first_column; c != last_column;
+                             ++c)
+                        {
+                            res_row += blaze::row(image, c) *
+                                blaze::pageslice(filter, c - left);
+                        }
+                    }
+                }
+            }
+        }
+
+        // result element (i, j) depends on the input rows [i - pad, i - pad
+        // + filter_height) and columns [j - pad, j - pad + filter_width)
+        util::stencil_extent conv2d_extent(
+            std::string const& padding, std::int64_t filter_size)
+        {
+            return util::stencil_extent{
+                padding == "same" ? (filter_size - 1) / 2 : 0, filter_size};
+        }
+
+        std::int64_t conv2d_result_size(std::string const& padding,
+            std::int64_t size, std::int64_t filter_size)
+        {
+            return padding == "same" ? size : size - filter_size + 1;
+        }
+    }    // namespace detail
+
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::primitive_argument_type dist_conv2d::conv2d(
+        ir::node_data<double>&& arg, ir::node_data<double>&& kernel,
+        std::string const& padding) const
+    {
+        auto a = arg.tensor();
+        auto k = kernel.quatern();
+
+        std::int64_t const height = a.pages();
+        std::int64_t const width = a.rows();
+
+        auto const height_extent = detail::conv2d_extent(padding, k.quats());
+        auto const width_extent = detail::conv2d_extent(padding, k.pages());
+
+        std::int64_t const result_height =
+            detail::conv2d_result_size(padding, height, k.quats());
+
+        blaze::DynamicTensor<double> result(result_height,
+            detail::conv2d_result_size(padding, width, k.pages()), k.columns(),
+            0.0);
+
+        detail::conv2d_rows(a, 0, k, height_extent, width_extent, height,
+            width, result, 0, 0, result_height);
+
+        return execution_tree::primitive_argument_type{std::move(result)};
+    }
+
+    execution_tree::primitive_argument_type dist_conv2d::conv2d(
+        ir::node_data<double>&& arg, ir::node_data<double>&& kernel,
+        execution_tree::localities_information&& arg_locs,
+        std::string const& padding, std::string&& given_name) const
+    {
+        using namespace execution_tree;
+        std::uint32_t const loc_id = arg_locs.locality_.locality_id_;
+        std::uint32_t const numtiles = arg_locs.locality_.num_localities_;
+
+        if (!arg_locs.is_page_tiled(name_, codename_))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_conv2d::conv2d",
+                generate_error_message(
+                    "conv2d_d supports arrays tiled along their height "
+                    "(pages) only"));
+        }
+
+        auto a = arg.tensor();
+        auto k = kernel.quatern();
+
+        std::int64_t const height = arg_locs.pages(name_, codename_);
+        std::int64_t const width = a.rows();
+
+        auto const height_extent = detail::conv2d_extent(padding, k.quats());
+        auto const width_extent = detail::conv2d_extent(padding, k.pages());
+
+        std::int64_t const result_height =
+            detail::conv2d_result_size(padding, height, k.quats());
+
+        std::vector<util::halo_span> spans(numtiles);
+        for (std::uint32_t i = 0; i != numtiles; ++i)
+        {
+            tiling_information_3d tile(arg_locs.tiles_[i], name_, codename_);
+            spans[i] = util::halo_span(
+                tile.spans_[0].start_, tile.spans_[0].stop_);
+
+            // every tile produces the result rows matching its own rows
+            if (spans[i].first >= result_height)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_conv2d::conv2d",
+                    generate_error_message(
+                        "in the valid padding mode the last tile has to hold "
+                        "at least filter_height rows"));
+            }
+        }
+
+        std::int64_t const page_start = spans[loc_id].first;
+        std::int64_t const page_stop = spans[loc_id].second;
+        std::int64_t const res_page_stop =
+            (std::min)(page_stop, result_height);
+
+        // make the local tile accessible to the neighbors
+        util::distributed_tensor<double> data(
+            arg_locs.annotation_.generate_name(), a, numtiles, loc_id);
+
+        auto halo = util::make_halo_exchange(data, 0, spans, loc_id,
+            height_extent.lower_halo(page_start, page_start),
+            height_extent.upper_halo(page_stop, res_page_stop, height));
+
+        blaze::DynamicTensor<double> result(res_page_stop - page_start,
+            detail::conv2d_result_size(padding, width, k.pages()), k.columns(),
+            0.0);
+
+        util::apply_stencil(halo, height_extent, page_start, page_stop,
+            height, page_start, res_page_stop,
+            [&](std::int64_t first, std::int64_t last) {
+                return blaze::subtensor(a, first - page_start, 0, 0,
+                    last - first, a.rows(), a.columns());
+            },
+            [](auto const& lower, auto const& local, auto const& upper) {
+                return util::assemble_halo_block(0, lower, local, upper);
+            },
+            [&](auto const& block, std::int64_t block_start,
+                std::int64_t first, std::int64_t last) {
+                detail::conv2d_rows(block, block_start, k, height_extent,
+                    width_extent, height, width, result, page_start, first,
+                    last);
+            });
+
+        std::string base_name =
+            given_name.empty() ? arg_locs.annotation_.name_ : given_name;
+        annotation_information ann_info(
+            std::move(base_name), ++arg_locs.annotation_.generation_);
+
+        tiling_information_3d res_tile_info(
+            tiling_span(page_start, res_page_stop),
+            tiling_span(0, result.rows()), tiling_span(0, result.columns()));
+
+        auto locality_ann = arg_locs.locality_.as_annotation();
+        return primitive_argument_type(std::move(result),
+            std::make_shared<annotation>(localities_annotation(locality_ann,
+                res_tile_info.as_annotation(name_, codename_), ann_info,
+                name_, codename_)));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<execution_tree::primitive_argument_type> dist_conv2d::eval(
+        execution_tree::primitive_arguments_type const& operands,
+        execution_tree::primitive_arguments_type const& args,
+        execution_tree::eval_context ctx) const
+    {
+        if (operands.size() < 2 || operands.size() > 4)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_conv2d::eval",
+                generate_error_message("the dist_conv2d primitive requires "
+                                       "between 2 and 4 operands"));
+        }
+
+        for (auto const& i : operands)
+        {
+            if (!valid(i))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_conv2d::eval",
+                    generate_error_message(
+                        "the conv2d_d primitive requires that the arguments "
+                        "given by the operands array are valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::unwrapping([this_ = std::move(this_)](
+                              execution_tree::primitive_arguments_type&& args)
+                                  -> execution_tree::primitive_argument_type
+            {
+                using namespace execution_tree;
+
+                if (extract_numeric_value_dimension(
+                        args[0], this_->name_, this_->codename_) != 3 ||
+                    extract_numeric_value_dimension(
+                        args[1], this_->name_, this_->codename_) != 4)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_conv2d::eval",
+                        this_->generate_error_message(
+                            "conv2d_d operation requires for x to be a tensor "
+                            "and for the kernel to be a 4d array"));
+                }
+
+                std::string padding = "valid";
+                if (valid(args[2]))
+                {
+                    padding = extract_string_value_strict(
+                        args[2], this_->name_, this_->codename_);
+
+                    if (padding != "valid" && padding != "same")
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dist_conv2d::eval",
+                            this_->generate_error_message(
+                                "invalid padding. Padding can be either "
+                                "`valid` or `same`"));
+                    }
+                }
+
+                auto x_dims = extract_numeric_value_dimensions(
+                    args[0], this_->name_, this_->codename_);
+                auto k_dims = extract_numeric_value_dimensions(
+                    args[1], this_->name_, this_->codename_);
+
+                if (x_dims[2] != k_dims[2])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_conv2d::eval",
+                        this_->generate_error_message(
+                            "the number of input channels of x and of the "
+                            "kernel must be the same"));
+                }
+
+                if (padding == "valid" && x_dims[1] < k_dims[1])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_conv2d::eval",
+                        this_->generate_error_message(
+                            "the kernel size cannot be greater than the "
+                            "array size in the valid padding mode"));
+                }
+
+                std::string given_name = "";
+                if (valid(args[3]))
+                {
+                    given_name = extract_string_value(std::move(args[3]),
+                        this_->name_, this_->codename_);
+                }
+
+                if (args[0].has_annotation())
+                {
+                    localities_information arg_locs =
+                        extract_localities_information(
+                            args[0], this_->name_, this_->codename_);
+
+                    if (padding == "valid" &&
+                        arg_locs.pages(this_->name_, this_->codename_) <
+                            k_dims[0])
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dist_conv2d::eval",
+                            this_->generate_error_message(
+                                "the kernel size cannot be greater than the "
+                                "array size in the valid padding mode"));
+                    }
+
+                    return this_->conv2d(
+                        extract_numeric_value(
+                            std::move(args[0]), this_->name_, this_->codename_),
+                        extract_numeric_value(
+                            std::move(args[1]), this_->name_, this_->codename_),
+                        std::move(arg_locs), padding, std::move(given_name));
+                }
+
+                if (padding == "valid" && x_dims[0] < k_dims[0])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_conv2d::eval",
+                        this_->generate_error_message(
+                            "the kernel size cannot be greater than the "
+                            "array size in the valid padding mode"));
+                }
+
+                return this_->conv2d(
+                    extract_numeric_value(
+                        std::move(args[0]), this_->name_, this_->codename_),
+                    extract_numeric_value(
+                        std::move(args[1]), this_->name_, this_->codename_),
+                    padding);
+            }),
+            execution_tree::primitives::detail::map_operands(operands,
+                execution_tree::functional::value_operand{}, args, name_,
+                codename_, std::move(ctx)));
+    }
+}}}
@@ -13,3 +13,5 @@ PHYLANX_REGISTER_PLUGIN_MODULE();
 
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_conv1d_plugin,
     phylanx::dist_keras_support::primitives::dist_conv1d::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dist_conv2d_plugin,
+    phylanx::dist_keras_support::primitives::dist_conv2d::match_data);
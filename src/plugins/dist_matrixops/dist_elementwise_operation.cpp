@@ -0,0 +1,804 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_elementwise_operation.hpp>
+#include <phylanx/plugins/dist_matrixops/retile_planner.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+#define PHYLANX_DIST_ELEMENTWISE_MATCH_DATA(name, description)                 \
+    execution_tree::match_pattern_type                                         \
+    {                                                                          \
+        name, std::vector<std::string>{name "(_1, _2)"},                       \
+            &create_dist_elementwise_operation,                                \
+            &execution_tree::create_primitive<dist_elementwise_operation>,     \
+            "lhs, rhs\n"                                                       \
+            "Args:\n"                                                          \
+            "\n"                                                               \
+            "    lhs (array) : a scalar or a (tiled) array\n"                  \
+            "    rhs (array) : a scalar or a (tiled) array\n"                  \
+            "\n"                                                               \
+            "Returns:\n"                                                       \
+            "\n"                                                               \
+            description " If the tilings of the operands differ, both are "    \
+            "aligned with the tiling of one of them, choosing the tiling "     \
+            "and the placement of its tiles that require the least data "      \
+            "movement. The result is annotated with the tiling it was "        \
+            "computed for."                                                    \
+    }                                                                          \
+    /**/
+
+    std::vector<execution_tree::match_pattern_type> const
+        dist_elementwise_operation::match_data = {
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__add_d",
+                "The element-wise sum of `lhs` and `rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__sub_d",
+                "The element-wise difference of `lhs` and `rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__mul_d",
+                "The element-wise product of `lhs` and `rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__div_d",
+                "The element-wise quotient of `lhs` and `rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__lt_d",
+                "The element-wise truth value of `lhs < rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__le_d",
+                "The element-wise truth value of `lhs <= rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__gt_d",
+                "The element-wise truth value of `lhs > rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__ge_d",
+                "The element-wise truth value of `lhs >= rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__eq_d",
+                "The element-wise truth value of `lhs == rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("__ne_d",
+                "The element-wise truth value of `lhs != rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("maximum_d",
+                "The element-wise maximum of `lhs` and `rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("minimum_d",
+                "The element-wise minimum of `lhs` and `rhs`."),
+            PHYLANX_DIST_ELEMENTWISE_MATCH_DATA("power_d",
+                "The element-wise value of `lhs` raised to the power of "
+                "`rhs`, computed in double precision.")
+        };
+
+#undef PHYLANX_DIST_ELEMENTWISE_MATCH_DATA
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct operation_info
+        {
+            char const* func_name_;
+            dist_elementwise_operation::operation op_;
+            char const* op_name_;
+        };
+
+        static operation_info const operations[] = {
+            {"__add_d", dist_elementwise_operation::add, "add"},
+            {"__sub_d", dist_elementwise_operation::sub, "sub"},
+            {"__mul_d", dist_elementwise_operation::mul, "mul"},
+            {"__div_d", dist_elementwise_operation::div, "div"},
+            {"__lt_d", dist_elementwise_operation::less, "lt"},
+            {"__le_d", dist_elementwise_operation::less_equal, "le"},
+            {"__gt_d", dist_elementwise_operation::greater, "gt"},
+            {"__ge_d", dist_elementwise_operation::greater_equal, "ge"},
+            {"__eq_d", dist_elementwise_operation::equal, "eq"},
+            {"__ne_d", dist_elementwise_operation::not_equal, "ne"},
+            {"maximum_d", dist_elementwise_operation::maximum, "max"},
+            {"minimum_d", dist_elementwise_operation::minimum, "min"},
+            {"power_d", dist_elementwise_operation::power, "power"}
+        };
+
+        operation_info const& extract_operation(std::string const& func_name,
+            std::string const& name, std::string const& codename)
+        {
+            for (auto const& info : operations)
+            {
+                if (func_name == info.func_name_)
+                {
+                    return info;
+                }
+            }
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::extract_operation",
+                util::generate_error_message(
+                    "unknown element-wise operation: " + func_name, name,
+                    codename));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct add_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return lhs + rhs;
+            }
+        };
+
+        struct sub_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return lhs - rhs;
+            }
+        };
+
+        struct mul_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return lhs * rhs;
+            }
+        };
+
+        struct div_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return lhs / rhs;
+            }
+        };
+
+        struct less_op
+        {
+            template <typename T>
+            std::uint8_t operator()(T lhs, T rhs) const
+            {
+                return lhs < rhs;
+            }
+        };
+
+        struct less_equal_op
+        {
+            template <typename T>
+            std::uint8_t operator()(T lhs, T rhs) const
+            {
+                return lhs <= rhs;
+            }
+        };
+
+        struct greater_op
+        {
+            template <typename T>
+            std::uint8_t operator()(T lhs, T rhs) const
+            {
+                return lhs > rhs;
+            }
+        };
+
+        struct greater_equal_op
+        {
+            template <typename T>
+            std::uint8_t operator()(T lhs, T rhs) const
+            {
+                return lhs >= rhs;
+            }
+        };
+
+        struct equal_op
+        {
+            template <typename T>
+            std::uint8_t operator()(T lhs, T rhs) const
+            {
+                return lhs == rhs;
+            }
+        };
+
+        struct not_equal_op
+        {
+            template <typename T>
+            std::uint8_t operator()(T lhs, T rhs) const
+            {
+                return lhs != rhs;
+            }
+        };
+
+        struct maximum_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return (std::max)(lhs, rhs);
+            }
+        };
+
+        struct minimum_op
+        {
+            template <typename T>
+            T operator()(T lhs, T rhs) const
+            {
+                return (std::min)(lhs, rhs);
+            }
+        };
+
+        // like the power primitive, integers are raised to a power in double
+        // precision
+        struct power_op
+        {
+            template <typename T>
+            double operator()(T lhs, T rhs) const
+            {
+                return std::pow(double(lhs), double(rhs));
+            }
+        };
+
+        template <typename T, typename Op>
+        using result_type =
+            decltype(std::declval<Op>()(std::declval<T>(), std::declval<T>()));
+
+        ///////////////////////////////////////////////////////////////////////
+        // access the local data of an N-dimensional array
+        template <std::size_t N>
+        struct local_data;
+
+        template <>
+        struct local_data<1>
+        {
+            template <typename T>
+            static auto call(ir::node_data<T>& data)
+            {
+                return data.vector();
+            }
+        };
+
+        template <>
+        struct local_data<2>
+        {
+            template <typename T>
+            static auto call(ir::node_data<T>& data)
+            {
+                return data.matrix();
+            }
+        };
+
+        template <>
+        struct local_data<3>
+        {
+            template <typename T>
+            static auto call(ir::node_data<T>& data)
+            {
+                return data.tensor();
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <std::size_t N>
+        bool same_tiling(retile_planner::tiling<N> const& lhs,
+            retile_planner::tiling<N> const& rhs)
+        {
+            if (lhs.size() != rhs.size())
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0; i != lhs.size(); ++i)
+            {
+                for (std::size_t d = 0; d != N; ++d)
+                {
+                    if (lhs[i][d].start_ != rhs[i][d].start_ ||
+                        lhs[i][d].stop_ != rhs[i][d].stop_)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // whether every locality keeps its tile of the common tiling
+        inline bool keeps_tiles(std::vector<std::uint32_t> const& tile_of)
+        {
+            for (std::size_t i = 0; i != tile_of.size(); ++i)
+            {
+                if (tile_of[i] != i)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_elementwise_operation::dist_elementwise_operation(
+            execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , transferred_bytes_(0)
+    {
+        auto const& info = detail::extract_operation(
+            extract_function_name(name), name_, codename_);
+
+        op_ = info.op_;
+        op_name_ = info.op_name_;
+    }
+
+    std::int64_t dist_elementwise_operation::get_transferred_bytes(
+        bool reset) const
+    {
+        return hpx::util::get_and_reset_value(transferred_bytes_, reset);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<execution_tree::annotation>
+    dist_elementwise_operation::result_annotation(
+        execution_tree::localities_information&& localities) const
+    {
+        using namespace execution_tree;
+
+        std::uint32_t const loc_id = localities.locality_.locality_id_;
+
+        localities.annotation_.name_ += "_" + op_name_;
+        ++localities.annotation_.generation_;
+
+        auto locality_ann = localities.locality_.as_annotation();
+        return std::make_shared<annotation>(localities_annotation(locality_ann,
+            localities.tiles_[loc_id].as_annotation(name_, codename_),
+            localities.annotation_, name_, codename_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Op>
+    execution_tree::primitive_argument_type
+    dist_elementwise_operation::elementwise_scalar(ir::node_data<T>&& lhs,
+        ir::node_data<T>&& rhs,
+        execution_tree::localities_information&& localities, bool annotated,
+        bool scalar_lhs, Op op) const
+    {
+        using namespace execution_tree;
+
+        // the scalar is applied to the local data of the other operand
+        T const scalar = scalar_lhs ? lhs.scalar() : rhs.scalar();
+        ir::node_data<T>& data = scalar_lhs ? rhs : lhs;
+
+        using result_type = detail::result_type<T, Op>;
+
+        ir::node_data<result_type> result;
+        switch (data.num_dimensions())
+        {
+        case 0:
+            result = scalar_lhs ? op(scalar, data.scalar()) :
+                                  op(data.scalar(), scalar);
+            break;
+
+        case 1:
+            result = blaze::DynamicVector<result_type>(
+                blaze::map(data.vector(), [&](T val) {
+                    return scalar_lhs ? op(scalar, val) : op(val, scalar);
+                }));
+            break;
+
+        case 2:
+            result = blaze::DynamicMatrix<result_type>(
+                blaze::map(data.matrix(), [&](T val) {
+                    return scalar_lhs ? op(scalar, val) : op(val, scalar);
+                }));
+            break;
+
+        case 3:
+            result = blaze::DynamicTensor<result_type>(
+                blaze::map(data.tensor(), [&](T val) {
+                    return scalar_lhs ? op(scalar, val) : op(val, scalar);
+                }));
+            break;
+
+        default:
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::elementwise_scalar",
+                generate_error_message(
+                    "the given operand has an unsupported dimensionality"));
+        }
+
+        if (!annotated)
+        {
+            return primitive_argument_type(std::move(result));
+        }
+
+        return primitive_argument_type(
+            std::move(result), result_annotation(std::move(localities)));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, std::size_t N, typename Op>
+    execution_tree::primitive_argument_type
+    dist_elementwise_operation::elementwise_nd(ir::node_data<T>&& lhs,
+        ir::node_data<T>&& rhs,
+        execution_tree::localities_information&& lhs_localities,
+        execution_tree::localities_information&& rhs_localities,
+        bool lhs_annotated, bool rhs_annotated, Op op) const
+    {
+        using namespace execution_tree;
+
+        using result_type = detail::result_type<T, Op>;
+        using block = retile_planner::detail::block_type<T, N>;
+        using result_block = retile_planner::detail::block_type<result_type, N>;
+
+        if (lhs_localities.dimensions(name_, codename_) !=
+            rhs_localities.dimensions(name_, codename_))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::elementwise_nd",
+                generate_error_message(
+                    "the dimensions of the operands do not match"));
+        }
+
+        // purely local operation
+        if (!lhs_annotated && !rhs_annotated)
+        {
+            return primitive_argument_type(
+                ir::node_data<result_type>(
+                    typename result_block::type(blaze::map(
+                        detail::local_data<N>::call(lhs),
+                        detail::local_data<N>::call(rhs), op))));
+        }
+
+        // one operand is not distributed, use its part corresponding to the
+        // local tile of the other operand
+        if (!lhs_annotated || !rhs_annotated)
+        {
+            localities_information& localities =
+                lhs_annotated ? lhs_localities : rhs_localities;
+
+            std::uint32_t const loc_id = localities.locality_.locality_id_;
+            retile_planner::tile_spans<N> const tile =
+                retile_planner::extract_tiling<N>(
+                    localities, name_, codename_)[loc_id];
+
+            typename result_block::type result;
+            if (lhs_annotated)
+            {
+                result = blaze::map(detail::local_data<N>::call(lhs),
+                    block::extract(detail::local_data<N>::call(rhs), tile),
+                    op);
+            }
+            else
+            {
+                result = blaze::map(
+                    block::extract(detail::local_data<N>::call(lhs), tile),
+                    detail::local_data<N>::call(rhs), op);
+            }
+
+            return primitive_argument_type(ir::node_data<result_type>(
+                                               std::move(result)),
+                result_annotation(std::move(localities)));
+        }
+
+        // both operands are distributed
+        std::uint32_t const loc_id = lhs_localities.locality_.locality_id_;
+
+        retile_planner::tiling<N> lhs_tiling =
+            retile_planner::extract_tiling<N>(lhs_localities, name_, codename_);
+        retile_planner::tiling<N> rhs_tiling =
+            retile_planner::extract_tiling<N>(rhs_localities, name_, codename_);
+
+        if (lhs_tiling.size() != rhs_tiling.size())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::elementwise_nd",
+                generate_error_message(
+                    "the operands must be distributed over the same number "
+                    "of localities"));
+        }
+
+        if (detail::same_tiling(lhs_tiling, rhs_tiling))
+        {
+            return primitive_argument_type(
+                ir::node_data<result_type>(
+                    typename result_block::type(blaze::map(
+                        detail::local_data<N>::call(lhs),
+                        detail::local_data<N>::call(rhs), op))),
+                result_annotation(std::move(lhs_localities)));
+        }
+
+        // the tilings differ, align both operands with the common tiling
+        // that requires the least data to be moved. All localities know
+        // both tilings, thus all of them arrive at the same decision.
+        retile_planner::common_tiling const common =
+            retile_planner::suggest_common_tiling(lhs_tiling, rhs_tiling);
+
+        bool const lhs_target = common.candidate_ == 0;
+        localities_information& localities =
+            lhs_target ? lhs_localities : rhs_localities;
+        retile_planner::tiling<N> const& target =
+            lhs_target ? lhs_tiling : rhs_tiling;
+
+        // retile the given operand, if needed
+        std::string const target_name = localities.annotation_.generate_name();
+        auto align = [&](ir::node_data<T>& arg,
+                         localities_information const& arg_localities,
+                         retile_planner::tiling<N> const& current)
+            -> typename block::type {
+            retile_planner::retile_plan plan =
+                retile_planner::make_retile_plan(
+                    retile_planner::transfer_matrix(current, target),
+                    std::vector<std::uint32_t>(common.tile_of_));
+
+            return retile_planner::execute_retile_plan<T, N>("elementwise_" +
+                    arg_localities.annotation_.generate_name() + "_" +
+                    target_name,
+                detail::local_data<N>::call(arg), plan, current, target,
+                loc_id, &transferred_bytes_);
+        };
+
+        // the operand owning the target tiling stays in place unless its
+        // tiles are moved to other localities
+        bool const in_place = detail::keeps_tiles(common.tile_of_);
+
+        // the operands are aligned one after the other, all localities
+        // have to take part in the same sequence of exchanges
+        typename result_block::type result;
+        if (in_place && lhs_target)
+        {
+            typename block::type rhs_aligned =
+                align(rhs, rhs_localities, rhs_tiling);
+            result = blaze::map(
+                detail::local_data<N>::call(lhs), rhs_aligned, op);
+        }
+        else if (in_place)
+        {
+            typename block::type lhs_aligned =
+                align(lhs, lhs_localities, lhs_tiling);
+            result = blaze::map(
+                lhs_aligned, detail::local_data<N>::call(rhs), op);
+        }
+        else
+        {
+            typename block::type lhs_aligned =
+                align(lhs, lhs_localities, lhs_tiling);
+            typename block::type rhs_aligned =
+                align(rhs, rhs_localities, rhs_tiling);
+            result = blaze::map(lhs_aligned, rhs_aligned, op);
+
+            // this locality now holds another tile of the target tiling
+            localities.tiles_[loc_id] =
+                localities.tiles_[common.tile_of_[loc_id]];
+        }
+
+        return primitive_argument_type(
+            ir::node_data<result_type>(std::move(result)),
+            result_annotation(std::move(localities)));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename Op>
+    execution_tree::primitive_argument_type
+    dist_elementwise_operation::elementwise(ir::node_data<T>&& lhs,
+        ir::node_data<T>&& rhs,
+        execution_tree::localities_information&& lhs_localities,
+        execution_tree::localities_information&& rhs_localities,
+        bool lhs_annotated, bool rhs_annotated, Op op) const
+    {
+        std::size_t const lhs_dims = lhs.num_dimensions();
+        std::size_t const rhs_dims = rhs.num_dimensions();
+
+        // scalars are broadcast to the local data of the other operand
+        if (lhs_dims == 0)
+        {
+            return elementwise_scalar(std::move(lhs), std::move(rhs),
+                std::move(rhs_localities), rhs_annotated && rhs_dims != 0,
+                true, op);
+        }
+        if (rhs_dims == 0)
+        {
+            return elementwise_scalar(std::move(lhs), std::move(rhs),
+                std::move(lhs_localities), lhs_annotated, false, op);
+        }
+
+        if (lhs_dims != rhs_dims)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::elementwise",
+                generate_error_message(
+                    "the operands must have the same dimensionality or one "
+                    "of them has to be a scalar"));
+        }
+
+        switch (lhs_dims)
+        {
+        case 1:
+            return elementwise_nd<T, 1>(std::move(lhs), std::move(rhs),
+                std::move(lhs_localities), std::move(rhs_localities),
+                lhs_annotated, rhs_annotated, op);
+
+        case 2:
+            return elementwise_nd<T, 2>(std::move(lhs), std::move(rhs),
+                std::move(lhs_localities), std::move(rhs_localities),
+                lhs_annotated, rhs_annotated, op);
+
+        case 3:
+            return elementwise_nd<T, 3>(std::move(lhs), std::move(rhs),
+                std::move(lhs_localities), std::move(rhs_localities),
+                lhs_annotated, rhs_annotated, op);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "dist_elementwise_operation::elementwise",
+            generate_error_message(
+                "the operands have an unsupported dimensionality"));
+    }
+
+    template <typename Op>
+    execution_tree::primitive_argument_type
+    dist_elementwise_operation::elementwise(
+        execution_tree::primitive_argument_type&& lhs,
+        execution_tree::primitive_argument_type&& rhs, Op op) const
+    {
+        using namespace execution_tree;
+
+        bool const lhs_annotated = lhs.has_annotation();
+        bool const rhs_annotated = rhs.has_annotation();
+
+        localities_information lhs_localities =
+            extract_localities_information(lhs, name_, codename_);
+        localities_information rhs_localities =
+            extract_localities_information(rhs, name_, codename_);
+
+        switch (extract_common_type(lhs, rhs))
+        {
+        case node_data_type_bool: [[fallthrough]];
+        case node_data_type_int64:
+            return elementwise(
+                extract_integer_value(std::move(lhs), name_, codename_),
+                extract_integer_value(std::move(rhs), name_, codename_),
+                std::move(lhs_localities), std::move(rhs_localities),
+                lhs_annotated, rhs_annotated, op);
+
+        case node_data_type_unknown: [[fallthrough]];
+        case node_data_type_double:
+            return elementwise(
+                extract_numeric_value(std::move(lhs), name_, codename_),
+                extract_numeric_value(std::move(rhs), name_, codename_),
+                std::move(lhs_localities), std::move(rhs_localities),
+                lhs_annotated, rhs_annotated, op);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "dist_elementwise_operation::elementwise",
+            generate_error_message(
+                "the distributed element-wise operations require for all "
+                "arguments to be numeric data types"));
+    }
+
+    execution_tree::primitive_argument_type
+    dist_elementwise_operation::elementwise(
+        execution_tree::primitive_argument_type&& lhs,
+        execution_tree::primitive_argument_type&& rhs) const
+    {
+        switch (op_)
+        {
+        case add:
+            return elementwise(std::move(lhs), std::move(rhs), detail::add_op{});
+
+        case sub:
+            return elementwise(std::move(lhs), std::move(rhs), detail::sub_op{});
+
+        case mul:
+            return elementwise(std::move(lhs), std::move(rhs), detail::mul_op{});
+
+        case div:
+            return elementwise(std::move(lhs), std::move(rhs), detail::div_op{});
+
+        case less:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::less_op{});
+
+        case less_equal:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::less_equal_op{});
+
+        case greater:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::greater_op{});
+
+        case greater_equal:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::greater_equal_op{});
+
+        case equal:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::equal_op{});
+
+        case not_equal:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::not_equal_op{});
+
+        case maximum:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::maximum_op{});
+
+        case minimum:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::minimum_op{});
+
+        case power:
+            return elementwise(
+                std::move(lhs), std::move(rhs), detail::power_op{});
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "dist_elementwise_operation::elementwise",
+            generate_error_message("unknown element-wise operation"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<execution_tree::primitive_argument_type>
+    dist_elementwise_operation::eval(
+        execution_tree::primitive_arguments_type const& operands,
+        execution_tree::primitive_arguments_type const& args,
+        execution_tree::eval_context ctx) const
+    {
+        using namespace execution_tree;
+
+        if (operands.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::eval",
+                generate_error_message(
+                    "the distributed element-wise operations require exactly "
+                    "two operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_elementwise_operation::eval",
+                generate_error_message(
+                    "the distributed element-wise operations require that "
+                    "the arguments given by the operands array are valid"));
+        }
+
+        auto f = value_operand(operands[0], args, name_, codename_, ctx);
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            [this_ = std::move(this_)](
+                    hpx::future<primitive_argument_type>&& lhs,
+                    hpx::future<primitive_argument_type>&& rhs)
+            -> primitive_argument_type
+            {
+                return this_->elementwise(lhs.get(), rhs.get());
+            },
+            std::move(f),
+            value_operand(operands[1], args, name_, codename_, std::move(ctx)));
+    }
+}}}
@@ -31,7 +31,53 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(dist_inverse_operation_plugin,
     phylanx::dist_matrixops::primitives::dist_inverse::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_random_plugin,
     phylanx::dist_matrixops::primitives::dist_random::match_data)
+PHYLANX_REGISTER_PLUGIN_FACTORY(dist_stencil_plugin,
+    phylanx::dist_matrixops::primitives::dist_stencil::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(dist_transpose_operation_plugin,
     phylanx::dist_matrixops::primitives::dist_transpose_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(retile_annotations_plugin,
     phylanx::dist_matrixops::primitives::retile_annotations::match_data);
+
+namespace phylanx { namespace plugin
+{
+    struct dist_elementwise_operation_plugin : plugin_base
+    {
+        void register_known_primitives(std::string const& fullpath) override
+        {
+            namespace pet = phylanx::execution_tree;
+
+            std::string dist_elementwise_operation_name("__elementwise_d");
+            for (auto const& pattern : phylanx::dist_matrixops::primitives::
+                     dist_elementwise_operation::match_data)
+            {
+                pet::register_pattern(
+                    dist_elementwise_operation_name, pattern, fullpath);
+            }
+        }
+    };
+
+    struct dist_sort_plugin : plugin_base
+    {
+        void register_known_primitives(std::string const& fullpath) override
+        {
+            namespace pet = phylanx::execution_tree;
+
+            std::string dist_sort_name("__sort_d");
+            for (auto const& pattern :
+                phylanx::dist_matrixops::primitives::dist_sort::match_data)
+            {
+                pet::register_pattern(dist_sort_name, pattern, fullpath);
+            }
+        }
+    };
+}}
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(
+    phylanx::plugin::dist_elementwise_operation_plugin,
+    dist_elementwise_operation_plugin,
+    phylanx::dist_matrixops::primitives::dist_elementwise_operation::match_data,
+    "__elementwise_d");
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(phylanx::plugin::dist_sort_plugin,
+    dist_sort_plugin,
+    phylanx::dist_matrixops::primitives::dist_sort::match_data, "__sort_d");
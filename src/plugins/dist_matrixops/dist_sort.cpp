@@ -0,0 +1,392 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_sort.hpp>
+#include <phylanx/plugins/dist_matrixops/retile_planner.hpp>
+#include <phylanx/plugins/dist_matrixops/sample_sort.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_sort.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/errors/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<execution_tree::match_pattern_type> const
+        dist_sort::match_data = {
+            execution_tree::match_pattern_type{"sort_d",
+                std::vector<std::string>{"sort_d(_1)"},
+                &create_dist_sort, &execution_tree::create_primitive<dist_sort>,
+                R"(
+                a
+                Args:
+
+                    a (array) : a (tiled) vector
+
+                Returns:
+
+                The sorted vector, tiled such that all localities hold
+                (almost) the same number of elements.)"},
+
+            execution_tree::match_pattern_type{"argsort_d",
+                std::vector<std::string>{"argsort_d(_1)"},
+                &create_dist_sort, &execution_tree::create_primitive<dist_sort>,
+                R"(
+                a
+                Args:
+
+                    a (array) : a (tiled) vector
+
+                Returns:
+
+                The (global) indices that would sort the vector, tiled such
+                that all localities hold (almost) the same number of
+                elements.)"},
+
+            execution_tree::match_pattern_type{"unique_d",
+                std::vector<std::string>{"unique_d(_1)"},
+                &create_dist_sort, &execution_tree::create_primitive<dist_sort>,
+                R"(
+                a
+                Args:
+
+                    a (array) : a (tiled) vector
+
+                Returns:
+
+                The sorted unique elements of the vector, tiled such that all
+                localities hold (almost) the same number of elements.)"}
+        };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        dist_sort::sort_mode extract_sort_mode(std::string const& func_name,
+            std::string const& name, std::string const& codename)
+        {
+            if (func_name == "sort_d")
+            {
+                return dist_sort::sort_values;
+            }
+            if (func_name == "argsort_d")
+            {
+                return dist_sort::argsort_values;
+            }
+            if (func_name == "unique_d")
+            {
+                return dist_sort::unique_values;
+            }
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dist_sort::extract_sort_mode",
+                util::generate_error_message(
+                    "unknown distributed sort operation: " + func_name, name,
+                    codename));
+        }
+
+        char const* const sort_mode_names[] = {"sorted", "argsorted", "unique"};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_sort::dist_sort(execution_tree::primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , mode_(detail::extract_sort_mode(
+            extract_function_name(name), name_, codename_))
+      , transferred_bytes_(0)
+    {
+    }
+
+    std::int64_t dist_sort::get_transferred_bytes(bool reset) const
+    {
+        return hpx::util::get_and_reset_value(transferred_bytes_, reset);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // sort_d, argsort_d and unique_d on data that is not distributed
+    template <typename T>
+    execution_tree::primitive_argument_type dist_sort::sort1d_local(
+        ir::node_data<T>&& arg) const
+    {
+        auto v = arg.vector();
+
+        if (mode_ == argsort_values)
+        {
+            blaze::DynamicVector<std::int64_t> result(v.size());
+            std::iota(result.begin(), result.end(), std::int64_t(0));
+            hpx::parallel::sort(hpx::execution::par, result.begin(),
+                result.end(), [&](std::int64_t lhs, std::int64_t rhs) {
+                    return v[lhs] < v[rhs] || (v[lhs] == v[rhs] && lhs < rhs);
+                });
+            return execution_tree::primitive_argument_type{std::move(result)};
+        }
+
+        std::vector<T> values(v.begin(), v.end());
+        hpx::parallel::sort(hpx::execution::par, values.begin(), values.end());
+
+        if (mode_ == unique_values)
+        {
+            values.erase(
+                std::unique(values.begin(), values.end()), values.end());
+        }
+
+        return execution_tree::primitive_argument_type{
+            blaze::DynamicVector<T>(values.size(), values.data())};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // balance the sorted data over all localities and annotate the result
+    template <typename T>
+    execution_tree::primitive_argument_type dist_sort::finalize(
+        blaze::DynamicVector<T>&& local,
+        execution_tree::localities_information&& localities) const
+    {
+        using namespace execution_tree;
+
+        std::uint32_t const loc_id = localities.locality_.locality_id_;
+        std::uint32_t const num_localities =
+            localities.locality_.num_localities_;
+
+        tiling_span span;
+        blaze::DynamicVector<T> result = sample_sort::rebalance(
+            localities.annotation_.generate_name() + "_" +
+                detail::sort_mode_names[mode_],
+            local, num_localities, loc_id, span, &transferred_bytes_);
+
+        // the result is a row or a column vector, depending on the argument
+        bool const is_column = localities.has_span(0);
+        tiling_information_1d tile_info(is_column ?
+                tiling_information_1d::tile1d_type::columns :
+                tiling_information_1d::tile1d_type::rows,
+            span);
+
+        localities.annotation_.name_ +=
+            std::string("_") + detail::sort_mode_names[mode_];
+        ++localities.annotation_.generation_;
+
+        auto locality_ann = localities.locality_.as_annotation();
+        auto attached_annotation =
+            std::make_shared<annotation>(localities_annotation(locality_ann,
+                tile_info.as_annotation(name_, codename_),
+                localities.annotation_, name_, codename_));
+
+        return primitive_argument_type(std::move(result), attached_annotation);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    execution_tree::primitive_argument_type dist_sort::sort1d(
+        ir::node_data<T>&& arg,
+        execution_tree::localities_information&& localities) const
+    {
+        std::uint32_t const loc_id = localities.locality_.locality_id_;
+        std::uint32_t const num_localities =
+            localities.locality_.num_localities_;
+
+        auto v = arg.vector();
+        std::vector<T> values(v.begin(), v.end());
+
+        if (mode_ == unique_values)
+        {
+            // remove local duplicates before exchanging any data
+            hpx::parallel::sort(
+                hpx::execution::par, values.begin(), values.end());
+            values.erase(
+                std::unique(values.begin(), values.end()), values.end());
+        }
+
+        // equal elements end up on the same locality, thus removing
+        // duplicates locally after the exchange is sufficient
+        std::vector<T> sorted = sample_sort::sort(
+            localities.annotation_.generate_name() + "_" +
+                detail::sort_mode_names[mode_],
+            std::move(values), std::less<T>{}, num_localities, loc_id);
+
+        if (mode_ == unique_values)
+        {
+            sorted.erase(
+                std::unique(sorted.begin(), sorted.end()), sorted.end());
+        }
+
+        return finalize(
+            blaze::DynamicVector<T>(sorted.size(), sorted.data()),
+            std::move(localities));
+    }
+
+    template <typename T>
+    execution_tree::primitive_argument_type dist_sort::argsort1d(
+        ir::node_data<T>&& arg,
+        execution_tree::localities_information&& localities) const
+    {
+        std::uint32_t const loc_id = localities.locality_.locality_id_;
+        std::uint32_t const num_localities =
+            localities.locality_.num_localities_;
+
+        // the global index of the first local element
+        std::int64_t const start = retile_planner::extract_tiling<1>(
+            localities, name_, codename_)[loc_id][0].start_;
+
+        auto v = arg.vector();
+
+        using element_type = std::pair<T, std::int64_t>;
+        std::vector<element_type> elements;
+        elements.reserve(v.size());
+        for (std::size_t i = 0; i != v.size(); ++i)
+        {
+            elements.emplace_back(v[i], start + std::int64_t(i));
+        }
+
+        // ties are broken by the global index, which makes the result
+        // identical to a stable sort
+        std::vector<element_type> sorted = sample_sort::sort(
+            localities.annotation_.generate_name() + "_" +
+                detail::sort_mode_names[mode_],
+            std::move(elements), std::less<element_type>{}, num_localities,
+            loc_id);
+
+        blaze::DynamicVector<std::int64_t> indices(sorted.size());
+        for (std::size_t i = 0; i != sorted.size(); ++i)
+        {
+            indices[i] = sorted[i].second;
+        }
+
+        return finalize(std::move(indices), std::move(localities));
+    }
+
+    execution_tree::primitive_argument_type dist_sort::sort1d(
+        execution_tree::primitive_argument_type&& arg) const
+    {
+        using namespace execution_tree;
+
+        bool const annotated = arg.has_annotation();
+        localities_information localities =
+            extract_localities_information(arg, name_, codename_);
+
+        switch (extract_common_type(arg))
+        {
+        case node_data_type_bool:
+            {
+                auto&& data =
+                    extract_boolean_value_strict(std::move(arg), name_, codename_);
+                if (!annotated)
+                {
+                    return sort1d_local(std::move(data));
+                }
+                if (mode_ == argsort_values)
+                {
+                    return argsort1d(std::move(data), std::move(localities));
+                }
+                return sort1d(std::move(data), std::move(localities));
+            }
+
+        case node_data_type_int64:
+            {
+                auto&& data =
+                    extract_integer_value_strict(std::move(arg), name_, codename_);
+                if (!annotated)
+                {
+                    return sort1d_local(std::move(data));
+                }
+                if (mode_ == argsort_values)
+                {
+                    return argsort1d(std::move(data), std::move(localities));
+                }
+                return sort1d(std::move(data), std::move(localities));
+            }
+
+        case node_data_type_unknown: [[fallthrough]];
+        case node_data_type_double:
+            {
+                auto&& data =
+                    extract_numeric_value(std::move(arg), name_, codename_);
+                if (!annotated)
+                {
+                    return sort1d_local(std::move(data));
+                }
+                if (mode_ == argsort_values)
+                {
+                    return argsort1d(std::move(data), std::move(localities));
+                }
+                return sort1d(std::move(data), std::move(localities));
+            }
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "dist_sort::sort1d",
+            generate_error_message(
+                "the distributed sort primitives require for all arguments to "
+                "be numeric data types"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<execution_tree::primitive_argument_type> dist_sort::eval(
+        execution_tree::primitive_arguments_type const& operands,
+        execution_tree::primitive_arguments_type const& args,
+        execution_tree::eval_context ctx) const
+    {
+        using namespace execution_tree;
+
+        if (operands.size() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_sort::eval",
+                generate_error_message(
+                    "the distributed sort primitives require exactly one "
+                    "operand"));
+        }
+
+        if (!valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_sort::eval",
+                generate_error_message(
+                    "the distributed sort primitives require that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            [this_ = std::move(this_)](
+                    hpx::future<primitive_argument_type>&& arg)
+            -> primitive_argument_type
+            {
+                auto&& val = arg.get();
+                if (extract_numeric_value_dimension(
+                        val, this_->name_, this_->codename_) != 1)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_sort::eval",
+                        this_->generate_error_message(
+                            "the distributed sort primitives support only "
+                            "vectors"));
+                }
+                return this_->sort1d(std::move(val));
+            },
+            value_operand(operands[0], args, name_, codename_, std::move(ctx)));
+    }
+}}}
@@ -0,0 +1,404 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/annotation.hpp>
+#include <phylanx/execution_tree/localities_annotation.hpp>
+#include <phylanx/execution_tree/locality_annotation.hpp>
+#include <phylanx/execution_tree/meta_annotation.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/tiling_annotations.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/dist_matrixops/dist_stencil.hpp>
+#include <phylanx/util/distributed_matrix.hpp>
+#include <phylanx/util/distributed_vector.hpp>
+#include <phylanx/util/halo_exchange.hpp>
+
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace dist_matrixops { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::match_pattern_type const dist_stencil::match_data =
+    {
+        hpx::make_tuple("stencil_d", std::vector<std::string>{R"(
+                stencil_d(_1_x, _2_weights, __arg(_3_name, ""))
+            )"},
+            &create_dist_stencil,
+            &execution_tree::create_primitive<dist_stencil>, R"(
+            x, weights, name
+            Args:
+                x (array): a vector or a matrix, possibly tiled along one of
+                    its dimensions.
+                weights (array): the weights of the stencil, a vector for a
+                    vector x, a matrix for a matrix x. The weights are
+                    centered on the element they are applied to, thus all of
+                    their dimensions have to be odd.
+                name (string, optional): the result name. If not given it
+                    will be the same as the next generation of the original
+                    distributed array.
+            Returns:
+
+            An array of the same shape (and tiling) as x where every element
+            is the weighted sum of its neighborhood. Elements outside of x
+            are treated as zeros.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    dist_stencil::dist_stencil(
+        execution_tree::primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        util::stencil_extent centered_extent(std::int64_t width)
+        {
+            return util::stencil_extent{(width - 1) / 2, width};
+        }
+
+        // Compute the elements [out_start, out_stop) of the result. The input
+        // elements held by 'block' start at the global index 'block_start'.
+        template <typename Block>
+        void stencil1d(Block const& block, std::int64_t block_start,
+            ir::node_data<double> const& weights,
+            util::stencil_extent const& extent, std::int64_t size,
+            blaze::DynamicVector<double>& result, std::int64_t result_start,
+            std::int64_t out_start, std::int64_t out_stop)
+        {
+            auto w = weights.vector();
+            for (std::int64_t i = out_start; i != out_stop; ++i)
+            {
+                std::int64_t const left = i - extent.offset_;
+                std::int64_t const first = (std::max)(std::int64_t(0), left);
+                std::int64_t const last =
+                    (std::min)(size, left + extent.width_);
+
+                result[i - result_start] = blaze::dot(
+                    blaze::subvector(block, first - block_start, last - first),
+                    blaze::subvector(w, first - left, last - first));
+            }
+        }
+
+        // Compute the elements [row_start, row_stop) x [column_start,
+        // column_stop) of the result. The input elements held by 'block'
+        // start at the global indices 'block_row' and 'block_column'.
+        template <typename Block>
+        void stencil2d(Block const& block, std::int64_t block_row,
+            std::int64_t block_column, ir::node_data<double> const& weights,
+            util::stencil_extent const& row_extent,
+            util::stencil_extent const& column_extent, std::int64_t rows,
+            std::int64_t columns, blaze::DynamicMatrix<double>& result,
+            std::int64_t result_row, std::int64_t result_column,
+            std::int64_t row_start, std::int64_t row_stop,
+            std::int64_t column_start, std::int64_t column_stop)
+        {
+            auto w = weights.matrix();
+            for (std::int64_t i = row_start; i != row_stop; ++i)
+            {
+                std::int64_t const top = i - row_extent.offset_;
+                std::int64_t const first_row =
+                    (std::max)(std::int64_t(0), top);
+                std::int64_t const last_row =
+                    (std::min)(rows, top + row_extent.width_);
+
+                for (std::int64_t j = column_start; j != column_stop; ++j)
+                {
+                    std::int64_t const left = j - column_extent.offset_;
+                    std::int64_t const first_column =
+                        (std::max)(std::int64_t(0), left);
+                    std::int64_t const last_column =
+                        (std::min)(columns, left + column_extent.width_);
+
+                    result(i - result_row, j - result_column) = blaze::sum(
+                        blaze::submatrix(block, first_row - block_row,
+                            first_column - block_column, last_row - first_row,
+                            last_column - first_column) %
+                        blaze::submatrix(w, first_row - top,
+                            first_column - left, last_row - first_row,
+                            last_column - first_column));
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<execution_tree::annotation> dist_stencil::result_annotation(
+        execution_tree::localities_information&& arg_locs,
+        std::string&& given_name) const
+    {
+        using namespace execution_tree;
+
+        std::string base_name =
+            given_name.empty() ? arg_locs.annotation_.name_ : given_name;
+        annotation_information ann_info(
+            std::move(base_name), ++arg_locs.annotation_.generation_);
+
+        auto locality_ann = arg_locs.locality_.as_annotation();
+        return std::make_shared<annotation>(localities_annotation(locality_ann,
+            arg_locs.tiles_[arg_locs.locality_.locality_id_].as_annotation(
+                name_, codename_),
+            ann_info, name_, codename_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::primitive_argument_type dist_stencil::stencil1d(
+        ir::node_data<double>&& arg, ir::node_data<double>&& weights,
+        execution_tree::localities_information&& arg_locs,
+        std::string&& given_name) const
+    {
+        using namespace execution_tree;
+        std::uint32_t const loc_id = arg_locs.locality_.locality_id_;
+        std::uint32_t const numtiles = arg_locs.locality_.num_localities_;
+
+        auto v = arg.vector();
+        std::int64_t const size = arg_locs.size(name_, codename_);
+        auto const extent = detail::centered_extent(weights.vector().size());
+
+        std::vector<util::halo_span> spans(numtiles);
+        for (std::uint32_t i = 0; i != numtiles; ++i)
+        {
+            tiling_information_1d tile(arg_locs.tiles_[i], name_, codename_);
+            spans[i] = util::halo_span(tile.span_.start_, tile.span_.stop_);
+        }
+
+        std::int64_t const start = spans[loc_id].first;
+        std::int64_t const stop = spans[loc_id].second;
+
+        blaze::DynamicVector<double> result(v.size());
+        if (numtiles == 1)
+        {
+            detail::stencil1d(
+                v, 0, weights, extent, size, result, 0, 0, size);
+            return primitive_argument_type(std::move(result),
+                result_annotation(std::move(arg_locs), std::move(given_name)));
+        }
+
+        // make the local tile accessible to the neighbors
+        util::distributed_vector<double> data(
+            arg_locs.annotation_.generate_name(), v, numtiles, loc_id);
+
+        auto halo = util::make_halo_exchange(data, spans, loc_id,
+            extent.lower_halo(start, start),
+            extent.upper_halo(stop, stop, size));
+
+        util::apply_stencil(halo, extent, start, stop, size, start, stop,
+            [&](std::int64_t first, std::int64_t last) {
+                return blaze::subvector(v, first - start, last - first);
+            },
+            [](auto const& lower, auto const& local, auto const& upper) {
+                return util::assemble_halo_block(lower, local, upper);
+            },
+            [&](auto const& block, std::int64_t block_start,
+                std::int64_t first, std::int64_t last) {
+                detail::stencil1d(block, block_start, weights, extent, size,
+                    result, start, first, last);
+            });
+
+        return primitive_argument_type(std::move(result),
+            result_annotation(std::move(arg_locs), std::move(given_name)));
+    }
+
+    execution_tree::primitive_argument_type dist_stencil::stencil2d(
+        ir::node_data<double>&& arg, ir::node_data<double>&& weights,
+        execution_tree::localities_information&& arg_locs,
+        std::string&& given_name) const
+    {
+        using namespace execution_tree;
+        std::uint32_t const loc_id = arg_locs.locality_.locality_id_;
+        std::uint32_t const numtiles = arg_locs.locality_.num_localities_;
+
+        // the tiles have to span the full extent of one of the dimensions
+        std::size_t axis = 0;
+        if (!arg_locs.is_row_tiled(name_, codename_))
+        {
+            if (!arg_locs.is_column_tiled(name_, codename_))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "dist_stencil::stencil2d",
+                    generate_error_message(
+                        "stencil_d requires for the matrix to be tiled along "
+                        "either its rows or its columns"));
+            }
+            axis = 1;
+        }
+
+        auto m = arg.matrix();
+        std::int64_t const rows = arg_locs.rows(name_, codename_);
+        std::int64_t const columns = arg_locs.columns(name_, codename_);
+
+        auto w = weights.matrix();
+        auto const row_extent = detail::centered_extent(w.rows());
+        auto const column_extent = detail::centered_extent(w.columns());
+        auto const& extent = axis == 0 ? row_extent : column_extent;
+
+        std::vector<util::halo_span> spans(numtiles);
+        for (std::uint32_t i = 0; i != numtiles; ++i)
+        {
+            tiling_information_2d tile(arg_locs.tiles_[i], name_, codename_);
+            spans[i] = util::halo_span(
+                tile.spans_[axis].start_, tile.spans_[axis].stop_);
+        }
+
+        std::int64_t const start = spans[loc_id].first;
+        std::int64_t const stop = spans[loc_id].second;
+        std::int64_t const size = axis == 0 ? rows : columns;
+
+        blaze::DynamicMatrix<double> result(m.rows(), m.columns());
+        if (numtiles == 1)
+        {
+            detail::stencil2d(m, 0, 0, weights, row_extent, column_extent,
+                rows, columns, result, 0, 0, 0, rows, 0, columns);
+            return primitive_argument_type(std::move(result),
+                result_annotation(std::move(arg_locs), std::move(given_name)));
+        }
+
+        // make the local tile accessible to the neighbors
+        util::distributed_matrix<double> data(
+            arg_locs.annotation_.generate_name(), m, numtiles, loc_id);
+
+        auto halo = util::make_halo_exchange(data, axis, spans, loc_id,
+            extent.lower_halo(start, start),
+            extent.upper_halo(stop, stop, size));
+
+        util::apply_stencil(halo, extent, start, stop, size, start, stop,
+            [&](std::int64_t first, std::int64_t last) {
+                return axis == 0 ?
+                    blaze::submatrix(
+                        m, first - start, 0, last - first, m.columns()) :
+                    blaze::submatrix(
+                        m, 0, first - start, m.rows(), last - first);
+            },
+            [axis](auto const& lower, auto const& local, auto const& upper) {
+                return util::assemble_halo_block(axis, lower, local, upper);
+            },
+            [&](auto const& block, std::int64_t block_start,
+                std::int64_t first, std::int64_t last) {
+                if (axis == 0)
+                {
+                    detail::stencil2d(block, block_start, 0, weights,
+                        row_extent, column_extent, rows, columns, result,
+                        start, 0, first, last, 0, columns);
+                }
+                else
+                {
+                    detail::stencil2d(block, 0, block_start, weights,
+                        row_extent, column_extent, rows, columns, result, 0,
+                        start, 0, rows, first, last);
+                }
+            });
+
+        return primitive_argument_type(std::move(result),
+            result_annotation(std::move(arg_locs), std::move(given_name)));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<execution_tree::primitive_argument_type> dist_stencil::eval(
+        execution_tree::primitive_arguments_type const& operands,
+        execution_tree::primitive_arguments_type const& args,
+        execution_tree::eval_context ctx) const
+    {
+        if (operands.size() < 2 || operands.size() > 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_stencil::eval",
+                generate_error_message("the stencil_d primitive requires "
+                                       "two or three operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "dist_stencil::eval",
+                generate_error_message(
+                    "the stencil_d primitive requires that the arguments "
+                    "given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::unwrapping([this_ = std::move(this_)](
+                                execution_tree::primitive_arguments_type&& args)
+                                -> execution_tree::primitive_argument_type {
+                using namespace execution_tree;
+
+                std::size_t const ndim = extract_numeric_value_dimension(
+                    args[0], this_->name_, this_->codename_);
+                if ((ndim != 1 && ndim != 2) ||
+                    ndim != extract_numeric_value_dimension(
+                                args[1], this_->name_, this_->codename_))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "dist_stencil::eval",
+                        this_->generate_error_message(
+                            "stencil_d requires for x and the weights to be "
+                            "either both vectors or both matrices"));
+                }
+
+                auto wdims = extract_numeric_value_dimensions(
+                    args[1], this_->name_, this_->codename_);
+                for (std::size_t i = 0; i != ndim; ++i)
+                {
+                    if (wdims[i] % 2 == 0)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "dist_stencil::eval",
+                            this_->generate_error_message(
+                                "the dimensions of the weights of the stencil "
+                                "have to be odd"));
+                    }
+                }
+
+                std::string given_name;
+                if (args.size() > 2 && valid(args[2]))
+                {
+                    given_name = extract_string_value(std::move(args[2]),
+                        this_->name_, this_->codename_);
+                }
+
+                // non-annotated arrays are handled as if they were the only
+                // tile of a distributed array
+                localities_information arg_locs =
+                    extract_localities_information(
+                        args[0], this_->name_, this_->codename_);
+                bool const annotated = args[0].has_annotation();
+
+                auto x = extract_numeric_value(
+                    std::move(args[0]), this_->name_, this_->codename_);
+                auto weights = extract_numeric_value(
+                    std::move(args[1]), this_->name_, this_->codename_);
+
+                primitive_argument_type result = ndim == 1 ?
+                    this_->stencil1d(std::move(x), std::move(weights),
+                        std::move(arg_locs), std::move(given_name)) :
+                    this_->stencil2d(std::move(x), std::move(weights),
+                        std::move(arg_locs), std::move(given_name));
+
+                if (!annotated)
+                {
+                    return primitive_argument_type{
+                        extract_numeric_value(std::move(result))};
+                }
+                return result;
+            }),
+            execution_tree::primitives::detail::map_operands(operands,
+                execution_tree::functional::value_operand{}, args, name_,
+                codename_, std::move(ctx)));
+    }
+}}}
@@ -14,14 +14,12 @@
 #include <phylanx/execution_tree/tiling_annotations.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/dist_matrixops/retile_annotations.hpp>
+#include <phylanx/plugins/dist_matrixops/retile_planner.hpp>
 #include <phylanx/plugins/dist_matrixops/tile_calculation_helper.hpp>
 #include <phylanx/util/detail/range_dimension.hpp>
-#include <phylanx/util/distributed_matrix.hpp>
-#include <phylanx/util/distributed_tensor.hpp>
-#include <phylanx/util/distributed_vector.hpp>
-#include <phylanx/util/index_calculation_helper.hpp>
 
 #include <hpx/assert.hpp>
+#include <hpx/collectives/all_gather.hpp>
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
@@ -51,12 +49,13 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                     __arg(_2_tiling_type, "sym"),
                     __arg(_3_intersection, nil),
                     __arg(_4_numtiles, num_localities()),
-                    __arg(_5_new_tiling, nil)
+                    __arg(_5_new_tiling, nil),
+                    __arg(_6_placement, "fixed")
                 )
             )"},
             &create_retile_annotations,
             &execution_tree::create_primitive<retile_annotations>, R"(
-            a, tiling_type, intersection, numtiles, new_tiling
+            a, tiling_type, intersection, numtiles, new_tiling, placement
             Args:
 
                 a (array): a distributed array. A vector or a matrix.
@@ -82,11 +81,17 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                     list("tile", list("columns", 0, 2), list("rows", 0, 2)) or
                     list("args", list("locality", 0, 4),
                        list("tile", list("columns", 0, 2), list("rows", 0, 2)))
+                placement (string, optional): defaults to `fixed` which keeps
+                    the i-th new tile on the i-th locality. If `local` is
+                    given, the new tiles are assigned to the localities such
+                    that the amount of data staying local is maximized. The
+                    `user` tiling type always uses the `fixed` placement.
 
             Returns:
 
             A retiled array according to the tiling type on numtiles localities
-            The returned array can contain overlapped parts)")
+            The returned array can contain overlapped parts. All data is
+            exchanged between the localities in one all-to-all operation.)")
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -326,6 +331,134 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             return tile_extraction_3d_helper(it, name, codename);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // calculate the tile_idx-th new tile for the `sym`, `page`, `row` and
+        // `column` tiling types
+        retile_planner::tile_spans<1> calculate_tile_1d(std::uint32_t tile_idx,
+            std::size_t dim, std::uint32_t numtiles, std::size_t intersection)
+        {
+            std::int64_t start;
+            std::size_t size;
+            std::tie(start, size) =
+                tile_calculation::tile_calculation_1d(tile_idx, dim, numtiles);
+
+            if (intersection != 0) // there should be some overlapped sections
+            {
+                std::tie(start, size) =
+                    tile_calculation::tile_calculation_overlap_1d(
+                        start, size, dim, intersection);
+            }
+
+            return retile_planner::tile_spans<1>{
+                execution_tree::tiling_span(start, start + size)};
+        }
+
+        retile_planner::tile_spans<2> calculate_tile_2d(std::uint32_t tile_idx,
+            std::size_t rows_dim, std::size_t cols_dim, std::uint32_t numtiles,
+            std::string const& tiling_type,
+            std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const&
+                intersections)
+        {
+            std::int64_t row_start, col_start;
+            std::size_t row_size, col_size;
+            std::tie(row_start, col_start, row_size, col_size) =
+                tile_calculation::tile_calculation_2d(
+                    tile_idx, rows_dim, cols_dim, numtiles, tiling_type);
+
+            if (row_size != rows_dim && intersections[0] != 0)    // rows overlap
+            {
+                std::tie(row_start, row_size) =
+                    tile_calculation::tile_calculation_overlap_1d(
+                        row_start, row_size, rows_dim, intersections[0]);
+            }
+            if (col_size != cols_dim &&
+                intersections[1] != 0)    // columns overlap
+            {
+                std::tie(col_start, col_size) =
+                    tile_calculation::tile_calculation_overlap_1d(
+                        col_start, col_size, cols_dim, intersections[1]);
+            }
+
+            return retile_planner::tile_spans<2>{
+                execution_tree::tiling_span(row_start, row_start + row_size),
+                execution_tree::tiling_span(col_start, col_start + col_size)};
+        }
+
+        retile_planner::tile_spans<3> calculate_tile_3d(std::uint32_t tile_idx,
+            std::size_t pages_dim, std::size_t rows_dim, std::size_t cols_dim,
+            std::uint32_t numtiles, std::string const& tiling_type,
+            std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const&
+                intersections)
+        {
+            std::int64_t page_start, row_start, col_start;
+            std::size_t page_size, row_size, col_size;
+            std::tie(page_start, row_start, col_start, page_size, row_size,
+                col_size) = tile_calculation::tile_calculation_3d(tile_idx,
+                pages_dim, rows_dim, cols_dim, numtiles, tiling_type);
+
+            if (page_size != pages_dim &&
+                intersections[0] != 0)    // pages overlap
+            {
+                std::tie(page_start, page_size) =
+                    tile_calculation::tile_calculation_overlap_1d(
+                        page_start, page_size, pages_dim, intersections[0]);
+            }
+            if (row_size != rows_dim && intersections[1] != 0)    // rows overlap
+            {
+                std::tie(row_start, row_size) =
+                    tile_calculation::tile_calculation_overlap_1d(
+                        row_start, row_size, rows_dim, intersections[1]);
+            }
+            if (col_size != cols_dim &&
+                intersections[2] != 0)    // columns overlap
+            {
+                std::tie(col_start, col_size) =
+                    tile_calculation::tile_calculation_overlap_1d(
+                        col_start, col_size, cols_dim, intersections[2]);
+            }
+
+            return retile_planner::tile_spans<3>{
+                execution_tree::tiling_span(page_start, page_start + page_size),
+                execution_tree::tiling_span(row_start, row_start + row_size),
+                execution_tree::tiling_span(col_start, col_start + col_size)};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // for the `user` tiling type each locality knows its new tile only,
+        // collect the new tiles from all localities
+        template <std::size_t N>
+        retile_planner::tiling<N> gather_tiling(std::string const& basename,
+            retile_planner::tile_spans<N> const& tile,
+            std::uint32_t num_localities, std::uint32_t loc_id)
+        {
+            std::vector<std::int64_t> local_tile;
+            local_tile.reserve(2 * N);
+            for (auto const& span : tile)
+            {
+                local_tile.push_back(span.start_);
+                local_tile.push_back(span.stop_);
+            }
+
+            std::vector<std::vector<std::int64_t>> tiles =
+                hpx::collectives::all_gather(
+                    ("retile_tiling_" + basename).c_str(),
+                    std::move(local_tile),
+                    hpx::collectives::num_sites_arg{num_localities},
+                    hpx::collectives::this_site_arg{loc_id})
+                    .get();
+
+            retile_planner::tiling<N> result(tiles.size());
+            for (std::size_t i = 0; i != tiles.size(); ++i)
+            {
+                for (std::size_t d = 0; d != N; ++d)
+                {
+                    result[i][d] = execution_tree::tiling_span(
+                        tiles[i][2 * d], tiles[i][2 * d + 1]);
+                }
+            }
+            return result;
+        }
+
     }    // namespace detail
 
     ///////////////////////////////////////////////////////////////////////////
@@ -333,7 +466,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     execution_tree::primitive_argument_type retile_annotations::retile1d(
         ir::node_data<T>&& arr, std::string const& tiling_type,
         std::size_t intersection, std::uint32_t numtiles,
-        ir::range&& new_tiling,
+        ir::range&& new_tiling, bool optimize_placement,
         execution_tree::localities_information&& arr_localities) const
     {
         using namespace execution_tree;
@@ -346,11 +479,9 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         // size of the whole array
         std::size_t dim =
             arr_localities.size(name_, codename_);
-        tiling_information_1d tile_info(
-            arr_localities.tiles_[loc_id], name_, codename_);
 
-        std::int64_t cur_start = tile_info.span_.start_;
-        std::int64_t cur_stop = tile_info.span_.stop_;
+        retile_planner::tiling<1> current =
+            retile_planner::extract_tiling<1>(arr_localities, name_, codename_);
 
         // updating the annotation_ part of localities annotation
         arr_localities.annotation_.name_ += "_retiled";
@@ -365,15 +496,15 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         }
 
         // desired annotation information
-        std::int64_t des_start, des_stop, des_size;
+        retile_planner::tiling<1> desired;
         bool type_ = span_index;    // initialized by the current type
 
         if (tiling_type == "user")
         {
+            std::int64_t des_start, des_stop;
             std::tie(type_, des_start, des_stop) = detail::tile_extraction_1d(
                 std::move(new_tiling), name_, codename_);
-            des_size = des_stop - des_start;
-            if (des_size <= 0)
+            if (des_stop - des_start <= 0)
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "dist_matrixops::primitives::retile_annotations::retile1d",
@@ -381,6 +512,13 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                         "the given start point of the new_tiling should be less "
                         "than its stop point"));
             }
+
+            desired = detail::gather_tiling<1>(
+                arr_localities.annotation_.generate_name(),
+                retile_planner::tile_spans<1>{tiling_span(des_start, des_stop)},
+                num_localities, loc_id);
+
+            optimize_placement = false;
         }
         else    // tiling_type is one of "sym", "row" or "column"
         {
@@ -392,85 +530,30 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             {
                 type_ = false;
             }
-            std::tie(des_start, des_size) =
-                tile_calculation::tile_calculation_1d(loc_id, dim, numtiles);
 
-            if (intersection != 0) // there should be some overlapped sections
+            desired.reserve(num_localities);
+            for (std::uint32_t tile = 0; tile != num_localities; ++tile)
             {
-                std::tie(des_start, des_size) =
-                    tile_calculation::tile_calculation_overlap_1d(
-                        des_start, des_size, dim, intersection);
+                desired.push_back(detail::calculate_tile_1d(
+                    tile, dim, numtiles, intersection));
             }
-            des_stop = des_start + des_size;
         }
 
-        // creating the updated array as result
-        auto v = arr.vector();
-        blaze::DynamicVector<T> result(des_size);
-        util::distributed_vector<T> v_data(arr_localities.annotation_.name_, v,
-            num_localities, loc_id, &transferred_bytes_);
+        // plan and execute the data exchange between all localities
+        retile_planner::retile_plan plan = retile_planner::make_retile_plan(
+            current, desired, optimize_placement);
 
-        // relative start
-        std::int64_t rel_start = des_start - cur_start;
-        if (rel_start < 0 || des_stop > cur_stop)
-        {
-            // there is a need to fetch some part
-
-            // copying the local part
-            if (des_start < cur_stop && des_stop > cur_start)
-            {
-                auto indices = util::index_calculation_1d(
-                    des_start, des_stop, cur_start, cur_stop);
-                blaze::subvector(result, indices.projected_start_,
-                    indices.intersection_size_) = blaze::subvector(v,
-                        indices.local_start_, indices.intersection_size_);
-            }
-
-            // collecting other parts from remote localities
-            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
-            {
-                if (loc == loc_id)
-                {
-                    continue;
-                }
-
-                // the array span in for loc-th locality
-                tiling_span loc_span =
-                    arr_localities.tiles_[loc].spans_[span_index];
-
-                auto indices =
-                    util::retile_calculation_1d(loc_span, des_start, des_stop);
-                if (indices.intersection_size_ > 0)
-                {
-                    // loc_span has the part of result that we need
-                    blaze::subvector(result, indices.projected_start_,
-                        indices.intersection_size_) =
-                        v_data
-                        .fetch(loc, indices.local_start_,
-                            indices.local_start_ +
-                            indices.intersection_size_)
-                        .get();
-                }
-            }
-        }
-        else // the new array is a subset of the original array
-        {
-            result = blaze::subvector(v, rel_start, des_size);
-        }
+        blaze::DynamicVector<T> result =
+            retile_planner::execute_retile_plan<T, 1>(
+                arr_localities.annotation_.generate_name(), arr.vector(), plan,
+                current, desired, loc_id, &transferred_bytes_);
 
         // updating the tile information
-        if (type_)    // rows
-        {
-            tile_info =
-                tiling_information_1d(tiling_information_1d::tile1d_type::rows,
-                    tiling_span(des_start, des_stop));
-        }
-        else    // columns
-        {
-            tile_info = tiling_information_1d(
+        tiling_span const& des_span = desired[plan.tile_of_[loc_id]][0];
+        tiling_information_1d tile_info(type_ ?
+                tiling_information_1d::tile1d_type::rows :
                 tiling_information_1d::tile1d_type::columns,
-                tiling_span(des_start, des_stop));
-        }
+            des_span);
 
         auto locality_ann = arr_localities.locality_.as_annotation();
         auto attached_annotation =
@@ -484,7 +567,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     execution_tree::primitive_argument_type retile_annotations::retile1d(
         execution_tree::primitive_argument_type&& arr,
         std::string const& tiling_type, std::size_t intersection,
-        std::uint32_t numtiles, ir::range&& new_tiling) const
+        std::uint32_t numtiles, ir::range&& new_tiling,
+        bool optimize_placement) const
     {
         using namespace execution_tree;
         localities_information arr_localities =
@@ -496,25 +580,25 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             return retile1d(
                 extract_boolean_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_int64:
             return retile1d(
                 extract_integer_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_double:
             return retile1d(
                 extract_numeric_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_unknown:
             return retile1d(
                 extract_numeric_value(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         default:
             break;
@@ -532,7 +616,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     execution_tree::primitive_argument_type retile_annotations::retile2d(
         ir::node_data<T>&& arr, std::string const& tiling_type,
         std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersections,
-        std::uint32_t numtiles, ir::range&& new_tiling,
+        std::uint32_t numtiles, ir::range&& new_tiling, bool optimize_placement,
         execution_tree::localities_information&& arr_localities) const
     {
         using namespace execution_tree;
@@ -543,32 +627,27 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             arr_localities.locality_.num_localities_;
         std::size_t rows_dim = arr_localities.rows(name_, codename_);
         std::size_t cols_dim = arr_localities.columns(name_, codename_);
-        tiling_information_2d tile_info(
-            arr_localities.tiles_[loc_id], name_, codename_);
 
-        std::int64_t cur_row_start = tile_info.spans_[0].start_;
-        std::int64_t cur_row_stop = tile_info.spans_[0].stop_;
-        std::int64_t cur_col_start = tile_info.spans_[1].start_;
-        std::int64_t cur_col_stop = tile_info.spans_[1].stop_;
+        retile_planner::tiling<2> current =
+            retile_planner::extract_tiling<2>(arr_localities, name_, codename_);
 
         // updating the annotation_ part of localities annotation
         arr_localities.annotation_.name_ += "_retiled";
         ++arr_localities.annotation_.generation_;
 
         // desired annotation information
-        std::int64_t des_row_start, des_row_stop, des_col_start, des_col_stop,
-            des_row_size, des_col_size;
+        retile_planner::tiling<2> desired;
 
         if (tiling_type == "user")
         {
+            std::int64_t des_row_start, des_row_stop, des_col_start,
+                des_col_stop;
             std::tie(des_row_start, des_col_start, des_row_stop, des_col_stop) =
                 detail::tile_extraction_2d(
                     std::move(new_tiling), name_, codename_);
 
-            des_row_size = des_row_stop - des_row_start;
-            des_col_size = des_col_stop - des_col_start;
-
-            if (des_row_size <= 0 || des_col_size <= 0)
+            if (des_row_stop - des_row_start <= 0 ||
+                des_col_stop - des_col_start <= 0)
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "dist_matrixops::primitives::retile_annotations::retile2d",
@@ -576,108 +655,39 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                         "the given start point of the new_tiling should be "
                         "smaller than its stop point on each dimension"));
             }
-        }
-        else    // tiling_type is one of "sym", "row" or "column"
-        {
-            std::tie(des_row_start, des_col_start, des_row_size, des_col_size) =
-                tile_calculation::tile_calculation_2d(
-                    loc_id, rows_dim, cols_dim, numtiles, tiling_type);
 
-            if (des_row_size != rows_dim &&
-                intersections[0] != 0)    // rows overlap
-            {
-                std::tie(des_row_start, des_row_size) =
-                    tile_calculation::tile_calculation_overlap_1d(des_row_start,
-                        des_row_size, rows_dim, intersections[0]);
-            }
-            if (des_col_size != cols_dim &&
-                intersections[1] != 0)    // columns overlap
-            {
-                std::tie(des_col_start, des_col_size) =
-                    tile_calculation::tile_calculation_overlap_1d(des_col_start,
-                        des_col_size, cols_dim, intersections[1]);
-            }
+            desired = detail::gather_tiling<2>(
+                arr_localities.annotation_.generate_name(),
+                retile_planner::tile_spans<2>{
+                    tiling_span(des_row_start, des_row_stop),
+                    tiling_span(des_col_start, des_col_stop)},
+                num_localities, loc_id);
 
-            des_row_stop = des_row_start + des_row_size;
-            des_col_stop = des_col_start + des_col_size;
+            optimize_placement = false;
         }
-
-
-        // updating the array
-        auto m = arr.matrix();
-        blaze::DynamicMatrix<T> result(des_row_size, des_col_size);
-        util::distributed_matrix<T> m_data(arr_localities.annotation_.name_, m,
-            num_localities, loc_id, &transferred_bytes_);
-
-        // relative starts
-        std::int64_t rel_row_start = des_row_start - cur_row_start;
-        std::int64_t rel_col_start = des_col_start - cur_col_start;
-        if ((rel_row_start < 0 || des_row_stop > cur_row_stop) ||
-            (rel_col_start < 0 || des_col_stop > cur_col_stop))
+        else    // tiling_type is one of "sym", "row" or "column"
         {
-            // copying the local part
-            if ((des_row_start < cur_row_stop &&
-                    des_row_stop > cur_row_start) &&
-                (des_col_start < cur_col_stop && des_col_stop > cur_col_start))
+            desired.reserve(num_localities);
+            for (std::uint32_t tile = 0; tile != num_localities; ++tile)
             {
-                auto row_indices = util::index_calculation_1d(
-                    des_row_start, des_row_stop, cur_row_start, cur_row_stop);
-                auto col_indices = util::index_calculation_1d(
-                    des_col_start, des_col_stop, cur_col_start, cur_col_stop);
-
-                blaze::submatrix(result, row_indices.projected_start_,
-                    col_indices.projected_start_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_) = blaze::submatrix(m,
-                    row_indices.local_start_, col_indices.local_start_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_);
+                desired.push_back(detail::calculate_tile_2d(tile, rows_dim,
+                    cols_dim, numtiles, tiling_type, intersections));
             }
+        }
 
-            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
-            {
-                if (loc == loc_id)
-                {
-                    continue;
-                }
+        // plan and execute the data exchange between all localities
+        retile_planner::retile_plan plan = retile_planner::make_retile_plan(
+            current, desired, optimize_placement);
 
-                // the array span in locality loc
-                tiling_span loc_row_span = arr_localities.tiles_[loc].spans_[0];
-                tiling_span loc_col_span = arr_localities.tiles_[loc].spans_[1];
-
-                auto row_indices = util::retile_calculation_1d(
-                    loc_row_span, des_row_start, des_row_stop);
-                auto col_indices = util::retile_calculation_1d(
-                    loc_col_span, des_col_start, des_col_stop);
-                if (row_indices.intersection_size_ > 0 &&
-                    col_indices.intersection_size_ > 0)
-                {
-                    // loc_span has the block of result that we need
-                    blaze::submatrix(result, row_indices.projected_start_,
-                        col_indices.projected_start_,
-                        row_indices.intersection_size_,
-                        col_indices.intersection_size_) =
-                        m_data
-                            .fetch(loc, row_indices.local_start_,
-                                col_indices.local_start_,
-                                row_indices.local_start_ +
-                                    row_indices.intersection_size_,
-                                col_indices.local_start_ +
-                                    col_indices.intersection_size_)
-                            .get();
-                }
-            }
-        }
-        else // the new array is a subset of the original array
-        {
-            result = blaze::submatrix(
-                m, rel_row_start, rel_col_start, des_row_size, des_col_size);
-        }
+        blaze::DynamicMatrix<T> result =
+            retile_planner::execute_retile_plan<T, 2>(
+                arr_localities.annotation_.generate_name(), arr.matrix(), plan,
+                current, desired, loc_id, &transferred_bytes_);
 
         // updating the tile information
-        tile_info =
-            tiling_information_2d(tiling_span(des_row_start, des_row_stop),
-                tiling_span(des_col_start, des_col_stop));
+        retile_planner::tile_spans<2> const& des_tile =
+            desired[plan.tile_of_[loc_id]];
+        tiling_information_2d tile_info(des_tile[0], des_tile[1]);
 
         auto locality_ann = arr_localities.locality_.as_annotation();
         auto attached_annotation =
@@ -692,7 +702,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_argument_type&& arr,
         std::string const& tiling_type,
         std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersection,
-        std::uint32_t numtiles, ir::range&& new_tiling) const
+        std::uint32_t numtiles, ir::range&& new_tiling,
+        bool optimize_placement) const
     {
         using namespace execution_tree;
         execution_tree::localities_information arr_localities =
@@ -704,25 +715,25 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             return retile2d(
                 extract_boolean_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_int64:
             return retile2d(
                 extract_integer_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_double:
             return retile2d(
                 extract_numeric_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_unknown:
             return retile2d(
                 extract_numeric_value(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         default:
             break;
@@ -740,7 +751,7 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
     execution_tree::primitive_argument_type retile_annotations::retile3d(
         ir::node_data<T>&& arr, std::string const& tiling_type,
         std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersections,
-        std::uint32_t numtiles, ir::range&& new_tiling,
+        std::uint32_t numtiles, ir::range&& new_tiling, bool optimize_placement,
         execution_tree::localities_information&& arr_localities) const
     {
         using namespace execution_tree;
@@ -752,37 +763,29 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         std::size_t pages_dim = arr_localities.pages(name_, codename_);
         std::size_t rows_dim = arr_localities.rows(name_, codename_);
         std::size_t cols_dim = arr_localities.columns(name_, codename_);
-        tiling_information_3d tile_info(
-            arr_localities.tiles_[loc_id], name_, codename_);
 
-        std::int64_t cur_page_start = tile_info.spans_[0].start_;
-        std::int64_t cur_page_stop = tile_info.spans_[0].stop_;
-        std::int64_t cur_row_start = tile_info.spans_[1].start_;
-        std::int64_t cur_row_stop = tile_info.spans_[1].stop_;
-        std::int64_t cur_col_start = tile_info.spans_[2].start_;
-        std::int64_t cur_col_stop = tile_info.spans_[2].stop_;
+        retile_planner::tiling<3> current =
+            retile_planner::extract_tiling<3>(arr_localities, name_, codename_);
 
         // updating the annotation_ part of localities annotation
         arr_localities.annotation_.name_ += "_retiled";
         ++arr_localities.annotation_.generation_;
 
         // desired annotation information
-        std::int64_t des_page_start, des_page_stop, des_row_start, des_row_stop,
-            des_col_start, des_col_stop, des_page_size, des_row_size,
-            des_col_size;
+        retile_planner::tiling<3> desired;
 
         if (tiling_type == "user")
         {
+            std::int64_t des_page_start, des_page_stop, des_row_start,
+                des_row_stop, des_col_start, des_col_stop;
             std::tie(des_page_start, des_row_start, des_col_start,
                 des_page_stop, des_row_stop, des_col_stop) =
                 detail::tile_extraction_3d(
                     std::move(new_tiling), name_, codename_);
 
-            des_page_size = des_page_stop - des_page_start;
-            des_row_size = des_row_stop - des_row_start;
-            des_col_size = des_col_stop - des_col_start;
-
-            if (des_page_size <= 0 || des_row_size <= 0 || des_col_size <= 0)
+            if (des_page_stop - des_page_start <= 0 ||
+                des_row_stop - des_row_start <= 0 ||
+                des_col_stop - des_col_start <= 0)
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "dist_matrixops::primitives::retile_annotations::retile3d",
@@ -790,137 +793,40 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                         "the given start point of the new_tiling should be "
                         "smaller than its stop point on each dimension"));
             }
+
+            desired = detail::gather_tiling<3>(
+                arr_localities.annotation_.generate_name(),
+                retile_planner::tile_spans<3>{
+                    tiling_span(des_page_start, des_page_stop),
+                    tiling_span(des_row_start, des_row_stop),
+                    tiling_span(des_col_start, des_col_stop)},
+                num_localities, loc_id);
+
+            optimize_placement = false;
         }
         else    // tiling_type is one of "sym", "page", "row" or "column"
         {
-            std::tie(des_page_start, des_row_start, des_col_start,
-                des_page_size, des_row_size, des_col_size) =
-                tile_calculation::tile_calculation_3d(loc_id, pages_dim,
-                    rows_dim, cols_dim, numtiles, tiling_type);
-
-            if (des_page_size != pages_dim &&
-                intersections[0] != 0)    // pages overlap
-            {
-                std::tie(des_page_start, des_page_size) =
-                    tile_calculation::tile_calculation_overlap_1d(
-                        des_page_start, des_page_size, pages_dim,
-                        intersections[0]);
-            }
-            if (des_row_size != rows_dim &&
-                intersections[1] != 0)    // rows overlap
-            {
-                std::tie(des_row_start, des_row_size) =
-                    tile_calculation::tile_calculation_overlap_1d(des_row_start,
-                        des_row_size, rows_dim, intersections[1]);
-            }
-            if (des_col_size != cols_dim &&
-                intersections[2] != 0)    // columns overlap
+            desired.reserve(num_localities);
+            for (std::uint32_t tile = 0; tile != num_localities; ++tile)
             {
-                std::tie(des_col_start, des_col_size) =
-                    tile_calculation::tile_calculation_overlap_1d(des_col_start,
-                        des_col_size, cols_dim, intersections[2]);
+                desired.push_back(detail::calculate_tile_3d(tile, pages_dim,
+                    rows_dim, cols_dim, numtiles, tiling_type, intersections));
             }
-
-            des_page_stop = des_page_start + des_page_size;
-            des_row_stop = des_row_start + des_row_size;
-            des_col_stop = des_col_start + des_col_size;
         }
 
+        // plan and execute the data exchange between all localities
+        retile_planner::retile_plan plan = retile_planner::make_retile_plan(
+            current, desired, optimize_placement);
 
-        // updating the array
-        auto t = arr.tensor();
-        blaze::DynamicTensor<T> result(
-            des_page_size, des_row_size, des_col_size);
-        util::distributed_tensor<T> t_data(
-            arr_localities.annotation_.name_, t, num_localities, loc_id);
-
-        // relative starts
-        std::int64_t rel_page_start = des_page_start - cur_page_start;
-        std::int64_t rel_row_start = des_row_start - cur_row_start;
-        std::int64_t rel_col_start = des_col_start - cur_col_start;
-        if ((rel_page_start < 0 || des_page_stop > cur_page_stop) ||
-            (rel_row_start < 0 || des_row_stop > cur_row_stop) ||
-            (rel_col_start < 0 || des_col_stop > cur_col_stop))
-        {
-            // copying the local part
-            if ((des_page_start < cur_page_stop &&
-                    des_page_stop > cur_page_start) &&
-                (des_row_start < cur_row_stop &&
-                    des_row_stop > cur_row_start) &&
-                (des_col_start < cur_col_stop && des_col_stop > cur_col_start))
-            {
-                auto page_indices = util::index_calculation_1d(des_page_start,
-                    des_page_stop, cur_page_start, cur_page_stop);
-                auto row_indices = util::index_calculation_1d(
-                    des_row_start, des_row_stop, cur_row_start, cur_row_stop);
-                auto col_indices = util::index_calculation_1d(
-                    des_col_start, des_col_stop, cur_col_start, cur_col_stop);
-
-                blaze::subtensor(result, page_indices.projected_start_,
-                    row_indices.projected_start_, col_indices.projected_start_,
-                    page_indices.intersection_size_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_) = blaze::subtensor(t,
-                    page_indices.local_start_, row_indices.local_start_,
-                    col_indices.local_start_, page_indices.intersection_size_,
-                    row_indices.intersection_size_,
-                    col_indices.intersection_size_);
-            }
-
-            for (std::uint32_t loc = 0; loc != num_localities; ++loc)
-            {
-                if (loc == loc_id)
-                {
-                    continue;
-                }
-
-                // the array span in locality loc
-                tiling_span loc_page_span = arr_localities.tiles_[loc].spans_[0];
-                tiling_span loc_row_span = arr_localities.tiles_[loc].spans_[1];
-                tiling_span loc_col_span = arr_localities.tiles_[loc].spans_[2];
-
-                auto page_indices = util::retile_calculation_1d(
-                    loc_page_span, des_page_start, des_page_stop);
-                auto row_indices = util::retile_calculation_1d(
-                    loc_row_span, des_row_start, des_row_stop);
-                auto col_indices = util::retile_calculation_1d(
-                    loc_col_span, des_col_start, des_col_stop);
-                if (page_indices.intersection_size_ > 0 &&
-                    row_indices.intersection_size_ > 0 &&
-                    col_indices.intersection_size_ > 0)
-                {
-                    // loc_span has the block of result that we need
-                    blaze::subtensor(result, page_indices.projected_start_,
-                        row_indices.projected_start_,
-                        col_indices.projected_start_,
-                        page_indices.intersection_size_,
-                        row_indices.intersection_size_,
-                        col_indices.intersection_size_) =
-                        t_data
-                            .fetch(loc, page_indices.local_start_,
-                                row_indices.local_start_,
-                                col_indices.local_start_,
-                                page_indices.local_start_ +
-                                    page_indices.intersection_size_,
-                                row_indices.local_start_ +
-                                    row_indices.intersection_size_,
-                                col_indices.local_start_ +
-                                    col_indices.intersection_size_)
-                            .get();
-                }
-            }
-        }
-        else // the new array is a subset of the original array
-        {
-            result = blaze::subtensor(t, rel_page_start, rel_row_start,
-                rel_col_start, des_page_size, des_row_size, des_col_size);
-        }
+        blaze::DynamicTensor<T> result =
+            retile_planner::execute_retile_plan<T, 3>(
+                arr_localities.annotation_.generate_name(), arr.tensor(), plan,
+                current, desired, loc_id, &transferred_bytes_);
 
         // updating the tile information
-        tile_info =
-            tiling_information_3d(tiling_span(des_page_start, des_page_stop),
-                tiling_span(des_row_start, des_row_stop),
-                tiling_span(des_col_start, des_col_stop));
+        retile_planner::tile_spans<3> const& des_tile =
+            desired[plan.tile_of_[loc_id]];
+        tiling_information_3d tile_info(des_tile[0], des_tile[1], des_tile[2]);
 
         auto locality_ann = arr_localities.locality_.as_annotation();
         auto attached_annotation =
@@ -935,7 +841,8 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_argument_type&& arr,
         std::string const& tiling_type,
         std::array<std::size_t, PHYLANX_MAX_DIMENSIONS> const& intersection,
-        std::uint32_t numtiles, ir::range&& new_tiling) const
+        std::uint32_t numtiles, ir::range&& new_tiling,
+        bool optimize_placement) const
     {
         using namespace execution_tree;
         execution_tree::localities_information arr_localities =
@@ -947,25 +854,25 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
             return retile3d(
                 extract_boolean_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_int64:
             return retile3d(
                 extract_integer_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_double:
             return retile3d(
                 extract_numeric_value_strict(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         case node_data_type_unknown:
             return retile3d(
                 extract_numeric_value(std::move(arr), name_, codename_),
                 tiling_type, intersection, numtiles, std::move(new_tiling),
-                std::move(arr_localities));
+                optimize_placement, std::move(arr_localities));
 
         default:
             break;
@@ -985,11 +892,11 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
         execution_tree::primitive_arguments_type const& args,
         execution_tree::eval_context ctx) const
     {
-        if (operands.empty() || operands.size() > 5)
+        if (operands.empty() || operands.size() > 6)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter, "retile_annotations::eval",
                 generate_error_message("the retile_d primitive requires at "
-                                       "least one and at most 5 operands"));
+                                       "least one and at most 6 operands"));
         }
 
         if (!valid(operands[0]))
@@ -1125,19 +1032,38 @@ namespace phylanx { namespace dist_matrixops { namespace primitives
                             std::move(args[4]), this_->name_, this_->codename_);
                     }
 
+                    bool optimize_placement = false;
+                    if (valid(args[5]))
+                    {
+                        std::string placement = extract_string_value(
+                            std::move(args[5]), this_->name_, this_->codename_);
+                        if (placement != "fixed" && placement != "local")
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "retile_annotations::eval",
+                                this_->generate_error_message(
+                                    "invalid placement. The placement can be "
+                                    "either `fixed` or `local`"));
+                        }
+                        optimize_placement = (placement == "local");
+                    }
+
                     switch (numdims)
                     {
                     case 1:
                         return this_->retile1d(std::move(args[0]), tiling_type,
-                            intersections[0], numtiles, std::move(new_tiling));
+                            intersections[0], numtiles, std::move(new_tiling),
+                            optimize_placement);
 
                     case 2:
                         return this_->retile2d(std::move(args[0]), tiling_type,
-                            intersections, numtiles, std::move(new_tiling));
+                            intersections, numtiles, std::move(new_tiling),
+                            optimize_placement);
 
                     case 3:
                         return this_->retile3d(std::move(args[0]), tiling_type,
-                            intersections, numtiles, std::move(new_tiling));
+                            intersections, numtiles, std::move(new_tiling),
+                            optimize_placement);
 
                     default:
                         HPX_THROW_EXCEPTION(hpx::bad_parameter,
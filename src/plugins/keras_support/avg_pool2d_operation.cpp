@@ -8,7 +8,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/keras_support/avg_pool2d_operation.hpp>
-#include <phylanx/plugins/keras_support/pool_indices_helper.hpp>
+#include <phylanx/plugins/keras_support/pooling_kernels.hpp>
 
 #include <hpx/datastructures/optional.hpp>
 #include <hpx/include/lcos.hpp>
@@ -61,201 +61,37 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {}
 
     ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type avg_pool2d_operation::avg_pool2d(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width) const
-    {
-        auto q = arg.quatern();
-
-        std::size_t result_height = q.pages() - filter_height + 1;
-        std::size_t result_width  = q.rows() - filter_width + 1;
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        res_slice(r, c) = (blaze::mean)(blaze::submatrix(
-                            slice, r, c, filter_height, filter_width));
-                    }
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
     primitive_argument_type avg_pool2d_operation::avg_pool2d(
         ir::node_data<double>&& arg, std::size_t filter_height,
         std::size_t filter_width, std::size_t stride_height,
-        std::size_t stride_width) const
+        std::size_t stride_width, bool same) const
     {
         auto q = arg.quatern();
 
-        std::size_t result_height = blaze::ceil(
-            static_cast<double>(q.pages() - filter_height + 1) / stride_height);
-        std::size_t result_width =
-            blaze::ceil(static_cast<double>(q.rows() - filter_width + 1) /
-                stride_width);
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
+        std::array<std::vector<detail::pool_window>, 2> windows = {
+            detail::make_pool_windows(
+                q.pages(), filter_height, stride_height, same),
+            detail::make_pool_windows(
+                q.rows(), filter_width, stride_width, same)};
 
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        res_slice(r, c) = (blaze::mean)(
-                            blaze::submatrix(slice, r * stride_height,
-                                c * stride_width, filter_height, filter_width));
-                    }
-                }
-            }
-        }
+        blaze::DynamicArray<4UL, double> result(q.quats(), windows[0].size(),
+            windows[1].size(), q.columns());
 
-        return primitive_argument_type{std::move(result)};
-    }
+        // the channels are the innermost, contiguous axis
+        detail::pool_layout<2> in;
+        in.outer = q.quats();
+        in.channels = q.columns();
+        in.extents = {q.pages(), q.rows()};
+        in.strides = {q.rows() * q.spacing(), q.spacing()};
+        in.outer_stride = q.pages() * in.strides[0];
+        in.channel_stride = 1;
 
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type avg_pool2d_operation::avg_pool2d_same(
-        ir::node_data<double>&& arg,
-         std::size_t filter_height, std::size_t filter_width) const
-    {
-        auto q = arg.quatern();
+        detail::pool_layout<2> out = in;
+        out.strides = {result.rows() * result.spacing(), result.spacing()};
+        out.outer_stride = result.pages() * out.strides[0];
 
-        std::int64_t pad_top = (filter_height - 1) / 2;
-        std::int64_t pad_left = (filter_width - 1) / 2;
-
-        std::size_t nrows = q.pages();
-        std::size_t ncolumns = q.rows();
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, nrows, ncolumns, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-                for (std::size_t r = 0; r != nrows; ++r)
-                {
-                    auto sub_row = pool_indices::get_subsizes(
-                        nrows, filter_height, r - pad_top);
-                    for (std::size_t c = 0; c != ncolumns; ++c)
-                    {
-                        auto sub_column = pool_indices::get_subsizes(
-                            ncolumns, filter_width, c - pad_left);
-
-                        res_slice(r, c) = (blaze::mean)(blaze::submatrix(slice,
-                            sub_row.image_beg_, sub_column.image_beg_,
-                            sub_row.size_, sub_column.size_));
-                    }
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type avg_pool2d_operation::avg_pool2d_same(
-        ir::node_data<double>&& arg, std::size_t filter_height,
-        std::size_t filter_width, std::size_t stride_height,
-        std::size_t stride_width) const
-    {
-        auto q = arg.quatern();
-
-        std::size_t pad_height;
-        std::size_t pad_width;
-
-        std::size_t nrows = q.pages();
-        std::size_t ncolumns = q.rows();
-        std::size_t batch = q.quats();
-        std::size_t channels = q.columns();
-
-        if (nrows % stride_height == 0)
-            pad_height = filter_height > stride_height ?
-                filter_height - stride_height :
-                static_cast<std::size_t>(0);
-        else
-            pad_height = filter_height > (nrows % stride_height) ?
-                filter_height - (nrows % stride_height) :
-                static_cast<std::size_t>(0);
-
-        if (ncolumns % stride_width == 0)
-            pad_width = filter_width > stride_width ?
-                filter_width - stride_width :
-                static_cast<std::size_t>(0);
-        else
-            pad_width = filter_width > (ncolumns % stride_width) ?
-                filter_width - (ncolumns % stride_width) :
-                static_cast<std::size_t>(0);
-
-        std::size_t pad_top  = pad_height / 2;
-        std::size_t pad_left = pad_width  / 2;
-
-        std::size_t result_height = blaze::ceil(
-            static_cast<double>(nrows + pad_height - filter_height + 1) /
-            stride_height);
-        std::size_t result_width = blaze::ceil(
-            static_cast<double>(ncolumns + pad_width - filter_width + 1) /
-            stride_width);
-
-        blaze::DynamicArray<4UL, double> result(
-            batch, result_height, result_width, channels);
-
-        for (std::size_t l = 0; l != batch; ++l)
-        {
-            auto res_tensor = blaze::quatslice(result, l);
-            auto t = blaze::quatslice(q, l);
-            for (std::size_t j = 0; j != channels; ++j)
-            {
-                auto res_slice = blaze::columnslice(res_tensor, j);
-                auto slice = blaze::columnslice(t, j);
-                for (std::size_t r = 0; r != result_height; ++r)
-                {
-                    auto sub_row = pool_indices::get_subsizes(
-                        nrows, filter_height, r * stride_height - pad_top);
-                    for (std::size_t c = 0; c != result_width; ++c)
-                    {
-                        auto sub_column = pool_indices::get_subsizes(ncolumns,
-                            filter_width, c * stride_width - pad_left);
-
-                        res_slice(r, c) = (blaze::mean)(blaze::submatrix(slice,
-                            sub_row.image_beg_, sub_column.image_beg_,
-                            sub_row.size_, sub_column.size_));
-                    }
-                }
-            }
-        }
+        detail::pool<detail::pool_avg>(
+            q.data(), in, result.data(), out, windows);
 
         return primitive_argument_type{std::move(result)};
     }
@@ -265,11 +101,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         ir::node_data<double>&& arg, std::size_t filter_height,
         std::size_t filter_width, std::string&& padding) const
     {
-        if (padding == "valid")
-            return avg_pool2d(std::move(arg), filter_height, filter_width);
-
-        // padding == "same"
-        return avg_pool2d_same(std::move(arg), filter_height, filter_width);
+        return avg_pool2d(std::move(arg), filter_height, filter_width, 1,
+            1, padding == "same");
     }
 
     primitive_argument_type avg_pool2d_operation::avg_pool_any_pad(
@@ -277,13 +110,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::size_t filter_width, std::string&& padding,
         std::size_t stride_height, std::size_t stride_width) const
     {
-        if (padding == "valid")
-            return avg_pool2d(std::move(arg), filter_height, filter_width,
-                stride_height, stride_width);
-
-        // padding == "same"
-        return avg_pool2d_same(std::move(arg), filter_height, filter_width,
-            stride_height, stride_width);
+        return avg_pool2d(std::move(arg), filter_height, filter_width,
+            stride_height, stride_width, padding == "same");
     }
 
     ///////////////////////////////////////////////////////////////////////////
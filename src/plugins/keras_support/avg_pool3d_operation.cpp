@@ -8,7 +8,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/keras_support/avg_pool3d_operation.hpp>
-#include <phylanx/plugins/keras_support/pool_indices_helper.hpp>
+#include <phylanx/plugins/keras_support/pooling_kernels.hpp>
 
 #include <hpx/datastructures/optional.hpp>
 #include <hpx/include/lcos.hpp>
@@ -63,190 +63,39 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {}
 
     ///////////////////////////////////////////////////////////////////////////
-    template <typename Tensor>
-    double avg_pool3d_operation::mean(const Tensor& t) const
-    {
-        return blaze::sum(t) / static_cast<double>(blaze::size(t));
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type avg_pool3d_operation::avg_pool3d(
-        ir::node_data<double>&& arg, std::size_t filter_depth,
-        std::size_t filter_height, std::size_t filter_width) const
-    {
-        auto t = arg.tensor();
-
-        std::size_t result_depth  = t.pages() - filter_depth + 1;
-        std::size_t result_height = t.rows() - filter_height + 1;
-        std::size_t result_width  = t.columns() - filter_width + 1;
-
-        blaze::DynamicTensor<double> result(
-            result_depth, result_height, result_width);
-
-        for (std::size_t p = 0; p != result_depth; ++p)
-        {
-            for (std::size_t r = 0; r != result_height; ++r)
-            {
-                for (std::size_t c = 0; c != result_width; ++c)
-                {
-                    result(p, r, c) = mean(blaze::subtensor(
-                        t, p, r, c, filter_depth, filter_height, filter_width));
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
     primitive_argument_type avg_pool3d_operation::avg_pool3d(
         ir::node_data<double>&& arg, std::size_t filter_depth,
         std::size_t filter_height, std::size_t filter_width,
         std::size_t stride_depth, std::size_t stride_height,
-        std::size_t stride_width) const
+        std::size_t stride_width, bool same) const
     {
         auto t = arg.tensor();
 
-        std::size_t result_depth = blaze::ceil(
-            static_cast<double>(t.pages() - filter_depth + 1) / stride_depth);
-        std::size_t result_height = blaze::ceil(
-            static_cast<double>(t.rows() - filter_height + 1) / stride_height);
-        std::size_t result_width = blaze::ceil(
-            static_cast<double>(t.columns() - filter_width + 1) / stride_width);
+        std::array<std::vector<detail::pool_window>, 3> windows = {
+            detail::make_pool_windows(
+                t.pages(), filter_depth, stride_depth, same),
+            detail::make_pool_windows(
+                t.rows(), filter_height, stride_height, same),
+            detail::make_pool_windows(
+                t.columns(), filter_width, stride_width, same)};
 
         blaze::DynamicTensor<double> result(
-            result_depth, result_height, result_width);
+            windows[0].size(), windows[1].size(), windows[2].size());
 
-        for (std::size_t p = 0; p != result_depth; ++p)
-        {
-            for (std::size_t r = 0; r != result_height; ++r)
-            {
-                for (std::size_t c = 0; c != result_width; ++c)
-                {
-                    result(p, r, c) = mean(blaze::subtensor(t,
-                        p * stride_depth, r * stride_height, c * stride_width,
-                        filter_depth, filter_height, filter_width));
-                }
-            }
-        }
+        // a tensor has a single channel
+        detail::pool_layout<3> in;
+        in.outer = 1;
+        in.channels = 1;
+        in.extents = {t.pages(), t.rows(), t.columns()};
+        in.strides = {t.rows() * t.spacing(), t.spacing(), 1};
+        in.outer_stride = 0;
+        in.channel_stride = 1;
 
-        return primitive_argument_type{std::move(result)};
-    }
+        detail::pool_layout<3> out = in;
+        out.strides = {result.rows() * result.spacing(), result.spacing(), 1};
 
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type avg_pool3d_operation::avg_pool3d_same(
-        ir::node_data<double>&& arg, std::size_t filter_depth,
-        std::size_t filter_height, std::size_t filter_width) const
-    {
-        auto t = arg.tensor();
-
-        std::int64_t pad_front = (filter_depth  - 1) / 2;
-        std::int64_t pad_top   = (filter_height - 1) / 2;
-        std::int64_t pad_left  = (filter_width  - 1) / 2;
-
-        std::size_t npages   = t.pages();
-        std::size_t nrows    = t.rows();
-        std::size_t ncolumns = t.columns();
-
-        blaze::DynamicTensor<double> result(npages, nrows, ncolumns);
-
-        for (std::size_t p = 0; p != npages; ++p)
-        {
-            auto sub_page =
-                pool_indices::get_subsizes(npages, filter_depth, p - pad_front);
-            for (std::size_t r = 0; r != nrows; ++r)
-            {
-                auto sub_row = pool_indices::get_subsizes(
-                    nrows, filter_height, r - pad_top);
-                for (std::size_t c = 0; c != ncolumns; ++c)
-                {
-                    auto sub_column = pool_indices::get_subsizes(
-                        ncolumns, filter_width, c - pad_left);
-
-                    result(p, r, c) =
-                        mean(blaze::subtensor(t, sub_page.image_beg_,
-                            sub_row.image_beg_, sub_column.image_beg_,
-                            sub_page.size_, sub_row.size_, sub_column.size_));
-                }
-            }
-        }
-
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type avg_pool3d_operation::avg_pool3d_same(
-        ir::node_data<double>&& arg, std::size_t filter_depth,
-        std::size_t filter_height, std::size_t filter_width,
-        std::size_t stride_depth, std::size_t stride_height,
-        std::size_t stride_width) const
-    {
-        auto t = arg.tensor();
-
-        std::size_t pad_depth;
-        std::size_t pad_height;
-        std::size_t pad_width;
-
-        std::size_t npages   = t.pages();
-        std::size_t nrows    = t.rows();
-        std::size_t ncolumns = t.columns();
-
-        if (npages % stride_depth == 0)
-            pad_depth = (blaze::max)(
-                filter_depth - stride_depth, static_cast<std::size_t>(0));
-        else
-            pad_depth = (blaze::max)(filter_depth - (npages % stride_depth),
-                static_cast<std::size_t>(0));
-
-        if (nrows % stride_height == 0)
-            pad_height = (blaze::max)(
-                filter_height - stride_height, static_cast<std::size_t>(0));
-        else
-            pad_height = (blaze::max)(filter_height - (nrows % stride_height),
-                static_cast<std::size_t>(0));
-
-        if (ncolumns % stride_width == 0)
-            pad_width = (blaze::max)(
-                filter_width - stride_width, static_cast<std::size_t>(0));
-        else
-            pad_width = (blaze::max)(filter_width - (ncolumns % stride_width),
-                static_cast<std::size_t>(0));
-
-        std::size_t pad_front = pad_depth  / 2;
-        std::size_t pad_top   = pad_height / 2;
-        std::size_t pad_left  = pad_width  / 2;
-
-        std::size_t result_depth = blaze::ceil(
-            static_cast<double>(npages + pad_depth - filter_depth + 1) /
-            stride_depth);
-        std::size_t result_height = blaze::ceil(
-            static_cast<double>(nrows + pad_height - filter_height + 1) /
-            stride_height);
-        std::size_t result_width = blaze::ceil(
-            static_cast<double>(ncolumns + pad_width - filter_width + 1) /
-            stride_width);
-
-        blaze::DynamicTensor<double> result(
-            result_depth, result_height, result_width);
-
-        for (std::size_t p = 0; p != result_depth; ++p)
-        {
-            auto sub_page = pool_indices::get_subsizes(
-                npages, filter_depth, p * stride_depth - pad_front);
-            for (std::size_t r = 0; r != result_height; ++r)
-            {
-                auto sub_row = pool_indices::get_subsizes(
-                    nrows, filter_height, r * stride_height - pad_top);
-                for (std::size_t c = 0; c != result_width; ++c)
-                {
-                    auto sub_column = pool_indices::get_subsizes(
-                        ncolumns, filter_width, c * stride_width - pad_left);
-
-                    result(p, r, c) =
-                        mean(blaze::subtensor(t, sub_page.image_beg_,
-                            sub_row.image_beg_, sub_column.image_beg_,
-                            sub_page.size_, sub_row.size_, sub_column.size_));
-                }
-            }
-        }
+        detail::pool<detail::pool_avg>(
+            t.data(), in, result.data(), out, windows);
 
         return primitive_argument_type{std::move(result)};
     }
@@ -257,13 +106,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::size_t filter_height, std::size_t filter_width,
         std::string&& padding) const
     {
-        if (padding == "valid")
-            return avg_pool3d(
-                std::move(arg), filter_depth, filter_height, filter_width);
-
-        // padding == "same"
-        return avg_pool3d_same(
-            std::move(arg), filter_depth, filter_height, filter_width);
+        return avg_pool3d(std::move(arg), filter_depth, filter_height,
+            filter_width, 1, 1, 1, padding == "same");
     }
 
     primitive_argument_type avg_pool3d_operation::avg_pool_any_pad(
@@ -272,13 +116,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::string&& padding, std::size_t stride_depth,
         std::size_t stride_height, std::size_t stride_width) const
     {
-        if (padding == "valid")
-            return avg_pool3d(std::move(arg), filter_depth, filter_height,
-                filter_width, stride_depth, stride_height, stride_width);
-
-        // padding == "same"
-        return avg_pool3d_same(std::move(arg), filter_depth, filter_height,
-            filter_width, stride_depth, stride_height, stride_width);
+        return avg_pool3d(std::move(arg), filter_depth, filter_height,
+            filter_width, stride_depth, stride_height, stride_width,
+            padding == "same");
     }
 
     ///////////////////////////////////////////////////////////////////////////
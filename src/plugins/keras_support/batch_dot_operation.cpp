@@ -8,6 +8,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/keras_support/batch_dot_operation.hpp>
+#include <phylanx/util/batched_gemm.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -19,6 +20,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -171,6 +173,27 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return true;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // the pages of a tensor as a batch of matrices
+        template <typename Tensor,
+            typename T = std::remove_reference_t<decltype(
+                *std::declval<Tensor&>().data())>>
+        util::strided_matrices<T> batch_dot_pages(Tensor& t)
+        {
+            return {t.data(), t.rows() * t.spacing(), t.spacing(), 1};
+        }
+
+        template <typename Tensor,
+            typename T = std::remove_reference_t<decltype(
+                *std::declval<Tensor&>().data())>>
+        util::strided_matrices<T> batch_dot_transposed_pages(Tensor& t)
+        {
+            return {t.data(), t.rows() * t.spacing(), 1, t.spacing()};
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
     primitive_argument_type batch_dot_operation::batch_dot2d2d(
@@ -181,10 +204,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(m1.rows(), 1);
 
-        for (std::size_t i = 0; i != m1.rows(); ++i)
-
-            blaze::row(result, i) =
-                blaze::dot(blaze::row(m1, i), blaze::row(m2, i));
+        // row i of m1 times the transposed row i of m2
+        util::batched_gemm<T>(m1.rows(), 1, 1, m1.columns(),
+            {m1.data(), m1.spacing(), 0, 1}, {m2.data(), m2.spacing(), 1, 0},
+            {result.data(), result.spacing(), 0, 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -198,9 +221,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(t.pages(), t.columns());
 
-        for (std::size_t i = 0; i != m.rows(); ++i)
-
-            blaze::row(result, i) = blaze::row(m, i) * blaze::pageslice(t, i);
+        // row i of m times page i of t
+        util::batched_gemm<T>(t.pages(), 1, t.columns(), t.rows(),
+            {m.data(), m.spacing(), 0, 1},
+            {t.data(), t.rows() * t.spacing(), t.spacing(), 1},
+            {result.data(), result.spacing(), 0, 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -214,9 +239,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(t.pages(), t.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::row(result, i) =
-                blaze::row(m, i) * blaze::trans(blaze::pageslice(t, i));
+        // row i of m times the transposed page i of t
+        util::batched_gemm<T>(t.pages(), 1, t.rows(), t.columns(),
+            {m.data(), m.spacing(), 0, 1},
+            {t.data(), t.rows() * t.spacing(), 1, t.spacing()},
+            {result.data(), result.spacing(), 0, 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -288,10 +315,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(t.pages(), t.rows());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-
-            blaze::row(result, i) =
-                blaze::row(m, i) * blaze::trans(blaze::pageslice(t, i));
+        // row i of m times the transposed page i of t
+        util::batched_gemm<T>(t.pages(), 1, t.rows(), t.columns(),
+            {m.data(), m.spacing(), 0, 1},
+            {t.data(), t.rows() * t.spacing(), 1, t.spacing()},
+            {result.data(), result.spacing(), 0, 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -305,8 +333,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicMatrix<T> result(t.pages(), t.columns());
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::row(result, i) = blaze::row(m, i) * blaze::pageslice(t, i);
+        // row i of m times page i of t
+        util::batched_gemm<T>(t.pages(), 1, t.columns(), t.rows(),
+            {m.data(), m.spacing(), 0, 1},
+            {t.data(), t.rows() * t.spacing(), t.spacing(), 1},
+            {result.data(), result.spacing(), 0, 1});
 
         return primitive_argument_type{std::move(result)};
     }
@@ -334,10 +365,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.rows(), t2.columns());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::pageslice(t1, i) * blaze::pageslice(t2, i);
+        util::batched_gemm<T>(t1.pages(), t1.rows(), t2.columns(),
+            t1.columns(), detail::batch_dot_pages(t1),
+            detail::batch_dot_pages(t2), detail::batch_dot_pages(result));
 
         return primitive_argument_type{std::move(result)};
     }
@@ -351,10 +381,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.columns(), t2.columns());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::trans(blaze::pageslice(t1, i)) * blaze::pageslice(t2, i);
+        util::batched_gemm<T>(t1.pages(), t1.columns(), t2.columns(),
+            t1.rows(), detail::batch_dot_transposed_pages(t1),
+            detail::batch_dot_pages(t2), detail::batch_dot_pages(result));
 
         return primitive_argument_type{std::move(result)};
     }
@@ -368,10 +397,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.rows(), t2.rows());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::pageslice(t1, i) * blaze::trans(blaze::pageslice(t2, i));
+        util::batched_gemm<T>(t1.pages(), t1.rows(), t2.rows(), t1.columns(),
+            detail::batch_dot_pages(t1), detail::batch_dot_transposed_pages(t2),
+            detail::batch_dot_pages(result));
 
         return primitive_argument_type{std::move(result)};
     }
@@ -385,10 +413,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         blaze::DynamicTensor<T> result(t1.pages(), t1.columns(), t2.rows());
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::trans(blaze::pageslice(t2, i) * blaze::pageslice(t1, i));
+        // trans(t2 * t1) == trans(t1) * trans(t2)
+        util::batched_gemm<T>(t1.pages(), t1.columns(), t2.rows(), t1.rows(),
+            detail::batch_dot_transposed_pages(t1),
+            detail::batch_dot_transposed_pages(t2),
+            detail::batch_dot_pages(result));
 
         return primitive_argument_type{std::move(result)};
     }
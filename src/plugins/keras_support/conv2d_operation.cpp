@@ -9,6 +9,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/keras_support/conv2d_operation.hpp>
 #include <phylanx/plugins/keras_support/conv_indices_helper.hpp>
+#include <phylanx/util/permute_axes.hpp>
 
 #include <hpx/datastructures/optional.hpp>
 #include <hpx/include/lcos.hpp>
@@ -89,9 +90,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         blaze::DynamicArray<4UL, double> result(
             batch, res_height, res_width, out_channels);
 
+        // the filters of every output channel are contiguous
+        auto const k_t = util::permute_axes(k, {3, 0, 1, 2});
+
         for (std::size_t c = 0; c != out_channels; ++c)
         {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
+            auto k_tensor = blaze::quatslice(k_t, c);
             auto res_tensor =
                 blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
             for (std::size_t l = 0; l != batch; ++l)
@@ -137,9 +141,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         blaze::DynamicArray<4UL, double> result(
             batch, res_height, res_width, out_channels);
 
+        auto const k_t = util::permute_axes(k, {3, 0, 1, 2});
+
         for (std::size_t c = 0; c != out_channels; ++c)
         {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
+            auto k_tensor = blaze::quatslice(k_t, c);
             auto res_tensor =
                 blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
             for (std::size_t l = 0; l != batch; ++l)
@@ -191,9 +197,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         blaze::DynamicArray<4UL, double> result(
             batch, res_height, res_width, out_channels);
 
+        auto const k_t = util::permute_axes(k, {3, 0, 1, 2});
+
         for (std::size_t c = 0; c != out_channels; ++c)
         {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
+            auto k_tensor = blaze::quatslice(k_t, c);
             auto res_tensor =
                 blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
             for (std::size_t l = 0; l != batch; ++l)
@@ -238,9 +246,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         blaze::DynamicArray<4UL, double> result(
             batch, in_height, in_width, out_channels);
 
+        auto const k_t = util::permute_axes(k, {3, 0, 1, 2});
+
         for (std::size_t c = 0; c != out_channels; ++c)
         {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
+            auto k_tensor = blaze::quatslice(k_t, c);
             auto res_tensor =
                 blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
             for (std::size_t l = 0; l != batch; ++l)
@@ -325,9 +335,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::int64_t pad_top  = pad_height / 2;
         std::int64_t pad_left = pad_width / 2;
 
+        auto const k_t = util::permute_axes(k, {3, 0, 1, 2});
+
         for (std::size_t c = 0; c != out_channels; ++c)
         {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
+            auto k_tensor = blaze::quatslice(k_t, c);
             auto res_tensor =
                 blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
             for (std::size_t l = 0; l != batch; ++l)
@@ -378,9 +390,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         blaze::DynamicArray<4UL, double> result(blaze::init_from_value, 0.0,
             batch, in_height, in_width, out_channels);
 
+        auto const k_t = util::permute_axes(k, {3, 0, 1, 2});
+
         for (std::size_t c = 0; c != out_channels; ++c)
         {
-            auto k_tensor = blaze::quatslice(blaze::trans(k, {3, 0, 1, 2}), c);
+            auto k_tensor = blaze::quatslice(k_t, c);
             auto res_tensor =
                 blaze::quatslice(blaze::trans(result, {3, 0, 1, 2}), c);
             for (std::size_t l = 0; l != batch; ++l)
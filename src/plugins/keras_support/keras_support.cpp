@@ -58,7 +58,11 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(separable_conv1d_operation_plugin,
 PHYLANX_REGISTER_PLUGIN_FACTORY(sigmoid_operation_plugin,
     phylanx::execution_tree::primitives::sigmoid_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(softmax_operation_plugin,
-    phylanx::execution_tree::primitives::softmax_operation::match_data);
+    phylanx::execution_tree::primitives::softmax_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(log_softmax_operation_plugin,
+    phylanx::execution_tree::primitives::softmax_operation::match_data[1]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(softmax_cross_entropy_operation_plugin,
+    phylanx::execution_tree::primitives::softmax_cross_entropy_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(softplus_operation_plugin,
     phylanx::execution_tree::primitives::softplus_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(softsign_operation_plugin,
@@ -0,0 +1,343 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/keras_support/softmax_cross_entropy_operation.hpp>
+#include <phylanx/plugins/keras_support/softmax_kernels.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/errors/throw_exception.hpp>
+#include <hpx/modules/format.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const softmax_cross_entropy_operation::match_data =
+    {
+        hpx::make_tuple("softmax_cross_entropy_with_logits",
+        std::vector<std::string>{
+            "softmax_cross_entropy_with_logits(_1_labels, _2_logits, "
+                "__arg(_3_axis, -1))"
+        },
+        &create_softmax_cross_entropy_operation,
+        &create_primitive<softmax_cross_entropy_operation>,
+        R"(labels, logits, axis
+        Args:
+
+            labels (array_like) : the labels, of the same shape as `logits`
+            logits (array_like) : unscaled log probabilities
+            axis (optional, integer): the class axis, the default is the last
+                axis (axis == -1) of the arrays
+
+        Returns:
+
+        A list holding the cross entropy loss `-sum(labels *
+        log_softmax(logits), axis)` (an array with one dimension less than
+        `logits`) and the gradient of the loss with respect to the logits,
+        `softmax(logits) * sum(labels, axis) - labels`. Both are computed
+        from a single pass over the logits without forming the softmax.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    softmax_cross_entropy_operation::softmax_cross_entropy_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename Labels, typename Logits, typename Gradient>
+        void softmax_cross_entropy_array(std::size_t num_dims,
+            std::array<std::size_t, 4> const& extents, std::size_t axis,
+            Labels const& labels, std::size_t labels_spacing,
+            Logits const& logits, std::size_t logits_spacing, double* loss,
+            Gradient& gradient, std::size_t gradient_spacing)
+        {
+            softmax_cross_entropy(labels.data(),
+                make_softmax_layout(num_dims, extents, labels_spacing, axis),
+                logits.data(),
+                make_softmax_layout(num_dims, extents, logits_spacing, axis),
+                loss, gradient.data(),
+                make_softmax_layout(
+                    num_dims, extents, gradient_spacing, axis));
+        }
+
+        // the loss is computed in row major order of the array with the
+        // given axis removed
+        primitive_argument_type softmax_cross_entropy_loss(
+            blaze::DynamicVector<double>&& loss, std::size_t num_dims,
+            std::array<std::size_t, 4> const& extents, std::size_t axis)
+        {
+            std::array<std::size_t, 3> reduced = {1, 1, 1};
+            for (std::size_t j = 0, k = 0; j != num_dims; ++j)
+            {
+                if (j != axis)
+                {
+                    reduced[k++] = extents[j];
+                }
+            }
+
+            switch (num_dims)
+            {
+            case 1:
+                return primitive_argument_type{loss[0]};
+
+            case 2:
+                return primitive_argument_type{std::move(loss)};
+
+            case 3:
+                {
+                    blaze::DynamicMatrix<double> result(
+                        reduced[0], reduced[1]);
+                    for (std::size_t i = 0; i != reduced[0]; ++i)
+                    {
+                        for (std::size_t j = 0; j != reduced[1]; ++j)
+                        {
+                            result(i, j) = loss[i * reduced[1] + j];
+                        }
+                    }
+                    return primitive_argument_type{std::move(result)};
+                }
+
+            default:
+                break;
+            }
+
+            blaze::DynamicTensor<double> result(
+                reduced[0], reduced[1], reduced[2]);
+            for (std::size_t k = 0; k != reduced[0]; ++k)
+            {
+                for (std::size_t i = 0; i != reduced[1]; ++i)
+                {
+                    for (std::size_t j = 0; j != reduced[2]; ++j)
+                    {
+                        result(k, i, j) =
+                            loss[(k * reduced[1] + i) * reduced[2] + j];
+                    }
+                }
+            }
+            return primitive_argument_type{std::move(result)};
+        }
+
+        primitive_argument_type softmax_cross_entropy_result(
+            primitive_argument_type&& loss, primitive_argument_type&& gradient)
+        {
+            primitive_arguments_type both{std::move(loss), std::move(gradient)};
+            return primitive_argument_type{phylanx::ir::range(std::move(both))};
+        }
+    }
+
+    // the gradient is written to the logits if those are not shared with
+    // other parts of the expression tree
+    primitive_argument_type
+    softmax_cross_entropy_operation::softmax_cross_entropy(arg_type&& labels,
+        arg_type&& logits, std::int64_t axis) const
+    {
+        std::size_t const dims = logits.num_dimensions();
+        if (labels.dimensions() != logits.dimensions())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_cross_entropy_operation::softmax_cross_entropy",
+                generate_error_message(
+                    "the labels and the logits must have the same shape"));
+        }
+
+        // the softmax of a single element is always one
+        if (dims == 0)
+        {
+            return detail::softmax_cross_entropy_result(
+                primitive_argument_type{0.0}, primitive_argument_type{0.0});
+        }
+
+        if (axis < -std::int64_t(dims) || axis >= std::int64_t(dims))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_cross_entropy_operation::softmax_cross_entropy",
+                generate_error_message(hpx::util::format(
+                    "axis {:d} is out of bounds for an array of dimension "
+                    "{:d}",
+                    axis, dims)));
+        }
+
+        std::size_t const real_axis =
+            std::size_t(axis < 0 ? axis + std::int64_t(dims) : axis);
+
+        std::array<std::size_t, 4> extents = {1, 1, 1, 1};
+        for (std::size_t j = 0; j != dims; ++j)
+        {
+            extents[j] = logits.dimension(int(j));
+        }
+
+        blaze::DynamicVector<double> loss(
+            logits.size() / extents[real_axis]);
+
+        primitive_argument_type gradient;
+        switch (dims)
+        {
+        case 1:
+            {
+                auto t = labels.vector();
+                auto x = logits.vector();
+                if (!logits.is_ref())
+                {
+                    detail::softmax_cross_entropy_array(dims, extents,
+                        real_axis, t, 1, x, 1, loss.data(), x, 1);
+                    gradient = primitive_argument_type{std::move(logits)};
+                    break;
+                }
+
+                blaze::DynamicVector<val_type> g(x.size());
+                detail::softmax_cross_entropy_array(dims, extents, real_axis,
+                    t, 1, x, 1, loss.data(), g, 1);
+                gradient = primitive_argument_type{std::move(g)};
+            }
+            break;
+
+        case 2:
+            {
+                auto t = labels.matrix();
+                auto x = logits.matrix();
+                if (!logits.is_ref())
+                {
+                    detail::softmax_cross_entropy_array(dims, extents,
+                        real_axis, t, t.spacing(), x, x.spacing(),
+                        loss.data(), x, x.spacing());
+                    gradient = primitive_argument_type{std::move(logits)};
+                    break;
+                }
+
+                blaze::DynamicMatrix<val_type> g(x.rows(), x.columns());
+                detail::softmax_cross_entropy_array(dims, extents, real_axis,
+                    t, t.spacing(), x, x.spacing(), loss.data(), g,
+                    g.spacing());
+                gradient = primitive_argument_type{std::move(g)};
+            }
+            break;
+
+        case 3:
+            {
+                auto t = labels.tensor();
+                auto x = logits.tensor();
+                if (!logits.is_ref())
+                {
+                    detail::softmax_cross_entropy_array(dims, extents,
+                        real_axis, t, t.spacing(), x, x.spacing(),
+                        loss.data(), x, x.spacing());
+                    gradient = primitive_argument_type{std::move(logits)};
+                    break;
+                }
+
+                blaze::DynamicTensor<val_type> g(
+                    x.pages(), x.rows(), x.columns());
+                detail::softmax_cross_entropy_array(dims, extents, real_axis,
+                    t, t.spacing(), x, x.spacing(), loss.data(), g,
+                    g.spacing());
+                gradient = primitive_argument_type{std::move(g)};
+            }
+            break;
+
+        case 4:
+            {
+                auto t = labels.quatern();
+                auto x = logits.quatern();
+                if (!logits.is_ref())
+                {
+                    detail::softmax_cross_entropy_array(dims, extents,
+                        real_axis, t, t.spacing(), x, x.spacing(),
+                        loss.data(), x, x.spacing());
+                    gradient = primitive_argument_type{std::move(logits)};
+                    break;
+                }
+
+                blaze::DynamicArray<4UL, val_type> g(
+                    x.quats(), x.pages(), x.rows(), x.columns());
+                detail::softmax_cross_entropy_array(dims, extents, real_axis,
+                    t, t.spacing(), x, x.spacing(), loss.data(), g,
+                    g.spacing());
+                gradient = primitive_argument_type{std::move(g)};
+            }
+            break;
+
+        default:
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_cross_entropy_operation::softmax_cross_entropy",
+                generate_error_message(
+                    "the logits have an unsupported number of dimensions"));
+        }
+
+        return detail::softmax_cross_entropy_result(
+            detail::softmax_cross_entropy_loss(
+                std::move(loss), dims, extents, real_axis),
+            std::move(gradient));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type>
+    softmax_cross_entropy_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() != 2 && operands.size() != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_cross_entropy_operation::eval",
+                generate_error_message(
+                    "the softmax_cross_entropy_with_logits primitive "
+                    "requires two or three operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_cross_entropy_operation::eval",
+                generate_error_message(
+                    "the softmax_cross_entropy_with_logits primitive "
+                    "requires that the arguments given by the operands "
+                    "array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                    -> primitive_argument_type
+                {
+                    std::int64_t axis = -1;
+                    if (args.size() == 3 && valid(args[2]))
+                    {
+                        axis = extract_scalar_integer_value_strict(
+                            std::move(args[2]), this_->name_,
+                            this_->codename_);
+                    }
+
+                    return this_->softmax_cross_entropy(
+                        extract_numeric_value(std::move(args[0]),
+                            this_->name_, this_->codename_),
+                        extract_numeric_value(std::move(args[1]),
+                            this_->name_, this_->codename_),
+                        axis);
+                }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args, name_, codename_,
+                std::move(ctx)));
+    }
+}}}
@@ -6,13 +6,16 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/keras_support/softmax_kernels.hpp>
 #include <phylanx/plugins/keras_support/softmax_operation.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/errors/throw_exception.hpp>
+#include <hpx/modules/format.hpp>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -27,7 +30,7 @@
 namespace phylanx { namespace execution_tree { namespace primitives
 {
     ///////////////////////////////////////////////////////////////////////////
-    match_pattern_type const softmax_operation::match_data =
+    match_pattern_type const softmax_operation::match_data[2] =
     {
         hpx::make_tuple("softmax",
         std::vector<std::string>{
@@ -47,335 +50,166 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         Returns an array of the same shape which is the normalized exponential
         function of the given array.  The resulting array consists of real
-        values in the range (0..1], which add up to 1 in direction of the given axis)")
+        values in the range (0..1], which add up to 1 in direction of the given axis)"),
+
+        hpx::make_tuple("log_softmax",
+        std::vector<std::string>{
+            "log_softmax(_1)",
+            "log_softmax(_1,_2)"
+        },
+        &create_log_softmax_operation, &create_primitive<softmax_operation>,
+        R"(a, axis
+        Args:
+
+            a (array_like) : input array
+            axis (optional, integer): an axis to softmax along. The
+                default is the last axis (axis == -1) of an array. Axis
+                is effective for >1d arrays.
+
+        Returns:
+
+        Returns an array of the same shape which is the logarithm of the
+        softmax of the given array, computed as `a - logsumexp(a)` along the
+        given axis without forming the softmax itself)")
     };
 
     ///////////////////////////////////////////////////////////////////////////
     softmax_operation::softmax_operation(primitive_arguments_type&& operands,
         std::string const& name, std::string const& codename)
       : primitive_component_base(std::move(operands), name, codename)
+      , log_softmax_(compiler::extract_primitive_name(name_) == "log_softmax")
     {}
 
     primitive_argument_type softmax_operation::softmax0d() const
     {
-        return primitive_argument_type{static_cast<double>(1.)};
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type softmax_operation::softmax1d(arg_type&& arg) const
-    {
-        if (!arg.is_ref())
-        {
-            arg.vector() = blaze::softmax(arg.vector());
-            return primitive_argument_type{std::move(arg)};
-        }
-        return primitive_argument_type{blaze::softmax(arg.vector())};
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type softmax_operation::softmax2d_axis0(
-        arg_type&& arg) const
-    {
-        if (!arg.is_ref())
-        {
-            arg.matrix() = blaze::softmax<blaze::columnwise>(arg.matrix());
-            return primitive_argument_type{std::move(arg)};
-        }
         return primitive_argument_type{
-            blaze::softmax<blaze::columnwise>(arg.matrix())};
+            static_cast<double>(log_softmax_ ? 0. : 1.)};
     }
 
-    primitive_argument_type softmax_operation::softmax2d_axis1(
-        arg_type&& arg) const
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
     {
-        if (!arg.is_ref())
+        template <typename Source, typename Dest>
+        void softmax_array(std::size_t num_dims,
+            std::array<std::size_t, 4> const& extents, std::size_t axis,
+            Source const& src, std::size_t src_spacing, Dest& dst,
+            std::size_t dst_spacing, bool log_softmax)
         {
-            arg.matrix() = blaze::softmax<blaze::rowwise>(arg.matrix());
-            return primitive_argument_type{std::move(arg)};
+            softmax(src.data(),
+                make_softmax_layout(num_dims, extents, src_spacing, axis),
+                dst.data(),
+                make_softmax_layout(num_dims, extents, dst_spacing, axis),
+                log_softmax);
         }
-        return primitive_argument_type{
-            blaze::softmax<blaze::rowwise>(arg.matrix())};
     }
 
-    primitive_argument_type softmax_operation::softmax2d(
+    // the result is written to the argument if it is not shared with other
+    // parts of the expression tree
+    primitive_argument_type softmax_operation::softmaxnd(
         arg_type&& arg, std::int64_t axis) const
     {
-        switch (axis)
+        // the axis is ignored for vectors
+        std::size_t const dims = arg.num_dimensions();
+        if (dims == 1)
         {
-        case -2: [[fallthrough]];
-        case 0:
-            return softmax2d_axis0(std::move(arg));
-
-        case -1: [[fallthrough]];
-        case 1:
-            return softmax2d_axis1(std::move(arg));
-
-        default:
-            break;
+            axis = 0;
         }
-        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "softmax_operation::softmax2d",
-            generate_error_message(
-                "the softmax_operation primitive requires operand axis "
-                "to be between -2 and 1 for matrices."));
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type softmax_operation::softmax3d_axis0(
-        arg_type&& arg) const
-    {
-        auto t = arg.tensor();
-        if (!arg.is_ref())
+        else if (axis < -std::int64_t(dims) || axis >= std::int64_t(dims))
         {
-            for (std::size_t i = 0; i != t.rows(); ++i)
-            {
-                blaze::rowslice(t, i) =
-                    blaze::softmax<blaze::rowwise>(blaze::rowslice(t, i));
-            }
-            return primitive_argument_type{std::move(arg)};
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_operation::softmaxnd",
+                generate_error_message(hpx::util::format(
+                    "the softmax_operation primitive requires operand axis "
+                    "to be between {:d} and {:d} for {:d}d arrays.",
+                    -std::int64_t(dims), dims - 1, dims)));
         }
 
-        blaze::DynamicTensor<val_type> result(t.pages(), t.rows(), t.columns());
-        for (std::size_t i = 0; i != t.rows(); ++i)
-        {
-            auto slice = blaze::rowslice(t, i);
-            blaze::rowslice(result, i) = blaze::softmax<blaze::rowwise>(slice);
-        }
-        return primitive_argument_type{std::move(result)};
-    }
+        std::size_t const real_axis =
+            std::size_t(axis < 0 ? axis + std::int64_t(dims) : axis);
 
-    primitive_argument_type softmax_operation::softmax3d_axis1(
-        arg_type&& arg) const
-    {
-        auto t = arg.tensor();
-        if (!arg.is_ref())
+        switch (dims)
         {
-            for (std::size_t i = 0; i != t.columns(); ++i)
+        case 1:
             {
-                blaze::columnslice(t, i) =
-                    blaze::softmax<blaze::rowwise>(blaze::columnslice(t, i));
-            }
-            return primitive_argument_type{std::move(arg)};
-        }
-
-        blaze::DynamicTensor<val_type> result(t.pages(), t.rows(), t.columns());
-        for (std::size_t i = 0; i != t.columns(); ++i)
-        {
-            auto slice = blaze::columnslice(t, i);
-            blaze::columnslice(result, i) = blaze::softmax<blaze::rowwise>(slice);
-        }
-        return primitive_argument_type{std::move(result)};
-    }
+                auto v = arg.vector();
+                std::array<std::size_t, 4> const extents = {v.size()};
+                if (!arg.is_ref())
+                {
+                    detail::softmax_array(
+                        dims, extents, real_axis, v, 1, v, 1, log_softmax_);
+                    return primitive_argument_type{std::move(arg)};
+                }
 
-    primitive_argument_type softmax_operation::softmax3d_axis2(
-        arg_type&& arg) const
-    {
-        auto t = arg.tensor();
-        if (!arg.is_ref())
-        {
-            for (std::size_t i = 0; i != t.pages(); ++i)
-            {
-                blaze::pageslice(t, i) =
-                    blaze::softmax<blaze::rowwise>(blaze::pageslice(t, i));
+                blaze::DynamicVector<val_type> result(v.size());
+                detail::softmax_array(dims, extents, real_axis, v, 1,
+                    result, 1, log_softmax_);
+                return primitive_argument_type{std::move(result)};
             }
-            return primitive_argument_type{std::move(arg)};
-        }
-
-        blaze::DynamicTensor<val_type> result(t.pages(), t.rows(), t.columns());
-        for (std::size_t i = 0; i != t.pages(); ++i)
-        {
-            auto slice = blaze::pageslice(t, i);
-            blaze::pageslice(result, i) = blaze::softmax<blaze::rowwise>(slice);
-        }
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type softmax_operation::softmax3d(
-        arg_type&& arg, std::int64_t axis) const
-    {
-        switch (axis)
-        {
-        case -3: [[fallthrough]];
-        case 0:
-            return softmax3d_axis0(std::move(arg));
-
-        case -2: [[fallthrough]];
-        case 1:
-            return softmax3d_axis1(std::move(arg));
 
-        case -1: [[fallthrough]];
         case 2:
-            return softmax3d_axis2(std::move(arg));
-
-        default:
-            break;
-        }
-        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "softmax_operation::softmax3d",
-            generate_error_message(
-                "the softmax_operation primitive requires operand axis "
-                "to be between -3 and 2 for tensors."));
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type softmax_operation::softmax4d_axis0(
-        arg_type&& arg) const
-    {
-        auto q = arg.quatern();
-        std::size_t quats = q.columns();
-        std::size_t pages = q.rows();
-
-        for (std::size_t l = 0; l != quats; ++l)
-        {
-            auto t = quatslice(blaze::trans(q), l);
-            for (std::size_t i = 0; i != pages; ++i)
-            {
-                blaze::pageslice(t, i) =
-                    blaze::softmax<blaze::rowwise>(blaze::pageslice(t, i));
-            }
-        }
-        blaze::DynamicArray<4UL, val_type> result = q;
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type softmax_operation::softmax4d_axis1(
-        arg_type&& arg) const
-    {
-        auto q = arg.quatern();
-        std::size_t quats = q.quats();
-        std::size_t columns = q.columns();
-        if (!arg.is_ref())
-        {
-            for (std::size_t l = 0; l != quats; ++l)
             {
-                auto t = quatslice(q, l);
-                for (std::size_t i = 0; i != columns; ++i)
+                auto m = arg.matrix();
+                std::array<std::size_t, 4> const extents = {
+                    m.rows(), m.columns()};
+                if (!arg.is_ref())
                 {
-                    blaze::columnslice(t, i) =
-                        blaze::softmax<blaze::columnwise>(
-                            blaze::columnslice(t, i));
+                    detail::softmax_array(dims, extents, real_axis, m,
+                        m.spacing(), m, m.spacing(), log_softmax_);
+                    return primitive_argument_type{std::move(arg)};
                 }
-            }
-            return primitive_argument_type{std::move(arg)};
-        }
 
-        blaze::DynamicArray<4UL, val_type> result(
-            quats, q.pages(), q.rows(), columns);
-        for (std::size_t l = 0; l != quats; ++l)
-        {
-            auto t = quatslice(q, l);
-            auto res_tensor = quatslice(result, l);
-            for (std::size_t i = 0; i != columns; ++i)
-            {
-                auto slice = blaze::columnslice(t, i);
-                blaze::columnslice(res_tensor, i) =
-                    blaze::softmax<blaze::columnwise>(slice);
+                blaze::DynamicMatrix<val_type> result(m.rows(), m.columns());
+                detail::softmax_array(dims, extents, real_axis, m,
+                    m.spacing(), result, result.spacing(), log_softmax_);
+                return primitive_argument_type{std::move(result)};
             }
-        }
-        return primitive_argument_type{std::move(result)};
-    }
 
-    primitive_argument_type softmax_operation::softmax4d_axis2(
-        arg_type&& arg) const
-    {
-        auto q = arg.quatern();
-        std::size_t quats = q.quats();
-        std::size_t pages = q.pages();
-        if (!arg.is_ref())
-        {
-            for (std::size_t l = 0; l != quats; ++l)
+        case 3:
             {
-                auto t = quatslice(q, l);
-                for (std::size_t i = 0; i != pages; ++i)
+                auto t = arg.tensor();
+                std::array<std::size_t, 4> const extents = {
+                    t.pages(), t.rows(), t.columns()};
+                if (!arg.is_ref())
                 {
-                    blaze::pageslice(t, i) = blaze::softmax<blaze::columnwise>(
-                        blaze::pageslice(t, i));
+                    detail::softmax_array(dims, extents, real_axis, t,
+                        t.spacing(), t, t.spacing(), log_softmax_);
+                    return primitive_argument_type{std::move(arg)};
                 }
-            }
-            return primitive_argument_type{std::move(arg)};
-        }
 
-        blaze::DynamicArray<4UL, val_type> result(
-            quats, pages, q.rows(), q.columns());
-        for (std::size_t l = 0; l != quats; ++l)
-        {
-            auto t = quatslice(q, l);
-            auto res_tensor = quatslice(result, l);
-            for (std::size_t i = 0; i != pages; ++i)
-            {
-                auto slice = blaze::pageslice(t, i);
-                blaze::pageslice(res_tensor, i) =
-                    blaze::softmax<blaze::columnwise>(slice);
+                blaze::DynamicTensor<val_type> result(
+                    t.pages(), t.rows(), t.columns());
+                detail::softmax_array(dims, extents, real_axis, t,
+                    t.spacing(), result, result.spacing(), log_softmax_);
+                return primitive_argument_type{std::move(result)};
             }
-        }
-        return primitive_argument_type{std::move(result)};
-    }
 
-    primitive_argument_type softmax_operation::softmax4d_axis3(
-        arg_type&& arg) const
-    {
-        auto q = arg.quatern();
-        std::size_t quats = q.quats();
-        std::size_t pages = q.pages();
-        if (!arg.is_ref())
-        {
-            for (std::size_t l = 0; l != quats; ++l)
+        case 4:
             {
-                auto t = quatslice(q, l);
-                for (std::size_t i = 0; i != pages; ++i)
+                auto q = arg.quatern();
+                std::array<std::size_t, 4> const extents = {
+                    q.quats(), q.pages(), q.rows(), q.columns()};
+                if (!arg.is_ref())
                 {
-                    blaze::pageslice(t, i) =
-                        blaze::softmax<blaze::rowwise>(blaze::pageslice(t, i));
+                    detail::softmax_array(dims, extents, real_axis, q,
+                        q.spacing(), q, q.spacing(), log_softmax_);
+                    return primitive_argument_type{std::move(arg)};
                 }
-            }
-            return primitive_argument_type{std::move(arg)};
-        }
 
-        blaze::DynamicArray<4UL, val_type> result(
-            quats, pages, q.rows(), q.columns());
-        for (std::size_t l = 0; l != quats; ++l)
-        {
-            auto t = quatslice(q, l);
-            auto res_tensor = quatslice(result, l);
-            for (std::size_t i = 0; i != pages; ++i)
-            {
-                auto slice = blaze::pageslice(t, i);
-                blaze::pageslice(res_tensor, i) =
-                    blaze::softmax<blaze::rowwise>(slice);
+                blaze::DynamicArray<4UL, val_type> result(
+                    q.quats(), q.pages(), q.rows(), q.columns());
+                detail::softmax_array(dims, extents, real_axis, q,
+                    q.spacing(), result, result.spacing(), log_softmax_);
+                return primitive_argument_type{std::move(result)};
             }
-        }
-        return primitive_argument_type{std::move(result)};
-    }
-
-    primitive_argument_type softmax_operation::softmax4d(
-        arg_type&& arg, std::int64_t axis) const
-    {
-        switch (axis)
-        {
-        case -4: [[fallthrough]];
-        case 0:
-            return softmax4d_axis0(std::move(arg));
-
-        case -3: [[fallthrough]];
-        case 1:
-            return softmax4d_axis1(std::move(arg));
-
-        case -2: [[fallthrough]];
-        case 2:
-            return softmax4d_axis2(std::move(arg));
-
-        case -1: [[fallthrough]];
-        case 3:
-            return softmax4d_axis3(std::move(arg));
 
         default:
             break;
         }
+
         HPX_THROW_EXCEPTION(hpx::bad_parameter,
-            "softmax_operation::softmax4d",
+            "softmax_operation::softmaxnd",
             generate_error_message(
-                "the softmax_operation primitive requires operand axis "
-                "to be between -4 and 3 for 4d arrays."));
+                "operand a has an invalid number of dimensions"));
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -431,30 +265,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 std::size_t a_dims = a.num_dimensions();
 
-                switch (a_dims)
+                if (a_dims == 0)
                 {
-                case 0:
                     return this_->softmax0d();
-
-                case 1:
-                    return this_->softmax1d(std::move(a));
-
-                case 2:
-                    return this_->softmax2d(std::move(a), axis);
-
-                case 3:
-                    return this_->softmax3d(std::move(a), axis);
-
-                case 4:
-                    return this_->softmax4d(std::move(a), axis);
-
-                default:
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "softmax_operation::eval",
-                        util::generate_error_message("operand a has an invalid "
-                                                        "number of dimensions",
-                            this_->name_, this_->codename_));
                 }
+                return this_->softmaxnd(std::move(a), axis);
             }),
             detail::map_operands(
                 operands, functional::value_operand{}, args,
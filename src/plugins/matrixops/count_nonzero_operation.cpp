@@ -7,6 +7,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/count_nonzero_operation.hpp>
+#include <phylanx/util/bit_mask.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -93,6 +94,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             return blaze::nonZeros(arg.vector());
         }
+
+        // boolean values are counted eight at a time
+        std::int64_t count_nonzero1d(ir::node_data<std::uint8_t>&& arg)
+        {
+            auto v = arg.vector();
+            return std::int64_t(util::count_nonzero_bytes(v.data(), v.size()));
+        }
     }
 
     primitive_argument_type count_nonzero_operation::count_nonzero1d(
@@ -129,6 +137,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             return blaze::nonZeros(arg.matrix());
         }
+
+        std::int64_t count_nonzero2d(ir::node_data<std::uint8_t>&& arg)
+        {
+            auto m = arg.matrix();
+            std::size_t result = 0;
+            for (std::size_t i = 0; i != m.rows(); ++i)
+            {
+                result += util::count_nonzero_bytes(
+                    m.data() + i * m.spacing(), m.columns());
+            }
+            return std::int64_t(result);
+        }
     }
 
     primitive_argument_type count_nonzero_operation::count_nonzero2d(
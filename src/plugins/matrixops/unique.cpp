@@ -10,6 +10,7 @@
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/unique.hpp>
 #include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/parallel_scan.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -44,6 +45,24 @@ namespace phylanx { namespace execution_tree { namespace primitives
             The sorted unique elements of an array."
             )")};
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // the first element of every run of equal elements of a sorted vector
+        template <typename T>
+        blaze::DynamicVector<T> unique_sorted(
+            blaze::DynamicVector<T> const& a)
+        {
+            blaze::DynamicVector<T> result;
+            phylanx::util::compact(
+                a.size(),
+                [&](std::size_t i) { return i == 0 || a[i] != a[i - 1]; },
+                [&](std::size_t count) { result.resize(count); },
+                [&](std::size_t i, std::size_t pos) { result[pos] = a[i]; });
+            return result;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     unique::unique(primitive_arguments_type && operands,
         std::string const& name, std::string const& codename)
@@ -107,13 +126,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         // Sorting the vector
         std::sort(a.begin(), a.end());
 
-        // Use std::unique to remove duplicacy
-        auto ip = std::unique(a.begin(), a.end());
-
-        // Resizing the vector to remove undifined elements
-        a.resize(std::distance(a.begin(), ip));
-
-        return primitive_argument_type{std::move(a)};
+        return primitive_argument_type{detail::unique_sorted(a)};
     }
 
     primitive_argument_type unique::unique1d(primitive_arguments_type && args)
@@ -185,13 +198,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         // Sorting the vector
         std::sort(result.begin(), result.end());
 
-        // Use std::unique to remove duplicacy
-        auto ip = std::unique(result.begin(), result.end());
-
-        // Resizing the vector to remove undifined elements
-        result.resize(std::distance(result.begin(), ip));
-
-        return primitive_argument_type{std::move(result)};
+        return primitive_argument_type{detail::unique_sorted(result)};
     }
 
     template <typename T>
@@ -0,0 +1,181 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/adaptive_execution_policy.hpp>
+
+#include <hpx/include/async.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/timing/high_resolution_clock.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // the overhead is measured lazily, concurrent measurements are
+        // harmless
+        static std::atomic<std::int64_t> task_spawn_overhead_(-1);
+
+        std::int64_t measure_task_spawn_overhead()
+        {
+            constexpr int rounds = 4;
+            constexpr int tasks = 16;
+
+            // use the best round to reduce the influence of other work
+            std::int64_t overhead = (std::numeric_limits<std::int64_t>::max)();
+            for (int round = 0; round != rounds; ++round)
+            {
+                std::uint64_t t = hpx::chrono::high_resolution_clock::now();
+                for (int i = 0; i != tasks; ++i)
+                {
+                    hpx::async([]() {}).get();
+                }
+                t = hpx::chrono::high_resolution_clock::now() - t;
+
+                overhead = (std::min)(overhead, std::int64_t(t / tasks));
+            }
+            return (std::max)(overhead, std::int64_t(1));
+        }
+
+        std::int64_t get_factor(char const* name, char const* default_value)
+        {
+            return std::stoll(hpx::get_config_entry(
+                std::string("phylanx.adaptive_execution.") + name,
+                default_value));
+        }
+
+        std::int64_t get_lower_factor()
+        {
+            static std::int64_t const factor = get_factor("lower_factor", "10");
+            return factor;
+        }
+
+        std::int64_t get_upper_factor()
+        {
+            static std::int64_t const factor = get_factor("upper_factor", "20");
+            return factor;
+        }
+    }
+
+    std::int64_t task_spawn_overhead()
+    {
+        std::int64_t overhead = detail::task_spawn_overhead_.load();
+        if (overhead < 0)
+        {
+            overhead = std::stoll(
+                hpx::get_config_entry("phylanx.task_spawn_overhead", "0"));
+            if (overhead <= 0)
+            {
+                overhead = detail::measure_task_spawn_overhead();
+            }
+            detail::task_spawn_overhead_.store(overhead);
+        }
+        return overhead;
+    }
+
+    std::int64_t task_spawn_overhead_counter(bool)
+    {
+        return (std::max)(detail::task_spawn_overhead_.load(), std::int64_t(0));
+    }
+
+    bool adaptive_execution_enabled()
+    {
+        static bool const enabled =
+            hpx::get_config_entry("phylanx.adaptive_execution", "0") == "1";
+        return enabled;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // has to be called while holding mtx_
+    void adaptive_execution_policy::add_sample(std::int64_t duration) noexcept
+    {
+        ++samples_;
+
+        std::int64_t estimate = estimate_.load(std::memory_order_relaxed);
+        if (estimate < 0)
+        {
+            estimate_.store(duration, std::memory_order_relaxed);
+            return;
+        }
+
+        if (duration > shift_factor * estimate ||
+            duration * shift_factor < estimate)
+        {
+            // a single outlier is ignored, a second one replaces the estimate
+            if (++outliers_ == 2)
+            {
+                estimate_.store(duration, std::memory_order_relaxed);
+                outliers_ = 0;
+            }
+            return;
+        }
+
+        // exponential moving average with a weight of 1/8 for new samples
+        outliers_ = 0;
+        estimate_.store(estimate + (duration - estimate) / 8,
+            std::memory_order_relaxed);
+    }
+
+    void adaptive_execution_policy::update(
+        std::int64_t count, std::int64_t duration) noexcept
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        if (count < last_count_ || duration < last_duration_)
+        {
+            // the counters were reset (by a performance counter)
+            last_count_ = count;
+            last_duration_ = duration;
+            return;
+        }
+
+        std::int64_t const evaluations = count - last_count_;
+        if (evaluations != 0)
+        {
+            add_sample((duration - last_duration_) / evaluations);
+
+            last_count_ = count;
+            last_duration_ = duration;
+        }
+    }
+
+    std::int64_t adaptive_execution_policy::decide()
+    {
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (samples_ < warmup_samples)
+            {
+                return decision_.load(std::memory_order_relaxed);
+            }
+        }
+
+        // measuring the overhead may suspend, which is not allowed while
+        // holding the lock
+        std::int64_t const overhead = task_spawn_overhead();
+
+        std::lock_guard<mutex_type> l(mtx_);
+
+        std::int64_t const estimate = estimate_.load(std::memory_order_relaxed);
+        if (estimate < detail::get_lower_factor() * overhead)
+        {
+            decision_.store(1, std::memory_order_relaxed);
+        }
+        else if (estimate > detail::get_upper_factor() * overhead)
+        {
+            decision_.store(0, std::memory_order_relaxed);
+        }
+        return decision_.load(std::memory_order_relaxed);
+    }
+}}
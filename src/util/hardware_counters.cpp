@@ -0,0 +1,282 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/util/hardware_counters.hpp>
+
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/threading_base.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ios>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        std::atomic<bool> hardware_counters_enabled_(false);
+
+#if defined(__linux__)
+        ///////////////////////////////////////////////////////////////////////
+        // The perf_event counters of one thread, all counters are opened as
+        // one group, which allows to read them with a single system call.
+        class thread_counters
+        {
+        public:
+            thread_counters() noexcept
+              : leader_(-1)
+              , count_(0)
+            {
+                static constexpr std::uint64_t events[num_hardware_events] =
+                {
+                    PERF_COUNT_HW_CPU_CYCLES,
+                    PERF_COUNT_HW_INSTRUCTIONS,
+                    PERF_COUNT_HW_CACHE_MISSES,
+                    PERF_COUNT_HW_BRANCH_MISSES
+                };
+
+                for (std::size_t i = 0; i != num_hardware_events; ++i)
+                {
+                    index_[i] = -1;
+
+                    // the events not supported by the hardware are skipped
+                    int fd = open(events[i], leader_);
+                    if (fd == -1)
+                    {
+                        continue;
+                    }
+
+                    if (leader_ == -1)
+                    {
+                        leader_ = fd;
+                    }
+                    fds_[count_] = fd;
+                    index_[i] = static_cast<int>(count_++);
+                }
+            }
+
+            ~thread_counters()
+            {
+                // the members of the group have to be closed first
+                for (std::size_t i = count_; i != 0; --i)
+                {
+                    ::close(fds_[i - 1]);
+                }
+            }
+
+            thread_counters(thread_counters const&) = delete;
+            thread_counters& operator=(thread_counters const&) = delete;
+
+            bool available() const noexcept
+            {
+                return leader_ != -1;
+            }
+
+            bool read(hardware_counter_values& values) const noexcept
+            {
+                // layout as given by PERF_FORMAT_GROUP: the number of
+                // counters followed by their values
+                std::uint64_t buffer[num_hardware_events + 1];
+                ssize_t const size =
+                    static_cast<ssize_t>((count_ + 1) * sizeof(std::uint64_t));
+                if (::read(leader_, buffer, size) != size)
+                {
+                    return false;
+                }
+
+                for (std::size_t i = 0; i != num_hardware_events; ++i)
+                {
+                    values[i] = index_[i] == -1 ?
+                        0 :
+                        static_cast<std::int64_t>(buffer[index_[i] + 1]);
+                }
+                return true;
+            }
+
+        private:
+            static int open(std::uint64_t event, int group_fd) noexcept
+            {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = event;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP;
+
+                // count the events of the calling thread on any core
+                return static_cast<int>(::syscall(
+                    SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+            }
+
+            int leader_;
+            std::size_t count_;
+            std::array<int, num_hardware_events> fds_;
+            std::array<int, num_hardware_events> index_;
+        };
+#else
+        class thread_counters
+        {
+        public:
+            bool available() const noexcept
+            {
+                return false;
+            }
+
+            bool read(hardware_counter_values&) const noexcept
+            {
+                return false;
+            }
+        };
+#endif
+
+        // the counters are opened the first time they are needed on a thread,
+        // this function must not be inlined as HPX threads may be resumed on
+        // a different thread
+        HPX_NOINLINE thread_counters const& get_thread_counters() noexcept
+        {
+            thread_local thread_counters counters;
+            return counters;
+        }
+
+        // the phase of an HPX thread changes whenever it is resumed
+        std::size_t get_thread_phase() noexcept
+        {
+            hpx::threads::thread_id_type id = hpx::threads::get_self_id();
+            if (id == hpx::threads::invalid_thread_id)
+            {
+                return 0;
+            }
+
+            hpx::error_code ec(hpx::lightweight);
+            return hpx::threads::get_thread_phase(id, ec);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void enable_hardware_counters(bool enable)
+    {
+        detail::hardware_counters_enabled_.store(
+            enable, std::memory_order_relaxed);
+    }
+
+    bool hardware_counters_available()
+    {
+        return detail::get_thread_counters().available();
+    }
+
+    std::int64_t hardware_counters_available_counter(bool)
+    {
+        return hardware_counters_available() ? 1 : 0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void hardware_counter_scope::start() noexcept
+    {
+        auto const& counters = detail::get_thread_counters();
+        if (!counters.available() || !counters.read(begin_))
+        {
+            data_ = nullptr;
+            return;
+        }
+
+        thread_ = &counters;
+        phase_ = detail::get_thread_phase();
+    }
+
+    void hardware_counter_scope::stop() noexcept
+    {
+        // discard the sample if the evaluation was suspended in between
+        auto const& counters = detail::get_thread_counters();
+        if (&counters != thread_ || detail::get_thread_phase() != phase_)
+        {
+            return;
+        }
+
+        hardware_counter_values end;
+        if (!counters.read(end))
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i != num_hardware_events; ++i)
+        {
+            end[i] -= begin_[i];
+        }
+        data_->add(end);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void print_hardware_counter_report(std::ostream& os,
+        std::map<std::string, std::vector<std::int64_t>> const& data)
+    {
+        using execution_tree::compiler::primitive_display_name;
+
+        using entry_type = std::pair<std::string, std::vector<std::int64_t>>;
+
+        // count, cycles, instructions, cache misses, branch misses
+        std::vector<entry_type> entries;
+        entries.reserve(data.size());
+        for (auto const& entry : data)
+        {
+            // skip primitives that have not been sampled
+            if (entry.second.size() >= 5 && entry.second[1] != 0)
+            {
+                entries.emplace_back(entry);
+            }
+        }
+
+        // sort by decreasing number of cycles
+        std::stable_sort(entries.begin(), entries.end(),
+            [](entry_type const& lhs, entry_type const& rhs) {
+                return lhs.second[1] > rhs.second[1];
+            });
+
+        // restore the formatting of the stream when done
+        std::ios_base::fmtflags const flags = os.flags();
+        std::streamsize const precision = os.precision();
+
+        os << "Hardware counters per primitive instance:\n";
+        os << "       count        cycles  instructions     IPC  "
+              "LLC misses     MPKI  branch misses  primitive\n";
+        for (auto const& entry : entries)
+        {
+            auto const& v = entry.second;
+            double const ipc = double(v[2]) / double(v[1]);
+            double const mpki =
+                v[2] != 0 ? 1000.0 * double(v[3]) / double(v[2]) : 0.0;
+
+            os << std::setw(12) << v[0] << std::setw(14) << v[1]
+               << std::setw(14) << v[2] << std::fixed << std::setprecision(2)
+               << std::setw(8) << ipc << std::setw(12) << v[3]
+               << std::setw(9) << mpki << std::setw(15) << v[4] << "  "
+               << primitive_display_name(entry.first) << "\n";
+        }
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+}}
@@ -0,0 +1,198 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/primitive_argument_type.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/memory_accounting.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ios>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        std::atomic<bool> memory_accounting_enabled_(false);
+
+        // bytes held by the last results of all primitives on this locality
+        std::atomic<std::int64_t> locality_live_bytes(0);
+        std::atomic<std::int64_t> locality_peak_bytes(0);
+
+        void update_peak(
+            std::atomic<std::int64_t>& peak, std::int64_t value) noexcept
+        {
+            std::int64_t current = peak.load(std::memory_order_relaxed);
+            while (current < value &&
+                !peak.compare_exchange_weak(
+                    current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void update_live_bytes(std::int64_t delta) noexcept
+        {
+            if (delta != 0)
+            {
+                update_peak(locality_peak_bytes,
+                    locality_live_bytes.fetch_add(
+                        delta, std::memory_order_relaxed) + delta);
+            }
+        }
+
+        template <typename T>
+        std::int64_t memory_footprint(ir::node_data<T> const& data)
+        {
+            // scalars are stored in place, references don't own their data
+            if (data.num_dimensions() == 0 || data.is_ref())
+            {
+                return 0;
+            }
+            return static_cast<std::int64_t>(data.size() * sizeof(T));
+        }
+    }
+
+    void enable_memory_accounting(bool enable)
+    {
+        detail::memory_accounting_enabled_.store(
+            enable, std::memory_order_relaxed);
+    }
+
+    std::int64_t memory_footprint(
+        execution_tree::primitive_argument_type const& value)
+    {
+        using execution_tree::primitive_argument_type;
+
+        switch (value.index())
+        {
+        case primitive_argument_type::bool_index:
+            return detail::memory_footprint(util::get<1>(value));
+
+        case primitive_argument_type::int64_index:
+            return detail::memory_footprint(util::get<2>(value));
+
+        case primitive_argument_type::float64_index:
+            return detail::memory_footprint(util::get<4>(value));
+
+        default:
+            break;
+        }
+
+        // the elements of lists and dictionaries are accounted for by the
+        // primitives that have produced them
+        return 0;
+    }
+
+    std::int64_t memory_live_bytes(bool)
+    {
+        return detail::locality_live_bytes.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t memory_peak_bytes(bool reset)
+    {
+        if (reset)
+        {
+            return detail::locality_peak_bytes.exchange(
+                detail::locality_live_bytes.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+        }
+        return detail::locality_peak_bytes.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    memory_accounting::~memory_accounting()
+    {
+        detail::update_live_bytes(-live_.load(std::memory_order_relaxed));
+    }
+
+    void memory_accounting::record(std::int64_t bytes) noexcept
+    {
+        allocated_.fetch_add(bytes, std::memory_order_relaxed);
+        detail::update_peak(peak_, bytes);
+
+        // the buffers of the previous result are assumed to be released
+        detail::update_live_bytes(
+            bytes - live_.exchange(bytes, std::memory_order_relaxed));
+    }
+
+    std::int64_t memory_accounting::allocated_bytes(bool reset) noexcept
+    {
+        if (reset)
+        {
+            return allocated_.exchange(0, std::memory_order_relaxed);
+        }
+        return allocated_.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t memory_accounting::peak_bytes(bool reset) noexcept
+    {
+        if (reset)
+        {
+            return peak_.exchange(live_.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+        }
+        return peak_.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void print_memory_report(std::ostream& os,
+        std::map<std::string, std::vector<std::int64_t>> const& data)
+    {
+        using execution_tree::compiler::primitive_display_name;
+
+        using entry_type = std::pair<std::string, std::vector<std::int64_t>>;
+
+        std::vector<entry_type> entries;
+        entries.reserve(data.size());
+        for (auto const& entry : data)
+        {
+            // skip primitives that have not produced any arrays
+            if (entry.second.size() >= 3 && entry.second[0] != 0)
+            {
+                entries.emplace_back(entry);
+            }
+        }
+
+        // sort by decreasing peak bytes
+        std::stable_sort(entries.begin(), entries.end(),
+            [](entry_type const& lhs, entry_type const& rhs) {
+                return lhs.second[2] > rhs.second[2];
+            });
+
+        std::int64_t allocated = 0;
+        std::int64_t live = 0;
+        for (auto const& entry : entries)
+        {
+            allocated += entry.second[0];
+            live += entry.second[1];
+        }
+
+        // restore the formatting of the stream when done
+        std::ios_base::fmtflags const flags = os.flags();
+
+        os << "Memory held by the results of the primitives:\n";
+        os << "   allocated [B]      live [B]      peak [B]  primitive\n";
+        for (auto const& entry : entries)
+        {
+            os << std::setw(16) << entry.second[0] << std::setw(14)
+               << entry.second[1] << std::setw(14) << entry.second[2] << "  "
+               << primitive_display_name(entry.first) << "\n";
+        }
+        os << std::setw(16) << allocated << std::setw(14) << live
+           << "                total\n";
+
+        os.flags(flags);
+    }
+}}
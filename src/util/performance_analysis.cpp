@@ -0,0 +1,335 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/primitive_argument_type.hpp>
+#include <phylanx/util/performance_analysis.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ios>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        std::string performance_location(
+            std::string const& codename, std::string const& name)
+        {
+            execution_tree::compiler::primitive_name_parts parts;
+            if (!execution_tree::compiler::parse_primitive_name(name, parts) ||
+                parts.tag1 < 0)
+            {
+                return codename;
+            }
+            return codename + ":" + std::to_string(parts.tag1);
+        }
+
+        // the name of a primitive instance as used in the folded stacks,
+        // those may not contain spaces or semicolons
+        std::string performance_frame(std::string const& name)
+        {
+            execution_tree::compiler::primitive_name_parts parts;
+            if (!execution_tree::compiler::parse_primitive_name(name, parts))
+            {
+                parts.primitive = name;
+            }
+
+            std::string result = parts.primitive;
+            if (result.size() > 2 && result[0] == '_' && result[1] == '_')
+            {
+                result.erase(0, 2);
+            }
+            if (!parts.instance.empty())
+            {
+                result += "/" + parts.instance;
+            }
+            if (parts.tag1 >= 0)
+            {
+                result += "(" + std::to_string(parts.tag1);
+                if (parts.tag2 != -1)
+                {
+                    result += ":" + std::to_string(parts.tag2);
+                }
+                result += ")";
+            }
+
+            std::replace(result.begin(), result.end(), ' ', '_');
+            std::replace(result.begin(), result.end(), ';', '_');
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        struct performance_analyzer
+        {
+            performance_analyzer(performance_analysis& analysis,
+                    std::map<std::string, std::vector<std::int64_t>> const&
+                        counter_data)
+              : analysis_(analysis)
+              , counter_data_(counter_data)
+            {
+            }
+
+            struct result
+            {
+                std::int64_t inclusive_time = 0;
+                std::int64_t critical_path_time = 0;
+                std::vector<std::string> critical_path;
+            };
+
+            result visit(execution_tree::topology const& t,
+                std::string const& stack)
+            {
+                // nodes without a name group the topologies of several
+                // independent expressions
+                if (t.name_.empty())
+                {
+                    return visit_children(t, stack);
+                }
+
+                // handle each node only once
+                if (!handled_nodes_.insert(t.name_).second)
+                {
+                    return result{};
+                }
+
+                primitive_performance data;
+                data.name = t.name_;
+                data.location =
+                    performance_location(analysis_.codename, t.name_);
+
+                auto it = counter_data_.find(t.name_);
+                if (it != counter_data_.end() && it->second.size() >= 2)
+                {
+                    data.count = it->second[0];
+                    data.inclusive_time = it->second[1];
+                }
+
+                std::string const frame = performance_frame(t.name_);
+                std::string const this_stack =
+                    stack.empty() ? frame : stack + ";" + frame;
+
+                result children = visit_children(t, this_stack);
+
+                data.self_time = (std::max)(std::int64_t(0),
+                    data.inclusive_time - children.inclusive_time);
+
+                if (data.self_time != 0)
+                {
+                    folded_stacks_[this_stack] += data.self_time;
+                }
+
+                result r;
+                r.inclusive_time = data.inclusive_time;
+                r.critical_path_time =
+                    data.self_time + children.critical_path_time;
+                r.critical_path.reserve(children.critical_path.size() + 1);
+                r.critical_path.push_back(t.name_);
+                r.critical_path.insert(r.critical_path.end(),
+                    children.critical_path.begin(),
+                    children.critical_path.end());
+
+                analysis_.primitives.push_back(std::move(data));
+                return r;
+            }
+
+            // the operands are evaluated concurrently, the critical path
+            // continues through the operand with the longest critical path
+            result visit_children(
+                execution_tree::topology const& t, std::string const& stack)
+            {
+                result r;
+                for (auto const& child : t.children_)
+                {
+                    result c = visit(child, stack);
+                    r.inclusive_time += c.inclusive_time;
+                    if (c.critical_path_time > r.critical_path_time ||
+                        r.critical_path.empty())
+                    {
+                        r.critical_path_time = c.critical_path_time;
+                        r.critical_path = std::move(c.critical_path);
+                    }
+                }
+                return r;
+            }
+
+            performance_analysis& analysis_;
+            std::map<std::string, std::vector<std::int64_t>> const&
+                counter_data_;
+            std::set<std::string> handled_nodes_;
+            std::map<std::string, std::int64_t> folded_stacks_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        void print_time(std::ostream& os, int width, std::int64_t ns)
+        {
+            os << std::setw(width) << std::fixed << std::setprecision(3)
+               << double(ns) / 1e6;
+        }
+
+        void print_percentage(
+            std::ostream& os, std::int64_t ns, std::int64_t total)
+        {
+            os << std::setw(10) << std::fixed << std::setprecision(1)
+               << (total != 0 ? 100.0 * double(ns) / double(total) : 0.0);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    performance_analysis analyze_performance(std::string const& codename,
+        execution_tree::topology const& t,
+        std::map<std::string, std::vector<std::int64_t>> const& counter_data)
+    {
+        performance_analysis analysis;
+        analysis.codename = codename;
+
+        detail::performance_analyzer analyzer(analysis, counter_data);
+        auto r = analyzer.visit(t, std::string{});
+
+        analysis.critical_path = std::move(r.critical_path);
+        analysis.critical_path_time = r.critical_path_time;
+
+        std::set<std::string> const critical(
+            analysis.critical_path.begin(), analysis.critical_path.end());
+
+        std::map<std::string, location_performance> locations;
+        for (auto& p : analysis.primitives)
+        {
+            p.critical = critical.find(p.name) != critical.end();
+            analysis.total_time += p.self_time;
+
+            location_performance& l = locations[p.location];
+            l.location = p.location;
+            l.count += p.count;
+            l.inclusive_time += p.inclusive_time;
+            l.self_time += p.self_time;
+        }
+
+        if (analysis.critical_path_time != 0)
+        {
+            analysis.parallelism = double(analysis.total_time) /
+                double(analysis.critical_path_time);
+        }
+
+        // sort by decreasing self time
+        std::stable_sort(analysis.primitives.begin(),
+            analysis.primitives.end(),
+            [](primitive_performance const& lhs,
+                primitive_performance const& rhs) {
+                return lhs.self_time > rhs.self_time;
+            });
+
+        analysis.locations.reserve(locations.size());
+        for (auto& l : locations)
+        {
+            analysis.locations.push_back(std::move(l.second));
+        }
+        std::stable_sort(analysis.locations.begin(),
+            analysis.locations.end(),
+            [](location_performance const& lhs,
+                location_performance const& rhs) {
+                return lhs.self_time > rhs.self_time;
+            });
+
+        analysis.folded_stacks.assign(analyzer.folded_stacks_.begin(),
+            analyzer.folded_stacks_.end());
+
+        return analysis;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void print_performance_report(
+        std::ostream& os, performance_analysis const& analysis)
+    {
+        using execution_tree::compiler::primitive_display_name;
+
+        std::int64_t const total = analysis.total_time;
+
+        // restore the formatting of the stream when done
+        std::ios_base::fmtflags const flags = os.flags();
+        std::streamsize const precision = os.precision();
+
+        os << "Performance analysis of '" << analysis.codename << "':\n";
+        os << "  total self time:     ";
+        detail::print_time(os, 12, total);
+        os << " [ms]\n";
+        os << "  critical path time:  ";
+        detail::print_time(os, 12, analysis.critical_path_time);
+        os << " [ms]\n";
+        os << "  achieved parallelism:" << std::setw(12) << std::fixed
+           << std::setprecision(2) << analysis.parallelism << "\n";
+
+        std::map<std::string, primitive_performance const*> primitives;
+        for (auto const& p : analysis.primitives)
+        {
+            primitives[p.name] = &p;
+        }
+
+        os << "\nCritical path:\n";
+        os << "   self [ms]  primitive\n";
+        for (auto const& name : analysis.critical_path)
+        {
+            auto it = primitives.find(name);
+            detail::print_time(
+                os, 12, it != primitives.end() ? it->second->self_time : 0);
+            os << "  " << primitive_display_name(name) << "\n";
+        }
+
+        os << "\nSelf time per primitive instance (* on critical path):\n";
+        os << "       count  inclusive [ms]     self [ms]  self [%]  "
+              "primitive\n";
+        for (auto const& p : analysis.primitives)
+        {
+            if (p.count == 0 && p.inclusive_time == 0)
+            {
+                continue;
+            }
+            os << std::setw(12) << p.count;
+            detail::print_time(os, 16, p.inclusive_time);
+            detail::print_time(os, 14, p.self_time);
+            detail::print_percentage(os, p.self_time, total);
+            os << (p.critical ? " * " : "   ")
+               << primitive_display_name(p.name) << "\n";
+        }
+
+        os << "\nSelf time per source line:\n";
+        os << "       count  inclusive [ms]     self [ms]  self [%]  "
+              "location\n";
+        for (auto const& l : analysis.locations)
+        {
+            if (l.count == 0 && l.inclusive_time == 0)
+            {
+                continue;
+            }
+            os << std::setw(12) << l.count;
+            detail::print_time(os, 16, l.inclusive_time);
+            detail::print_time(os, 14, l.self_time);
+            detail::print_percentage(os, l.self_time, total);
+            os << "   " << l.location << "\n";
+        }
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    void print_folded_stacks(
+        std::ostream& os, performance_analysis const& analysis)
+    {
+        for (auto const& stack : analysis.folded_stacks)
+        {
+            os << stack.first << " " << stack.second << "\n";
+        }
+    }
+}}
@@ -286,21 +286,55 @@ namespace phylanx { namespace util {
             primitive_instances, counter_names, locality_id);
     }
 
+    namespace detail
+    {
+        std::vector<std::string> find_primitive_instances(
+            hpx::naming::id_type const& locality_id)
+        {
+            auto entries = hpx::agas::find_symbols(hpx::launch::sync,
+                hpx::util::format("/phylanx${}/*$*",
+                    hpx::naming::get_locality_id_from_id(locality_id)));
+
+            std::vector<std::string> primitive_instances;
+            primitive_instances.reserve(entries.size());
+
+            for (auto&& entry : entries)
+            {
+                primitive_instances.emplace_back(std::move(entry.first));
+            }
+
+            return primitive_instances;
+        }
+    }
+
     std::map<std::string, std::vector<std::int64_t>> retrieve_counter_data(
         hpx::naming::id_type const& locality_id)
     {
-        auto entries = hpx::agas::find_symbols(hpx::launch::sync,
-            hpx::util::format("/phylanx${}/*$*",
-                hpx::naming::get_locality_id_from_id(locality_id)));
+        return retrieve_counter_data(
+            detail::find_primitive_instances(locality_id), locality_id);
+    }
+
+    std::map<std::string, std::vector<std::int64_t>> retrieve_memory_data(
+        hpx::naming::id_type const& locality_id)
+    {
+        std::vector<std::string> const counter_names{
+            "memory/allocated_bytes", "memory/live_bytes",
+            "memory/peak_bytes"};
 
-        std::vector<std::string> primitive_instances;
-        primitive_instances.reserve(entries.size());
+        return retrieve_counter_data(
+            detail::find_primitive_instances(locality_id), counter_names,
+            locality_id);
+    }
 
-        for (auto&& entry : entries)
-        {
-            primitive_instances.emplace_back(std::move(entry.first));
-        }
+    std::map<std::string, std::vector<std::int64_t>>
+    retrieve_hardware_counter_data(hpx::naming::id_type const& locality_id)
+    {
+        std::vector<std::string> const counter_names{"count/eval",
+            "count/cycles", "count/instructions", "count/llc_misses",
+            "count/branch_misses"};
 
-        return retrieve_counter_data(primitive_instances, locality_id);
+        return retrieve_counter_data(
+            detail::find_primitive_instances(locality_id), counter_names,
+            locality_id);
     }
 }}    // namespace phylanx::util
@@ -0,0 +1,577 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/util/primitive_trace.hpp>
+
+#include <hpx/include/actions.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/runtime_local/config_entry.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+#include <hpx/timing/high_resolution_clock.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        std::atomic<bool> tracing_enabled_(false);
+
+        // identifies the evaluations recorded on this locality
+        std::atomic<std::uint64_t> next_trace_id_(0);
+
+        ///////////////////////////////////////////////////////////////////////
+        // the events recorded by one thread, the thread is the only writer
+        struct trace_buffer
+        {
+            explicit trace_buffer(std::size_t capacity)
+              : events_(capacity)
+              , head_(0)
+            {
+            }
+
+            void record(trace_event const& event) noexcept
+            {
+                std::uint64_t const head =
+                    head_.load(std::memory_order_relaxed);
+                events_[head % events_.size()] = event;
+                head_.store(head + 1, std::memory_order_release);
+            }
+
+            std::vector<trace_event> events_;
+            std::atomic<std::uint64_t> head_;
+        };
+
+        struct trace_name
+        {
+            std::string name;        // display name of the primitive
+            std::string primitive;   // full name of the primitive
+            std::string location;    // codename:line:column
+        };
+
+        struct trace_data
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            mutex_type mtx_;
+            std::vector<std::unique_ptr<trace_buffer>> buffers_;
+            std::vector<trace_name> names_;
+            std::unordered_map<std::string, std::uint32_t> ids_;
+        };
+
+        trace_data& get_trace_data()
+        {
+            static trace_data data;
+            return data;
+        }
+
+        std::size_t trace_buffer_size()
+        {
+            static std::size_t const size = [] {
+                std::int64_t const value = std::stoll(hpx::get_config_entry(
+                    "phylanx.trace.buffer_size", "65536"));
+                return value > 0 ? std::size_t(value) : std::size_t(65536);
+            }();
+            return size;
+        }
+
+        // offset (ns) of the high resolution clock from the system clock,
+        // used to align the events recorded on different localities
+        std::int64_t trace_clock_offset()
+        {
+            static std::int64_t const offset = [] {
+                std::int64_t const now =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+                return now -
+                    std::int64_t(hpx::chrono::high_resolution_clock::now());
+            }();
+            return offset;
+        }
+
+        thread_local trace_buffer* current_trace_buffer = nullptr;
+
+        trace_buffer* get_trace_buffer()
+        {
+            if (current_trace_buffer == nullptr)
+            {
+                auto buffer =
+                    std::make_unique<trace_buffer>(trace_buffer_size());
+
+                trace_data& data = get_trace_data();
+                std::lock_guard<trace_data::mutex_type> l(data.mtx_);
+                data.buffers_.push_back(std::move(buffer));
+                current_trace_buffer = data.buffers_.back().get();
+            }
+            return current_trace_buffer;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void write_json_string(std::ostream& os, std::string const& str)
+        {
+            os << '"';
+            for (char c : str)
+            {
+                switch (c)
+                {
+                case '"':
+                    os << "\\\"";
+                    break;
+                case '\\':
+                    os << "\\\\";
+                    break;
+                case '\n':
+                    os << "\\n";
+                    break;
+                case '\t':
+                    os << "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        os << "\\u" << std::hex << std::setw(4)
+                           << std::setfill('0') << int(c) << std::dec
+                           << std::setfill(' ');
+                    }
+                    else
+                    {
+                        os << c;
+                    }
+                    break;
+                }
+            }
+            os << '"';
+        }
+
+        // Chrome expects timestamps in microseconds
+        void write_timestamp(std::ostream& os, std::int64_t ns)
+        {
+            os << ns / 1000 << '.' << std::setw(3) << std::setfill('0')
+               << ns % 1000 << std::setfill(' ');
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void enable_tracing_locally(bool enable)
+        {
+            if (enable)
+            {
+                // initialize the clock offset before the first event
+                trace_clock_offset();
+            }
+            tracing_enabled_.store(enable, std::memory_order_relaxed);
+        }
+
+        void clear_trace_locally()
+        {
+            trace_data& data = get_trace_data();
+            std::lock_guard<trace_data::mutex_type> l(data.mtx_);
+            for (auto& buffer : data.buffers_)
+            {
+                buffer->head_.store(0, std::memory_order_release);
+            }
+        }
+
+        // Return the recorded events of this locality as a comma separated
+        // list of JSON objects
+        std::string retrieve_trace_locally()
+        {
+            std::uint32_t const locality = hpx::get_locality_id();
+            std::int64_t const offset = trace_clock_offset();
+
+            trace_data& data = get_trace_data();
+            std::lock_guard<trace_data::mutex_type> l(data.mtx_);
+
+            std::ostringstream os;
+            bool first = true;
+            auto separate = [&]() {
+                if (!first)
+                {
+                    os << ",\n";
+                }
+                first = false;
+            };
+
+            std::set<std::int32_t> workers;
+
+            for (auto const& buffer : data.buffers_)
+            {
+                std::uint64_t const head =
+                    buffer->head_.load(std::memory_order_acquire);
+                std::uint64_t const capacity = buffer->events_.size();
+                std::uint64_t const count =
+                    head < capacity ? head : capacity;
+
+                for (std::uint64_t i = head - count; i != head; ++i)
+                {
+                    trace_event const& event =
+                        buffer->events_[i % capacity];
+                    if (event.name >= data.names_.size())
+                    {
+                        continue;
+                    }
+
+                    trace_name const& name = data.names_[event.name];
+                    std::int32_t const worker = std::int32_t(event.worker);
+                    workers.insert(worker);
+
+                    auto write_common = [&](char const* phase,
+                                            std::int64_t ts) {
+                        separate();
+                        os << "{\"name\":";
+                        write_json_string(os, name.name);
+                        os << ",\"cat\":\"primitive\",\"ph\":\"" << phase
+                           << "\",\"pid\":" << locality
+                           << ",\"tid\":" << worker << ",\"ts\":";
+                        write_timestamp(os, ts + offset);
+                    };
+
+                    auto write_args = [&]() {
+                        os << ",\"args\":{\"primitive\":";
+                        write_json_string(os, name.primitive);
+                        os << ",\"location\":";
+                        write_json_string(os, name.location);
+                        os << ",\"operands\":" << event.operands
+                           << ",\"literal_operands\":" << event.literal_operands
+                           << ",\"requested_operands\":" << event.requested
+                           << ",\"pending_operands\":" << event.pending
+                           << "}";
+                    };
+
+                    // asynchronous slices are matched by their id, the waits
+                    // for operands use the id of the evaluation that
+                    // requested them and are therefore nested into its slice
+                    auto write_id = [&]() {
+                        os << ",\"id\":\"" << locality << "/" << event.id
+                           << "\"";
+                    };
+
+                    std::int64_t const begin = std::int64_t(event.begin);
+                    std::int64_t const end = std::int64_t(event.end);
+
+                    if (event.wait)
+                    {
+                        separate();
+                        os << "{\"name\":\"wait for operand #"
+                           << event.requested
+                           << "\",\"cat\":\"primitive\",\"ph\":\"b\","
+                           << "\"pid\":" << locality << ",\"tid\":" << worker
+                           << ",\"ts\":";
+                        write_timestamp(os, begin + offset);
+                        write_id();
+                        os << ",\"args\":{\"operand\":" << event.requested
+                           << "}}";
+
+                        separate();
+                        os << "{\"name\":\"wait for operand #"
+                           << event.requested
+                           << "\",\"cat\":\"primitive\",\"ph\":\"e\","
+                           << "\"pid\":" << locality << ",\"tid\":" << worker
+                           << ",\"ts\":";
+                        write_timestamp(os, end + offset);
+                        write_id();
+                        os << "}";
+                    }
+                    else if (!event.deferred)
+                    {
+                        write_common("X", begin);
+                        os << ",\"dur\":";
+                        write_timestamp(os, end - begin);
+                        write_args();
+                        os << "}";
+                    }
+                    else
+                    {
+                        write_common("b", begin);
+                        write_id();
+                        write_args();
+                        os << "}";
+
+                        write_common("e", end);
+                        write_id();
+                        os << "}";
+                    }
+                }
+            }
+
+            if (!first)
+            {
+                separate();
+                os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":"
+                   << locality << ",\"args\":{\"name\":\"locality#"
+                   << locality << "\"}}";
+
+                for (std::int32_t worker : workers)
+                {
+                    separate();
+                    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":"
+                       << locality << ",\"tid\":" << worker
+                       << ",\"args\":{\"name\":\"worker-thread#" << worker
+                       << "\"}}";
+                }
+            }
+
+            return os.str();
+        }
+    }
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_PLAIN_ACTION(phylanx::util::detail::enable_tracing_locally,
+    phylanx_enable_tracing_action);
+HPX_PLAIN_ACTION(phylanx::util::detail::clear_trace_locally,
+    phylanx_clear_trace_action);
+HPX_PLAIN_ACTION(phylanx::util::detail::retrieve_trace_locally,
+    phylanx_retrieve_trace_action);
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        template <typename Action, typename... Ts>
+        auto invoke_on_all_localities(Ts const&... ts) -> std::vector<
+            decltype(hpx::async(Action(), hpx::find_here(), ts...))>
+        {
+            std::vector<hpx::id_type> const localities =
+                hpx::find_all_localities();
+
+            std::vector<decltype(
+                hpx::async(Action(), hpx::find_here(), ts...))>
+                results;
+            results.reserve(localities.size());
+
+            for (auto const& locality : localities)
+            {
+                results.push_back(hpx::async(Action(), locality, ts...));
+            }
+
+            hpx::wait_all(results);
+            return results;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void enable_tracing(bool enable)
+    {
+        for (auto& f :
+            detail::invoke_on_all_localities<phylanx_enable_tracing_action>(
+                enable))
+        {
+            f.get();    // rethrow exceptions
+        }
+    }
+
+    void clear_trace()
+    {
+        for (auto& f :
+            detail::invoke_on_all_localities<phylanx_clear_trace_action>())
+        {
+            f.get();    // rethrow exceptions
+        }
+    }
+
+    void write_trace(std::ostream& os)
+    {
+        os << "{\"traceEvents\":[\n";
+
+        bool first = true;
+        for (auto& f :
+            detail::invoke_on_all_localities<phylanx_retrieve_trace_action>())
+        {
+            std::string events = f.get();
+            if (!events.empty())
+            {
+                if (!first)
+                {
+                    os << ",\n";
+                }
+                os << events;
+                first = false;
+            }
+        }
+
+        os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+
+    void write_trace(std::string const& filename)
+    {
+        std::ofstream os(filename);
+        if (!os.good())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::util::write_trace",
+                "Failed to open the specified file: " + filename);
+        }
+        write_trace(os);
+    }
+
+    std::string retrieve_trace()
+    {
+        std::ostringstream os;
+        write_trace(os);
+        return os.str();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::uint32_t register_trace_name(
+        std::string const& name, std::string const& codename)
+    {
+        detail::trace_data& data = detail::get_trace_data();
+
+        {
+            std::lock_guard<detail::trace_data::mutex_type> l(data.mtx_);
+            auto it = data.ids_.find(name);
+            if (it != data.ids_.end())
+            {
+                return it->second;
+            }
+        }
+
+        detail::trace_name entry{name, name, codename};
+
+        execution_tree::compiler::primitive_name_parts parts;
+        if (execution_tree::compiler::parse_primitive_name(name, parts))
+        {
+            entry.name = parts.primitive;
+            if (entry.name.size() > 2 && entry.name[0] == '_' &&
+                entry.name[1] == '_')
+            {
+                entry.name.erase(0, 2);
+            }
+            if (!parts.instance.empty())
+            {
+                entry.name += "/" + parts.instance;
+            }
+
+            if (parts.tag1 >= 0)
+            {
+                entry.location += ":" + std::to_string(parts.tag1);
+                if (parts.tag2 != -1)
+                {
+                    entry.location += ":" + std::to_string(parts.tag2);
+                }
+            }
+        }
+
+        std::lock_guard<detail::trace_data::mutex_type> l(data.mtx_);
+        auto it = data.ids_.emplace(
+            name, std::uint32_t(data.names_.size()));
+        if (it.second)
+        {
+            data.names_.push_back(std::move(entry));
+        }
+        return it.first->second;
+    }
+
+    void record_trace_event(trace_event const& event) noexcept
+    {
+        try
+        {
+            detail::get_trace_buffer()->record(event);
+        }
+        catch (...)
+        {
+            // the event is lost if no buffer could be allocated
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    trace_scope::trace_scope(std::uint32_t name, std::uint32_t operands,
+        std::uint32_t literal_operands) noexcept
+      : event_{hpx::chrono::high_resolution_clock::now(), 0,
+            detail::next_trace_id_.fetch_add(1, std::memory_order_relaxed),
+            name, std::uint32_t(hpx::get_worker_thread_num()), operands,
+            literal_operands, 0, 0, false, false}
+      , enabled_(true)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The evaluation the operands are attributed to is kept in the data slot
+    // of the HPX thread, which (unlike a thread_local variable) stays with
+    // the HPX thread if it is resumed on a different worker thread.
+    trace_operands::trace_operands(trace_scope& scope) noexcept
+      : previous_(0)
+      , active_(false)
+    {
+        hpx::threads::thread_id_type const id = hpx::threads::get_self_id();
+        if (!scope.enabled() || id == hpx::threads::invalid_thread_id)
+        {
+            return;
+        }
+
+        hpx::error_code ec(hpx::lightweight);
+        previous_ = hpx::threads::set_thread_data(
+            id, reinterpret_cast<std::size_t>(&scope), ec);
+        active_ = !ec;
+    }
+
+    trace_operands::~trace_operands()
+    {
+        if (active_)
+        {
+            hpx::error_code ec(hpx::lightweight);
+            hpx::threads::set_thread_data(
+                hpx::threads::get_self_id(), previous_, ec);
+        }
+    }
+
+    namespace detail
+    {
+        bool trace_operand(bool ready, trace_event& wait) noexcept
+        {
+            hpx::threads::thread_id_type const id =
+                hpx::threads::get_self_id();
+            if (id == hpx::threads::invalid_thread_id)
+            {
+                return false;
+            }
+
+            hpx::error_code ec(hpx::lightweight);
+            auto* scope = reinterpret_cast<trace_scope*>(
+                hpx::threads::get_thread_data(id, ec));
+            if (ec || scope == nullptr)
+            {
+                return false;
+            }
+
+            std::uint32_t const operand = scope->add_operand(ready);
+            if (ready)
+            {
+                return false;
+            }
+
+            wait = scope->event();
+            wait.begin = hpx::chrono::high_resolution_clock::now();
+            wait.end = 0;
+            wait.worker = std::uint32_t(hpx::get_worker_thread_num());
+            wait.requested = operand;
+            wait.pending = 0;
+            wait.deferred = false;
+            wait.wait = true;
+            return true;
+        }
+    }
+}}
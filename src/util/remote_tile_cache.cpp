@@ -0,0 +1,269 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/remote_tile_cache.hpp>
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/synchronization/spinlock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // performance counter data
+    static std::atomic<std::int64_t> count_cache_hits_;
+    static std::atomic<std::int64_t> count_cache_misses_;
+    static std::atomic<std::int64_t> count_cache_evictions_;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // LRU cache of tiles fetched from remote localities
+        class remote_tile_cache
+        {
+        private:
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            struct entry
+            {
+                std::shared_ptr<void const> data_;
+                std::uint64_t version_;
+                std::size_t size_;
+                std::list<remote_tile_cache_key>::iterator lru_pos_;
+            };
+
+            using map_type = std::map<remote_tile_cache_key, entry>;
+
+        public:
+            remote_tile_cache()
+              : capacity_(std::stoull(hpx::get_config_entry(
+                    "phylanx.remote_tile_cache_size", "0")))
+              , size_(0)
+            {
+            }
+
+            bool enabled() const
+            {
+                return capacity_ != 0;
+            }
+
+            remote_tile_cache_entry lookup(remote_tile_cache_key const& key)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                auto it = entries_.find(key);
+                if (it == entries_.end())
+                {
+                    return remote_tile_cache_entry{nullptr, unversioned_tile};
+                }
+
+                // move entry to the front of the LRU list
+                lru_.splice(lru_.begin(), lru_, it->second.lru_pos_);
+
+                return remote_tile_cache_entry{
+                    it->second.data_, it->second.version_};
+            }
+
+            void insert(remote_tile_cache_key&& key,
+                std::shared_ptr<void const>&& data, std::uint64_t version,
+                std::size_t size)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                // the remote part has changed, all copies of other ranges of
+                // the same part are outdated as well
+                invalidate(key.basename_, key.site_, version);
+
+                auto it = entries_.find(key);
+                if (it != entries_.end())
+                {
+                    // some other thread fetched the same tile concurrently
+                    return;
+                }
+
+                if (size > capacity_)
+                {
+                    return;     // never cache tiles larger than the cache
+                }
+
+                // make room for the new entry, if needed
+                while (size_ + size > capacity_ && !lru_.empty())
+                {
+                    erase(entries_.find(lru_.back()));
+                }
+
+                lru_.push_front(key);
+                entries_.emplace(std::move(key),
+                    entry{std::move(data), version, size, lru_.begin()});
+                size_ += size;
+            }
+
+            void clear()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                count_cache_evictions_ += entries_.size();
+
+                entries_.clear();
+                lru_.clear();
+                size_ = 0;
+            }
+
+            std::int64_t size() const
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return static_cast<std::int64_t>(size_);
+            }
+
+        private:
+            void invalidate(std::string const& basename, std::size_t site,
+                std::uint64_t version)
+            {
+                // all entries for the same part are stored consecutively
+                auto it = entries_.lower_bound(remote_tile_cache_key{
+                    basename, site, {}, std::type_index(typeid(void))});
+
+                while (it != entries_.end() &&
+                    it->first.basename_ == basename && it->first.site_ == site)
+                {
+                    if (it->second.version_ != version)
+                    {
+                        it = erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+
+            map_type::iterator erase(map_type::iterator it)
+            {
+                ++count_cache_evictions_;
+
+                size_ -= it->second.size_;
+                lru_.erase(it->second.lru_pos_);
+                return entries_.erase(it);
+            }
+
+        private:
+            mutable mutex_type mtx_;
+            std::size_t const capacity_;
+            std::size_t size_;
+            map_type entries_;
+            std::list<remote_tile_cache_key> lru_;
+        };
+
+        remote_tile_cache& get_remote_tile_cache()
+        {
+            static remote_tile_cache cache;
+            return cache;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        remote_tile_cache_entry remote_tile_cache_lookup(
+            remote_tile_cache_key const& key)
+        {
+            return get_remote_tile_cache().lookup(key);
+        }
+
+        void remote_tile_cache_insert(remote_tile_cache_key&& key,
+            std::shared_ptr<void const> data, std::uint64_t version,
+            std::size_t size_in_bytes)
+        {
+            get_remote_tile_cache().insert(
+                std::move(key), std::move(data), version, size_in_bytes);
+        }
+
+        void remote_tile_cache_count_access(bool hit)
+        {
+            if (hit)
+            {
+                ++count_cache_hits_;
+            }
+            else
+            {
+                ++count_cache_misses_;
+            }
+        }
+
+        // 64 bit hash of the given bytes, processes eight bytes at a time
+        std::uint64_t remote_tile_cache_hash(
+            std::uint64_t seed, void const* data, std::size_t size_in_bytes)
+        {
+            auto mix = [](std::uint64_t h) -> std::uint64_t {
+                // finalizer of splitmix64
+                h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+                h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+                return h ^ (h >> 31);
+            };
+
+            std::uint64_t h = seed ^ (size_in_bytes * 0x9e3779b97f4a7c15ull);
+
+            auto const* bytes = static_cast<unsigned char const*>(data);
+            for (/**/; size_in_bytes >= 8; size_in_bytes -= 8, bytes += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, bytes, 8);
+                h = mix(h ^ word) + 0x9e3779b97f4a7c15ull;
+            }
+
+            if (size_in_bytes != 0)
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, bytes, size_in_bytes);
+                h = mix(h ^ word) + 0x9e3779b97f4a7c15ull;
+            }
+
+            return mix(h);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool remote_tile_cache_enabled()
+    {
+        return detail::get_remote_tile_cache().enabled();
+    }
+
+    void remote_tile_cache_clear()
+    {
+        detail::get_remote_tile_cache().clear();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t remote_tile_cache_hits(bool reset)
+    {
+        return hpx::util::get_and_reset_value(count_cache_hits_, reset);
+    }
+
+    std::int64_t remote_tile_cache_misses(bool reset)
+    {
+        return hpx::util::get_and_reset_value(count_cache_misses_, reset);
+    }
+
+    std::int64_t remote_tile_cache_evictions(bool reset)
+    {
+        return hpx::util::get_and_reset_value(count_cache_evictions_, reset);
+    }
+
+    std::int64_t remote_tile_cache_size(bool)
+    {
+        return detail::get_remote_tile_cache().size();
+    }
+}}
@@ -6,6 +6,8 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/plugins/plugin_factory.hpp>
+#include <phylanx/util/hardware_counters.hpp>
+#include <phylanx/util/memory_accounting.hpp>
 #include <phylanx/util/performance_data.hpp>
 
 #include <hpx/include/components.hpp>
@@ -51,6 +53,19 @@ namespace phylanx { namespace util {
         // register performance counters for all discovered primitives
         performance_counters::startup_counters();
 
+        // enable the memory accounting if requested by the configuration
+        if (hpx::get_config_entry("phylanx.memory_accounting", "0") == "1")
+        {
+            enable_memory_accounting();
+        }
+
+        // enable the sampling of the hardware counters if requested by the
+        // configuration
+        if (hpx::get_config_entry("phylanx.hardware_counters", "0") == "1")
+        {
+            enable_hardware_counters();
+        }
+
         // enable performance counters if requested on command line
         if (need_performance_counters(performance_counter_dest))
         {
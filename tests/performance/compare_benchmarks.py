@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021 Hartmut Kaiser
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# ## Synopsis
+# ```
+# usage: compare_benchmarks.py [-h] [--threshold THRESHOLD] [--all]
+#                              baseline current
+#
+# Compare the JSON results of two runs of primitive_benchmarks (or of
+# dist_scaling.py)
+#
+# positional arguments:
+#   baseline               JSON results of the baseline run
+#   current                JSON results of the run to compare
+#
+# optional arguments:
+#   -h, --help             show this help message and exit
+#   --threshold THRESHOLD  relative slowdown of the median time reported as a
+#                          regression (default: 0.1)
+#   --all                  print all benchmarks, not only the changed ones
+# ```
+#
+# The exit code is 1 if any of the benchmarks has regressed.
+
+import argparse
+import json
+import sys
+
+
+def load_results(filename):
+    with open(filename) as fh:
+        data = json.load(fh)
+
+    results = {}
+    for entry in data['benchmarks']:
+        # the results of dist_scaling.py are distinguished by the number of
+        # localities and the kind of scaling as well
+        key = (entry['name'], entry['dtype'], entry['dims'], entry['size'],
+               entry.get('localities', 1), entry.get('mode', ''))
+        results[key] = entry
+
+    return data.get('context', {}), results
+
+
+def compare(baseline, current, threshold, print_all):
+    regressions = 0
+    improvements = 0
+
+    print('{:<18} {:>8} {:>4} {:>11} {:>4} {:>14} {:>14} {:>8}'.format(
+        'benchmark', 'dtype', 'dims', 'size', 'locs', 'baseline [ns]',
+        'current [ns]', 'ratio'))
+
+    for key in sorted(current.keys()):
+        if key not in baseline:
+            continue
+
+        old = baseline[key]['median_ns']
+        new = current[key]['median_ns']
+        ratio = new / old if old > 0 else 1.0
+
+        status = ''
+        if ratio > 1.0 + threshold:
+            status = 'REGRESSION'
+            regressions += 1
+        elif ratio < 1.0 / (1.0 + threshold):
+            status = 'improvement'
+            improvements += 1
+        elif not print_all:
+            continue
+
+        line = '{:<18} {:>8} {:>4} {:>11} {:>4} {:>14.1f} {:>14.1f} {:>8.3f}  {}'
+        print(line.format(key[0] + (' (' + key[5] + ')' if key[5] else ''),
+                          key[1], key[2], key[3], key[4], old, new, ratio,
+                          status).rstrip())
+
+    missing = [key for key in baseline.keys() if key not in current]
+    if missing:
+        print('{} benchmark(s) of the baseline were not run'.format(
+            len(missing)))
+
+    print('{} regression(s), {} improvement(s) (threshold: {:.0%})'.format(
+        regressions, improvements, threshold))
+
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare the JSON results of two runs of '
+                    'primitive_benchmarks or dist_scaling.py')
+    parser.add_argument('baseline', help='JSON results of the baseline run')
+    parser.add_argument('current', help='JSON results of the run to compare')
+    parser.add_argument('--threshold', type=float, default=0.1,
+                        help='relative slowdown of the median time reported '
+                             'as a regression (default: 0.1)')
+    parser.add_argument('--all', action='store_true',
+                        help='print all benchmarks, not only the changed ones')
+    args = parser.parse_args()
+
+    baseline_context, baseline = load_results(args.baseline)
+    current_context, current = load_results(args.current)
+
+    for name in ('localities', 'threads'):
+        if baseline_context.get(name) != current_context.get(name):
+            print('warning: the runs used a different number of {} '
+                  '({} vs. {})'.format(name, baseline_context.get(name),
+                                       current_context.get(name)))
+
+    return 1 if compare(baseline, current, args.threshold, args.all) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
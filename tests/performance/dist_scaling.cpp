@@ -0,0 +1,450 @@
+//   Copyright (c) 2021 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Scaling benchmarks of the distributed primitives. This program is run on
+// all localities (SPMD style), dist_scaling.py launches it for a series of
+// numbers of localities on a single host and collects the results.
+//
+// For each benchmark the distributed inputs are created first (using
+// random_d), then the primitive is evaluated on all localities. The
+// reported time is the maximum of the evaluation times on all localities.
+// For strong scaling the matrices have a fixed edge length (--size), for
+// weak scaling the number of elements per locality is kept constant
+// (edge length --size * sqrt(number of localities)).
+//
+// The reported number of transferred bytes is the sum of the values of the
+// transferred_bytes counters of all primitives (as far as the primitives
+// keep track of it). Additionally, the number of bytes sent through the
+// parcelport and the time spent transmitting them are collected from the
+// HPX parcelport counters. The time spent in the parcelport (averaged over
+// the localities) is used as the communication time, the remaining time as
+// the computation time.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/modules/collectives.hpp>
+#include <hpx/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct dist_benchmark
+{
+    char const* name;
+    char const* inputs;         // list of distributed inputs of edge size n
+    char const* expression;     // using the inputs a (and b)
+    std::size_t arity;
+    double relative_size;       // edge size relative to --size
+    bool square_localities;     // requires a square number of localities
+};
+
+// clang-format off
+std::vector<dist_benchmark> const benchmarks =
+{
+    {"dot_d", R"(list(
+            random_d(list(n, n), find_here(), num_localities(), "", "row"),
+            random_d(list(n), find_here(), num_localities())
+        ))", "dot_d(a, b)", 2, 1.0, false},
+    {"cannon_product_d", R"(list(
+            random_d(list(n, n), find_here(), num_localities()),
+            random_d(list(n, n), find_here(), num_localities())
+        ))", "cannon_product_d(a, b)", 2, 0.5, true},
+    {"transpose_d", R"(list(
+            random_d(list(n, n), find_here(), num_localities())
+        ))", "transpose_d(a)", 1, 1.0, false},
+    {"retile_d", R"(list(
+            random_d(list(n, n), find_here(), num_localities(), "", "column")
+        ))", R"(retile_d(a, "row"))", 1, 1.0, false},
+    {"all_gather_d", R"(list(
+            random_d(list(n, n), find_here(), num_localities())
+        ))", "all_gather_d(a)", 1, 1.0, false},
+    {"argmax_d", R"(list(
+            random_d(list(n * n), find_here(), num_localities())
+        ))", "argmax_d(a)", 1, 1.0, false},
+    {"inverse_d", R"(list(
+            random_d(list(n, n), find_here(), num_localities(), "", "column")
+        ))", "inverse_d(a)", 1, 0.25, false},
+};
+// clang-format on
+
+///////////////////////////////////////////////////////////////////////////////
+// The values collected on each locality for each evaluation
+enum measurement
+{
+    measured_time = 0,              // [ns]
+    measured_transferred_bytes = 1,
+    measured_parcelport_bytes = 2,
+    measured_parcelport_time = 3,   // [ns]
+    num_measurements = 4
+};
+
+class locality_counters
+{
+public:
+    explicit locality_counters(std::string const& parcelport)
+    {
+        if (hpx::get_num_localities(hpx::launch::sync) == 1)
+        {
+            return;     // no parcels are sent
+        }
+
+        std::string const prefix = "/data{locality#" +
+            std::to_string(hpx::get_locality_id()) + "/total}/";
+
+        try
+        {
+            bytes_sent_ = hpx::performance_counters::performance_counter(
+                prefix + "count/" + parcelport + "/sent");
+            time_sent_ = hpx::performance_counters::performance_counter(
+                prefix + "time/" + parcelport + "/sent");
+            time_received_ = hpx::performance_counters::performance_counter(
+                prefix + "time/" + parcelport + "/received");
+
+            // make sure the counters can be queried
+            bytes_sent_.get_value<std::int64_t>(hpx::launch::sync);
+            available_ = true;
+        }
+        catch (hpx::exception const& e)
+        {
+            if (hpx::get_locality_id() == 0)
+            {
+                std::cerr << "the parcelport counters are not available: "
+                          << e.what() << "\n";
+            }
+        }
+    }
+
+    // the current values of the counters
+    std::vector<std::int64_t> read()
+    {
+        std::vector<std::int64_t> values(num_measurements, 0);
+
+        for (auto const& entry : phylanx::util::retrieve_counter_data(
+                 hpx::find_here()))
+        {
+            // count/eval, time/eval, eval_direct, transferred_bytes
+            if (entry.second.size() >= 4)
+            {
+                values[measured_transferred_bytes] += entry.second[3];
+            }
+        }
+
+        if (available_)
+        {
+            values[measured_parcelport_bytes] =
+                bytes_sent_.get_value<std::int64_t>(hpx::launch::sync);
+            values[measured_parcelport_time] =
+                time_sent_.get_value<std::int64_t>(hpx::launch::sync) +
+                time_received_.get_value<std::int64_t>(hpx::launch::sync);
+        }
+        return values;
+    }
+
+private:
+    bool available_ = false;
+    hpx::performance_counters::performance_counter bytes_sent_;
+    hpx::performance_counters::performance_counter time_sent_;
+    hpx::performance_counters::performance_counter time_received_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+struct scaling_result
+{
+    std::string name;
+    std::int64_t edge;
+    std::size_t repetitions;
+    double min_ns;
+    double median_ns;
+    std::int64_t transferred_bytes;     // per evaluation, all localities
+    std::int64_t parcelport_bytes;
+    double communication_ns;            // per evaluation and locality
+    double comm_compute_ratio;
+};
+
+// run the given benchmark, the results are valid on locality 0 only
+scaling_result run_benchmark(dist_benchmark const& spec, std::int64_t edge,
+    std::size_t repetitions, locality_counters& counters,
+    phylanx::execution_tree::compiler::function_list& snippets)
+{
+    using namespace phylanx::execution_tree;
+
+    std::uint32_t const num_localities =
+        hpx::get_num_localities(hpx::launch::sync);
+    std::uint32_t const locality_id = hpx::get_locality_id();
+
+    std::string const name(spec.name);
+    std::string const parameters = spec.arity == 1 ? "a" : "a, b";
+    std::string const setup_code = "define(setup_" + name + ", n, " +
+        spec.inputs + ")\nsetup_" + name;
+    std::string const run_code = "define(run_" + name + ", " + parameters +
+        ", " + spec.expression + ")\nrun_" + name;
+
+    auto const& compiled_setup =
+        compile("setup_" + name, setup_code, snippets);
+    auto setup = compiled_setup.run();
+
+    auto const& compiled_run = compile("run_" + name, run_code, snippets);
+    auto run = compiled_run.run();
+
+    std::vector<std::vector<std::int64_t>> samples;
+    samples.reserve(repetitions);
+
+    // the first evaluation is used for warming up
+    for (std::size_t i = 0; i <= repetitions; ++i)
+    {
+        auto inputs = extract_list_value_strict(setup(edge)).copy();
+
+        // start all evaluations at the same time
+        std::string const basename =
+            "dist_scaling_" + name + "_" + std::to_string(i);
+        hpx::lcos::barrier(
+            basename + "_barrier", num_localities, locality_id)
+            .wait();
+
+        std::vector<std::int64_t> before = counters.read();
+
+        std::uint64_t t = hpx::chrono::high_resolution_clock::now();
+        if (spec.arity == 1)
+        {
+            run(std::move(inputs[0]));
+        }
+        else
+        {
+            run(std::move(inputs[0]), std::move(inputs[1]));
+        }
+        t = hpx::chrono::high_resolution_clock::now() - t;
+
+        std::vector<std::int64_t> values = counters.read();
+        for (std::size_t j = 0; j != num_measurements; ++j)
+        {
+            values[j] -= before[j];
+        }
+        values[measured_time] = static_cast<std::int64_t>(t);
+
+        std::vector<std::vector<std::int64_t>> all_values =
+            hpx::collectives::all_gather(basename.c_str(), std::move(values),
+                hpx::collectives::num_sites_arg{num_localities},
+                hpx::collectives::this_site_arg{locality_id})
+                .get();
+
+        if (i == 0)
+        {
+            continue;
+        }
+
+        // combine the values of all localities
+        std::vector<std::int64_t> sample(num_measurements, 0);
+        for (auto const& v : all_values)
+        {
+            sample[measured_time] =
+                (std::max)(sample[measured_time], v[measured_time]);
+            for (std::size_t j = 1; j != num_measurements; ++j)
+            {
+                sample[j] += v[j];
+            }
+        }
+        samples.push_back(std::move(sample));
+    }
+
+    std::sort(samples.begin(), samples.end(),
+        [](std::vector<std::int64_t> const& lhs,
+            std::vector<std::int64_t> const& rhs) {
+            return lhs[measured_time] < rhs[measured_time];
+        });
+
+    // all values are reported for the sample with the median time
+    auto const& median = samples[samples.size() / 2];
+
+    scaling_result result;
+    result.name = name;
+    result.edge = edge;
+    result.repetitions = samples.size();
+    result.min_ns = double(samples.front()[measured_time]);
+    result.median_ns = double(median[measured_time]);
+    result.transferred_bytes = median[measured_transferred_bytes];
+    result.parcelport_bytes = median[measured_parcelport_bytes];
+    result.communication_ns = (std::min)(result.median_ns,
+        double(median[measured_parcelport_time]) / num_localities);
+
+    double const computation_ns = result.median_ns - result.communication_ns;
+    result.comm_compute_ratio = computation_ns > 0.0 ?
+        result.communication_ns / computation_ns :
+        0.0;
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void write_json(std::ostream& os, std::vector<scaling_result> const& results,
+    std::string const& mode, std::string const& parcelport)
+{
+    std::uint32_t const num_localities =
+        hpx::get_num_localities(hpx::launch::sync);
+
+    os << "{\n  \"context\": {\n";
+    os << "    \"phylanx_version\": \"" << phylanx::full_version_as_string()
+       << "\",\n";
+    os << "    \"localities\": " << num_localities << ",\n";
+    os << "    \"threads\": " << hpx::get_os_thread_count() << ",\n";
+    os << "    \"mode\": \"" << mode << "\",\n";
+    os << "    \"parcelport\": \"" << parcelport << "\"\n  },\n";
+    os << "  \"benchmarks\": [";
+
+    os << std::setprecision(17);
+    bool first = true;
+    for (auto const& r : results)
+    {
+        os << (first ? "\n" : ",\n");
+        first = false;
+
+        os << "    {\"name\": \"" << r.name
+           << "\", \"dtype\": \"float64\", \"dims\": 2, \"size\": "
+           << r.edge * r.edge << ", \"edge\": " << r.edge
+           << ", \"localities\": " << num_localities << ", \"mode\": \""
+           << mode << "\", \"repetitions\": " << r.repetitions
+           << ", \"min_ns\": " << r.min_ns << ", \"median_ns\": "
+           << r.median_ns << ", \"transferred_bytes\": " << r.transferred_bytes
+           << ", \"parcelport_bytes\": " << r.parcelport_bytes
+           << ", \"communication_ns\": " << r.communication_ns
+           << ", \"comm_compute_ratio\": " << r.comm_compute_ratio << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    std::uint32_t const num_localities =
+        hpx::get_num_localities(hpx::launch::sync);
+    std::uint32_t const locality_id = hpx::get_locality_id();
+
+    std::string const mode = vm["mode"].as<std::string>();
+    if (mode != "strong" && mode != "weak")
+    {
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "hpx_main",
+            "the mode has to be either 'strong' or 'weak', given: " + mode);
+    }
+
+    std::int64_t const size = vm["size"].as<std::int64_t>();
+    std::size_t const repetitions = vm["repetitions"].as<std::size_t>();
+    std::string const parcelport = vm["parcelport"].as<std::string>();
+    std::regex const filter(vm["filter"].as<std::string>());
+
+    std::uint32_t const root =
+        std::uint32_t(std::lround(std::sqrt(double(num_localities))));
+    bool const square_localities = root * root == num_localities;
+
+    locality_counters counters(parcelport);
+    phylanx::execution_tree::compiler::function_list snippets;
+    std::vector<scaling_result> results;
+
+    if (locality_id == 0)
+    {
+        std::cout << mode << " scaling on " << num_localities
+                  << " localities:\n";
+    }
+
+    for (auto const& spec : benchmarks)
+    {
+        if (!std::regex_search(spec.name, filter) ||
+            (spec.square_localities && !square_localities))
+        {
+            continue;
+        }
+
+        // keep the number of elements per locality constant for weak scaling
+        double edge = spec.relative_size * size;
+        if (mode == "weak")
+        {
+            edge *= std::sqrt(double(num_localities));
+        }
+
+        // the Cannon product requires the edge size to be divisible by the
+        // square root of the number of localities
+        std::int64_t n = (std::max)(std::int64_t(edge), std::int64_t(1));
+        if (spec.square_localities)
+        {
+            n = (std::max)(n / root, std::int64_t(1)) * root;
+        }
+
+        scaling_result result =
+            run_benchmark(spec, n, repetitions, counters, snippets);
+
+        if (locality_id == 0)
+        {
+            std::cout << std::setw(18) << std::left << result.name
+                      << std::right << std::setw(8) << result.edge
+                      << std::fixed << std::setprecision(3) << std::setw(12)
+                      << result.median_ns / 1e6 << " ms" << std::setw(14)
+                      << result.transferred_bytes << " B" << std::setw(14)
+                      << result.parcelport_bytes << " B (parcelport)"
+                      << std::setw(10) << result.comm_compute_ratio
+                      << " comm/comp\n"
+                      << std::defaultfloat;
+        }
+        results.push_back(std::move(result));
+    }
+
+    if (locality_id == 0 && vm.count("output") != 0)
+    {
+        std::string const filename = vm["output"].as<std::string>();
+        std::ofstream os(filename);
+        if (!os.good())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error, "hpx_main",
+                "Failed to open the specified file: " + filename);
+        }
+        write_json(os, results, mode, parcelport);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = hpx::program_options;
+
+    // command line handling
+    po::options_description desc("usage: dist_scaling [options]");
+    desc.add_options()
+        ("mode", po::value<std::string>()->default_value("strong"),
+            "'strong' (fixed problem size) or 'weak' (fixed problem size "
+            "per locality) scaling (default: strong)")
+        ("size", po::value<std::int64_t>()->default_value(1000),
+            "edge length of the matrices, per locality for weak scaling "
+            "(default: 1000)")
+        ("repetitions", po::value<std::size_t>()->default_value(5),
+            "number of evaluations per benchmark (default: 5)")
+        ("parcelport", po::value<std::string>()->default_value("tcp"),
+            "the parcelport whose counters are collected (default: tcp)")
+        ("filter", po::value<std::string>()->default_value(""),
+            "run only the benchmarks whose name matches the given regular "
+            "expression")
+        ("output,o", po::value<std::string>(),
+            "write the results as JSON to the given file")
+        ;
+
+    // run hpx_main on all localities
+    std::vector<std::string> cfg = {"hpx.run_hpx_main!=1"};
+
+    hpx::init_params params;
+    params.desc_cmdline = desc;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
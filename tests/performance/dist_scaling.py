@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+# Copyright (c) 2021 Hartmut Kaiser
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# ## Synopsis
+# ```
+# usage: dist_scaling.py [-h] [--localities LOCALITIES] [--threads THREADS]
+#                        [--mode {strong,weak,both}] [--parcelport PARCELPORT]
+#                        [--phylanxrun PHYLANXRUN] [--output OUTPUT]
+#                        executable [args ...]
+#
+# Run the scaling benchmarks of the distributed primitives for a series of
+# numbers of localities on this host
+#
+# positional arguments:
+#   executable             the dist_scaling_test executable
+#   args                   additional arguments passed to the executable
+#                          (e.g. --size=2000 --filter=dot_d)
+#
+# optional arguments:
+#   -h, --help             show this help message and exit
+#   --localities LOCALITIES
+#                          comma separated numbers of localities
+#                          (default: 1,2,4)
+#   --threads THREADS      number of threads per locality (default: 1)
+#   --mode {strong,weak,both}
+#                          kind of scaling to measure (default: both)
+#   --parcelport PARCELPORT
+#                          parcelport to use (default: tcp)
+#   --phylanxrun PHYLANXRUN
+#                          path of phylanxrun.py (default: next to the
+#                          executable)
+#   --output OUTPUT        write the combined results as JSON to this file,
+#                          the file can be compared against a baseline using
+#                          compare_benchmarks.py
+# ```
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def run(args, localities, mode, extra_args):
+    fd, output = tempfile.mkstemp(suffix='.json')
+    os.close(fd)
+
+    cmd = [sys.executable, args.phylanxrun, args.executable,
+           '-l', str(localities), '-t', str(args.threads),
+           '-p', args.parcelport, '--',
+           '--mode=' + mode, '--parcelport=' + args.parcelport,
+           '--output=' + output] + extra_args
+
+    try:
+        if subprocess.call(cmd) != 0:
+            print('error: {} scaling on {} localities failed'.format(
+                mode, localities), file=sys.stderr)
+            return None
+
+        with open(output) as fh:
+            return json.load(fh)
+
+    finally:
+        os.remove(output)
+
+
+def print_summary(results, mode):
+    # the times relative to the smallest number of localities
+    print('\n{} scaling:'.format(mode))
+    print('{:<18} {:>5} {:>7} {:>11} {:>10} {:>14} {:>14} {:>9}'.format(
+        'benchmark', 'locs', 'edge', 'time [ms]',
+        'speedup' if mode == 'strong' else 'efficiency',
+        'transferred', 'parcelport', 'comm/comp'))
+
+    names = []
+    for entry in results:
+        if entry['mode'] == mode and entry['name'] not in names:
+            names.append(entry['name'])
+
+    for name in names:
+        entries = sorted([e for e in results
+                          if e['name'] == name and e['mode'] == mode],
+                         key=lambda e: e['localities'])
+        reference = entries[0]
+
+        for entry in entries:
+            # strong scaling: t(1) / t(N), weak scaling: t(1) / t(N) as well,
+            # which is the parallel efficiency
+            relative = reference['median_ns'] / entry['median_ns'] \
+                if entry['median_ns'] > 0 else 0.0
+            print('{:<18} {:>5} {:>7} {:>11.3f} {:>10.3f} {:>14} {:>14} {:>9.3f}'
+                  .format(name, entry['localities'], entry['edge'],
+                          entry['median_ns'] / 1e6, relative,
+                          entry['transferred_bytes'],
+                          entry['parcelport_bytes'],
+                          entry['comm_compute_ratio']))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Run the scaling benchmarks of the distributed '
+                    'primitives for a series of numbers of localities on '
+                    'this host')
+    parser.add_argument('executable',
+                        help='the dist_scaling_test executable')
+    parser.add_argument('--localities', default='1,2,4',
+                        help='comma separated numbers of localities '
+                             '(default: 1,2,4)')
+    parser.add_argument('--threads', type=int, default=1,
+                        help='number of threads per locality (default: 1)')
+    parser.add_argument('--mode', choices=['strong', 'weak', 'both'],
+                        default='both',
+                        help='kind of scaling to measure (default: both)')
+    parser.add_argument('--parcelport', default='tcp',
+                        help='parcelport to use (default: tcp)')
+    parser.add_argument('--phylanxrun',
+                        help='path of phylanxrun.py (default: next to the '
+                             'executable)')
+    parser.add_argument('--output',
+                        help='write the combined results as JSON to this file')
+    args, extra_args = parser.parse_known_args()
+
+    if args.phylanxrun is None:
+        args.phylanxrun = os.path.join(
+            os.path.dirname(os.path.abspath(args.executable)), 'phylanxrun.py')
+
+    modes = ['strong', 'weak'] if args.mode == 'both' else [args.mode]
+    localities = [int(n) for n in args.localities.split(',') if n]
+
+    context = None
+    results = []
+    failed = False
+
+    for mode in modes:
+        for n in localities:
+            data = run(args, n, mode, extra_args)
+            if data is None:
+                failed = True
+                continue
+
+            context = context or data['context']
+            results.extend(data['benchmarks'])
+
+    for mode in modes:
+        print_summary(results, mode)
+
+    if args.output is not None:
+        context = dict(context or {})
+        context['localities'] = localities
+        context['mode'] = args.mode
+        with open(args.output, 'w') as fh:
+            json.dump({'context': context, 'benchmarks': results}, fh,
+                      indent=2)
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,106 @@
+//   Copyright (c) 2021 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Counts the heap allocations and measures the time needed to evaluate
+// chains of scalar additions through value_operand (which always returns a
+// future) and through value_operand_future_or_value (which returns ready
+// results as plain values). Inner nodes of the chains are evaluated in place
+// once their execution policy has settled on synchronous execution, so the
+// number of allocations per evaluation should not depend on the shared
+// states of the futures of the nodes.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::size_t> allocations(0);
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size != 0 ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// run(x) = x + 1.0 + ... + 1.0, built from nested binary additions
+std::string generate_chain(std::size_t depth)
+{
+    std::string expr = "x";
+    for (std::size_t i = 0; i != depth; ++i)
+    {
+        expr = "(" + expr + " + 1.0)";
+    }
+    return "define(run, x, " + expr + ")\nrun";
+}
+
+template <typename F>
+void measure(std::string const& name, std::size_t depth, F&& eval)
+{
+    constexpr std::size_t iterations = 10000;
+
+    // let the execution policies of all nodes settle
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        eval();
+    }
+
+    std::size_t const start = allocations.load();
+    std::uint64_t t = hpx::chrono::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        eval();
+    }
+
+    t = hpx::chrono::high_resolution_clock::now() - t;
+    std::size_t const count = allocations.load() - start;
+
+    std::cout << name << "(" << depth << "): "
+              << (double(count) / iterations) << " allocations/evaluation, "
+              << (double(t) / iterations) << " ns/evaluation.\n";
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace phylanx::execution_tree;
+
+    compiler::function_list snippets;
+
+    for (std::size_t depth : {1, 8, 64})
+    {
+        auto const& code = compile(generate_chain(depth), snippets);
+        auto run = code.run();
+
+        primitive_arguments_type args{primitive_argument_type{1.0}};
+
+        measure("value_operand", depth, [&]() {
+            return value_operand(run.arg_, args).get();
+        });
+        measure("value_operand_future_or_value", depth, [&]() {
+            return value_operand_future_or_value(run.arg_, args).get();
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+//   Copyright (c) 2021 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark for the LDA trainer. The corpus is either read from a file in
+// the UCI 'bag of words' format (e.g. docword.kos.txt or docword.nips.txt,
+// https://archive.ics.uci.edu/ml/datasets/Bag+of+Words):
+//
+//     D
+//     W
+//     NNZ
+//     docID wordID count
+//     ...
+//
+// or generated randomly. Note that the files in examples/algorithms/datasets
+// are MATLAB files, those have to be converted to the text format first.
+///////////////////////////////////////////////////////////////////////////////
+char const* const lda_code = R"(
+    define(run, topics, iterations, word_doc,
+        lda_trainer(topics, 0.1, 0.01, iterations, word_doc, 42)
+    )
+    run
+)";
+
+blaze::DynamicMatrix<double> read_docword(std::string const& filename)
+{
+    std::ifstream in(filename);
+    if (!in)
+    {
+        throw std::runtime_error("cannot open file: " + filename);
+    }
+
+    std::size_t docs = 0, words = 0, nnz = 0;
+    in >> docs >> words >> nnz;
+
+    blaze::DynamicMatrix<double> word_doc(docs, words, 0.0);
+
+    std::size_t doc = 0, word = 0, count = 0;
+    for (std::size_t i = 0; i != nnz && (in >> doc >> word >> count); ++i)
+    {
+        word_doc(doc - 1, word - 1) = double(count);
+    }
+    return word_doc;
+}
+
+blaze::DynamicMatrix<double> generate_docword(
+    std::size_t docs, std::size_t words, std::size_t doc_length)
+{
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<std::size_t> dist(0, words - 1);
+
+    blaze::DynamicMatrix<double> word_doc(docs, words, 0.0);
+    for (std::size_t d = 0; d != docs; ++d)
+    {
+        for (std::size_t n = 0; n != doc_length; ++n)
+        {
+            word_doc(d, dist(gen)) += 1.0;
+        }
+    }
+    return word_doc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    blaze::DynamicMatrix<double> word_doc;
+    if (vm.count("docword") != 0)
+    {
+        word_doc = read_docword(vm["docword"].as<std::string>());
+    }
+    else
+    {
+        word_doc = generate_docword(vm["documents"].as<std::size_t>(),
+            vm["words"].as<std::size_t>(), vm["doc_length"].as<std::size_t>());
+    }
+
+    auto topics = vm["topics"].as<std::int64_t>();
+    auto iterations = vm["iterations"].as<std::int64_t>();
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code =
+        phylanx::execution_tree::compile("lda_trainer", lda_code, snippets);
+    auto lda = code.run();
+
+    double const tokens = blaze::sum(word_doc);
+
+    hpx::chrono::high_resolution_timer t;
+
+    lda(topics, iterations, std::move(word_doc));
+
+    auto elapsed = t.elapsed();
+
+    std::cout << "lda_trainer: " << topics << " topics, " << iterations
+              << " iterations, " << tokens << " tokens: " << elapsed
+              << " s (" << (tokens * iterations / elapsed)
+              << " tokens/s)\n";
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // command line handling
+    hpx::program_options::options_description desc(
+        "usage: lda_trainer [options]");
+    desc.add_options()
+        ("docword", hpx::program_options::value<std::string>(),
+            "file name of a corpus in UCI bag of words format")
+        ("documents",
+            hpx::program_options::value<std::size_t>()->default_value(10000),
+            "number of generated documents (default: 10000)")
+        ("words",
+            hpx::program_options::value<std::size_t>()->default_value(5000),
+            "number of generated words (default: 5000)")
+        ("doc_length",
+            hpx::program_options::value<std::size_t>()->default_value(100),
+            "number of tokens per generated document (default: 100)")
+        ("topics",
+            hpx::program_options::value<std::int64_t>()->default_value(100),
+            "number of topics (default: 100)")
+        ("iterations",
+            hpx::program_options::value<std::int64_t>()->default_value(50),
+            "number of iterations (default: 50)");
+
+    hpx::init_params params;
+    params.desc_cmdline = desc;
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,551 @@
+//   Copyright (c) 2021 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Micro-benchmarks of the primitives of the plugins. Every benchmark is a
+// PhySL function of one or two arrays wrapping a single primitive, it is
+// invoked for all supported data types and dimensionalities, for sizes from
+// 10 elements up to --max-size elements (in steps of powers of ten). The
+// evaluations of the zero-dimensional variants measure the overhead of
+// dispatching a primitive, the others measure the throughput of its kernel.
+//
+// The results are written as JSON (--output), which can be compared against
+// the results of a baseline run using compare_benchmarks.py.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// The work done by a benchmark for arrays of the given number of elements and
+// the given edge length (the number of columns of matrices, one otherwise)
+using work_function = double (*)(double elements, double edge);
+
+double none(double, double)
+{
+    return 0.0;
+}
+
+template <int N>
+double per_element(double elements, double)
+{
+    return N * elements;
+}
+
+// 2 k^3 for the product of two k x k matrices, 2 n for vectors
+double matrix_product(double elements, double edge)
+{
+    return 2.0 * elements * edge;
+}
+
+// 2/3 k^3 for the LU factorization of a k x k matrix
+double lu_factorization(double elements, double edge)
+{
+    return 2.0 / 3.0 * elements * edge;
+}
+
+enum class arguments
+{
+    unary,              // f(a)
+    binary,             // f(a, b), with a and b of the same shape
+    matrix_vector,      // f(a, b), with a square a and a vector b
+    size                // f(n), with n being the number of elements
+};
+
+struct benchmark_spec
+{
+    char const* name;
+    char const* plugin;
+    char const* expression;     // using the arguments a and b
+    arguments args;
+    std::size_t min_dims;
+    std::size_t max_dims;
+    bool float_only;            // not supported for integer arrays
+    bool regular;               // matrices have to be regular
+    double max_elements;        // largest supported array size
+    work_function flops;        // number of floating point operations
+    work_function streams;      // number of elements read and written
+};
+
+// clang-format off
+std::vector<benchmark_spec> const benchmarks =
+{
+    // arithmetics
+    {"add", "arithmetics", "a + b", arguments::binary, 0, 2,
+        false, false, 1e8, &per_element<1>, &per_element<3>},
+    {"sub", "arithmetics", "a - b", arguments::binary, 0, 2,
+        false, false, 1e8, &per_element<1>, &per_element<3>},
+    {"mul", "arithmetics", "a * b", arguments::binary, 0, 2,
+        false, false, 1e8, &per_element<1>, &per_element<3>},
+    {"div", "arithmetics", "a / b", arguments::binary, 0, 2,
+        false, false, 1e8, &per_element<1>, &per_element<3>},
+    {"minus", "arithmetics", "-a", arguments::unary, 0, 2,
+        false, false, 1e8, &per_element<1>, &per_element<2>},
+    {"square", "arithmetics", "square(a)", arguments::unary, 0, 2,
+        false, false, 1e8, &per_element<1>, &per_element<2>},
+    {"exp", "arithmetics", "exp(a)", arguments::unary, 0, 2,
+        true, false, 1e8, &per_element<1>, &per_element<2>},
+    {"sqrt", "arithmetics", "sqrt(a)", arguments::unary, 0, 2,
+        true, false, 1e8, &per_element<1>, &per_element<2>},
+    {"tanh", "arithmetics", "tanh(a)", arguments::unary, 0, 2,
+        true, false, 1e8, &per_element<1>, &per_element<2>},
+    {"cumsum", "arithmetics", "cumsum(a)", arguments::unary, 1, 2,
+        false, false, 1e8, &per_element<1>, &per_element<2>},
+
+    // booleans
+    {"greater", "booleans", "a > b", arguments::binary, 0, 2,
+        false, false, 1e8, &per_element<1>, &per_element<3>},
+    {"where", "booleans", "where(a > b, a, b)", arguments::binary, 0, 2,
+        false, false, 1e8, &per_element<1>, &per_element<4>},
+
+    // matrixops
+    {"dot", "matrixops", "dot(a, b)", arguments::binary, 1, 2,
+        false, false, 1e7, &matrix_product, &per_element<3>},
+    {"transpose", "matrixops", "transpose(a)", arguments::unary, 2, 2,
+        false, false, 1e8, &none, &per_element<2>},
+    {"concatenate", "matrixops", "concatenate(list(a, b))",
+        arguments::binary, 1, 2, false, false, 1e8, &none, &per_element<4>},
+    {"flip", "matrixops", "flip(a)", arguments::unary, 1, 2,
+        false, false, 1e8, &none, &per_element<2>},
+    {"slice", "matrixops", "slice(a, list(1, -1))", arguments::unary, 1, 1,
+        false, false, 1e8, &none, &per_element<2>},
+    {"sort", "matrixops", "sort(a)", arguments::unary, 1, 1,
+        false, false, 1e8, &none, &per_element<2>},
+    {"argmax", "matrixops", "argmax(a)", arguments::unary, 1, 2,
+        false, false, 1e8, &per_element<1>, &per_element<1>},
+    {"inverse", "matrixops", "inverse(a)", arguments::unary, 2, 2,
+        true, true, 1e6, &matrix_product, &per_element<2>},
+    {"determinant", "matrixops", "determinant(a)", arguments::unary, 2, 2,
+        true, true, 1e6, &lu_factorization, &per_element<1>},
+
+    // statistics
+    {"sum", "statistics", "sum(a)", arguments::unary, 1, 2,
+        false, false, 1e8, &per_element<1>, &per_element<1>},
+    {"sum_axis", "statistics", "sum(a, 0)", arguments::unary, 2, 2,
+        false, false, 1e8, &per_element<1>, &per_element<1>},
+    {"mean", "statistics", "mean(a)", arguments::unary, 1, 2,
+        false, false, 1e8, &per_element<1>, &per_element<1>},
+    {"var", "statistics", "var(a)", arguments::unary, 1, 2,
+        false, false, 1e8, &per_element<3>, &per_element<2>},
+    {"amax", "statistics", "amax(a)", arguments::unary, 1, 2,
+        false, false, 1e8, &per_element<1>, &per_element<1>},
+    {"prod", "statistics", "prod(a)", arguments::unary, 1, 2,
+        false, false, 1e8, &per_element<1>, &per_element<1>},
+
+    // keras_support
+    {"relu", "keras_support", "relu(a)", arguments::unary, 0, 2,
+        true, false, 1e8, &per_element<1>, &per_element<2>},
+    {"sigmoid", "keras_support", "sigmoid(a)", arguments::unary, 0, 2,
+        true, false, 1e8, &per_element<4>, &per_element<2>},
+    {"softmax", "keras_support", "softmax(a)", arguments::unary, 1, 2,
+        true, false, 1e8, &per_element<4>, &per_element<3>},
+
+    // solvers
+    {"linear_solver_lu", "solvers", "linear_solver_lu(a, b)",
+        arguments::matrix_vector, 2, 2, true, true, 1e6, &lu_factorization,
+        &per_element<1>},
+
+    // controls
+    {"call", "controls", "a", arguments::unary, 0, 0,
+        false, false, 1, &none, &none},
+    {"if", "controls", "if(a > b, a, b)", arguments::binary, 0, 0,
+        false, false, 1, &none, &none},
+    {"for_each", "controls", R"(block(
+            define(s, 0),
+            for_each(lambda(i, store(s, s + i)), range(a)),
+            s
+        ))", arguments::size, 0, 0, false, false, 1e6, &per_element<1>,
+        &none},
+    {"while", "controls", R"(block(
+            define(i, 0),
+            while(i < a, store(i, i + 1)),
+            i
+        ))", arguments::size, 0, 0, false, false, 1e6, &per_element<1>,
+        &none},
+};
+// clang-format on
+
+///////////////////////////////////////////////////////////////////////////////
+struct benchmark_options
+{
+    double max_size;
+    double min_time;            // minimal time per measurement [s]
+    std::size_t max_repetitions;
+    std::vector<std::string> dtypes;
+    std::regex filter;
+};
+
+struct benchmark_result
+{
+    std::string name;
+    std::string plugin;
+    std::string dtype;
+    std::size_t dims;
+    std::int64_t size;          // number of elements
+    std::size_t repetitions;
+    double min_ns;              // per evaluation
+    double median_ns;
+    double gflops;              // based on the median time
+    double gbytes;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// The number of elements and the edge length (the number of columns) of the
+// arrays of the given dimensionality holding roughly the given number of
+// elements
+std::pair<std::int64_t, std::int64_t> array_extent(
+    std::size_t dims, std::int64_t size)
+{
+    if (dims == 0)
+    {
+        return std::make_pair(std::int64_t(1), std::int64_t(1));
+    }
+    if (dims == 1)
+    {
+        return std::make_pair(size, std::int64_t(1));
+    }
+
+    // matrices are square
+    std::int64_t const edge = std::int64_t(std::sqrt(double(size)));
+    return std::make_pair(edge * edge, edge);
+}
+
+// random values in [1, 2) (or [1, 10] for integers), matrices that have to be
+// regular are made diagonally dominant
+template <typename T>
+phylanx::execution_tree::primitive_argument_type make_argument(
+    std::size_t dims, std::int64_t size, bool regular, std::uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(1.0, 2.0);
+    std::uniform_int_distribution<std::int64_t> int_dist(1, 10);
+
+    auto value = [&]() {
+        return std::is_integral<T>::value ? T(int_dist(gen)) : T(dist(gen));
+    };
+
+    if (dims == 0)
+    {
+        return phylanx::ir::node_data<T>{value()};
+    }
+
+    auto const extent = array_extent(dims, size);
+    if (dims == 1)
+    {
+        blaze::DynamicVector<T> v(extent.first);
+        for (auto& e : v)
+        {
+            e = value();
+        }
+        return phylanx::ir::node_data<T>{std::move(v)};
+    }
+
+    std::size_t const edge = std::size_t(extent.second);
+    blaze::DynamicMatrix<T> m(edge, edge);
+    for (std::size_t i = 0; i != edge; ++i)
+    {
+        for (std::size_t j = 0; j != edge; ++j)
+        {
+            m(i, j) = value();
+        }
+        if (regular)
+        {
+            m(i, i) += T(20 * edge);
+        }
+    }
+    return phylanx::ir::node_data<T>{std::move(m)};
+}
+
+phylanx::execution_tree::primitive_argument_type make_argument(
+    std::string const& dtype, std::size_t dims, std::int64_t size,
+    bool regular, std::uint32_t seed)
+{
+    if (dtype == "int64")
+    {
+        return make_argument<std::int64_t>(dims, size, regular, seed);
+    }
+    return make_argument<double>(dims, size, regular, seed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+benchmark_result measure(benchmark_options const& options, F&& f)
+{
+    // warm up, this also lets the execution policies of the primitives
+    // settle
+    f();
+
+    std::vector<double> times;
+    double total = 0.0;
+    while (times.size() < options.max_repetitions &&
+        (times.size() < 3 || total < options.min_time))
+    {
+        std::uint64_t t = hpx::chrono::high_resolution_clock::now();
+        f();
+        t = hpx::chrono::high_resolution_clock::now() - t;
+
+        times.push_back(double(t));
+        total += t / 1e9;
+    }
+
+    std::sort(times.begin(), times.end());
+
+    benchmark_result result;
+    result.repetitions = times.size();
+    result.min_ns = times.front();
+    result.median_ns = times[times.size() / 2];
+    return result;
+}
+
+void run_benchmark(benchmark_spec const& spec,
+    benchmark_options const& options,
+    phylanx::execution_tree::compiler::function_list& snippets,
+    std::vector<benchmark_result>& results)
+{
+    using phylanx::execution_tree::primitive_argument_type;
+
+    std::string const parameters =
+        spec.args == arguments::unary || spec.args == arguments::size ?
+        "a" : "a, b";
+    std::string const code = "define(bench_" + std::string(spec.name) + ", " +
+        parameters + ", " + spec.expression + ")\nbench_" + spec.name;
+
+    auto const& compiled = phylanx::execution_tree::compile(
+        std::string("bench_") + spec.name, code, snippets);
+    auto bench = compiled.run();
+
+    // the benchmarks taking a size don't depend on the data type
+    std::vector<std::string> const dtypes = spec.args == arguments::size ?
+        std::vector<std::string>{"int64"} :
+        options.dtypes;
+
+    for (std::string const& dtype : dtypes)
+    {
+        if (spec.float_only && dtype != "float64")
+        {
+            continue;
+        }
+
+        for (std::size_t dims = spec.min_dims; dims <= spec.max_dims; ++dims)
+        {
+            // scalar arguments are evaluated once, measuring the overhead
+            // of dispatching the primitive
+            bool const scalar = dims == 0 && spec.args != arguments::size;
+            double const max_size = scalar ?
+                1.0 :
+                (std::min)(options.max_size, spec.max_elements);
+
+            for (double size = scalar ? 1.0 : 10.0; size <= max_size;
+                 size *= 10.0)
+            {
+                auto const extent = array_extent(
+                    spec.args == arguments::size ? 1 : dims,
+                    std::int64_t(size));
+
+                primitive_argument_type a, b;
+                switch (spec.args)
+                {
+                case arguments::size:
+                    a = primitive_argument_type{std::int64_t(size)};
+                    break;
+
+                case arguments::matrix_vector:
+                    b = make_argument(dtype, 1, extent.second, false, 2);
+                    [[fallthrough]];
+
+                case arguments::unary:
+                    a = make_argument(dtype, dims, std::int64_t(size),
+                        spec.regular, 1);
+                    break;
+
+                case arguments::binary:
+                    a = make_argument(dtype, dims, std::int64_t(size),
+                        spec.regular, 1);
+                    b = make_argument(dtype, dims, std::int64_t(size),
+                        spec.regular, 2);
+                    break;
+                }
+
+                benchmark_result result;
+                if (spec.args == arguments::unary ||
+                    spec.args == arguments::size)
+                {
+                    result = measure(options, [&]() { return bench(a); });
+                }
+                else
+                {
+                    result = measure(options, [&]() { return bench(a, b); });
+                }
+
+                double const elements = double(extent.first);
+                double const edge = double(extent.second);
+                std::size_t const element_size = dtype == "int64" ?
+                    sizeof(std::int64_t) : sizeof(double);
+
+                result.name = spec.name;
+                result.plugin = spec.plugin;
+                result.dtype = dtype;
+                result.dims = dims;
+                result.size = extent.first;
+                result.gflops = spec.flops(elements, edge) / result.median_ns;
+                result.gbytes = spec.streams(elements, edge) * element_size /
+                    result.median_ns;
+
+                std::cout << std::setw(18) << std::left << result.name
+                          << std::right << std::setw(8) << result.dtype
+                          << std::setw(3) << result.dims << "d"
+                          << std::setw(11) << result.size << std::fixed
+                          << std::setprecision(1) << std::setw(14)
+                          << result.median_ns << " ns" << std::setprecision(3)
+                          << std::setw(10) << result.gflops << " GFLOP/s"
+                          << std::setw(10) << result.gbytes << " GB/s\n"
+                          << std::defaultfloat;
+
+                results.push_back(std::move(result));
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void write_json(std::ostream& os, std::vector<benchmark_result> const& results)
+{
+    os << "{\n  \"context\": {\n";
+    os << "    \"phylanx_version\": \"" << phylanx::full_version_as_string()
+       << "\",\n";
+    os << "    \"localities\": " << hpx::get_num_localities(hpx::launch::sync)
+       << ",\n";
+    os << "    \"threads\": " << hpx::get_os_thread_count() << "\n  },\n";
+    os << "  \"benchmarks\": [";
+
+    os << std::setprecision(17);
+    bool first = true;
+    for (auto const& r : results)
+    {
+        os << (first ? "\n" : ",\n");
+        first = false;
+
+        os << "    {\"name\": \"" << r.name << "\", \"plugin\": \"" << r.plugin
+           << "\", \"dtype\": \"" << r.dtype << "\", \"dims\": " << r.dims
+           << ", \"size\": " << r.size << ", \"repetitions\": "
+           << r.repetitions << ", \"min_ns\": " << r.min_ns
+           << ", \"median_ns\": " << r.median_ns << ", \"gflops\": "
+           << r.gflops << ", \"gbytes_per_s\": " << r.gbytes << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+std::vector<std::string> split(std::string const& str)
+{
+    std::vector<std::string> result;
+    std::istringstream is(str);
+    for (std::string item; std::getline(is, item, ',');)
+    {
+        if (!item.empty())
+        {
+            result.push_back(item);
+        }
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(hpx::program_options::variables_map& vm)
+{
+    if (vm.count("list") != 0)
+    {
+        for (auto const& spec : benchmarks)
+        {
+            std::cout << spec.plugin << "/" << spec.name << ": "
+                      << spec.expression << "\n";
+        }
+        return hpx::finalize();
+    }
+
+    benchmark_options options;
+    options.max_size = vm["max-size"].as<double>();
+    options.min_time = vm["min-time"].as<double>();
+    options.max_repetitions = vm["max-repetitions"].as<std::size_t>();
+    options.dtypes = split(vm["dtypes"].as<std::string>());
+    options.filter = std::regex(vm["filter"].as<std::string>());
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    std::vector<benchmark_result> results;
+
+    for (auto const& spec : benchmarks)
+    {
+        // the filter is matched against <plugin>/<name>
+        if (!std::regex_search(
+                std::string(spec.plugin) + "/" + spec.name, options.filter))
+        {
+            continue;
+        }
+        run_benchmark(spec, options, snippets, results);
+    }
+
+    if (vm.count("output") != 0)
+    {
+        std::string const filename = vm["output"].as<std::string>();
+        std::ofstream os(filename);
+        if (!os.good())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error, "hpx_main",
+                "Failed to open the specified file: " + filename);
+        }
+        write_json(os, results);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = hpx::program_options;
+
+    // command line handling
+    po::options_description desc("usage: primitive_benchmarks [options]");
+    desc.add_options()
+        ("output,o", po::value<std::string>(),
+            "write the results as JSON to the given file")
+        ("max-size", po::value<double>()->default_value(1e6),
+            "largest number of array elements (up to 1e8, default: 1e6)")
+        ("min-time", po::value<double>()->default_value(0.1),
+            "minimal time spent per measurement in seconds (default: 0.1)")
+        ("max-repetitions",
+            po::value<std::size_t>()->default_value(10000),
+            "maximal number of evaluations per measurement "
+            "(default: 10000)")
+        ("dtypes", po::value<std::string>()->default_value("float64,int64"),
+            "comma separated list of the data types to benchmark "
+            "(default: float64,int64)")
+        ("filter", po::value<std::string>()->default_value(""),
+            "run only the benchmarks whose <plugin>/<name> matches the "
+            "given regular expression")
+        ("list", "list all benchmarks")
+        ;
+
+    hpx::init_params params;
+    params.desc_cmdline = desc;
+    return hpx::init(argc, argv, params);
+}
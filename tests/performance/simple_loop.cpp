@@ -72,6 +72,35 @@ std::string const bench2_intidx = R"(
     run
 )";
 
+// loops with trivial bodies, these measure the overhead per iteration
+std::string const loop_while = R"(
+    define(run, n, block(
+        define(i, 0),
+        while(i < n, store(i, i + 1)),
+        i
+    ))
+    run
+)";
+
+std::string const loop_for = R"(
+    define(run, n, block(
+        define(i, 0),
+        define(z, 0),
+        for(store(i, 0), i < n, store(i, i + 1), store(z, z + i)),
+        z
+    ))
+    run
+)";
+
+std::string const loop_for_each = R"(
+    define(run, n, block(
+        define(z, 0),
+        for_each(lambda(i, store(z, z + i)), range(n)),
+        z
+    ))
+    run
+)";
+
 ///////////////////////////////////////////////////////////////////////////////
 template <typename Data>
 void benchmark(std::string const& name,
@@ -91,6 +120,26 @@ void benchmark(std::string const& name,
     std::cout << name << ": " << (t / 1e6) << " ms.\n";
 }
 
+void benchmark_iterations(std::string const& name,
+    phylanx::execution_tree::compiler::function_list& snippets,
+    std::string const& codestr)
+{
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets);
+    auto bench = code.run();
+
+    for (std::int64_t n : {1000, 10000, 100000, 1000000})
+    {
+        std::uint64_t t = hpx::chrono::high_resolution_clock::now();
+
+        bench(n);
+
+        t = hpx::chrono::high_resolution_clock::now() - t;
+
+        std::cout << name << "(" << n << "): " << (t / 1e6) << " ms, "
+                  << (double(t) / n) << " ns/iteration.\n";
+    }
+}
+
 int main(int argc, char* argv[])
 {
     phylanx::execution_tree::compiler::function_list snippets;
@@ -109,6 +158,10 @@ int main(int argc, char* argv[])
     benchmark("bench1_intidx", snippets, bench1_intidx, y);
     benchmark("bench2_intidx", snippets, bench2_intidx, y);
 
+    benchmark_iterations("loop_while", snippets, loop_while);
+    benchmark_iterations("loop_for", snippets, loop_for);
+    benchmark_iterations("loop_for_each", snippets, loop_for_each);
+
     return 0;
 }
 
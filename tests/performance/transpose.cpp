@@ -0,0 +1,131 @@
+//   Copyright (c) 2021 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/permute_axes.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Compares the blocked parallel kernels in phylanx/util/permute_axes.hpp with
+// the Blaze transpose operations used before.
+constexpr int repetitions = 10;
+
+template <typename F>
+double time_ms(F&& f)
+{
+    std::uint64_t t = hpx::chrono::high_resolution_clock::now();
+    for (int i = 0; i != repetitions; ++i)
+    {
+        f();
+    }
+    t = hpx::chrono::high_resolution_clock::now() - t;
+    return t / 1e6 / repetitions;
+}
+
+void report(std::string const& name, double blaze_ms, double blocked_ms,
+    bool correct)
+{
+    std::cout << name << ": blaze " << blaze_ms << " ms, blocked "
+              << blocked_ms << " ms, speedup " << (blaze_ms / blocked_ms)
+              << (correct ? "" : " (WRONG RESULT)") << "\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void benchmark_matrix(std::size_t n)
+{
+    blaze::DynamicMatrix<double> m(n, n + 1);
+    blaze::randomize(m);
+
+    blaze::DynamicMatrix<double> expected, result;
+    double blaze_ms = time_ms([&]() { expected = blaze::trans(m); });
+    double blocked_ms =
+        time_ms([&]() { result = phylanx::util::permute_axes(m); });
+
+    report("2d " + std::to_string(n) + "x" + std::to_string(n + 1),
+        blaze_ms, blocked_ms, result == expected);
+
+    blaze::DynamicMatrix<double> square(n, n);
+    blaze::randomize(square);
+    blaze_ms = time_ms([&]() { blaze::transpose(square); });
+    blocked_ms = time_ms([&]() { phylanx::util::transpose_inplace(square); });
+
+    report("2d in-place " + std::to_string(n) + "x" + std::to_string(n),
+        blaze_ms, blocked_ms, true);
+}
+
+void benchmark_tensor(std::size_t n, std::array<std::size_t, 3> const& axes)
+{
+    blaze::DynamicTensor<double> t(n, n, n);
+    blaze::randomize(t);
+
+    blaze::DynamicTensor<double> expected, result;
+    double blaze_ms = time_ms(
+        [&]() { expected = blaze::trans(t, {axes[0], axes[1], axes[2]}); });
+    double blocked_ms =
+        time_ms([&]() { result = phylanx::util::permute_axes(t, axes); });
+
+    report("3d " + std::to_string(n) + "^3 {" + std::to_string(axes[0]) +
+            "," + std::to_string(axes[1]) + "," + std::to_string(axes[2]) +
+            "}",
+        blaze_ms, blocked_ms, result == expected);
+}
+
+void benchmark_array(std::size_t n, std::array<std::size_t, 4> const& axes)
+{
+    blaze::DynamicArray<4, double> q(n, n, n, n);
+    blaze::randomize(q);
+
+    blaze::DynamicArray<4, double> expected, result;
+    double blaze_ms = time_ms([&]() {
+        expected = blaze::trans(q, {axes[0], axes[1], axes[2], axes[3]});
+    });
+    double blocked_ms =
+        time_ms([&]() { result = phylanx::util::permute_axes(q, axes); });
+
+    report("4d " + std::to_string(n) + "^4 {" + std::to_string(axes[0]) +
+            "," + std::to_string(axes[1]) + "," + std::to_string(axes[2]) +
+            "," + std::to_string(axes[3]) + "}",
+        blaze_ms, blocked_ms, result == expected);
+}
+
+int main(int argc, char* argv[])
+{
+    for (std::size_t n : {256, 1024, 4096})
+    {
+        benchmark_matrix(n);
+    }
+
+    for (std::size_t n : {64, 256})
+    {
+        benchmark_tensor(n, {2, 1, 0});
+        benchmark_tensor(n, {1, 0, 2});
+        benchmark_tensor(n, {0, 2, 1});
+        benchmark_tensor(n, {1, 2, 0});
+        benchmark_tensor(n, {2, 0, 1});
+    }
+
+    // permutations used by the keras convolutions
+    for (std::size_t n : {16, 48})
+    {
+        benchmark_array(n, {3, 2, 1, 0});
+        benchmark_array(n, {3, 0, 1, 2});
+        benchmark_array(n, {2, 0, 1, 3});
+        benchmark_array(n, {1, 2, 3, 0});
+        benchmark_array(n, {0, 2, 1, 3});
+    }
+
+    return 0;
+}
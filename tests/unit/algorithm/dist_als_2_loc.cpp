@@ -0,0 +1,128 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const als_test = R"(
+    als([[0.0,4.0,0.0,0.0,0.0],
+         [1.0,0.0,4.0,0.0,5.0],
+         [0.0,0.0,0.0,2.0,0.0],
+         [0.0,8.0,0.0,0.0,0.0],
+         [0.0,0.0,4.0,0.0,0.0],
+         [0.0,0.0,0.0,0.0,0.0],
+         [0.0,0.0,0.0,0.0,2.0],
+         [1.0,0.0,0.0,0.0,0.0],
+         [0.0,0.0,0.0,5.0,0.0],
+         [1.0,0.0,0.0,2.0,0.0]], 0.1, 3, 10, 40)
+)";
+
+char const* const dist_als_test_0 = R"(
+    als_d(annotate_d(
+            [[0.0,4.0,0.0,0.0,0.0],
+             [1.0,0.0,4.0,0.0,5.0],
+             [0.0,0.0,0.0,2.0,0.0],
+             [0.0,8.0,0.0,0.0,0.0],
+             [0.0,0.0,4.0,0.0,0.0]], "dist_als_ratings",
+            list("tile", list("rows", 0, 5), list("columns", 0, 5))),
+        0.1, 3, 10, 40)
+)";
+
+char const* const dist_als_test_1 = R"(
+    als_d(annotate_d(
+            [[0.0,0.0,0.0,0.0,0.0],
+             [0.0,0.0,0.0,0.0,2.0],
+             [1.0,0.0,0.0,0.0,0.0],
+             [0.0,0.0,0.0,5.0,0.0],
+             [1.0,0.0,0.0,2.0,0.0]], "dist_als_ratings",
+            list("tile", list("rows", 5, 10), list("columns", 0, 5))),
+        0.1, 3, 10, 40)
+)";
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+std::pair<blaze::DynamicMatrix<double>, blaze::DynamicMatrix<double>>
+extract_factors(phylanx::execution_tree::primitive_argument_type&& result)
+{
+    auto factors = phylanx::execution_tree::extract_list_value(result);
+    HPX_TEST_EQ(factors.size(), std::size_t(2));
+
+    auto it = factors.begin();
+    blaze::DynamicMatrix<double> X =
+        phylanx::execution_tree::extract_numeric_value(*it++).matrix();
+    blaze::DynamicMatrix<double> Y =
+        phylanx::execution_tree::extract_numeric_value(*it).matrix();
+
+    return std::make_pair(std::move(X), std::move(Y));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the distributed algorithm has to produce the same factors as the local one
+void test_dist_als()
+{
+    std::size_t const loc_id = hpx::get_locality_id();
+
+    auto expected = extract_factors(compile_and_run("als", als_test));
+    auto result = extract_factors(compile_and_run("dist_als",
+        loc_id == 0 ? dist_als_test_0 : dist_als_test_1));
+
+    // users are distributed as given, the five items are distributed evenly
+    std::size_t const user_start = loc_id == 0 ? 0 : 5;
+    std::size_t const item_start = loc_id == 0 ? 0 : 2;
+    std::size_t const num_items = loc_id == 0 ? 2 : 3;
+
+    HPX_TEST_EQ(result.first.rows(), std::size_t(5));
+    HPX_TEST_EQ(result.second.rows(), num_items);
+
+    HPX_TEST_LT(blaze::max(blaze::abs(result.first -
+                    blaze::submatrix(expected.first, user_start, 0, 5, 3))),
+        1e-10);
+    HPX_TEST_LT(blaze::max(blaze::abs(result.second -
+                    blaze::submatrix(
+                        expected.second, item_start, 0, num_items, 3))),
+        1e-10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_dist_als();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
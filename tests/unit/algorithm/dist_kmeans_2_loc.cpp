@@ -0,0 +1,159 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const points = R"(
+    define(points, [[ 0.75,  0.25], [ 1.25,  3.  ], [ 2.75,  3.  ],
+                    [ 1.  ,  0.25], [ 3.  ,  0.25], [ 1.5 ,  2.75],
+                    [ 3.  ,  0.  ], [ 3.  ,  3.  ], [ 2.75,  2.25],
+                    [ 2.5 ,  1.75], [11.  ,  4.5 ], [10.5 ,  3.  ],
+                    [ 9.5 ,  5.  ], [10.  ,  3.5 ], [11.25,  6.25],
+                    [ 9.25,  3.  ], [11.75,  0.75], [10.  ,  2.75],
+                    [12.  ,  5.75], [15.25,  2.25], [-3.  , 14.75],
+                    [ 4.75, 10.25], [-1.25, 13.25], [-0.25, 13.  ],
+                    [ 0.75,  9.25], [-0.25,  9.25], [ 2.5 ,  8.75],
+                    [-2.25, 10.25], [-2.25, 10.75], [ 2.5 , 11.75]])
+)";
+
+char const* const local_points_0 = R"(
+    define(local_points, annotate_d(slice(points, list(0, 15), nil),
+        "kmeans_points",
+        list("tile", list("rows", 0, 15), list("columns", 0, 2))))
+)";
+
+char const* const local_points_1 = R"(
+    define(local_points, annotate_d(slice(points, list(15, 30), nil),
+        "kmeans_points",
+        list("tile", list("rows", 15, 30), list("columns", 0, 2))))
+)";
+
+char const* const points_3d_0 = R"(
+    define(local_points, annotate_d(
+        [[ 0.5,  0. ,   0. ], [-0.5,  0. ,   0. ],
+         [ 0. ,  0.5,   0. ], [ 0. , -0.5,   0. ],
+         [10. , 10. ,  10.5], [10. , 10. ,   9.5]],
+        "kmeans_points_3d",
+        list("tile", list("rows", 0, 6), list("columns", 0, 3))))
+)";
+
+char const* const points_3d_1 = R"(
+    define(local_points, annotate_d(
+        [[10.5, 10. ,  10. ], [ 9.5, 10. ,  10. ],
+         [ 0. , 10. , -10.5], [ 0. , 10. ,  -9.5],
+         [ 0.5, 10. , -10. ], [-0.5, 10. , -10. ]],
+        "kmeans_points_3d",
+        list("tile", list("rows", 6, 12), list("columns", 0, 3))))
+)";
+
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_kmeans_d(std::string const& name, std::string const& code,
+    std::string const& expected)
+{
+    std::string const data = std::string(points) +
+        (hpx::get_locality_id() == 0 ? local_points_0 : local_points_1);
+
+    HPX_TEST_EQ(compile_and_run(name, data + code),
+        compile_and_run(name, data + expected));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the distributed algorithm chooses the same random initial centroids and
+// has to produce the same result as the local one
+void test_kmeans_d_random()
+{
+    test_kmeans_d("test_kmeans_d_random", R"(
+        kmeans_d(local_points, 3, 5, false, 7)
+    )", R"(
+        kmeans(points, 3, 5, false, 7)
+    )");
+}
+
+void test_kmeans_d_initial_centroids()
+{
+    test_kmeans_d("test_kmeans_d_initial_centroids", R"(
+        kmeans_d(local_points, 3, 5, false, nil,
+            [[-3., 14.75], [1.5, 2.75], [3., 0.]])
+    )", R"(
+        kmeans(points, 3, 5, false, nil,
+            [[-3., 14.75], [1.5, 2.75], [3., 0.]])
+    )");
+}
+
+// k-means++ picks one point of each of the well separated clusters
+void test_kmeans_d_plusplus()
+{
+    std::string const code =
+        std::string(hpx::get_locality_id() == 0 ? points_3d_0 : points_3d_1) +
+        R"(kmeans_d(local_points, 3, 5, false, 1, nil, "k-means++"))";
+
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        compile_and_run("test_kmeans_d_plusplus", code));
+
+    blaze::DynamicMatrix<double> expected{
+        {0., 0., 0.}, {10., 10., 10.}, {0., 10., -10.}};
+
+    // the order of the centroids depends on the seeding
+    auto centroids = result.matrix();
+    HPX_TEST_EQ(centroids.rows(), std::size_t(3));
+    for (std::size_t i = 0; i != expected.rows(); ++i)
+    {
+        bool found = false;
+        for (std::size_t j = 0; j != centroids.rows(); ++j)
+        {
+            if (blaze::norm(blaze::row(centroids, j) -
+                    blaze::row(expected, i)) < 1e-12)
+            {
+                found = true;
+            }
+        }
+        HPX_TEST(found);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_kmeans_d_random();
+    test_kmeans_d_initial_centroids();
+    test_kmeans_d_plusplus();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,128 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/collectives/all_gather.hpp>
+#include <hpx/collectives/all_reduce.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// documents are rows, words are columns
+blaze::DynamicMatrix<double> const word_doc_matrix{
+    {2., 1., 0., 0., 3., 0.}, {0., 0., 4., 1., 0., 2.},
+    {1., 2., 0., 0., 2., 0.}, {0., 0., 1., 3., 0., 1.},
+    {0., 0., 0., 0., 0., 0.}, {3., 0., 1., 0., 1., 1.}};
+
+char const* const local_word_doc_0 = R"(
+    define(local_word_doc, annotate_d(
+        [[2., 1., 0., 0., 3., 0.],
+         [0., 0., 4., 1., 0., 2.],
+         [1., 2., 0., 0., 2., 0.]],
+        "lda_word_doc",
+        list("tile", list("rows", 0, 3), list("columns", 0, 6))))
+)";
+
+char const* const local_word_doc_1 = R"(
+    define(local_word_doc, annotate_d(
+        [[0., 0., 1., 3., 0., 1.],
+         [0., 0., 0., 0., 0., 0.],
+         [3., 0., 1., 0., 1., 1.]],
+        "lda_word_doc",
+        list("tile", list("rows", 3, 6), list("columns", 0, 6))))
+)";
+
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the word-topic counts are the same on all localities and cover the tokens
+// of all documents
+void test_lda_trainer_d(std::string const& name, std::size_t iterations)
+{
+    std::uint32_t const loc_id = hpx::get_locality_id();
+    std::string const code =
+        std::string(loc_id == 0 ? local_word_doc_0 : local_word_doc_1) +
+        "lda_trainer_d(2, 0.1, 0.01, " + std::to_string(iterations) +
+        ", local_word_doc, 42)";
+
+    auto result = phylanx::execution_tree::extract_list_value(
+        compile_and_run(name, code));
+
+    auto it = result.begin();
+    blaze::DynamicMatrix<double> wp =
+        phylanx::execution_tree::extract_numeric_value(*it++).matrix();
+    blaze::DynamicMatrix<double> dp =
+        phylanx::execution_tree::extract_numeric_value(*it).matrix();
+
+    HPX_TEST_EQ(dp.rows(), std::size_t(3));
+    HPX_TEST_EQ(dp.columns(), std::size_t(2));
+    HPX_TEST_EQ(blaze::sum<blaze::rowwise>(dp),
+        blaze::sum<blaze::rowwise>(
+            blaze::submatrix(word_doc_matrix, 3 * loc_id, 0, 3, 6)));
+
+    HPX_TEST_EQ(blaze::sum<blaze::rowwise>(wp),
+        blaze::trans(blaze::sum<blaze::columnwise>(word_doc_matrix)));
+
+    // wp has to be identical on both localities
+    std::vector<blaze::DynamicMatrix<double>> all_wp =
+        hpx::collectives::all_gather(("test_" + name).c_str(), wp,
+            hpx::collectives::num_sites_arg{2},
+            hpx::collectives::this_site_arg{loc_id})
+            .get();
+    HPX_TEST_EQ(all_wp[0], all_wp[1]);
+
+    // the topic totals of the documents of both localities add up to the
+    // topic totals of wp
+    using vector_type = blaze::DynamicVector<double, blaze::rowVector>;
+    vector_type topics = hpx::collectives::all_reduce(
+        ("test_totals_" + name).c_str(),
+        vector_type(blaze::sum<blaze::columnwise>(dp)),
+        std::plus<vector_type>{}, hpx::collectives::num_sites_arg{2},
+        hpx::collectives::this_site_arg{loc_id})
+        .get();
+    HPX_TEST_EQ(topics, vector_type(blaze::sum<blaze::columnwise>(wp)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_lda_trainer_d("test_lda_trainer_d_0", 0);
+    test_lda_trainer_d("test_lda_trainer_d_20", 20);
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const data = R"(
+    define(x, [[15.04, 16.74], [13.82, 24.49], [12.54, 16.32], [23.09, 19.83],
+               [9.268, 12.87], [9.676, 13.14], [12.22, 20.04], [11.06, 17.12],
+               [16.3 , 15.7 ], [15.46, 23.95], [11.74, 14.69], [14.81, 14.7 ],
+               [13.4 , 20.52], [14.58, 13.66], [15.05, 19.07], [11.34, 18.61],
+               [18.31, 20.58], [19.89, 20.26], [12.88, 18.22], [12.75, 16.7 ]])
+    define(y, [1., 0., 1., 0., 1., 1., 1., 1., 1., 0.,
+               1., 1., 0., 1., 0., 1., 0., 0., 1., 1.])
+)";
+
+// every locality holds one half of the samples
+std::string local_data(std::string const& name)
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        return R"(
+            define(local_x, annotate_d(slice(x, list(0, 10), nil), ")" +
+            name + R"(",
+                list("tile", list("rows", 0, 10), list("columns", 0, 2))))
+            define(local_y, slice(y, list(0, 10)))
+        )";
+    }
+    return R"(
+        define(local_x, annotate_d(slice(x, list(10, 20), nil), ")" +
+        name + R"(",
+            list("tile", list("rows", 10, 20), list("columns", 0, 2))))
+        define(local_y, slice(y, list(10, 20)))
+    )";
+}
+
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+blaze::DynamicVector<double> run_weights(
+    std::string const& name, std::string const& code)
+{
+    std::string const codestr =
+        std::string(data) + local_data(name + "_x") + code;
+    return phylanx::execution_tree::extract_numeric_value(
+        compile_and_run(name, codestr))
+        .vector();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// every update combines one batch of each locality, this is the same as
+// using batches holding the corresponding samples of both localities
+void test_lra_sgd_d(std::string const& optimizer)
+{
+    auto weights = run_weights("test_lra_sgd_d_" + optimizer,
+        "lra_sgd_d(local_x, local_y, 1e-3, 4, 10, \"" + optimizer + "\")");
+    auto expected = run_weights("test_lra_sgd_d_expected_" + optimizer,
+        "lra_sgd(x, y, 1e-3, 4, 20, \"" + optimizer + "\")");
+
+    HPX_TEST_LT(blaze::norm(weights - expected), 1e-10);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_lra_sgd_d("sgd");
+    test_lra_sgd_d("adam");
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
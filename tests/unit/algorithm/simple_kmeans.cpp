@@ -11,6 +11,7 @@
 #include <hpx/include/util.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -152,10 +153,73 @@ void test_kmeans_cpp_physl()
         phylanx::ir::node_data<uint8_t>{1});
 }
 
+///////////////////////////////////////////////////////////////////////////////
+char const* const kmeans_3d_points = R"(
+    define(points, [[ 0.5,  0. ,   0. ], [-0.5,  0. ,   0. ],
+                    [ 0. ,  0.5,   0. ], [ 0. , -0.5,   0. ],
+                    [10. , 10. ,  10.5], [10. , 10. ,   9.5],
+                    [10.5, 10. ,  10. ], [ 9.5, 10. ,  10. ],
+                    [ 0. , 10. , -10.5], [ 0. , 10. ,  -9.5],
+                    [ 0.5, 10. , -10. ], [-0.5, 10. , -10. ]])
+)";
+
+phylanx::execution_tree::primitive_argument_type run_kmeans_3d(
+    std::string const& invocation)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(
+        std::string(kmeans_3d_points) + invocation, snippets);
+    return code.run()();
+}
+
+void test_kmeans_3d()
+{
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        run_kmeans_3d(R"(
+            kmeans(points, 3, 5, false, nil,
+                [[0.5, 0., 0.], [10., 10., 10.5], [0., 10., -10.5]])
+        )"));
+
+    blaze::DynamicMatrix<double> expected{
+        {0., 0., 0.}, {10., 10., 10.}, {0., 10., -10.}};
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)), result);
+}
+
+void test_kmeans_plusplus()
+{
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        run_kmeans_3d(R"(
+            kmeans(points, 3, 5, false, 1, nil, "k-means++")
+        )"));
+
+    blaze::DynamicMatrix<double> expected{
+        {0., 0., 0.}, {10., 10., 10.}, {0., 10., -10.}};
+
+    // the order of the centroids depends on the seeding
+    auto centroids = result.matrix();
+    HPX_TEST_EQ(centroids.rows(), std::size_t(3));
+    for (std::size_t i = 0; i != expected.rows(); ++i)
+    {
+        bool found = false;
+        for (std::size_t j = 0; j != centroids.rows(); ++j)
+        {
+            if (blaze::norm(blaze::row(centroids, j) -
+                    blaze::row(expected, i)) < 1e-12)
+            {
+                found = true;
+            }
+        }
+        HPX_TEST(found);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
     test_kmeans_as_primitive();
     test_kmeans_cpp_physl();
+    test_kmeans_3d();
+    test_kmeans_plusplus();
     return hpx::util::report_errors();
 }
@@ -0,0 +1,94 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// documents are rows, words are columns
+char const* const word_doc = R"(
+    define(word_doc, [[2., 1., 0., 0., 3., 0.],
+                      [0., 0., 4., 1., 0., 2.],
+                      [1., 2., 0., 0., 2., 0.],
+                      [0., 0., 1., 3., 0., 1.],
+                      [0., 0., 0., 0., 0., 0.],
+                      [3., 0., 1., 0., 1., 1.]])
+)";
+
+blaze::DynamicMatrix<double> const word_doc_matrix{
+    {2., 1., 0., 0., 3., 0.}, {0., 0., 4., 1., 0., 2.},
+    {1., 2., 0., 0., 2., 0.}, {0., 0., 1., 3., 0., 1.},
+    {0., 0., 0., 0., 0., 0.}, {3., 0., 1., 0., 1., 1.}};
+
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// every token is assigned to exactly one topic
+void test_lda_trainer_counts(std::string const& code)
+{
+    auto result = phylanx::execution_tree::extract_list_value(
+        compile_and_run("test_lda_trainer", std::string(word_doc) + code));
+
+    auto it = result.begin();
+    blaze::DynamicMatrix<double> wp =
+        phylanx::execution_tree::extract_numeric_value(*it++).matrix();
+    blaze::DynamicMatrix<double> dp =
+        phylanx::execution_tree::extract_numeric_value(*it).matrix();
+
+    HPX_TEST_EQ(wp.rows(), word_doc_matrix.columns());
+    HPX_TEST_EQ(wp.columns(), std::size_t(2));
+    HPX_TEST_EQ(dp.rows(), word_doc_matrix.rows());
+    HPX_TEST_EQ(dp.columns(), std::size_t(2));
+
+    HPX_TEST_EQ(blaze::min(wp), 0.0);
+    HPX_TEST_EQ(blaze::min(dp), 0.0);
+
+    HPX_TEST_EQ(blaze::sum<blaze::rowwise>(wp),
+        blaze::trans(blaze::sum<blaze::columnwise>(word_doc_matrix)));
+    HPX_TEST_EQ(blaze::sum<blaze::rowwise>(dp),
+        blaze::sum<blaze::rowwise>(word_doc_matrix));
+    HPX_TEST_EQ(blaze::sum<blaze::columnwise>(wp),
+        blaze::sum<blaze::columnwise>(dp));
+}
+
+void test_lda_trainer_seed()
+{
+    std::string const code = std::string(word_doc) +
+        "lda_trainer(3, 0.1, 0.01, 10, word_doc, 17)";
+
+    HPX_TEST_EQ(compile_and_run("test_lda_trainer_seed", code),
+        compile_and_run("test_lda_trainer_seed", code));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_lda_trainer_counts("lda_trainer(2, 0.1, 0.01, 0, word_doc, 42)");
+    test_lda_trainer_counts("lda_trainer(2, 0.1, 0.01, 20, word_doc, 42)");
+    test_lda_trainer_counts("lda_trainer(2, 0.5, 0.1, 20, word_doc)");
+    test_lda_trainer_seed();
+
+    return hpx::util::report_errors();
+}
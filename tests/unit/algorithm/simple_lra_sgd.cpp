@@ -0,0 +1,126 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const data = R"(
+    define(x, [[15.04, 16.74], [13.82, 24.49], [12.54, 16.32], [23.09, 19.83],
+               [9.268, 12.87], [9.676, 13.14], [12.22, 20.04], [11.06, 17.12],
+               [16.3 , 15.7 ], [15.46, 23.95], [11.74, 14.69], [14.81, 14.7 ],
+               [13.4 , 20.52], [14.58, 13.66], [15.05, 19.07], [11.34, 18.61],
+               [18.31, 20.58], [19.89, 20.26], [12.88, 18.22], [12.75, 16.7 ]])
+    define(y, [1., 0., 1., 0., 1., 1., 1., 1., 1., 0.,
+               1., 1., 0., 1., 0., 1., 0., 0., 1., 1.])
+)";
+
+char const* const csv_data =
+    "x0,x1,y\n"
+    "15.04,16.74,1\n13.82,24.49,0\n12.54,16.32,1\n23.09,19.83,0\n"
+    "9.268,12.87,1\n9.676,13.14,1\n12.22,20.04,1\n11.06,17.12,1\n"
+    "16.3,15.7,1\n15.46,23.95,0\n11.74,14.69,1\n14.81,14.7,1\n"
+    "13.4,20.52,0\n14.58,13.66,1\n15.05,19.07,0\n11.34,18.61,1\n"
+    "18.31,20.58,0\n19.89,20.26,0\n12.88,18.22,1\n12.75,16.7,1\n";
+
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+blaze::DynamicVector<double> run_weights(
+    std::string const& name, std::string const& code)
+{
+    return phylanx::execution_tree::extract_numeric_value(
+        compile_and_run(name, std::string(data) + code))
+        .vector();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// using all samples as one batch is the same as gradient descent on the mean
+// gradient
+void test_lra_sgd_full_batch()
+{
+    auto expected =
+        run_weights("test_lra_sgd_full_batch", "lra(x, y, 1e-5, 100)");
+    auto weights = run_weights("test_lra_sgd_full_batch",
+        "lra_sgd(x, y, 20 * 1e-5, 100, 20)");
+
+    HPX_TEST_LT(blaze::norm(weights - expected), 1e-10);
+}
+
+void test_lra_sgd_momentum()
+{
+    HPX_TEST_EQ(run_weights("test_lra_sgd_momentum",
+                    R"(lra_sgd(x, y, 1e-3, 5, 6, "momentum", 0.0))"),
+        run_weights("test_lra_sgd_momentum", R"(lra_sgd(x, y, 1e-3, 5, 6))"));
+}
+
+// the streamed batches are the same as the ones taken from memory
+void test_lra_sgd_file()
+{
+    std::string const filename = "simple_lra_sgd_test.csv";
+    {
+        std::ofstream out(filename);
+        out << csv_data;
+    }
+
+    for (std::string optimizer : {"sgd", "momentum", "adam"})
+    {
+        HPX_TEST_EQ(run_weights("test_lra_sgd_file",
+                        "lra_sgd(\"" + filename + "\", nil, 1e-3, 3, 7, \"" +
+                            optimizer + "\")"),
+            run_weights("test_lra_sgd_file",
+                "lra_sgd(x, y, 1e-3, 3, 7, \"" + optimizer + "\")"));
+    }
+
+    std::remove(filename.c_str());
+}
+
+void test_lra_sgd_adam()
+{
+    auto weights = phylanx::execution_tree::extract_numeric_value(
+        compile_and_run("test_lra_sgd_adam", R"(
+            lra_sgd([[1., -2.], [1., -1.], [1., 1.], [1., 2.]],
+                [0., 0., 1., 1.], 0.1, 50, 2, "adam")
+        )"))
+                       .vector();
+
+    HPX_TEST_EQ(weights.size(), std::size_t(2));
+    HPX_TEST_LT(weights[0] - 2. * weights[1], 0.);
+    HPX_TEST_LT(weights[0] - weights[1], 0.);
+    HPX_TEST_LT(0., weights[0] + weights[1]);
+    HPX_TEST_LT(0., weights[0] + 2. * weights[1]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_lra_sgd_full_batch();
+    test_lra_sgd_momentum();
+    test_lra_sgd_file();
+    test_lra_sgd_adam();
+
+    return hpx::util::report_errors();
+}
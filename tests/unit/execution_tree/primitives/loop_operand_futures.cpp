@@ -0,0 +1,150 @@
+//   Copyright (c) 2021 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// The loop primitives run their iterations synchronously as long as the
+// operands return ready values and fall back to continuations whenever an
+// operand returns a pending future. Verify that the loops produce the correct
+// results if both kinds of iterations are interleaved.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_loop(std::string const& code, std::int64_t expected)
+{
+    auto result = compile_and_run(code);
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_scalar_integer_value(result()),
+        expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_while_operation()
+{
+    // the body is pending in every third iteration
+    test_loop(R"(block(
+            define(i, 0),
+            define(s, 0),
+            while(i < 100, block(
+                store(s, s + if(i % 3 == 0, async(i), i)),
+                store(i, i + 1)
+            )),
+            s
+        ))", 4950);
+
+    // the condition is pending in every other iteration
+    test_loop(R"(block(
+            define(i, 0),
+            define(s, 0),
+            while(if(i % 2 == 0, async(i < 100), i < 100), block(
+                store(s, s + i),
+                store(i, i + 1)
+            )),
+            s
+        ))", 4950);
+
+    // the value returned from the last iteration is pending or ready
+    test_loop(R"(block(
+            define(i, 0),
+            while(i < 100, block(
+                store(i, i + 1),
+                if(i % 2 == 0, async(i), i)
+            ))
+        ))", 100);
+
+    test_loop(R"(block(
+            define(i, 0),
+            while(i < 101, block(
+                store(i, i + 1),
+                if(i % 2 == 0, async(i), i)
+            ))
+        ))", 101);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_for_operation()
+{
+    // the body is pending in every third iteration
+    test_loop(R"(block(
+            define(s, 0),
+            for(define(i, 0), i < 100, store(i, i + 1),
+                store(s, s + if(i % 3 == 0, async(i), i))
+            ),
+            s
+        ))", 4950);
+
+    // the condition and the reinit are pending in alternating iterations
+    test_loop(R"(block(
+            define(s, 0),
+            for(define(i, 0), if(i % 2 == 0, async(i < 100), i < 100),
+                store(i, if(i % 2 == 0, i + 1, async(i + 1))),
+                store(s, s + i)
+            ),
+            s
+        ))", 4950);
+
+    // the value returned from the last iteration is pending or ready
+    test_loop(R"(
+            for(define(i, 0), i < 100, store(i, i + 1),
+                if(i % 2 == 0, async(i), i)
+            )
+        )", 99);
+
+    test_loop(R"(
+            for(define(i, 0), i < 101, store(i, i + 1),
+                if(i % 2 == 0, async(i), i)
+            )
+        )", 100);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_for_each()
+{
+    // the function is pending for every third element
+    test_loop(R"(block(
+            define(s, 0),
+            for_each(
+                lambda(i, store(s, s + if(i % 3 == 0, async(i), i))),
+                range(100)
+            ),
+            s
+        ))", 4950);
+
+    // the iteration space is pending
+    test_loop(R"(block(
+            define(s, 0),
+            for_each(
+                lambda(i, store(s, s + if(i % 2 == 0, async(i), i))),
+                async(range(100))
+            ),
+            s
+        ))", 4950);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_while_operation();
+    test_for_operation();
+    test_for_each();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t compile_and_run(std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(codestr, snippets, env);
+    return phylanx::execution_tree::extract_scalar_integer_value(
+        code.run()());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the recursion depth of these would exhaust the stack without eliminating
+// the tail calls
+void test_tail_call_if()
+{
+    std::string const code = R"(block(
+        define(sum, n, acc, if(n == 0, acc, sum(n - 1, acc + n))),
+        sum(100000, 0)
+    ))";
+
+    HPX_TEST_EQ(compile_and_run(code), std::int64_t(5000050000));
+}
+
+void test_tail_call_block()
+{
+    std::string const code = R"(block(
+        define(count, n, acc, block(
+            define(m, n - 1),
+            if(n == 0, acc, count(m, acc + 2))
+        )),
+        count(100000, 0)
+    ))";
+
+    HPX_TEST_EQ(compile_and_run(code), std::int64_t(200000));
+}
+
+// the enclosing function's arguments are bound to the nested function
+void test_tail_call_nested()
+{
+    std::string const code = R"(block(
+        define(scale, x, block(
+            define(loop, n, acc, if(n == 0, acc, loop(n - 1, acc + x))),
+            loop(100000, 0)
+        )),
+        scale(3)
+    ))";
+
+    HPX_TEST_EQ(compile_and_run(code), std::int64_t(300000));
+}
+
+// calls in non-tail position still recurse
+void test_non_tail_call()
+{
+    std::string const code = R"(block(
+        define(fact, n, if(n <= 1, 1, n * fact(n - 1))),
+        fact(20)
+    ))";
+
+    HPX_TEST_EQ(compile_and_run(code), std::int64_t(2432902008176640000));
+}
+
+void test_shadowed_tail_call()
+{
+    std::string const code = R"(block(
+        define(f, n, block(
+            define(f, k, k + 1),
+            f(n)
+        )),
+        f(41)
+    ))";
+
+    HPX_TEST_EQ(compile_and_run(code), std::int64_t(42));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// without memoization this would take exponential time
+void test_memoize()
+{
+    std::string const code = R"(block(
+        define{memoize}(fib, n, if(n < 2, n, fib(n - 1) + fib(n - 2))),
+        fib(80)
+    ))";
+
+    HPX_TEST_EQ(compile_and_run(code), std::int64_t(23416728348467685));
+}
+
+// more different arguments than results are memoized, the least recently
+// used ones are evicted
+void test_memoize_evict()
+{
+    std::string const code = R"(block(
+        define{memoize}(sq, n, n * n),
+        define(sum, n, acc, if(n == 0, acc, sum(n - 1, acc + sq(n)))),
+        sum(10000, 0) + sum(10000, 0)
+    ))";
+
+    HPX_TEST_EQ(compile_and_run(code), std::int64_t(666766670000));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_tail_call_if();
+    test_tail_call_block();
+    test_tail_call_nested();
+
+    test_non_tail_call();
+    test_shadowed_tail_call();
+
+    test_memoize();
+    test_memoize_evict();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <exception>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run().arg_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_compress_operation(std::string const& code,
+    std::string const& expected_str)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
+}
+
+// like numpy, a condition longer than the array is rejected
+void test_compress_operation_throws(std::string const& code)
+{
+    bool exception_thrown = false;
+    try
+    {
+        compile_and_run(code);
+        HPX_TEST(false);
+    }
+    catch (std::exception const&)
+    {
+        exception_thrown = true;
+    }
+
+    HPX_TEST(exception_thrown);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // flattened arrays
+    test_compress_operation("compress([1], 42)", "[42]");
+    test_compress_operation("compress([1, 0, 1], [10, 20, 30])", "[10, 30]");
+    test_compress_operation("compress([0, 1], [10., 20., 30.])", "[20.]");
+    test_compress_operation("compress([0, 0], [1, 2])",
+        R"(hstack(list(), __arg(dtype, "int")))");
+    test_compress_operation(
+        "compress([1, 0, 1], [[1, 2], [3, 4]])", "[1, 3]");
+    test_compress_operation(
+        "compress([0, 1, 0, 1, 0, 1], [[[1, 2], [3, 4]], [[5, 6], [7, 8]]])",
+        "[2, 4, 6]");
+
+    // selection along an axis
+    test_compress_operation("compress([1, 0, 1], [10, 20, 30], 0)", "[10, 30]");
+    test_compress_operation(
+        "compress(hstack(list(false, true)), [[1, 2], [3, 4]], 0)",
+        "[[3, 4]]");
+    test_compress_operation(
+        "compress([0, 1], [[1, 2], [3, 4]], 1)", "[[2], [4]]");
+    test_compress_operation(
+        "compress([1, 1], [[1, 2], [3, 4]], -1)", "[[1, 2], [3, 4]]");
+    test_compress_operation(
+        "compress([1], [[1, 2], [3, 4]], 0)", "[[1, 2]]");
+
+    test_compress_operation(
+        "compress([0, 1], [[[1, 2], [3, 4]], [[5, 6], [7, 8]]], 0)",
+        "[[[5, 6], [7, 8]]]");
+    test_compress_operation(
+        "compress([1, 0], [[[1, 2], [3, 4]], [[5, 6], [7, 8]]], 1)",
+        "[[[1, 2]], [[5, 6]]]");
+    test_compress_operation(
+        "compress([0, 1], [[[1, 2], [3, 4]], [[5, 6], [7, 8]]], 2)",
+        "[[[2], [4]], [[6], [8]]]");
+
+    test_compress_operation_throws("compress([1, 0, 1], 42)");
+    test_compress_operation_throws("compress([1, 0, 1], [10, 20])");
+    test_compress_operation_throws(
+        "compress([1, 0, 1], [[1, 2], [3, 4]], 1)");
+
+    return hpx::util::report_errors();
+}
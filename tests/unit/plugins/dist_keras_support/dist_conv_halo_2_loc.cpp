@@ -0,0 +1,271 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_conv_d_operation(std::string const& name, std::string const& code,
+    std::string const& expected_str)
+{
+    phylanx::execution_tree::primitive_argument_type result =
+        compile_and_run(name, code);
+    phylanx::execution_tree::primitive_argument_type comparison =
+        compile_and_run(name, expected_str);
+
+    HPX_TEST_EQ(hpx::cout, result, comparison);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// spatial parallelization on plain row tiles, the tiles do not overlap and the
+// rows needed from the neighbors are exchanged by conv1d_d
+void test_conv1d_d_halo_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_conv_d_operation("test_conv1d_d_halo_0",
+            R"(
+            conv1d_d(
+                annotate_d(
+                    [[[1, 2], [3, 4]],
+                     [[7, 8], [9, 10]]], "halo_arg_0",
+                    list("tile", list("pages", 0, 2), list("rows", 0, 2),
+                        list("columns", 0, 2))
+                ),
+                [[[ 2, 3,-3,-2], [ 0, 1,-1, 0]],
+                 [[ 1, 1, 2, 1], [-1, 1, 1, 1]]],
+                "same"
+            )
+        )", R"(
+                annotate_d([[[  1.,  12.,   5.,   5.],
+                             [  5.,  24.,   3.,   5.]],
+                            [[ 13.,  48.,  -1.,   5.],
+                             [ 17.,  60.,  -3.,   5.]]],
+                    "halo_arg_0/1", list("tile", list("pages", 0, 2),
+                        list("rows", 0, 2), list("columns", 0, 4))
+                )
+        )");
+    }
+    else
+    {
+        test_conv_d_operation("test_conv1d_d_halo_0",
+            R"(
+            conv1d_d(
+                annotate_d(
+                    [[[5, 6], [7, 8]],
+                     [[11, 12], [1, 2]]], "halo_arg_0",
+                    list("tile", list("pages", 0, 2), list("rows", 2, 4),
+                        list("columns", 0, 2))
+                ),
+                [[[ 2, 3,-3,-2], [ 0, 1,-1, 0]],
+                 [[ 1, 1, 2, 1], [-1, 1, 1, 1]]],
+                "same"
+            )
+        )", R"(
+                annotate_d([[[  9.,  36.,   1.,   5.],
+                             [ 14.,  29., -29., -14.]],
+                            [[ 21.,  48., -41., -19.],
+                             [  2.,   5.,  -5.,  -2.]]],
+                    "halo_arg_0/1", list("tile", list("pages", 0, 2),
+                        list("rows", 2, 4), list("columns", 0, 4))
+                )
+        )");
+    }
+}
+
+void test_conv1d_d_halo_1()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_conv_d_operation("test_conv1d_d_halo_1",
+            R"(
+            conv1d_d(
+                annotate_d(
+                    [[[1, 2], [3, 4]],
+                     [[7, 8], [9, 10]]], "halo_arg_1",
+                    list("tile", list("pages", 0, 2), list("rows", 0, 2),
+                        list("columns", 0, 2))
+                ),
+                [[[ 2, 3,-3,-2], [ 0, 1,-1, 0]],
+                 [[ 1, 1, 2, 1], [-1, 1, 1, 1]]],
+                "causal"
+            )
+        )", R"(
+                annotate_d([[[ -1.,   3.,   4.,   3.],
+                             [  1.,  12.,   5.,   5.]],
+                            [[ -1.,  15.,  22.,  15.],
+                             [ 13.,  48.,  -1.,   5.]]],
+                    "halo_arg_1/1", list("tile", list("pages", 0, 2),
+                        list("rows", 0, 2), list("columns", 0, 4))
+                )
+        )");
+    }
+    else
+    {
+        test_conv_d_operation("test_conv1d_d_halo_1",
+            R"(
+            conv1d_d(
+                annotate_d(
+                    [[[5, 6], [7, 8]],
+                     [[11, 12], [1, 2]]], "halo_arg_1",
+                    list("tile", list("pages", 0, 2), list("rows", 2, 4),
+                        list("columns", 0, 2))
+                ),
+                [[[ 2, 3,-3,-2], [ 0, 1,-1, 0]],
+                 [[ 1, 1, 2, 1], [-1, 1, 1, 1]]],
+                "causal"
+            )
+        )", R"(
+                annotate_d([[[  5.,  24.,   3.,   5.],
+                             [  9.,  36.,   1.,   5.]],
+                            [[ 17.,  60.,  -3.,   5.],
+                             [ 21.,  48., -41., -19.]]],
+                    "halo_arg_1/1", list("tile", list("pages", 0, 2),
+                        list("rows", 2, 4), list("columns", 0, 4))
+                )
+        )");
+    }
+}
+
+void test_conv1d_d_halo_2()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_conv_d_operation("test_conv1d_d_halo_2",
+            R"(
+            conv1d_d(
+                annotate_d(
+                    [[[1, 2], [3, 4]],
+                     [[7, 8], [9, 10]]], "halo_arg_2",
+                    list("tile", list("pages", 0, 2), list("rows", 0, 2),
+                        list("columns", 0, 2))
+                ),
+                [[[ 2, 3,-3,-2], [ 0, 1,-1, 0]],
+                 [[ 1, 1, 2, 1], [-1, 1, 1, 1]]],
+                "valid"
+            )
+        )", R"(
+                annotate_d([[[  1.,  12.,   5.,   5.],
+                             [  5.,  24.,   3.,   5.]],
+                            [[ 13.,  48.,  -1.,   5.],
+                             [ 17.,  60.,  -3.,   5.]]],
+                    "halo_arg_2/1", list("tile", list("pages", 0, 2),
+                        list("rows", 0, 2), list("columns", 0, 4))
+                )
+        )");
+    }
+    else
+    {
+        test_conv_d_operation("test_conv1d_d_halo_2",
+            R"(
+            conv1d_d(
+                annotate_d(
+                    [[[5, 6], [7, 8]],
+                     [[11, 12], [1, 2]]], "halo_arg_2",
+                    list("tile", list("pages", 0, 2), list("rows", 2, 4),
+                        list("columns", 0, 2))
+                ),
+                [[[ 2, 3,-3,-2], [ 0, 1,-1, 0]],
+                 [[ 1, 1, 2, 1], [-1, 1, 1, 1]]],
+                "valid"
+            )
+        )", R"(
+                annotate_d([[[  9.,  36.,   1.,   5.]],
+                            [[ 21.,  48., -41., -19.]]],
+                    "halo_arg_2/1", list("tile", list("pages", 0, 2),
+                        list("rows", 2, 3), list("columns", 0, 4))
+                )
+        )");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// 2d convolution of an image tiled along its height
+void test_conv2d_d_halo_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_conv_d_operation("test_conv2d_d_halo_0", R"(
+            conv2d_d(
+                annotate_d([[[1], [2], [3]], [[4], [5], [6]]], "conv2d_x_0",
+                    list("tile", list("pages", 0, 2), list("rows", 0, 3),
+                        list("columns", 0, 1))
+                ),
+                [[[[1]], [[1]], [[1]]],
+                 [[[1]], [[1]], [[1]]],
+                 [[[1]], [[1]], [[1]]]],
+                "same"
+            )
+        )", R"(
+            annotate_d([[[12.], [21.], [16.]], [[27.], [45.], [33.]]],
+                "conv2d_x_0/1", list("tile", list("pages", 0, 2),
+                    list("rows", 0, 3), list("columns", 0, 1))
+            )
+        )");
+    }
+    else
+    {
+        test_conv_d_operation("test_conv2d_d_halo_0", R"(
+            conv2d_d(
+                annotate_d([[[7], [8], [9]], [[10], [11], [12]]], "conv2d_x_0",
+                    list("tile", list("pages", 2, 4), list("rows", 0, 3),
+                        list("columns", 0, 1))
+                ),
+                [[[[1]], [[1]], [[1]]],
+                 [[[1]], [[1]], [[1]]],
+                 [[[1]], [[1]], [[1]]]],
+                "same"
+            )
+        )", R"(
+            annotate_d([[[45.], [72.], [51.]], [[36.], [57.], [40.]]],
+                "conv2d_x_0/1", list("tile", list("pages", 2, 4),
+                    list("rows", 0, 3), list("columns", 0, 1))
+            )
+        )");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_conv1d_d_halo_0();
+    test_conv1d_d_halo_1();
+    test_conv1d_d_halo_2();
+
+    test_conv2d_d_halo_0();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {"hpx.run_hpx_main!=1"};
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,324 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_elementwise_d_operation(std::string const& name,
+    std::string const& code, std::string const& expected_str)
+{
+    phylanx::execution_tree::primitive_argument_type result =
+        compile_and_run(name, code);
+    phylanx::execution_tree::primitive_argument_type comparison =
+        compile_and_run(name, expected_str);
+
+    HPX_TEST_EQ(hpx::cout, result, comparison);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// both operands have the same tiling
+void test_add_2loc_1d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_elementwise_d_operation("test_add_2loc1d_0", R"(
+            __add_d(
+                annotate_d([1, 2, 3], "add_lhs_1d_0",
+                    list("tile", list("columns", 0, 3))),
+                annotate_d([10, 20, 30], "add_rhs_1d_0",
+                    list("tile", list("columns", 0, 3)))
+            )
+        )", R"(
+            annotate_d([11, 22, 33], "add_lhs_1d_0_add/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_elementwise_d_operation("test_add_2loc1d_0", R"(
+            __add_d(
+                annotate_d([4, 5, 6], "add_lhs_1d_0",
+                    list("tile", list("columns", 3, 6))),
+                annotate_d([40, 50, 60], "add_rhs_1d_0",
+                    list("tile", list("columns", 3, 6)))
+            )
+        )", R"(
+            annotate_d([44, 55, 66], "add_lhs_1d_0_add/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 3, 6))))
+        )");
+    }
+}
+
+// the rhs operand is aligned with the tiling of the lhs operand
+void test_sub_2loc_1d_1()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_elementwise_d_operation("test_sub_2loc1d_1", R"(
+            __sub_d(
+                annotate_d([10, 20, 30], "sub_lhs_1d_1",
+                    list("tile", list("columns", 0, 3))),
+                annotate_d([1, 2], "sub_rhs_1d_1",
+                    list("tile", list("columns", 0, 2)))
+            )
+        )", R"(
+            annotate_d([9, 18, 27], "sub_lhs_1d_1_sub/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_elementwise_d_operation("test_sub_2loc1d_1", R"(
+            __sub_d(
+                annotate_d([40, 50, 60], "sub_lhs_1d_1",
+                    list("tile", list("columns", 3, 6))),
+                annotate_d([3, 4, 5, 6], "sub_rhs_1d_1",
+                    list("tile", list("columns", 2, 6)))
+            )
+        )", R"(
+            annotate_d([36, 45, 54], "sub_lhs_1d_1_sub/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 3, 6))))
+        )");
+    }
+}
+
+// scalars are applied to the local tile
+void test_mul_2loc_1d_2()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_elementwise_d_operation("test_mul_2loc1d_2", R"(
+            __mul_d(
+                annotate_d([1., 2.], "mul_lhs_1d_2",
+                    list("tile", list("rows", 0, 2))),
+                2.
+            )
+        )", R"(
+            annotate_d([2., 4.], "mul_lhs_1d_2_mul/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("rows", 0, 2))))
+        )");
+    }
+    else
+    {
+        test_elementwise_d_operation("test_mul_2loc1d_2", R"(
+            __mul_d(
+                annotate_d([3., 4., 5.], "mul_lhs_1d_2",
+                    list("tile", list("rows", 2, 5))),
+                2.
+            )
+        )", R"(
+            annotate_d([6., 8., 10.], "mul_lhs_1d_2_mul/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("rows", 2, 5))))
+        )");
+    }
+}
+
+// the overlapping lhs tiles make aligning it with the rhs tiling cheaper
+void test_add_2loc_1d_3()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_elementwise_d_operation("test_add_2loc1d_3", R"(
+            __add_d(
+                annotate_d([1, 2, 3, 4], "add_lhs_1d_3",
+                    list("tile", list("columns", 0, 4))),
+                annotate_d([10, 20, 30], "add_rhs_1d_3",
+                    list("tile", list("columns", 0, 3)))
+            )
+        )", R"(
+            annotate_d([11, 22, 33], "add_rhs_1d_3_add/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_elementwise_d_operation("test_add_2loc1d_3", R"(
+            __add_d(
+                annotate_d([3, 4, 5, 6], "add_lhs_1d_3",
+                    list("tile", list("columns", 2, 6))),
+                annotate_d([40, 50, 60], "add_rhs_1d_3",
+                    list("tile", list("columns", 3, 6)))
+            )
+        )", R"(
+            annotate_d([44, 55, 66], "add_rhs_1d_3_add/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 3, 6))))
+        )");
+    }
+}
+
+// the rhs operand is aligned with the tiling of the lhs operand
+void test_maximum_2loc_1d_4()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_elementwise_d_operation("test_maximum_2loc1d_4", R"(
+            maximum_d(
+                annotate_d([10, 20, 30], "max_lhs_1d_4",
+                    list("tile", list("columns", 0, 3))),
+                annotate_d([15, 5], "max_rhs_1d_4",
+                    list("tile", list("columns", 0, 2)))
+            )
+        )", R"(
+            annotate_d([15, 20, 35], "max_lhs_1d_4_max/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_elementwise_d_operation("test_maximum_2loc1d_4", R"(
+            maximum_d(
+                annotate_d([40, 50, 60], "max_lhs_1d_4",
+                    list("tile", list("columns", 3, 6))),
+                annotate_d([35, 45, 70, 1], "max_rhs_1d_4",
+                    list("tile", list("columns", 2, 6)))
+            )
+        )", R"(
+            annotate_d([45, 70, 60], "max_lhs_1d_4_max/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 3, 6))))
+        )");
+    }
+}
+
+// scalars are applied to the local tile
+void test_power_2loc_1d_5()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_elementwise_d_operation("test_power_2loc1d_5", R"(
+            power_d(
+                annotate_d([1., 2.], "power_lhs_1d_5",
+                    list("tile", list("rows", 0, 2))),
+                2.
+            )
+        )", R"(
+            annotate_d([1., 4.], "power_lhs_1d_5_power/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("rows", 0, 2))))
+        )");
+    }
+    else
+    {
+        test_elementwise_d_operation("test_power_2loc1d_5", R"(
+            power_d(
+                annotate_d([3., 4., 5.], "power_lhs_1d_5",
+                    list("tile", list("rows", 2, 5))),
+                2.
+            )
+        )", R"(
+            annotate_d([9., 16., 25.], "power_lhs_1d_5_power/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("rows", 2, 5))))
+        )");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// row-tiled lhs, column-tiled rhs
+void test_lt_2loc_2d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_elementwise_d_operation("test_lt_2loc2d_0", R"(
+            __lt_d(
+                annotate_d([[1, 2, 3, 4]], "lt_lhs_2d_0",
+                    list("tile", list("rows", 0, 1), list("columns", 0, 4))),
+                annotate_d([[2, 2], [1, 1]], "lt_rhs_2d_0",
+                    list("tile", list("rows", 0, 2), list("columns", 0, 2)))
+            )
+        )", R"(
+            annotate_d([[true, false, true, true]], "lt_lhs_2d_0_lt/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("rows", 0, 1), list("columns", 0, 4))))
+        )");
+    }
+    else
+    {
+        test_elementwise_d_operation("test_lt_2loc2d_0", R"(
+            __lt_d(
+                annotate_d([[5, 6, 7, 8]], "lt_lhs_2d_0",
+                    list("tile", list("rows", 1, 2), list("columns", 0, 4))),
+                annotate_d([[5, 5], [9, 9]], "lt_rhs_2d_0",
+                    list("tile", list("rows", 0, 2), list("columns", 2, 4)))
+            )
+        )", R"(
+            annotate_d([[false, false, true, true]], "lt_lhs_2d_0_lt/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("rows", 1, 2), list("columns", 0, 4))))
+        )");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_add_2loc_1d_0();
+    test_sub_2loc_1d_1();
+    test_mul_2loc_1d_2();
+    test_add_2loc_1d_3();
+    test_maximum_2loc_1d_4();
+    test_power_2loc_1d_5();
+
+    test_lt_2loc_2d_0();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
@@ -0,0 +1,176 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_sort_d_operation(std::string const& name, std::string const& code,
+    std::string const& expected_str)
+{
+    phylanx::execution_tree::primitive_argument_type result =
+        compile_and_run(name, code);
+    phylanx::execution_tree::primitive_argument_type comparison =
+        compile_and_run(name, expected_str);
+
+    HPX_TEST_EQ(hpx::cout, result, comparison);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_sort_2loc_1d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_sort_d_operation("test_sort_2loc_1d_0", R"(
+            sort_d(annotate_d([5, 1, 4], "sort_array_1d_0",
+                list("tile", list("columns", 0, 3))))
+        )", R"(
+            annotate_d([1, 2, 3], "sort_array_1d_0_sorted/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_sort_d_operation("test_sort_2loc_1d_0", R"(
+            sort_d(annotate_d([3, 2, 6], "sort_array_1d_0",
+                list("tile", list("columns", 3, 6))))
+        )", R"(
+            annotate_d([4, 5, 6], "sort_array_1d_0_sorted/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 3, 6))))
+        )");
+    }
+}
+
+void test_sort_2loc_1d_1()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_sort_d_operation("test_sort_2loc_1d_1", R"(
+            sort_d(annotate_d([7., 1.], "sort_array_1d_1",
+                list("tile", list("columns", 0, 2))))
+        )", R"(
+            annotate_d([0., 1., 2., 3.], "sort_array_1d_1_sorted/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 4))))
+        )");
+    }
+    else
+    {
+        test_sort_d_operation("test_sort_2loc_1d_1", R"(
+            sort_d(annotate_d([3., 9., 2., 8., 0.], "sort_array_1d_1",
+                list("tile", list("columns", 2, 7))))
+        )", R"(
+            annotate_d([7., 8., 9.], "sort_array_1d_1_sorted/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 4, 7))))
+        )");
+    }
+}
+
+void test_argsort_2loc_1d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_sort_d_operation("test_argsort_2loc_1d_0", R"(
+            argsort_d(annotate_d([5, 1, 4], "argsort_array_1d_0",
+                list("tile", list("columns", 0, 3))))
+        )", R"(
+            annotate_d([1, 4, 3], "argsort_array_1d_0_argsorted/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_sort_d_operation("test_argsort_2loc_1d_0", R"(
+            argsort_d(annotate_d([3, 2, 6], "argsort_array_1d_0",
+                list("tile", list("columns", 3, 6))))
+        )", R"(
+            annotate_d([2, 0, 5], "argsort_array_1d_0_argsorted/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 3, 6))))
+        )");
+    }
+}
+
+void test_unique_2loc_1d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_sort_d_operation("test_unique_2loc_1d_0", R"(
+            unique_d(annotate_d([3, 1, 3], "unique_array_1d_0",
+                list("tile", list("columns", 0, 3))))
+        )", R"(
+            annotate_d([1, 2], "unique_array_1d_0_unique/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 2))))
+        )");
+    }
+    else
+    {
+        test_sort_d_operation("test_unique_2loc_1d_0", R"(
+            unique_d(annotate_d([2, 1, 2], "unique_array_1d_0",
+                list("tile", list("columns", 3, 6))))
+        )", R"(
+            annotate_d([3], "unique_array_1d_0_unique/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 2, 3))))
+        )");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_sort_2loc_1d_0();
+    test_sort_2loc_1d_1();
+    test_argsort_2loc_1d_0();
+    test_unique_2loc_1d_0();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
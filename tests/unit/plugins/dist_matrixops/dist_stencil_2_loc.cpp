@@ -0,0 +1,133 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/iostream.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& name, std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code =
+        phylanx::execution_tree::compile(name, codestr, snippets, env);
+    return code.run().arg_;
+}
+
+void test_stencil_d_operation(std::string const& name, std::string const& code,
+    std::string const& expected_str)
+{
+    phylanx::execution_tree::primitive_argument_type result =
+        compile_and_run(name, code);
+    phylanx::execution_tree::primitive_argument_type comparison =
+        compile_and_run(name, expected_str);
+
+    HPX_TEST_EQ(hpx::cout, result, comparison);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_stencil_2loc_1d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_stencil_d_operation("test_stencil_2loc_1d_0", R"(
+            stencil_d(annotate_d([1, 2, 3], "stencil_array_1d_0",
+                list("tile", list("columns", 0, 3))), [1, 2, 3])
+        )", R"(
+            annotate_d([8., 14., 20.], "stencil_array_1d_0/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_stencil_d_operation("test_stencil_2loc_1d_0", R"(
+            stencil_d(annotate_d([4, 5, 6], "stencil_array_1d_0",
+                list("tile", list("columns", 3, 6))), [1, 2, 3])
+        )", R"(
+            annotate_d([26., 32., 17.], "stencil_array_1d_0/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 3, 6))))
+        )");
+    }
+}
+
+void test_stencil_2loc_2d_0()
+{
+    if (hpx::get_locality_id() == 0)
+    {
+        test_stencil_d_operation("test_stencil_2loc_2d_0", R"(
+            stencil_d(annotate_d([[1, 2, 3], [4, 5, 6]], "stencil_array_2d_0",
+                    list("tile", list("rows", 0, 2), list("columns", 0, 3))),
+                [[0, 1, 0], [1, -4, 1], [0, 1, 0]])
+        )", R"(
+            annotate_d([[2., 1., -4.], [-3., 0., -7.]],
+                "stencil_array_2d_0/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("rows", 0, 2), list("columns", 0, 3))))
+        )");
+    }
+    else
+    {
+        test_stencil_d_operation("test_stencil_2loc_2d_0", R"(
+            stencil_d(annotate_d([[7, 8, 9], [10, 11, 12]],
+                    "stencil_array_2d_0",
+                    list("tile", list("rows", 2, 4), list("columns", 0, 3))),
+                [[0, 1, 0], [1, -4, 1], [0, 1, 0]])
+        )", R"(
+            annotate_d([[-6., 0., -10.], [-22., -14., -28.]],
+                "stencil_array_2d_0/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("rows", 2, 4), list("columns", 0, 3))))
+        )");
+    }
+}
+
+void test_stencil_1d_local()
+{
+    test_stencil_d_operation("test_stencil_1d_local", R"(
+        stencil_d([1, 2, 3, 4, 5, 6], [1, 2, 3])
+    )", R"(
+        [8., 14., 20., 26., 32., 17.]
+    )");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    test_stencil_2loc_1d_0();
+    test_stencil_2loc_2d_0();
+    test_stencil_1d_local();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
@@ -371,6 +371,43 @@ void test_retile_2loc_1d_8()
     }
 }
 
+void test_retile_2loc_1d_9()
+{
+    // the `local` placement keeps the tiles where the data already lives
+    if (hpx::get_locality_id() == 0)
+    {
+        test_retile_d_operation("test_retile_2loc1d_9", R"(
+            retile_d(
+                annotate_d([4, 5, 6], "tiled_array_1d_9",
+                    list("tile", list("columns", 3, 6))
+                ),
+                "sym", nil, nil, nil, "local"
+            )
+        )", R"(
+            annotate_d([4, 5, 6], "tiled_array_1d_9_retiled/1",
+                list("args",
+                    list("locality", 0, 2),
+                    list("tile", list("columns", 3, 6))))
+        )");
+    }
+    else
+    {
+        test_retile_d_operation("test_retile_2loc1d_9", R"(
+            retile_d(
+                annotate_d([1, 2, 3], "tiled_array_1d_9",
+                    list("tile", list("columns", 0, 3))
+                ),
+                "sym", nil, nil, nil, "local"
+            )
+        )", R"(
+            annotate_d([1, 2, 3], "tiled_array_1d_9_retiled/1",
+                list("args",
+                    list("locality", 1, 2),
+                    list("tile", list("columns", 0, 3))))
+        )");
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void test_retile_2loc_2d_0()
 {
@@ -691,6 +728,7 @@ int hpx_main(int argc, char* argv[])
     test_retile_2loc_1d_6();
     test_retile_2loc_1d_7();
     test_retile_2loc_1d_8();
+    test_retile_2loc_1d_9();
 
     test_retile_2loc_2d_0();
     test_retile_2loc_2d_1();
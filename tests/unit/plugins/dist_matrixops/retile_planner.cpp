@@ -0,0 +1,288 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/plugins/dist_matrixops/retile_planner.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <blaze/Math.h>
+
+namespace planner = phylanx::dist_matrixops::retile_planner;
+using phylanx::execution_tree::tiling_span;
+
+///////////////////////////////////////////////////////////////////////////////
+planner::tiling<1> make_tiling(std::vector<tiling_span> const& spans)
+{
+    planner::tiling<1> result;
+    for (auto const& span : spans)
+    {
+        result.push_back(planner::tile_spans<1>{span});
+    }
+    return result;
+}
+
+// a random tiling of [0, size) into num_tiles pieces, placed on the
+// localities in random order
+planner::tiling<1> random_tiling(
+    std::mt19937& gen, std::int64_t size, std::size_t num_tiles)
+{
+    std::vector<std::int64_t> cuts(size - 1);
+    std::iota(cuts.begin(), cuts.end(), 1);
+    std::shuffle(cuts.begin(), cuts.end(), gen);
+    cuts.resize(num_tiles - 1);
+    cuts.push_back(0);
+    cuts.push_back(size);
+    std::sort(cuts.begin(), cuts.end());
+
+    std::vector<tiling_span> spans;
+    for (std::size_t i = 0; i != num_tiles; ++i)
+    {
+        spans.emplace_back(cuts[i], cuts[i + 1]);
+    }
+    std::shuffle(spans.begin(), spans.end(), gen);
+    return make_tiling(spans);
+}
+
+// number of elements staying local for the given assignment
+std::int64_t local_volume(blaze::DynamicMatrix<std::int64_t> const& transfer,
+    std::vector<std::uint32_t> const& tile_of)
+{
+    std::int64_t result = 0;
+    for (std::size_t i = 0; i != tile_of.size(); ++i)
+    {
+        result += transfer(i, tile_of[i]);
+    }
+    return result;
+}
+
+// the maximal local volume over all assignments
+std::int64_t brute_force_local_volume(
+    blaze::DynamicMatrix<std::int64_t> const& transfer)
+{
+    std::vector<std::uint32_t> tile_of(transfer.rows());
+    std::iota(tile_of.begin(), tile_of.end(), 0);
+
+    std::int64_t result = 0;
+    do
+    {
+        result = (std::max)(result, local_volume(transfer, tile_of));
+    } while (std::next_permutation(tile_of.begin(), tile_of.end()));
+    return result;
+}
+
+bool is_permutation(std::vector<std::uint32_t> tile_of)
+{
+    std::sort(tile_of.begin(), tile_of.end());
+    for (std::size_t i = 0; i != tile_of.size(); ++i)
+    {
+        if (tile_of[i] != i)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_transfer_matrix_1d()
+{
+    planner::tiling<1> current =
+        make_tiling({tiling_span(0, 4), tiling_span(4, 6)});
+    planner::tiling<1> desired =
+        make_tiling({tiling_span(0, 2), tiling_span(2, 6)});
+
+    blaze::DynamicMatrix<std::int64_t> expected{{2, 2}, {0, 2}};
+    HPX_TEST_EQ(planner::transfer_matrix(current, desired), expected);
+
+    planner::retile_plan plan =
+        planner::make_retile_plan(current, desired, false);
+    HPX_TEST_EQ(plan.local_volume_, 4);
+    HPX_TEST_EQ(plan.remote_volume_, 2);
+}
+
+void test_transfer_matrix_2d()
+{
+    // row tiles of a 4x4 matrix are moved to uneven column tiles
+    planner::tiling<2> current = {
+        {tiling_span(0, 2), tiling_span(0, 4)},
+        {tiling_span(2, 4), tiling_span(0, 4)}};
+    planner::tiling<2> desired = {
+        {tiling_span(0, 4), tiling_span(0, 1)},
+        {tiling_span(0, 4), tiling_span(1, 4)}};
+
+    blaze::DynamicMatrix<std::int64_t> expected{{2, 6}, {2, 6}};
+    HPX_TEST_EQ(planner::transfer_matrix(current, desired), expected);
+
+    planner::retile_plan plan =
+        planner::make_retile_plan(current, desired, true);
+    HPX_TEST_EQ(plan.local_volume_ + plan.remote_volume_, 16);
+    HPX_TEST_EQ(plan.local_volume_, 8);
+    HPX_TEST(is_permutation(plan.tile_of_));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_retile_plan_placement()
+{
+    // the same tiles, placed on the other locality
+    planner::tiling<1> current =
+        make_tiling({tiling_span(3, 6), tiling_span(0, 3)});
+    planner::tiling<1> desired =
+        make_tiling({tiling_span(0, 3), tiling_span(3, 6)});
+
+    planner::retile_plan in_place =
+        planner::make_retile_plan(current, desired, false);
+    HPX_TEST_EQ(in_place.local_volume_, 0);
+    HPX_TEST_EQ(in_place.remote_volume_, 6);
+
+    planner::retile_plan optimized =
+        planner::make_retile_plan(current, desired, true);
+    HPX_TEST_EQ(optimized.local_volume_, 6);
+    HPX_TEST_EQ(optimized.remote_volume_, 0);
+    HPX_TEST(optimized.tile_of_ == std::vector<std::uint32_t>({1, 0}));
+}
+
+// the Hungarian method finds an optimal assignment
+void test_assign_tiles()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::int64_t> dist(0, 20);
+
+    for (std::size_t n = 1; n <= 6; ++n)
+    {
+        for (int round = 0; round != 50; ++round)
+        {
+            blaze::DynamicMatrix<std::int64_t> transfer(n, n);
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                for (std::size_t j = 0; j != n; ++j)
+                {
+                    transfer(i, j) = dist(gen);
+                }
+            }
+
+            std::vector<std::uint32_t> tile_of =
+                planner::assign_tiles(transfer);
+            HPX_TEST_EQ(tile_of.size(), n);
+            HPX_TEST(is_permutation(tile_of));
+            HPX_TEST_EQ(local_volume(transfer, tile_of),
+                brute_force_local_volume(transfer));
+        }
+    }
+
+    HPX_TEST(planner::assign_tiles(
+        blaze::DynamicMatrix<std::int64_t>(0, 0)).empty());
+
+    bool exception_thrown = false;
+    try
+    {
+        planner::assign_tiles(blaze::DynamicMatrix<std::int64_t>(2, 3, 0));
+        HPX_TEST(false);
+    }
+    catch (std::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_suggest_common_tiling()
+{
+    // equally expensive candidates: the lhs tiling is kept in place
+    {
+        planner::tiling<1> lhs =
+            make_tiling({tiling_span(0, 3), tiling_span(3, 6)});
+        planner::tiling<1> rhs =
+            make_tiling({tiling_span(3, 6), tiling_span(0, 3)});
+
+        planner::common_tiling common =
+            planner::suggest_common_tiling(lhs, rhs);
+        HPX_TEST_EQ(common.candidate_, std::size_t(0));
+        HPX_TEST(common.tile_of_ == std::vector<std::uint32_t>({0, 1}));
+        HPX_TEST_EQ(common.remote_volume_, 6);
+    }
+
+    // candidates with a different number of tiles are ignored
+    {
+        planner::tiling<1> lhs =
+            make_tiling({tiling_span(0, 2), tiling_span(2, 6)});
+        planner::tiling<1> rhs =
+            make_tiling({tiling_span(0, 4), tiling_span(4, 6)});
+        std::vector<planner::tiling<1>> candidates = {
+            make_tiling({tiling_span(0, 6)})};
+
+        planner::common_tiling common =
+            planner::suggest_common_tiling(lhs, rhs, candidates);
+        HPX_TEST_EQ(common.candidate_, std::size_t(0));
+        HPX_TEST_EQ(common.remote_volume_, 2);
+    }
+
+    // compare the combined volume with all candidates and placements
+    std::mt19937 gen(7);
+    for (std::size_t n = 1; n <= 4; ++n)
+    {
+        for (int round = 0; round != 50; ++round)
+        {
+            planner::tiling<1> lhs = random_tiling(gen, 12, n);
+            planner::tiling<1> rhs = random_tiling(gen, 12, n);
+            std::vector<planner::tiling<1>> candidates = {
+                random_tiling(gen, 12, n), random_tiling(gen, 12, n)};
+
+            planner::common_tiling common =
+                planner::suggest_common_tiling(lhs, rhs, candidates);
+
+            std::int64_t expected =
+                (std::numeric_limits<std::int64_t>::max)();
+            for (std::size_t c = 0; c != candidates.size() + 2; ++c)
+            {
+                planner::tiling<1> const& candidate = c == 0 ?
+                    lhs :
+                    (c == 1 ? rhs : candidates[c - 2]);
+
+                blaze::DynamicMatrix<std::int64_t> transfer =
+                    planner::transfer_matrix(lhs, candidate) +
+                    planner::transfer_matrix(rhs, candidate);
+
+                std::int64_t const remote =
+                    24 - brute_force_local_volume(transfer);
+                expected = (std::min)(expected, remote);
+
+                if (c == common.candidate_)
+                {
+                    HPX_TEST(is_permutation(common.tile_of_));
+                    HPX_TEST_EQ(
+                        24 - local_volume(transfer, common.tile_of_),
+                        common.remote_volume_);
+                }
+            }
+            HPX_TEST_EQ(common.remote_volume_, expected);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_transfer_matrix_1d();
+    test_transfer_matrix_2d();
+
+    test_retile_plan_placement();
+    test_assign_tiles();
+
+    test_suggest_common_tiling();
+
+    return hpx::util::report_errors();
+}
@@ -9,6 +9,9 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include "pool_reference.hpp"
+
+#include <cstddef>
 #include <string>
 #include <utility>
 
@@ -31,6 +34,68 @@ void test_avg_pool2d_operation(std::string const& code,
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+// large enough to be processed in parallel, the windows overlap
+void test_avg_pool2d_operation_parallel()
+{
+    blaze::DynamicArray<4UL, double> x(2, 33, 31, 40);
+    for (std::size_t l = 0; l != x.quats(); ++l)
+    {
+        for (std::size_t p = 0; p != x.pages(); ++p)
+        {
+            for (std::size_t r = 0; r != x.rows(); ++r)
+            {
+                for (std::size_t c = 0; c != x.columns(); ++c)
+                {
+                    x(l, p, r, c) = double((7 * l + 5 * p + 3 * r + c) % 23);
+                }
+            }
+        }
+    }
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(
+        R"(block(
+            define(pool, x, avg_pool2d(x, make_list(3, 2), "valid",
+                make_list(2, 1))),
+            pool
+        ))",
+        snippets);
+    auto pool = code.run();
+
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        pool(phylanx::ir::node_data<double>{x}));
+
+    blaze::DynamicArray<4UL, double> expected(x.quats(),
+        pool_outputs(x.pages(), 3, 2, false),
+        pool_outputs(x.rows(), 2, 1, false), x.columns());
+    for (std::size_t l = 0; l != expected.quats(); ++l)
+    {
+        for (std::size_t p = 0; p != expected.pages(); ++p)
+        {
+            auto h = pool_window(x.pages(), 3, 2, false, p);
+            for (std::size_t r = 0; r != expected.rows(); ++r)
+            {
+                auto w = pool_window(x.rows(), 2, 1, false, r);
+                for (std::size_t c = 0; c != expected.columns(); ++c)
+                {
+                    double value = 0.0;
+                    for (std::size_t i = 0; i != h.second; ++i)
+                    {
+                        for (std::size_t j = 0; j != w.second; ++j)
+                        {
+                            value += x(l, h.first + i, w.first + j, c);
+                        }
+                    }
+                    expected(l, p, r, c) = value / double(h.second * w.second);
+                }
+            }
+        }
+    }
+
+    HPX_TEST(allclose(
+        phylanx::ir::node_data<double>{std::move(expected)}, result));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -105,5 +170,7 @@ int main(int argc, char* argv[])
         "[[[[ 2.,  3.,  4.,  5.]], [[26., 27., 28., 29.]]],"
         "[[[38., 39., 40., 41.]], [[62., 33., 34., 65.]]]]");
 
+    test_avg_pool2d_operation_parallel();
+
     return hpx::util::report_errors();
 }
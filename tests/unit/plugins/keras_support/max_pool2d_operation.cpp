@@ -9,6 +9,11 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include "pool_reference.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -31,6 +36,69 @@ void test_max_pool2d_operation(std::string const& code,
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+// large enough to be processed in parallel, the windows overlap
+void test_max_pool2d_operation_parallel()
+{
+    blaze::DynamicArray<4UL, double> x(2, 33, 31, 40);
+    for (std::size_t l = 0; l != x.quats(); ++l)
+    {
+        for (std::size_t p = 0; p != x.pages(); ++p)
+        {
+            for (std::size_t r = 0; r != x.rows(); ++r)
+            {
+                for (std::size_t c = 0; c != x.columns(); ++c)
+                {
+                    x(l, p, r, c) = double((7 * l + 5 * p + 3 * r + c) % 23);
+                }
+            }
+        }
+    }
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(
+        R"(block(
+            define(pool, x, max_pool2d(x, make_list(3, 3), "same",
+                make_list(2, 2))),
+            pool
+        ))",
+        snippets);
+    auto pool = code.run();
+
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        pool(phylanx::ir::node_data<double>{x}));
+
+    blaze::DynamicArray<4UL, double> expected(x.quats(),
+        pool_outputs(x.pages(), 3, 2, true),
+        pool_outputs(x.rows(), 3, 2, true), x.columns());
+    for (std::size_t l = 0; l != expected.quats(); ++l)
+    {
+        for (std::size_t p = 0; p != expected.pages(); ++p)
+        {
+            auto h = pool_window(x.pages(), 3, 2, true, p);
+            for (std::size_t r = 0; r != expected.rows(); ++r)
+            {
+                auto w = pool_window(x.rows(), 3, 2, true, r);
+                for (std::size_t c = 0; c != expected.columns(); ++c)
+                {
+                    double value = std::numeric_limits<double>::lowest();
+                    for (std::size_t i = 0; i != h.second; ++i)
+                    {
+                        for (std::size_t j = 0; j != w.second; ++j)
+                        {
+                            value = (std::max)(
+                                value, x(l, h.first + i, w.first + j, c));
+                        }
+                    }
+                    expected(l, p, r, c) = value;
+                }
+            }
+        }
+    }
+
+    HPX_TEST(allclose(
+        phylanx::ir::node_data<double>{std::move(expected)}, result));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -114,5 +182,7 @@ int main(int argc, char* argv[])
         "[[[[ 4.,  5.,  6.,  7.]], [[28., 29., 30., 31.]]],"
         "[[[40., 41., 42., 43.]], [[64., 61., 62., 67.]]]]");
 
+    test_max_pool2d_operation_parallel();
+
     return hpx::util::report_errors();
 }
@@ -9,6 +9,11 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include "pool_reference.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -31,6 +36,69 @@ void test_max_pool3d_operation(std::string const& code,
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+// large enough to be processed in parallel, the windows overlap
+void test_max_pool3d_operation_parallel()
+{
+    blaze::DynamicTensor<double> x(40, 45, 41);
+    for (std::size_t p = 0; p != x.pages(); ++p)
+    {
+        for (std::size_t r = 0; r != x.rows(); ++r)
+        {
+            for (std::size_t c = 0; c != x.columns(); ++c)
+            {
+                x(p, r, c) = double((5 * p + 3 * r + c) % 23);
+            }
+        }
+    }
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(
+        R"(block(
+            define(pool, x, max_pool3d(x, make_list(3, 2, 3), "same",
+                make_list(2, 2, 1))),
+            pool
+        ))",
+        snippets);
+    auto pool = code.run();
+
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        pool(phylanx::ir::node_data<double>{x}));
+
+    blaze::DynamicTensor<double> expected(
+        pool_outputs(x.pages(), 3, 2, true),
+        pool_outputs(x.rows(), 2, 2, true),
+        pool_outputs(x.columns(), 3, 1, true));
+    for (std::size_t p = 0; p != expected.pages(); ++p)
+    {
+        auto d = pool_window(x.pages(), 3, 2, true, p);
+        for (std::size_t r = 0; r != expected.rows(); ++r)
+        {
+            auto h = pool_window(x.rows(), 2, 2, true, r);
+            for (std::size_t c = 0; c != expected.columns(); ++c)
+            {
+                auto w = pool_window(x.columns(), 3, 1, true, c);
+                double value = std::numeric_limits<double>::lowest();
+                for (std::size_t i = 0; i != d.second; ++i)
+                {
+                    for (std::size_t j = 0; j != h.second; ++j)
+                    {
+                        for (std::size_t m = 0; m != w.second; ++m)
+                        {
+                            value = (std::max)(value,
+                                x(d.first + i, h.first + j, w.first + m));
+                        }
+                    }
+                }
+                expected(p, r, c) =
+                    value;
+            }
+        }
+    }
+
+    HPX_TEST(allclose(
+        phylanx::ir::node_data<double>{std::move(expected)}, result));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -58,5 +126,7 @@ int main(int argc, char* argv[])
           make_list(3,2,1)))",
         "[[[42., 42.,  3.], [13., 23., 23.]]]");
 
+    test_max_pool3d_operation_parallel();
+
     return hpx::util::report_errors();
 }
@@ -0,0 +1,47 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Reference computations shared by the tests of the pooling primitives
+
+#if !defined(PHYLANX_TESTS_UNIT_KERAS_SUPPORT_POOL_REFERENCE_HPP)
+#define PHYLANX_TESTS_UNIT_KERAS_SUPPORT_POOL_REFERENCE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+// first element and number of elements of the input covered by the window of
+// output i (Keras semantics, padded elements are ignored)
+inline std::pair<std::size_t, std::size_t> pool_window(std::size_t size,
+    std::size_t pool_size, std::size_t stride, bool same, std::size_t i)
+{
+    std::int64_t pad = 0;
+    if (same)
+    {
+        std::int64_t covered = std::int64_t(
+            size % stride == 0 ? stride : size % stride);
+        pad = (std::max)(std::int64_t(pool_size) - covered, std::int64_t(0));
+    }
+    std::int64_t first = std::int64_t(i * stride) - pad / 2;
+    std::int64_t last =
+        (std::min)(first + std::int64_t(pool_size), std::int64_t(size));
+    first = (std::max)(first, std::int64_t(0));
+    return std::make_pair(std::size_t(first), std::size_t(last - first));
+}
+
+// number of outputs of the pooling along a dimension of the given size
+inline std::size_t pool_outputs(
+    std::size_t size, std::size_t pool_size, std::size_t stride, bool same)
+{
+    if (!same)
+    {
+        return (size - pool_size) / stride + 1;
+    }
+    return (size + stride - 1) / stride;
+}
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run().arg_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_softmax_cross_entropy_operation(std::string const& code,
+    std::string const& expected_loss, std::string const& expected_gradient)
+{
+    auto result =
+        phylanx::execution_tree::extract_list_value(compile_and_run(code));
+    HPX_TEST_EQ(result.size(), std::size_t(2));
+
+    auto it = result.begin();
+    HPX_TEST(allclose(phylanx::execution_tree::extract_numeric_value(*it),
+        phylanx::execution_tree::extract_numeric_value(
+            compile_and_run(expected_loss))));
+    HPX_TEST(allclose(phylanx::execution_tree::extract_numeric_value(*++it),
+        phylanx::execution_tree::extract_numeric_value(
+            compile_and_run(expected_gradient))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_softmax_cross_entropy_operation(
+        "softmax_cross_entropy_with_logits([0., 1., 0.], [1., 2., 3.])",
+        "1.40760596",
+        "[0.09003057, -0.75527153, 0.66524096]");
+
+    test_softmax_cross_entropy_operation(
+        R"(softmax_cross_entropy_with_logits(
+            [[0., 1., 0.], [1., 0., 0.]], [[1., 2., 3.], [4., 1., 2.]]))",
+        "[1.40760596, 0.16984602]",
+        R"([[0.09003057, -0.75527153, 0.66524096],
+            [-0.15620527, 0.04201007, 0.1141952]])");
+
+    // the logits are shifted by their maximum before being exponentiated
+    test_softmax_cross_entropy_operation(
+        R"(softmax_cross_entropy_with_logits(
+            [[0., 1., 0.], [1., 0., 0.]],
+            [[1001., 1002., 1003.], [1004., 1001., 1002.]]))",
+        "[1.40760596, 0.16984602]",
+        R"([[0.09003057, -0.75527153, 0.66524096],
+            [-0.15620527, 0.04201007, 0.1141952]])");
+
+    test_softmax_cross_entropy_operation(
+        R"(softmax_cross_entropy_with_logits(
+            [[0., 1., 0.], [1., 0., 0.]], [[1., 2., 3.], [4., 1., 2.]], 0))",
+        "[0.04858735, 0.31326169, 0.]",
+        R"([[0.04742587, -0.26894142, 0.], [-0.04742587, 0.26894142, 0.]])");
+
+    // the result matches the unfused computation
+    std::string const labels = R"([
+        [[0., 1., 0., 0.], [0.5, 0., 0.5, 0.], [0., 0., 0., 1.]],
+        [[1., 0., 0., 0.], [0., 0.25, 0.25, 0.5], [0., 1., 0., 0.]]
+    ])";
+    std::string const logits = R"([
+        [[1., -2., 3., 0.5], [4., 1., -2., 2.], [0., 0., 1., 1.]],
+        [[-1., 2., 3., 7.], [2., 2., 1., -4.], [3., 5., 1., 0.]]
+    ])";
+
+    for (std::string const axis : {"0", "1", "2"})
+    {
+        test_softmax_cross_entropy_operation(
+            "softmax_cross_entropy_with_logits(" + labels + ", " + logits +
+                ", " + axis + ")",
+            "-sum(" + labels + " * log_softmax(" + logits + ", " + axis +
+                "), " + axis + ")",
+            "softmax(" + logits + ", " + axis + ") * sum(" + labels + ", " +
+                axis + ", true) - " + labels);
+    }
+
+    return hpx::util::report_errors();
+}
@@ -10,6 +10,7 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/modules/testing.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
@@ -458,6 +459,90 @@ void test_softmax_operation_4d_axis3()
         phylanx::execution_tree::extract_numeric_value(std::move(rhs))));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void test_log_softmax_operation_1d()
+{
+    blaze::DynamicVector<double> subject{41., 42., 43.};
+    phylanx::execution_tree::primitive arg =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>(subject));
+
+    phylanx::execution_tree::primitive log_softmax =
+        phylanx::execution_tree::primitives::create_log_softmax_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{std::move(arg)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        log_softmax.eval();
+
+    blaze::DynamicVector<double> expected{
+        -2.40760596, -1.40760596, -0.40760596};
+
+    HPX_TEST(allclose(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get())));
+}
+
+// the exponentials of the arguments overflow if not shifted by the maximum
+void test_log_softmax_operation_2d_large_values()
+{
+    blaze::DynamicMatrix<double> subject{
+        {1001.0, 1002.0, 1003.0}, {1004.0, 1001.0, 1002.0}};
+    phylanx::execution_tree::primitive arg =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>(subject));
+
+    phylanx::execution_tree::primitive log_softmax =
+        phylanx::execution_tree::primitives::create_log_softmax_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{std::move(arg)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        log_softmax.eval();
+
+    blaze::DynamicMatrix<double> expected{
+        {-2.40760596, -1.40760596, -0.40760596},
+        {-0.16984602, -3.16984602, -2.16984602}};
+
+    HPX_TEST(allclose(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get())));
+}
+
+// large enough to be processed in parallel
+void test_softmax_operation_2d_parallel()
+{
+    blaze::DynamicMatrix<double> subject(513, 300);
+    for (std::size_t i = 0; i != subject.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != subject.columns(); ++j)
+        {
+            subject(i, j) = double((7 * i + 3 * j) % 19) - 9.0;
+        }
+    }
+
+    phylanx::execution_tree::primitive arg0 =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>(subject));
+
+    phylanx::execution_tree::primitive arg1 =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<std::int64_t>(0));
+
+    phylanx::execution_tree::primitive softmax =
+        phylanx::execution_tree::primitives::create_softmax_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                std::move(arg0), std::move(arg1)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        softmax.eval();
+
+    blaze::DynamicMatrix<double> expected =
+        blaze::softmax<blaze::columnwise>(subject);
+
+    HPX_TEST(allclose(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get())));
+}
+
 int main(int argc, char* argv[])
 {
     test_softmax_operation_0d();
@@ -478,5 +563,9 @@ int main(int argc, char* argv[])
     test_softmax_operation_4d_axis2();
     test_softmax_operation_4d_axis3();
 
+    test_log_softmax_operation_1d();
+    test_log_softmax_operation_2d_large_values();
+    test_softmax_operation_2d_parallel();
+
     return hpx::util::report_errors();
 }
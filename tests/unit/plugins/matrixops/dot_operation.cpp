@@ -829,6 +829,12 @@ int main(int argc, char* argv[])
     test_dot_operation("dot([[[3, 2, 5], [1, 10, 2], [3, 2, 15], [1, 11, 2]]],"
                        "[[1, -1],[1, 0],[2, 1]])",
         "[[[15,  2],[15,  1],[35, 12],[16,  1]]]");
+    test_dot_operation("dot([[[1, 2], [3, 4]]], [[[1], [0]], [[2], [1]]])",
+        "[[[[1], [4]], [[3], [10]]]]");
+    test_dot_operation("dot([[[1, 2], [3, 4]], [[0, -1], [2, 1]]],"
+        "[[[1, 0], [0, 1]], [[2, 1], [1, 3]], [[1, 1], [1, 1]]])",
+        "[[[[1, 2], [4, 7], [3, 3]], [[3, 4], [10, 15], [7, 7]]],"
+        "[[[0, -1], [-1, -3], [-1, -1]], [[2, 1], [5, 5], [3, 3]]]]");
 
     // tensordot
     //// axes = 0 (scalar axes)
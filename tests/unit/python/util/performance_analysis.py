@@ -0,0 +1,66 @@
+#  Copyright (c) 2021 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import re
+
+import phylanx
+from phylanx import Phylanx, PhylanxSession
+
+PhylanxSession.init(1)
+
+
+@Phylanx(performance=True)
+def f(x):
+    return x * 2.0 + (x + 1.0)
+
+
+###############################################################################
+
+
+def report_value(report, label):
+    match = re.search(label + r':\s*([0-9.]+)', report)
+    assert match is not None, label
+    return float(match.group(1))
+
+
+def test_performance_analysis():
+    assert f(20.0) == 61.0
+
+    report, folded_stacks = phylanx.util.performance_analysis(f)
+    assert report is not None
+    assert folded_stacks is not None
+
+    total = report_value(report, 'total self time')
+    critical_path = report_value(report, 'critical path time')
+    parallelism = report_value(report, 'achieved parallelism')
+
+    # the critical path is one of the chains making up the total, all
+    # values are rounded in the report
+    assert 0.0 <= critical_path <= total
+    if critical_path != 0.0:
+        assert parallelism >= 0.99
+
+    assert 'Critical path:' in report
+    assert 'Self time per source line:' in report
+
+    # one line per call stack: frames separated by ';' and the self time
+    # in nanoseconds
+    stacks = {}
+    for line in folded_stacks.splitlines():
+        stack, _, self_time = line.rpartition(' ')
+        assert stack != ''
+        assert ' ' not in stack
+        assert int(self_time) > 0
+        stacks[stack] = int(self_time)
+
+    # all self times are attributed to a stack starting at the same root
+    roots = set(stack.split(';')[0] for stack in stacks)
+    assert len(roots) <= 1
+    assert abs(sum(stacks.values()) / 1e6 - total) < 0.001 * (len(stacks) + 1)
+
+
+###############################################################################
+
+test_performance_analysis()
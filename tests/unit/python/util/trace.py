@@ -0,0 +1,60 @@
+#  Copyright (c) 2021 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import json
+import os
+import tempfile
+
+import phylanx
+from phylanx import PhylanxSession
+
+PhylanxSession.init(1)
+
+et = phylanx.execution_tree
+cs = et.compiler_state('global', __name__)
+
+###############################################################################
+
+
+def test_trace_file():
+    filename = os.path.join(tempfile.mkdtemp(), 'trace.json')
+
+    with phylanx.util.trace(filename):
+        result = et.eval(cs, "define(f, x, x + 1.0)\nf", 41.0)
+    assert result == 42.0
+
+    with open(filename) as f:
+        trace = json.load(f)
+
+    events = [e for e in trace['traceEvents'] if e.get('name') == 'add']
+    assert len(events) != 0
+    assert all(e['cat'] == 'primitive' for e in events)
+    assert all(e['ph'] in ('X', 'b', 'e') for e in events)
+
+    os.remove(filename)
+
+
+###############################################################################
+
+
+def test_retrieve_trace():
+    phylanx.util.clear_trace()
+    phylanx.util.enable_tracing()
+    et.eval(cs, "define(g, x, x * 2.0)\ng", 21.0)
+    phylanx.util.enable_tracing(False)
+
+    trace = json.loads(phylanx.util.retrieve_trace())
+    names = set(e.get('name') for e in trace['traceEvents'])
+    assert 'mul' in names
+
+    phylanx.util.clear_trace()
+    trace = json.loads(phylanx.util.retrieve_trace())
+    assert len(trace['traceEvents']) == 0
+
+
+###############################################################################
+
+test_trace_file()
+test_retrieve_trace()
@@ -0,0 +1,250 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/adaptive_execution_policy.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// feeds the given number of evaluations of the given duration to the policy
+// the same way the primitives do (by accumulating the measurements)
+void add_samples(phylanx::util::adaptive_execution_policy& policy,
+    std::int64_t& count, std::int64_t& duration, std::int64_t samples,
+    std::int64_t sample_duration)
+{
+    for (std::int64_t i = 0; i != samples; ++i)
+    {
+        ++count;
+        duration += sample_duration;
+        policy.update(count, duration);
+    }
+}
+
+void test_adaptive_execution_policy()
+{
+    using phylanx::util::adaptive_execution_policy;
+
+    // the overhead is given by the configuration, the policy evaluates
+    // directly below 10us and asynchronously above 20us
+    HPX_TEST_EQ(phylanx::util::task_spawn_overhead(), std::int64_t(1000));
+    HPX_TEST(phylanx::util::adaptive_execution_enabled());
+
+    // cheap evaluations
+    {
+        adaptive_execution_policy policy;
+        std::int64_t count = 0, duration = 0;
+
+        HPX_TEST_EQ(policy.estimate(), std::int64_t(-1));
+        HPX_TEST(policy.sample());
+
+        add_samples(policy, count, duration,
+            adaptive_execution_policy::warmup_samples - 1, 500);
+        HPX_TEST_EQ(policy.decide(), std::int64_t(-1));
+
+        add_samples(policy, count, duration, 1, 500);
+        HPX_TEST_EQ(policy.estimate(), std::int64_t(500));
+        HPX_TEST_EQ(policy.decide(), std::int64_t(1));
+
+        // only every sampling_period'th evaluation is timed once decided
+        std::int64_t sampled = 0;
+        for (std::int64_t i = 0;
+             i != 4 * adaptive_execution_policy::sampling_period; ++i)
+        {
+            if (policy.sample())
+            {
+                ++sampled;
+            }
+        }
+        HPX_TEST_EQ(sampled, std::int64_t(4));
+    }
+
+    // expensive evaluations
+    {
+        adaptive_execution_policy policy;
+        std::int64_t count = 0, duration = 0;
+
+        add_samples(policy, count, duration,
+            adaptive_execution_policy::warmup_samples, 100000);
+        HPX_TEST_EQ(policy.decide(), std::int64_t(0));
+    }
+
+    // no decision is made between both thresholds
+    {
+        adaptive_execution_policy policy;
+        std::int64_t count = 0, duration = 0;
+
+        add_samples(policy, count, duration,
+            adaptive_execution_policy::warmup_samples, 15000);
+        HPX_TEST_EQ(policy.decide(), std::int64_t(-1));
+    }
+
+    // the previous decision is kept between both thresholds
+    {
+        adaptive_execution_policy policy;
+        std::int64_t count = 0, duration = 0;
+
+        add_samples(policy, count, duration,
+            adaptive_execution_policy::warmup_samples, 8000);
+        HPX_TEST_EQ(policy.decide(), std::int64_t(1));
+
+        add_samples(policy, count, duration, 32, 16000);
+        HPX_TEST(policy.estimate() > 10000 && policy.estimate() <= 16000);
+        HPX_TEST_EQ(policy.decide(), std::int64_t(1));
+    }
+
+    // a change of the cost replaces the estimate, single outliers don't
+    {
+        adaptive_execution_policy policy;
+        std::int64_t count = 0, duration = 0;
+
+        add_samples(policy, count, duration,
+            adaptive_execution_policy::warmup_samples, 500);
+        HPX_TEST_EQ(policy.decide(), std::int64_t(1));
+
+        add_samples(policy, count, duration, 1, 100000);
+        HPX_TEST_EQ(policy.estimate(), std::int64_t(500));
+        add_samples(policy, count, duration, 1, 500);
+
+        add_samples(policy, count, duration, 2, 100000);
+        HPX_TEST_EQ(policy.estimate(), std::int64_t(100000));
+        HPX_TEST_EQ(policy.decide(), std::int64_t(0));
+    }
+
+    // resetting the accumulated measurements doesn't produce samples
+    {
+        adaptive_execution_policy policy;
+        std::int64_t count = 0, duration = 0;
+
+        add_samples(policy, count, duration,
+            adaptive_execution_policy::warmup_samples, 500);
+
+        policy.update(0, 0);
+        HPX_TEST_EQ(policy.estimate(), std::int64_t(500));
+
+        count = 0;
+        duration = 0;
+        add_samples(policy, count, duration, 1, 600);
+        HPX_TEST(policy.estimate() > 500 && policy.estimate() <= 600);
+    }
+}
+
+// a primitive may be evaluated concurrently, no evaluation may be lost
+void test_adaptive_execution_policy_concurrent()
+{
+    using phylanx::util::adaptive_execution_policy;
+
+    adaptive_execution_policy policy;
+    std::int64_t count = 0, duration = 0;
+
+    add_samples(policy, count, duration,
+        adaptive_execution_policy::warmup_samples, 500);
+    HPX_TEST_EQ(policy.decide(), std::int64_t(1));
+
+    constexpr std::int64_t tasks = 8;
+    constexpr std::int64_t evaluations =
+        64 * adaptive_execution_policy::sampling_period;
+
+    std::vector<hpx::future<std::int64_t>> sampled;
+    for (std::int64_t task = 0; task != tasks; ++task)
+    {
+        sampled.push_back(hpx::async([&policy]() {
+            std::int64_t result = 0;
+            for (std::int64_t i = 0; i != evaluations; ++i)
+            {
+                if (policy.sample())
+                {
+                    ++result;
+                }
+                HPX_TEST_EQ(policy.decide(), std::int64_t(1));
+            }
+            return result;
+        }));
+    }
+
+    std::int64_t total = 0;
+    for (auto& f : sampled)
+    {
+        total += f.get();
+    }
+    HPX_TEST_EQ(total,
+        tasks * evaluations / adaptive_execution_policy::sampling_period);
+    HPX_TEST_EQ(policy.estimate(), std::int64_t(500));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t sum_counter_values(std::string const& name)
+{
+    hpx::performance_counters::performance_counter counter(
+        "/phylanx{locality#0/total}/primitives/__add/" + name);
+
+    auto const values =
+        counter.get_counter_values_array(hpx::launch::sync, false);
+
+    std::int64_t result = 0;
+    for (std::int64_t value : values.values_)
+    {
+        result += value;
+    }
+    return result;
+}
+
+void test_adaptive_execution_counters()
+{
+    using namespace phylanx::execution_tree;
+
+    compiler::function_list snippets;
+    auto const& code = compile("define(f, x, x + 1.0)\nf", snippets);
+    auto f = code.run();
+
+    constexpr std::int64_t evaluations = 100;
+    for (std::int64_t i = 0; i != evaluations; ++i)
+    {
+        HPX_TEST_EQ(extract_scalar_numeric_value(f(double(i))), i + 1.0);
+    }
+
+    // a scalar addition takes much less than 10us, all evaluations after
+    // the first few are executed directly
+    std::int64_t const sync_evals = sum_counter_values("count/eval_sync");
+    std::int64_t const async_evals = sum_counter_values("count/eval_async");
+
+    HPX_TEST_EQ(sync_evals + async_evals, evaluations);
+    HPX_TEST(sync_evals > async_evals);
+
+    std::int64_t const estimate = sum_counter_values("time/eval_estimate");
+    HPX_TEST(estimate >= 0 && estimate < 10000);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_adaptive_execution_policy();
+    test_adaptive_execution_policy_concurrent();
+    test_adaptive_execution_counters();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1",
+        "phylanx.adaptive_execution=1",
+        "phylanx.task_spawn_overhead=1000"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}
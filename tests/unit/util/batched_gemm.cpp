@@ -0,0 +1,125 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/batched_gemm.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+blaze::DynamicTensor<std::int64_t> make_tensor(
+    std::size_t pages, std::size_t rows, std::size_t columns)
+{
+    blaze::DynamicTensor<std::int64_t> t(pages, rows, columns);
+    for (std::size_t k = 0; k != pages; ++k)
+    {
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            for (std::size_t j = 0; j != columns; ++j)
+            {
+                t(k, i, j) = std::int64_t((3 * k + 5 * i + 7 * j) % 13) - 6;
+            }
+        }
+    }
+    return t;
+}
+
+// the products of the larger sizes are computed by Blaze, the batches are
+// processed in parallel
+void test_batched_gemm(std::size_t batch, std::size_t rows,
+    std::size_t columns, std::size_t inner)
+{
+    using phylanx::util::strided_matrices;
+
+    auto pages = [](blaze::DynamicTensor<std::int64_t>& t) {
+        return strided_matrices<std::int64_t>{
+            t.data(), t.rows() * t.spacing(), t.spacing(), 1};
+    };
+    auto transposed_pages = [](blaze::DynamicTensor<std::int64_t>& t) {
+        return strided_matrices<std::int64_t>{
+            t.data(), t.rows() * t.spacing(), 1, t.spacing()};
+    };
+
+    // C = A * B
+    {
+        auto a = make_tensor(batch, rows, inner);
+        auto b = make_tensor(batch, inner, columns);
+        blaze::DynamicTensor<std::int64_t> c(batch, rows, columns);
+
+        phylanx::util::batched_gemm<std::int64_t>(
+            batch, rows, columns, inner, pages(a), pages(b), pages(c));
+
+        for (std::size_t k = 0; k != batch; ++k)
+        {
+            blaze::DynamicMatrix<std::int64_t> expected =
+                blaze::pageslice(a, k) * blaze::pageslice(b, k);
+            HPX_TEST_EQ(blaze::DynamicMatrix<std::int64_t>(
+                            blaze::pageslice(c, k)), expected);
+        }
+    }
+
+    // C = trans(A) * trans(B)
+    {
+        auto a = make_tensor(batch, inner, rows);
+        auto b = make_tensor(batch, columns, inner);
+        blaze::DynamicTensor<std::int64_t> c(batch, rows, columns);
+
+        phylanx::util::batched_gemm<std::int64_t>(batch, rows, columns,
+            inner, transposed_pages(a), transposed_pages(b), pages(c));
+
+        for (std::size_t k = 0; k != batch; ++k)
+        {
+            blaze::DynamicMatrix<std::int64_t> expected =
+                blaze::trans(blaze::pageslice(a, k)) *
+                blaze::trans(blaze::pageslice(b, k));
+            HPX_TEST_EQ(blaze::DynamicMatrix<std::int64_t>(
+                            blaze::pageslice(c, k)), expected);
+        }
+    }
+
+    // trans(C) = A * B, with A broadcast over the batch
+    {
+        blaze::DynamicMatrix<std::int64_t> a(rows, inner);
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            for (std::size_t j = 0; j != inner; ++j)
+            {
+                a(i, j) = std::int64_t((i + 2 * j) % 5) - 2;
+            }
+        }
+        auto b = make_tensor(batch, inner, columns);
+        blaze::DynamicTensor<std::int64_t> c(batch, columns, rows);
+
+        phylanx::util::batched_gemm<std::int64_t>(batch, rows, columns,
+            inner, {a.data(), 0, a.spacing(), 1}, pages(b),
+            transposed_pages(c));
+
+        for (std::size_t k = 0; k != batch; ++k)
+        {
+            blaze::DynamicMatrix<std::int64_t> expected =
+                blaze::trans(a * blaze::pageslice(b, k));
+            HPX_TEST_EQ(blaze::DynamicMatrix<std::int64_t>(
+                            blaze::pageslice(c, k)), expected);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    test_batched_gemm(1, 1, 1, 1);
+    test_batched_gemm(7, 3, 5, 2);
+    test_batched_gemm(1000, 17, 9, 33);
+    test_batched_gemm(64, 64, 64, 64);
+    test_batched_gemm(3, 130, 70, 90);
+
+    return hpx::util::report_errors();
+}
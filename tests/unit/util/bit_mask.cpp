@@ -0,0 +1,67 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/bit_mask.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// the larger sizes are processed in parallel, none of the sizes but 64 is a
+// multiple of the word size
+void test_bit_mask(std::size_t size)
+{
+    using phylanx::util::bit_mask;
+
+    auto every_third = [](std::size_t i) { return i % 3 == 0; };
+
+    bit_mask const mask = bit_mask::from_predicate(size, every_third);
+    HPX_TEST_EQ(mask.size(), size);
+
+    std::vector<std::uint8_t> bytes(size);
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        HPX_TEST_EQ(mask.test(i), every_third(i));
+        bytes[i] = every_third(i) ? 1 : 0;
+        expected += bytes[i];
+    }
+    HPX_TEST_EQ(mask.count(), expected);
+    HPX_TEST_EQ(bit_mask::from_values(bytes.data(), size).count(), expected);
+
+    // set bits are visited in ascending order
+    std::vector<std::size_t> indices;
+    mask.for_each_set([&](std::size_t i) { indices.push_back(i); });
+    HPX_TEST_EQ(indices.size(), expected);
+    for (std::size_t k = 0; k != indices.size(); ++k)
+    {
+        HPX_TEST_EQ(indices[k], 3 * k);
+    }
+
+    // one byte per element
+    HPX_TEST_EQ(
+        phylanx::util::count_nonzero_bytes(bytes.data(), size), expected);
+}
+
+int main(int argc, char* argv[])
+{
+    test_bit_mask(0);
+    test_bit_mask(1);
+    test_bit_mask(64);
+    test_bit_mask(65);
+    test_bit_mask(1000);
+    test_bit_mask(200003);
+
+    std::vector<std::uint8_t> bytes = {0, 1, 255, 0, 128, 0, 0, 2, 3, 0, 7};
+    HPX_TEST_EQ(
+        phylanx::util::count_nonzero_bytes(bytes.data(), bytes.size()),
+        std::size_t(6));
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,119 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+double busy_work(std::int64_t n)
+{
+    double result = 0.0;
+    for (std::int64_t i = 0; i != n; ++i)
+    {
+        result += double(i) * 0.5;
+    }
+    return result;
+}
+
+void test_hardware_counter_data()
+{
+    phylanx::util::hardware_counter_data data;
+
+    data.add({100, 200, 3, 4});
+    data.add({100, 200, 3, 4});
+
+    HPX_TEST_EQ(data.get(phylanx::util::hardware_cycles, false),
+        std::int64_t(200));
+    HPX_TEST_EQ(data.get(phylanx::util::hardware_instructions, false),
+        std::int64_t(400));
+    HPX_TEST_EQ(data.get(phylanx::util::hardware_llc_misses, true),
+        std::int64_t(6));
+    HPX_TEST_EQ(data.get(phylanx::util::hardware_llc_misses, false),
+        std::int64_t(0));
+    HPX_TEST_EQ(data.get(phylanx::util::hardware_branch_misses, false),
+        std::int64_t(8));
+}
+
+void test_hardware_counter_scope()
+{
+    phylanx::util::hardware_counter_data data;
+
+    // nothing is sampled as long as the hardware counters are disabled
+    HPX_TEST(!phylanx::util::hardware_counters_enabled());
+    {
+        phylanx::util::hardware_counter_scope scope(data);
+        HPX_TEST(busy_work(100000) != 0.0);
+    }
+    HPX_TEST_EQ(data.get(phylanx::util::hardware_instructions, false),
+        std::int64_t(0));
+
+    phylanx::util::enable_hardware_counters();
+    {
+        phylanx::util::hardware_counter_scope scope(data);
+        HPX_TEST(busy_work(100000) != 0.0);
+    }
+    phylanx::util::enable_hardware_counters(false);
+
+    // the values stay zero if perf_event is not available
+    bool const available = phylanx::util::hardware_counters_available();
+    HPX_TEST_EQ(
+        data.get(phylanx::util::hardware_instructions, false) > 0, available);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_primitive_hardware_counters()
+{
+    using namespace phylanx::execution_tree;
+
+    compiler::function_list snippets;
+    auto const& code = compile("hardware_counters",
+        "define(f, n, sum(constant(1.0, n)))\nf", snippets);
+    auto f = code.run();
+
+    // querying the counters enables the sampling
+    phylanx::util::retrieve_hardware_counter_data();
+    HPX_TEST(phylanx::util::hardware_counters_enabled());
+
+    HPX_TEST_EQ(
+        extract_scalar_numeric_value(f(std::int64_t(100000))), 100000.0);
+
+    auto const data = phylanx::util::retrieve_hardware_counter_data();
+
+    std::int64_t evaluations = 0;
+    std::int64_t instructions = 0;
+    for (auto const& entry : data)
+    {
+        HPX_TEST_EQ(entry.second.size(), std::size_t(5));
+        evaluations += entry.second[0];
+        instructions += entry.second[2];
+    }
+
+    HPX_TEST(evaluations != 0);
+    HPX_TEST_EQ(instructions > 0,
+        phylanx::util::hardware_counters_available());
+
+    std::ostringstream report;
+    phylanx::util::print_hardware_counter_report(report, data);
+    HPX_TEST(report.str().find("IPC") != std::string::npos);
+
+    phylanx::util::enable_hardware_counters(false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_hardware_counter_data();
+    test_hardware_counter_scope();
+    test_primitive_hardware_counters();
+
+    return hpx::util::report_errors();
+}
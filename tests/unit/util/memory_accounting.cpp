@@ -0,0 +1,121 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+void test_memory_footprint()
+{
+    using phylanx::execution_tree::primitive_argument_type;
+
+    blaze::DynamicVector<double> v(10, 1.0);
+    phylanx::ir::node_data<double> vector{v};
+
+    HPX_TEST_EQ(phylanx::util::memory_footprint(primitive_argument_type{
+                    phylanx::ir::node_data<double>{42.0}}),
+        std::int64_t(0));
+    HPX_TEST_EQ(
+        phylanx::util::memory_footprint(primitive_argument_type{vector}),
+        std::int64_t(10 * sizeof(double)));
+    HPX_TEST_EQ(phylanx::util::memory_footprint(
+                    primitive_argument_type{vector.ref()}),
+        std::int64_t(0));
+
+    blaze::DynamicMatrix<std::int64_t> m(3, 4, 1);
+    HPX_TEST_EQ(phylanx::util::memory_footprint(primitive_argument_type{
+                    phylanx::ir::node_data<std::int64_t>{m}}),
+        std::int64_t(12 * sizeof(std::int64_t)));
+}
+
+void test_memory_accounting()
+{
+    std::int64_t const live = phylanx::util::memory_live_bytes(false);
+
+    {
+        phylanx::util::memory_accounting memory;
+
+        memory.record(800);
+        memory.record(400);
+
+        HPX_TEST_EQ(memory.allocated_bytes(false), std::int64_t(1200));
+        HPX_TEST_EQ(memory.live_bytes(false), std::int64_t(400));
+        HPX_TEST_EQ(memory.peak_bytes(false), std::int64_t(800));
+
+        HPX_TEST_EQ(phylanx::util::memory_live_bytes(false), live + 400);
+        HPX_TEST(phylanx::util::memory_peak_bytes(false) >= live + 800);
+
+        // the peak is reset to the live bytes
+        HPX_TEST_EQ(memory.peak_bytes(true), std::int64_t(800));
+        HPX_TEST_EQ(memory.peak_bytes(false), std::int64_t(400));
+        HPX_TEST_EQ(memory.allocated_bytes(true), std::int64_t(1200));
+        HPX_TEST_EQ(memory.allocated_bytes(false), std::int64_t(0));
+    }
+
+    // the bytes held by the last result are released with the primitive
+    HPX_TEST_EQ(phylanx::util::memory_live_bytes(false), live);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_primitive_memory_accounting()
+{
+    using namespace phylanx::execution_tree;
+
+    compiler::function_list snippets;
+    auto const& code = compile(
+        "memory_accounting", "define(f, n, constant(1.0, n))\nf", snippets);
+    auto f = code.run();
+
+    phylanx::util::enable_memory_accounting();
+    HPX_TEST(phylanx::util::memory_accounting_enabled());
+
+    f(std::int64_t(10));
+    f(std::int64_t(20));
+
+    std::map<std::string, std::vector<std::int64_t>> constant_data;
+    for (auto const& entry : phylanx::util::retrieve_memory_data())
+    {
+        if (entry.first.find("/constant$") != std::string::npos)
+        {
+            constant_data.insert(entry);
+        }
+    }
+
+    HPX_TEST_EQ(constant_data.size(), std::size_t(1));
+
+    auto const& data = constant_data.begin()->second;
+    HPX_TEST_EQ(data.size(), std::size_t(3));
+    HPX_TEST_EQ(data[0], std::int64_t(30 * sizeof(double)));    // allocated
+    HPX_TEST_EQ(data[1], std::int64_t(20 * sizeof(double)));    // live
+    HPX_TEST_EQ(data[2], std::int64_t(20 * sizeof(double)));    // peak
+
+    std::ostringstream report;
+    phylanx::util::print_memory_report(report, constant_data);
+    HPX_TEST(report.str().find("constant") != std::string::npos);
+    HPX_TEST(report.str().find("240") != std::string::npos);
+
+    phylanx::util::enable_memory_accounting(false);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_memory_footprint();
+    test_memory_accounting();
+    test_primitive_memory_accounting();
+
+    return hpx::util::report_errors();
+}
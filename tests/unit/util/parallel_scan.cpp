@@ -0,0 +1,177 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/parallel_scan.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+// the larger sizes are processed in parallel and are not multiples of the
+// chunk size
+void test_inclusive_scan(std::size_t size)
+{
+    std::vector<std::int64_t> v(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        v[i] = std::int64_t(i % 7) - 3;
+    }
+
+    std::vector<std::int64_t> expected(size);
+    std::partial_sum(v.begin(), v.end(), expected.begin());
+    for (auto& e : expected)
+    {
+        e += 42;
+    }
+
+    std::vector<std::int64_t> result(size);
+    phylanx::util::inclusive_scan(
+        v.data(), size, result.data(), std::plus<>{}, std::int64_t(42));
+    HPX_TEST(result == expected);
+}
+
+// the rows of the source are padded
+void test_inclusive_scan_matrix(std::size_t rows, std::size_t columns)
+{
+    blaze::DynamicMatrix<double> m(rows, columns);
+    std::vector<double> expected(rows * columns);
+    double sum = 0.0;
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        for (std::size_t j = 0; j != columns; ++j)
+        {
+            m(i, j) = double((i + j) % 9) - 4.0;
+            sum += m(i, j);
+            expected[i * columns + j] = sum;
+        }
+    }
+
+    std::vector<double> result(rows * columns);
+    phylanx::util::inclusive_scan(m.data(), rows, columns, m.spacing(),
+        result.data(), columns, std::plus<>{}, 0.0);
+    HPX_TEST(result == expected);
+}
+
+void test_inclusive_scan_axis(std::size_t pages, std::size_t rows,
+    std::size_t columns)
+{
+    blaze::DynamicTensor<std::int64_t> t(pages, rows, columns);
+    for (std::size_t k = 0; k != pages; ++k)
+    {
+        for (std::size_t i = 0; i != rows; ++i)
+        {
+            for (std::size_t j = 0; j != columns; ++j)
+            {
+                t(k, i, j) = std::int64_t((k + 3 * i + 7 * j) % 11) - 5;
+            }
+        }
+    }
+
+    std::size_t const ld = t.spacing();
+    std::size_t const page_ld = rows * ld;
+
+    // along the pages
+    {
+        blaze::DynamicTensor<std::int64_t> expected = t;
+        for (std::size_t k = 1; k < pages; ++k)
+        {
+            blaze::pageslice(expected, k) += blaze::pageslice(expected, k - 1);
+        }
+
+        blaze::DynamicTensor<std::int64_t> result(pages, rows, columns);
+        phylanx::util::inclusive_scan_axis(t.data(), {ld, page_ld, 1},
+            result.data(), {ld, page_ld, 1}, {rows, pages, columns},
+            std::plus<>{}, std::int64_t(0));
+        HPX_TEST_EQ(result, expected);
+    }
+
+    // along the rows of every page
+    {
+        blaze::DynamicTensor<std::int64_t> expected = t;
+        for (std::size_t k = 0; k != pages; ++k)
+        {
+            auto ps = blaze::pageslice(expected, k);
+            for (std::size_t i = 1; i < rows; ++i)
+            {
+                blaze::row(ps, i) += blaze::row(ps, i - 1);
+            }
+        }
+
+        blaze::DynamicTensor<std::int64_t> result(pages, rows, columns);
+        phylanx::util::inclusive_scan_axis(t.data(), {page_ld, ld, 1},
+            result.data(), {page_ld, ld, 1}, {pages, rows, columns},
+            std::plus<>{}, std::int64_t(0));
+        HPX_TEST_EQ(result, expected);
+    }
+
+    // along the columns of every row
+    {
+        blaze::DynamicTensor<std::int64_t> expected = t;
+        for (std::size_t k = 0; k != pages; ++k)
+        {
+            auto ps = blaze::pageslice(expected, k);
+            for (std::size_t j = 1; j < columns; ++j)
+            {
+                blaze::column(ps, j) += blaze::column(ps, j - 1);
+            }
+        }
+
+        blaze::DynamicTensor<std::int64_t> result(pages, rows, columns);
+        phylanx::util::inclusive_scan_axis(t.data(), {ld, 1, 0},
+            result.data(), {ld, 1, 0}, {pages * rows, columns, 1},
+            std::plus<>{}, std::int64_t(0));
+        HPX_TEST_EQ(result, expected);
+    }
+}
+
+void test_compact(std::size_t size)
+{
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (i % 3 == 0 || i % 5 == 0)
+        {
+            expected.push_back(i);
+        }
+    }
+
+    std::vector<std::size_t> result;
+    std::size_t selected = phylanx::util::compact(
+        size, [](std::size_t i) { return i % 3 == 0 || i % 5 == 0; },
+        [&](std::size_t count) { result.resize(count); },
+        [&](std::size_t i, std::size_t pos) { result[pos] = i; });
+
+    HPX_TEST_EQ(selected, expected.size());
+    HPX_TEST(result == expected);
+}
+
+int main(int argc, char* argv[])
+{
+    test_inclusive_scan(0);
+    test_inclusive_scan(1);
+    test_inclusive_scan(1000);
+    test_inclusive_scan(1000003);
+
+    test_inclusive_scan_matrix(3, 5);
+    test_inclusive_scan_matrix(1031, 263);
+
+    test_inclusive_scan_axis(2, 3, 5);
+    test_inclusive_scan_axis(17, 130, 1033);
+
+    test_compact(0);
+    test_compact(100);
+    test_compact(1000003);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,207 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+//  block(                  line 1
+//      x * 2.0,            line 2
+//      x + 1.0 + x         line 3 (the inner addition at column 5)
+//  )
+char const* const block = "/phylanx$0/block$0/0$1$1";
+char const* const mul = "/phylanx$0/__mul$0/0$2$5";
+char const* const add_outer = "/phylanx$0/__add$0/0$3$5";
+char const* const add_inner = "/phylanx$0/__add$1/0$3$9";
+char const* const x_mul = "/phylanx$0/access-argument$0$x/0$2$5";
+char const* const x_add = "/phylanx$0/access-argument$1$x/0$3$5";
+
+phylanx::execution_tree::topology make_topology()
+{
+    using phylanx::execution_tree::topology;
+
+    std::vector<topology> mul_children{topology(x_mul)};
+    std::vector<topology> inner_children{topology(x_add)};
+    std::vector<topology> outer_children{
+        topology(std::move(inner_children), add_inner), topology(x_add)};
+
+    std::vector<topology> block_children{
+        topology(std::move(mul_children), mul),
+        topology(std::move(outer_children), add_outer)};
+
+    return topology(std::move(block_children), block);
+}
+
+// count, inclusive time (ns), eval_direct
+std::map<std::string, std::vector<std::int64_t>> const counter_data = {
+    {block, {1, 10000, 0}},
+    {mul, {1, 4000, 1}},
+    {add_outer, {1, 5000, 0}},
+    {add_inner, {1, 3000, 1}},
+    {x_mul, {1, 1000, 1}},
+    {x_add, {1, 500, 1}},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void test_performance_analysis()
+{
+    auto const analysis = phylanx::util::analyze_performance(
+        "test", make_topology(), counter_data);
+
+    std::map<std::string, phylanx::util::primitive_performance> primitives;
+    for (auto const& p : analysis.primitives)
+    {
+        primitives[p.name] = p;
+    }
+
+    // every instance is accounted for once
+    HPX_TEST_EQ(analysis.primitives.size(), std::size_t(6));
+
+    HPX_TEST_EQ(primitives[block].self_time, std::int64_t(1000));
+    HPX_TEST_EQ(primitives[mul].self_time, std::int64_t(3000));
+    HPX_TEST_EQ(primitives[add_outer].self_time, std::int64_t(2000));
+    HPX_TEST_EQ(primitives[add_inner].self_time, std::int64_t(2500));
+    HPX_TEST_EQ(primitives[x_mul].self_time, std::int64_t(1000));
+    HPX_TEST_EQ(primitives[x_add].self_time, std::int64_t(500));
+
+    HPX_TEST_EQ(primitives[mul].inclusive_time, std::int64_t(4000));
+    HPX_TEST_EQ(primitives[mul].location, std::string("test:2"));
+
+    // the primitives are sorted by decreasing self time
+    HPX_TEST_EQ(analysis.primitives.front().name, std::string(mul));
+    HPX_TEST_EQ(analysis.primitives.back().name, std::string(x_add));
+
+    // block -> add_outer -> add_inner -> x_add is the longest chain
+    std::vector<std::string> const critical_path{
+        block, add_outer, add_inner, x_add};
+    HPX_TEST(analysis.critical_path == critical_path);
+    HPX_TEST_EQ(analysis.critical_path_time, std::int64_t(6000));
+    HPX_TEST_EQ(analysis.total_time, std::int64_t(10000));
+    HPX_TEST_EQ(analysis.parallelism, 10000.0 / 6000.0);
+
+    HPX_TEST(primitives[add_inner].critical);
+    HPX_TEST(!primitives[mul].critical);
+
+    // the instances created for line 3 are aggregated
+    HPX_TEST_EQ(analysis.locations.size(), std::size_t(3));
+    HPX_TEST_EQ(analysis.locations.front().location, std::string("test:3"));
+    HPX_TEST_EQ(analysis.locations.front().count, std::int64_t(3));
+    HPX_TEST_EQ(analysis.locations.front().self_time, std::int64_t(5000));
+
+    // the self times are attributed to the stack of their first occurrence
+    std::ostringstream folded_stacks;
+    phylanx::util::print_folded_stacks(folded_stacks, analysis);
+
+    std::string const expected =
+        "block(1:1) 1000\n"
+        "block(1:1);add(3:5) 2000\n"
+        "block(1:1);add(3:5);add(3:9) 2500\n"
+        "block(1:1);add(3:5);add(3:9);access-argument/x(3:5) 500\n"
+        "block(1:1);mul(2:5) 3000\n"
+        "block(1:1);mul(2:5);access-argument/x(2:5) 1000\n";
+    HPX_TEST_EQ(folded_stacks.str(), expected);
+
+    std::ostringstream report;
+    phylanx::util::print_performance_report(report, analysis);
+    HPX_TEST(report.str().find("achieved parallelism:") != std::string::npos);
+}
+
+// an instance shared by two operations is accounted for at its first
+// occurrence only, the self times never become negative
+void test_performance_analysis_shared()
+{
+    using phylanx::execution_tree::topology;
+
+    //  block(                  line 1
+    //      y + 1,              line 2
+    //      y * 2               line 3
+    //  )
+    char const* const block = "/phylanx$0/block$0/0$1$1";
+    char const* const add = "/phylanx$0/__add$0/0$2$5";
+    char const* const mul = "/phylanx$0/__mul$0/0$3$5";
+    char const* const y = "/phylanx$0/access-variable$0$y/0$2$5";
+
+    std::vector<topology> add_children{topology(y)};
+    std::vector<topology> mul_children{topology(y)};
+    std::vector<topology> block_children{
+        topology(std::move(add_children), add),
+        topology(std::move(mul_children), mul)};
+
+    std::map<std::string, std::vector<std::int64_t>> const data = {
+        {block, {2, 6000, 0}},
+        {add, {2, 1000, 1}},
+        {mul, {2, 5000, 1}},
+        {y, {4, 2000, 1}},
+    };
+
+    auto const analysis = phylanx::util::analyze_performance(
+        "test", topology(std::move(block_children), block), data);
+
+    std::map<std::string, phylanx::util::primitive_performance> primitives;
+    for (auto const& p : analysis.primitives)
+    {
+        primitives[p.name] = p;
+    }
+
+    HPX_TEST_EQ(analysis.primitives.size(), std::size_t(4));
+
+    // the operand took longer than the addition waiting for it
+    HPX_TEST_EQ(primitives[add].self_time, std::int64_t(0));
+    HPX_TEST_EQ(primitives[y].self_time, std::int64_t(2000));
+    HPX_TEST_EQ(primitives[y].count, std::int64_t(4));
+
+    // the multiplication does not account for the shared operand
+    HPX_TEST_EQ(primitives[mul].self_time, std::int64_t(5000));
+    HPX_TEST_EQ(primitives[block].self_time, std::int64_t(0));
+
+    std::vector<std::string> const critical_path{block, mul};
+    HPX_TEST(analysis.critical_path == critical_path);
+    HPX_TEST_EQ(analysis.critical_path_time, std::int64_t(5000));
+    HPX_TEST_EQ(analysis.total_time, std::int64_t(7000));
+    HPX_TEST_EQ(analysis.parallelism, 7000.0 / 5000.0);
+
+    HPX_TEST(primitives[mul].critical);
+    HPX_TEST(!primitives[y].critical);
+
+    // stacks without self time are omitted
+    std::ostringstream folded_stacks;
+    phylanx::util::print_folded_stacks(folded_stacks, analysis);
+
+    std::string const expected =
+        "block(1:1);add(2:5);access-variable/y(2:5) 2000\n"
+        "block(1:1);mul(3:5) 5000\n";
+    HPX_TEST_EQ(folded_stacks.str(), expected);
+}
+
+void test_performance_analysis_no_data()
+{
+    auto const analysis = phylanx::util::analyze_performance(
+        "test", make_topology(), {});
+
+    HPX_TEST_EQ(analysis.primitives.size(), std::size_t(6));
+    HPX_TEST_EQ(analysis.total_time, std::int64_t(0));
+    HPX_TEST_EQ(analysis.critical_path_time, std::int64_t(0));
+    HPX_TEST_EQ(analysis.parallelism, 0.0);
+    HPX_TEST(analysis.folded_stacks.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_performance_analysis();
+    test_performance_analysis_shared();
+    test_performance_analysis_no_data();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,96 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/permute_axes.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <blaze/Math.h>
+#include <blaze_tensor/Math.h>
+
+// the sizes are not multiples of the tile sizes, the larger ones are
+// processed in parallel
+void test_permute_matrix(std::size_t rows, std::size_t columns)
+{
+    blaze::DynamicMatrix<double> m(rows, columns);
+    blaze::randomize(m);
+
+    blaze::DynamicMatrix<double> expected = blaze::trans(m);
+    HPX_TEST_EQ(phylanx::util::permute_axes(m), expected);
+
+    blaze::DynamicMatrix<std::int64_t> mi(rows, columns);
+    blaze::randomize(mi);
+
+    blaze::DynamicMatrix<std::int64_t> expected_i = blaze::trans(mi);
+    HPX_TEST_EQ(phylanx::util::permute_axes(mi), expected_i);
+}
+
+void test_transpose_inplace(std::size_t rows, std::size_t columns)
+{
+    blaze::DynamicMatrix<double> m(rows, columns);
+    blaze::randomize(m);
+
+    blaze::DynamicMatrix<double> expected = blaze::trans(m);
+    phylanx::util::transpose_inplace(m);
+    HPX_TEST_EQ(m, expected);
+}
+
+void test_permute_tensor(std::size_t pages, std::size_t rows,
+    std::size_t columns)
+{
+    blaze::DynamicTensor<double> t(pages, rows, columns);
+    blaze::randomize(t);
+
+    std::array<std::size_t, 3> axes = {0, 1, 2};
+    do
+    {
+        blaze::DynamicTensor<double> expected =
+            blaze::trans(t, {axes[0], axes[1], axes[2]});
+        HPX_TEST_EQ(phylanx::util::permute_axes(t, axes), expected);
+    } while (std::next_permutation(axes.begin(), axes.end()));
+}
+
+void test_permute_array(std::size_t quats, std::size_t pages,
+    std::size_t rows, std::size_t columns)
+{
+    blaze::DynamicArray<4, double> q(quats, pages, rows, columns);
+    blaze::randomize(q);
+
+    std::array<std::size_t, 4> axes = {0, 1, 2, 3};
+    do
+    {
+        blaze::DynamicArray<4, double> expected =
+            blaze::trans(q, {axes[0], axes[1], axes[2], axes[3]});
+        HPX_TEST_EQ(phylanx::util::permute_axes(q, axes), expected);
+    } while (std::next_permutation(axes.begin(), axes.end()));
+}
+
+int main(int argc, char* argv[])
+{
+    test_permute_matrix(1, 1);
+    test_permute_matrix(7, 13);
+    test_permute_matrix(130, 67);
+    test_permute_matrix(333, 517);
+
+    test_transpose_inplace(1, 1);
+    test_transpose_inplace(9, 9);
+    test_transpose_inplace(257, 257);
+    test_transpose_inplace(130, 67);
+
+    test_permute_tensor(3, 5, 7);
+    test_permute_tensor(17, 70, 67);
+
+    test_permute_array(2, 3, 5, 7);
+    test_permute_array(5, 9, 66, 71);
+
+    return hpx::util::report_errors();
+}
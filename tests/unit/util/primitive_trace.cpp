@@ -0,0 +1,122 @@
+//  Copyright (c) 2021 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t count_occurrences(std::string const& str, std::string const& what)
+{
+    std::size_t count = 0;
+    for (std::size_t pos = str.find(what); pos != std::string::npos;
+         pos = str.find(what, pos + what.size()))
+    {
+        ++count;
+    }
+    return count;
+}
+
+// number of evaluations of the addition recorded in the given trace
+std::size_t count_add_events(std::string const& trace)
+{
+    return count_occurrences(
+               trace, R"("name":"add","cat":"primitive","ph":"X")") +
+        count_occurrences(
+            trace, R"("name":"add","cat":"primitive","ph":"b")");
+}
+
+// sum of the values of the given numeric argument of all events
+std::size_t sum_values(std::string const& trace, std::string const& arg)
+{
+    std::string const what = "\"" + arg + "\":";
+
+    std::size_t sum = 0;
+    for (std::size_t pos = trace.find(what); pos != std::string::npos;
+         pos = trace.find(what, pos + what.size()))
+    {
+        sum += std::stoul(trace.substr(pos + what.size()));
+    }
+    return sum;
+}
+
+void test_primitive_trace()
+{
+    using namespace phylanx::execution_tree;
+
+    compiler::function_list snippets;
+    auto const& code =
+        compile("trace", "define(f, x, x + 1.0)\nf", snippets);
+    auto f = code.run();
+
+    constexpr std::int64_t evaluations = 10;
+
+    // nothing is recorded as long as tracing is disabled
+    HPX_TEST(!phylanx::util::tracing_enabled());
+    HPX_TEST_EQ(extract_scalar_numeric_value(f(1.0)), 2.0);
+    HPX_TEST_EQ(count_add_events(phylanx::util::retrieve_trace()),
+        std::size_t(0));
+
+    phylanx::util::enable_tracing();
+    HPX_TEST(phylanx::util::tracing_enabled());
+
+    for (std::int64_t i = 0; i != evaluations; ++i)
+    {
+        HPX_TEST_EQ(extract_scalar_numeric_value(f(double(i))), i + 1.0);
+    }
+
+    phylanx::util::enable_tracing(false);
+    HPX_TEST(!phylanx::util::tracing_enabled());
+
+    std::ostringstream os;
+    phylanx::util::write_trace(os);
+    std::string const trace = os.str();
+
+    HPX_TEST_EQ(trace.find(R"({"traceEvents":[)"), std::size_t(0));
+    HPX_TEST_EQ(count_add_events(trace), std::size_t(evaluations));
+
+    // the events refer to the location of the addition in the code
+    HPX_TEST(trace.find(R"("location":"trace:1:)") != std::string::npos);
+    HPX_TEST(trace.find(R"("operands":2,"literal_operands":1)") !=
+        std::string::npos);
+
+    // the addition requests its argument, every request that was not ready
+    // produces a wait nested into the slice of the addition
+    HPX_TEST(trace.find(R"("requested_operands":1,"pending_operands":)") !=
+        std::string::npos);
+    HPX_TEST(sum_values(trace, "pending_operands") <=
+        sum_values(trace, "requested_operands"));
+    HPX_TEST_EQ(
+        count_occurrences(trace, R"("name":"wait for operand #)"),
+        2 * sum_values(trace, "pending_operands"));
+
+    // every worker thread that recorded events is named
+    HPX_TEST(trace.find(R"("name":"process_name","ph":"M","pid":0)") !=
+        std::string::npos);
+    HPX_TEST(trace.find(R"("name":"thread_name","ph":"M","pid":0)") !=
+        std::string::npos);
+
+    // events recorded while tracing was disabled are not added
+    HPX_TEST_EQ(extract_scalar_numeric_value(f(1.0)), 2.0);
+    HPX_TEST_EQ(count_add_events(phylanx::util::retrieve_trace()),
+        std::size_t(evaluations));
+
+    phylanx::util::clear_trace();
+    HPX_TEST_EQ(count_add_events(phylanx::util::retrieve_trace()),
+        std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_primitive_trace();
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2021 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/distributed_vector.hpp>
+#include <phylanx/util/remote_tile_cache.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/modules/testing.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+REGISTER_DISTRIBUTED_VECTOR_DECLARATION(double);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_remote_tile_cache_vector()
+{
+    std::size_t num_localities = hpx::get_num_localities(hpx::launch::sync);
+    std::size_t this_locality = hpx::get_locality_id();
+    std::size_t other_locality = (this_locality + 1) % num_localities;
+
+    HPX_TEST(phylanx::util::remote_tile_cache_enabled());
+
+    phylanx::util::remote_tile_cache_hits(true);
+    phylanx::util::remote_tile_cache_misses(true);
+    phylanx::util::remote_tile_cache_evictions(true);
+
+    std::int64_t transferred_bytes = 0;
+
+    {
+        phylanx::ir::node_data<double> v(
+            blaze::DynamicVector<double>(16, double(this_locality)));
+
+        phylanx::util::distributed_vector<double> const dist_v(
+            "test_remote_tile_cache_vector", v.vector(), num_localities,
+            this_locality, &transferred_bytes, true);
+
+        // the first fetch transfers the data from the remote locality
+        auto r1 = dist_v.fetch(other_locality, 4, 8).get();
+        HPX_TEST_EQ(r1.size(), std::size_t(4));
+        HPX_TEST_EQ(r1[0], double(other_locality));
+        HPX_TEST_EQ(phylanx::util::remote_tile_cache_misses(false), 1);
+
+        std::int64_t bytes = transferred_bytes;
+        HPX_TEST_NEQ(bytes, 0);
+
+        // the second fetch of the same range uses the cached copy
+        auto r2 = dist_v.fetch(other_locality, 4, 8).get();
+        HPX_TEST_EQ(r2, r1);
+        HPX_TEST_EQ(phylanx::util::remote_tile_cache_hits(false), 1);
+        HPX_TEST_EQ(transferred_bytes, bytes);
+
+        hpx::lcos::barrier b("barrier_test_remote_tile_cache_vector_1",
+            num_localities, this_locality);
+        b.wait();
+    }
+
+    {
+        // storing the same data again keeps the cached copies valid
+        phylanx::ir::node_data<double> v(
+            blaze::DynamicVector<double>(16, double(this_locality)));
+
+        phylanx::util::distributed_vector<double> const dist_v(
+            "test_remote_tile_cache_vector", v.vector(), num_localities,
+            this_locality, &transferred_bytes, true);
+
+        std::int64_t bytes = transferred_bytes;
+
+        auto r = dist_v.fetch(other_locality, 4, 8).get();
+        HPX_TEST_EQ(r[0], double(other_locality));
+        HPX_TEST_EQ(phylanx::util::remote_tile_cache_hits(false), 2);
+        HPX_TEST_EQ(transferred_bytes, bytes);
+
+        hpx::lcos::barrier b("barrier_test_remote_tile_cache_vector_2",
+            num_localities, this_locality);
+        b.wait();
+    }
+
+    {
+        // storing different data under the same name replaces the cached
+        // copies
+        phylanx::ir::node_data<double> v(
+            blaze::DynamicVector<double>(16, double(this_locality + 1)));
+
+        phylanx::util::distributed_vector<double> const dist_v(
+            "test_remote_tile_cache_vector", v.vector(), num_localities,
+            this_locality, &transferred_bytes, true);
+
+        auto r = dist_v.fetch(other_locality, 4, 8).get();
+        HPX_TEST_EQ(r[0], double(other_locality + 1));
+        HPX_TEST_EQ(phylanx::util::remote_tile_cache_misses(false), 2);
+        HPX_TEST_EQ(phylanx::util::remote_tile_cache_evictions(false), 1);
+
+        hpx::lcos::barrier b("barrier_test_remote_tile_cache_vector_3",
+            num_localities, this_locality);
+        b.wait();
+    }
+
+    {
+        // parts that were accessed for modification are never cached
+        phylanx::ir::node_data<double> v(
+            blaze::DynamicVector<double>(16, double(this_locality)));
+
+        phylanx::util::distributed_vector<double> dist_v(
+            "test_remote_tile_cache_vector", v.vector(), num_localities,
+            this_locality, &transferred_bytes, true);
+
+        (*dist_v)[4] = -1.0;
+
+        hpx::lcos::barrier b1("barrier_test_remote_tile_cache_vector_4",
+            num_localities, this_locality);
+        b1.wait();
+
+        auto r1 = dist_v.fetch(other_locality, 4, 8).get();
+        HPX_TEST_EQ(r1[0], -1.0);
+
+        auto r2 = dist_v.fetch(other_locality, 4, 8).get();
+        HPX_TEST_EQ(r2[0], -1.0);
+
+        HPX_TEST_EQ(phylanx::util::remote_tile_cache_hits(false), 2);
+        HPX_TEST_EQ(phylanx::util::remote_tile_cache_misses(false), 4);
+
+        hpx::lcos::barrier b2("barrier_test_remote_tile_cache_vector_5",
+            num_localities, this_locality);
+        b2.wait();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_remote_tile_cache_vector();
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg = {
+        "hpx.run_hpx_main!=1",
+        "phylanx.remote_tile_cache_size=1048576"
+    };
+
+    hpx::init_params params;
+    params.cfg = std::move(cfg);
+    return hpx::init(argc, argv, params);
+}